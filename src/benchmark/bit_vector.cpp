@@ -0,0 +1,162 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include "utility/bit_kernels.h"
+#include "utility/bit_vector.h"
+
+namespace {
+
+using encrypto::motion::BitKernelLevel;
+using encrypto::motion::BitVector;
+
+// Selects the kernel level given by the second argument and returns the bit size given by the
+// first one.  Levels not supported by the CPU are skipped.
+std::size_t Setup(benchmark::State& state) {
+  const auto level = static_cast<BitKernelLevel>(state.range(1));
+  if (static_cast<int>(level) > static_cast<int>(encrypto::motion::GetSupportedBitKernelLevel())) {
+    state.SkipWithError("kernel level not supported by this CPU");
+  }
+  encrypto::motion::SetBitKernelLevel(level);
+  return state.range(0);
+}
+
+void SetBytesProcessed(benchmark::State& state, std::size_t number_of_bits) {
+  state.SetBytesProcessed(state.iterations() * ((number_of_bits + 7) / 8));
+}
+
+// sizes from 1 bit to 10^8 bits for each of the kernel levels
+void Arguments(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgsProduct({benchmark::CreateRange(1, 100'000'000, 10),
+                          {static_cast<int>(BitKernelLevel::kScalar),
+                           static_cast<int>(BitKernelLevel::kAvx2),
+                           static_cast<int>(BitKernelLevel::kAvx512)}});
+  benchmark->ArgNames({"bits", "level"});
+}
+
+}  // namespace
+
+/**
+ * Benchmark for the in-place XOR of two BitVectors of bits (first argument) bits using the kernels
+ * of level (second argument, 0 = scalar, 1 = AVX2, 2 = AVX-512).
+ *
+ * @param state the benchmark state
+ */
+static void BM_BitVectorXor(benchmark::State& state) {
+  const auto number_of_bits = Setup(state);
+  auto a = BitVector<>::SecureRandom(number_of_bits);
+  const auto b = BitVector<>::SecureRandom(number_of_bits);
+  for (auto _ : state) {
+    a ^= b;
+    benchmark::DoNotOptimize(a.GetData().data());
+  }
+  SetBytesProcessed(state, number_of_bits);
+}
+BENCHMARK(BM_BitVectorXor)->Apply(Arguments);
+
+/**
+ * Benchmark for the in-place AND of two BitVectors, see BM_BitVectorXor.
+ *
+ * @param state the benchmark state
+ */
+static void BM_BitVectorAnd(benchmark::State& state) {
+  const auto number_of_bits = Setup(state);
+  auto a = BitVector<>::SecureRandom(number_of_bits);
+  const auto b = BitVector<>::SecureRandom(number_of_bits);
+  for (auto _ : state) {
+    a &= b;
+    benchmark::DoNotOptimize(a.GetData().data());
+  }
+  SetBytesProcessed(state, number_of_bits);
+}
+BENCHMARK(BM_BitVectorAnd)->Apply(Arguments);
+
+/**
+ * Benchmark for the in-place inversion of a BitVector, see BM_BitVectorXor.
+ *
+ * @param state the benchmark state
+ */
+static void BM_BitVectorInvert(benchmark::State& state) {
+  const auto number_of_bits = Setup(state);
+  auto a = BitVector<>::SecureRandom(number_of_bits);
+  for (auto _ : state) {
+    a.Invert();
+    benchmark::DoNotOptimize(a.GetData().data());
+  }
+  SetBytesProcessed(state, number_of_bits);
+}
+BENCHMARK(BM_BitVectorInvert)->Apply(Arguments);
+
+/**
+ * Benchmark for XorBitVectors of four BitVectors, see BM_BitVectorXor.
+ *
+ * @param state the benchmark state
+ */
+static void BM_XorBitVectors(benchmark::State& state) {
+  const auto number_of_bits = Setup(state);
+  std::vector<BitVector<>> bit_vectors;
+  for (std::size_t i = 0; i < 4; ++i) {
+    bit_vectors.emplace_back(BitVector<>::SecureRandom(number_of_bits));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BitVector<>::XorBitVectors(bit_vectors));
+  }
+  SetBytesProcessed(state, bit_vectors.size() * number_of_bits);
+}
+BENCHMARK(BM_XorBitVectors)->Apply(Arguments);
+
+/**
+ * Benchmark for extracting the Subset starting at the unaligned bit offset 3 of a BitVector of
+ * bits + 3 bits, as done when slicing MTs, see BM_BitVectorXor.
+ *
+ * @param state the benchmark state
+ */
+static void BM_BitVectorSubsetUnaligned(benchmark::State& state) {
+  const auto number_of_bits = Setup(state);
+  const auto a = BitVector<>::SecureRandom(number_of_bits + 3);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.Subset(3, number_of_bits + 3));
+  }
+  SetBytesProcessed(state, number_of_bits);
+}
+BENCHMARK(BM_BitVectorSubsetUnaligned)->Apply(Arguments);
+
+/**
+ * Benchmark for copying a BitVector to the unaligned bit offset 3 of another BitVector, see
+ * BM_BitVectorXor.
+ *
+ * @param state the benchmark state
+ */
+static void BM_BitVectorCopyUnaligned(benchmark::State& state) {
+  const auto number_of_bits = Setup(state);
+  auto a = BitVector<>::SecureRandom(number_of_bits + 3);
+  const auto b = BitVector<>::SecureRandom(number_of_bits);
+  for (auto _ : state) {
+    a.Copy(3, b);
+    benchmark::DoNotOptimize(a.GetData().data());
+  }
+  SetBytesProcessed(state, number_of_bits);
+}
+BENCHMARK(BM_BitVectorCopyUnaligned)->Apply(Arguments);
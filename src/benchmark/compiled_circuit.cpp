@@ -0,0 +1,139 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <vector>
+
+#include "base/compiled_circuit.h"
+#include "base/party.h"
+#include "protocols/share_wrapper.h"
+
+namespace {
+
+constexpr std::size_t kNumberOfParties = 2;
+constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+
+// Runs function(party_id, party) for each of the given parties in a separate thread.
+template <typename F>
+void RunParties(std::vector<encrypto::motion::PartyPointer>& parties, F function) {
+  std::vector<std::thread> threads;
+  threads.reserve(parties.size());
+  for (std::size_t party_id = 0; party_id < parties.size(); ++party_id) {
+    threads.emplace_back([&, party_id] { function(party_id, parties.at(party_id)); });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+std::vector<encrypto::motion::PartyPointer> MakeParties() {
+  auto parties = encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, 0);
+  for (auto& party : parties) {
+    party->GetLogger()->SetEnabled(false);
+  }
+  return parties;
+}
+
+// A chain of number_of_gates additions of the inputs of both parties.
+encrypto::motion::ShareWrapper BuildCircuit(encrypto::motion::ShareWrapper a,
+                                            const encrypto::motion::ShareWrapper& b,
+                                            std::size_t number_of_gates) {
+  for (std::size_t i = 0; i < number_of_gates; ++i) {
+    a = a + b;
+  }
+  return a.Out();
+}
+
+}  // namespace
+
+/**
+ * Benchmark for evaluating a circuit of number_of_gates (argument) gates with new inputs, where
+ * the circuit is rebuilt for every evaluation after resetting the parties.
+ *
+ * @param state the benchmark state
+ */
+static void BM_RebuildCircuit(benchmark::State& state) {
+  const std::size_t number_of_gates = state.range(0);
+  auto parties = MakeParties();
+  std::uint64_t input = 0;
+  for (auto _ : state) {
+    ++input;
+    RunParties(parties, [&](std::size_t party_id, auto& party) {
+      if (input > 1) {
+        party->Reset();
+      }
+      encrypto::motion::ShareWrapper a{
+          party->template In<kArithmeticGmw>(std::vector<std::uint64_t>{input}, 0)};
+      encrypto::motion::ShareWrapper b{
+          party->template In<kArithmeticGmw>(std::vector<std::uint64_t>{party_id}, 1)};
+      BuildCircuit(a, b, number_of_gates);
+      party->Run();
+    });
+  }
+  RunParties(parties, [](std::size_t, auto& party) { party->Finish(); });
+  state.counters["evaluations"] =
+      benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_RebuildCircuit)
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 12)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * Benchmark for evaluating the same circuit with new inputs, where the circuit is built once as a
+ * compiled circuit and only its inputs are replaced before every evaluation.
+ *
+ * @param state the benchmark state
+ */
+static void BM_CompiledCircuit(benchmark::State& state) {
+  const std::size_t number_of_gates = state.range(0);
+  auto parties = MakeParties();
+  std::vector<encrypto::motion::CompiledCircuit> circuits;
+  circuits.reserve(kNumberOfParties);
+  for (auto& party : parties) {
+    circuits.emplace_back(*party);
+    auto& circuit = circuits.back();
+    auto a = circuit.In(std::vector<std::uint64_t>{0}, 0);
+    auto b = circuit.In(std::vector<std::uint64_t>{0}, 1);
+    BuildCircuit(a, b, number_of_gates);
+  }
+  std::uint64_t input = 0;
+  for (auto _ : state) {
+    ++input;
+    RunParties(parties, [&](std::size_t party_id, auto&) {
+      auto& circuit = circuits.at(party_id);
+      circuit.SetInput(party_id, party_id == 0 ? std::vector<std::uint64_t>{input}
+                                               : std::vector<std::uint64_t>{party_id});
+      circuit.Evaluate();
+    });
+  }
+  RunParties(parties, [](std::size_t, auto& party) { party->Finish(); });
+  state.counters["evaluations"] =
+      benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_CompiledCircuit)
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 12)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,85 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <boost/fiber/operations.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "utility/fiber_thread_pool/fiber_thread_pool.hpp"
+
+namespace {
+
+constexpr std::size_t kNumberOfTasks = 1 << 14;
+
+// A task that alternates between computation on its own memory and yielding, similar to a gate
+// that computes its messages and waits for the other parties' messages.
+void Task() {
+  std::vector<std::uint64_t> values(1024, 1);
+  for (std::size_t round = 0; round < 4; ++round) {
+    for (std::size_t i = 1; i < values.size(); ++i) values[i] = values[i - 1] * 31 + values[i];
+    benchmark::DoNotOptimize(values.data());
+    boost::this_fiber::yield();
+  }
+}
+
+void RunTasks(benchmark::State& state, bool pin_threads) {
+  const std::size_t number_of_workers = state.range(0);
+  for (auto _ : state) {
+    encrypto::motion::FiberThreadPool fiber_pool(number_of_workers, kNumberOfTasks, true,
+                                                 pin_threads);
+    for (std::size_t i = 0; i < kNumberOfTasks; ++i) fiber_pool.post(Task);
+    fiber_pool.join();
+  }
+  state.counters["Tasks"] =
+      benchmark::Counter(state.iterations() * kNumberOfTasks, benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+/**
+ * Benchmark for the scaling of the FiberThreadPool with the number of worker threads (argument)
+ * for independent tasks, where the workers may run on any cpu.
+ *
+ * @param state the benchmark state
+ */
+static void BM_FiberThreadPoolScaling(benchmark::State& state) { RunTasks(state, false); }
+BENCHMARK(BM_FiberThreadPoolScaling)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * Benchmark for the same tasks, where the workers are pinned to the available cpus and steal from
+ * workers on the same NUMA node first.
+ *
+ * @param state the benchmark state
+ */
+static void BM_FiberThreadPoolScalingPinned(benchmark::State& state) { RunTasks(state, true); }
+BENCHMARK(BM_FiberThreadPoolScalingPinned)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,99 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <vector>
+
+#include "base/party.h"
+#include "protocols/share_wrapper.h"
+
+namespace {
+
+// Builds a Boolean GMW circuit consisting of `depth` layers of `width` independent 1-bit AND gates
+// and evaluates it between two locally connected parties.
+void EvaluateAndLayers(std::size_t width, std::size_t depth, bool layered_evaluation) {
+  constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+  constexpr std::size_t kNumberOfParties = 2;
+  auto parties = encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, 0);
+
+  std::vector<std::thread> threads;
+  threads.reserve(kNumberOfParties);
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    threads.emplace_back([&, party_id] {
+      auto& party = parties.at(party_id);
+      party->GetLogger()->SetEnabled(false);
+      party->GetConfiguration()->SetLayeredEvaluation(layered_evaluation);
+
+      std::vector<encrypto::motion::ShareWrapper> values;
+      values.reserve(width);
+      for (std::size_t i = 0; i < width; ++i) {
+        values.emplace_back(party->In<kBooleanGmw>(false, i % kNumberOfParties));
+      }
+      encrypto::motion::ShareWrapper factor{party->In<kBooleanGmw>(true, 0)};
+      for (std::size_t layer = 0; layer < depth; ++layer) {
+        for (auto& value : values) value = value & factor;
+      }
+      for (auto& value : values) value.Out();
+
+      party->Run();
+      party->Finish();
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace
+
+/**
+ * Benchmark for the one-fiber-per-gate executor against the layered executor. The circuit consists
+ * of width (first argument) independent chains of depth (second argument) AND gates.
+ *
+ * @param state the benchmark state
+ */
+static void BM_FiberExecutor(benchmark::State& state) {
+  const std::size_t width = state.range(0), depth = state.range(1);
+  for (auto _ : state) {
+    EvaluateAndLayers(width, depth, false);
+  }
+  state.counters["Gates"] =
+      benchmark::Counter(state.iterations() * width * depth, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_FiberExecutor)
+    ->ArgsProduct({benchmark::CreateRange(1, 1 << 14, 8), {1, 16, 64}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_LayeredExecutor(benchmark::State& state) {
+  const std::size_t width = state.range(0), depth = state.range(1);
+  for (auto _ : state) {
+    EvaluateAndLayers(width, depth, true);
+  }
+  state.counters["Gates"] =
+      benchmark::Counter(state.iterations() * width * depth, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_LayeredExecutor)
+    ->ArgsProduct({benchmark::CreateRange(1, 1 << 14, 8), {1, 16, 64}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,150 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "base/motion_base_provider.h"
+#include "communication/communication_layer.h"
+#include "oblivious_transfer/base_ots/base_ot_provider.h"
+#include "oblivious_transfer/ot_flavors.h"
+#include "oblivious_transfer/ot_provider.h"
+#include "utility/bit_vector.h"
+
+namespace {
+
+constexpr std::size_t kNumberOfParties = 2;
+constexpr std::size_t kSenderId = 0;
+constexpr std::size_t kReceiverId = 1;
+
+// Two parties connected by dummy transports which already computed their base OTs
+struct OtParties {
+  OtParties()
+      : communication_layers(
+            encrypto::motion::communication::MakeDummyCommunicationLayers(kNumberOfParties)) {
+    for (std::size_t i = 0; i < kNumberOfParties; ++i) {
+      base_ot_providers.emplace_back(
+          std::make_unique<encrypto::motion::BaseOtProvider>(*communication_layers[i], nullptr));
+      base_providers.emplace_back(
+          std::make_unique<encrypto::motion::BaseProvider>(*communication_layers[i], nullptr));
+      ot_provider_managers.emplace_back(std::make_unique<encrypto::motion::OtProviderManager>(
+          *communication_layers[i], *base_ot_providers[i], *base_providers[i], nullptr));
+    }
+    RunForAllParties([this](std::size_t i) {
+      communication_layers[i]->Start();
+      base_providers[i]->Setup();
+      base_ot_providers[i]->ComputeBaseOts();
+    });
+  }
+
+  ~OtParties() {
+    RunForAllParties([this](std::size_t i) { communication_layers[i]->Shutdown(); });
+  }
+
+  template <typename F>
+  void RunForAllParties(F function) {
+    std::vector<std::future<void>> futures;
+    for (std::size_t i = 0; i < kNumberOfParties; ++i) {
+      futures.emplace_back(std::async(std::launch::async, [&function, i] { function(i); }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+  }
+
+  encrypto::motion::OtProvider& GetProvider(std::size_t party_id) {
+    return ot_provider_managers.at(party_id)->GetProvider(kNumberOfParties - 1 - party_id);
+  }
+
+  std::vector<std::unique_ptr<encrypto::motion::communication::CommunicationLayer>>
+      communication_layers;
+  std::vector<std::unique_ptr<encrypto::motion::BaseOtProvider>> base_ot_providers;
+  std::vector<std::unique_ptr<encrypto::motion::BaseProvider>> base_providers;
+  std::vector<std::unique_ptr<encrypto::motion::OtProviderManager>> ot_provider_managers;
+};
+
+}  // namespace
+
+/**
+ * Stress benchmark for the bookkeeping of many small OT vectors: registers number_of_batches
+ * (first argument) XCOT vectors of batch_size (second argument) bit OTs each, runs the OT
+ * extension setup and transfers every vector with its own sender message and corrections.
+ *
+ * @param state the benchmark state
+ */
+static void BM_ManySmallXcOtBitBatches(benchmark::State& state) {
+  const std::size_t number_of_batches = state.range(0);
+  const std::size_t batch_size = state.range(1);
+  const auto correlations = encrypto::motion::BitVector<>::SecureRandom(batch_size);
+  const auto choices = encrypto::motion::BitVector<>::SecureRandom(batch_size);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto parties = std::make_unique<OtParties>();
+    state.ResumeTiming();
+
+    std::vector<std::unique_ptr<encrypto::motion::XcOtBitSender>> senders;
+    std::vector<std::unique_ptr<encrypto::motion::XcOtBitReceiver>> receivers;
+    senders.reserve(number_of_batches);
+    receivers.reserve(number_of_batches);
+    for (std::size_t i = 0; i < number_of_batches; ++i) {
+      senders.emplace_back(parties->GetProvider(kSenderId).RegisterSendXcOtBit(batch_size));
+      receivers.emplace_back(parties->GetProvider(kReceiverId).RegisterReceiveXcOtBit(batch_size));
+    }
+    parties->RunForAllParties([&parties](std::size_t i) {
+      if (i == kSenderId) {
+        parties->GetProvider(i).SendSetup();
+      } else {
+        parties->GetProvider(i).ReceiveSetup();
+      }
+    });
+    parties->RunForAllParties([&](std::size_t i) {
+      if (i == kSenderId) {
+        for (auto& sender : senders) {
+          sender->SetCorrelations(correlations);
+          sender->SendMessages();
+        }
+        for (auto& sender : senders) sender->ComputeOutputs();
+      } else {
+        for (auto& receiver : receivers) {
+          receiver->SetChoices(choices);
+          receiver->SendCorrections();
+        }
+        for (auto& receiver : receivers) receiver->ComputeOutputs();
+      }
+    });
+
+    state.PauseTiming();
+    senders.clear();
+    receivers.clear();
+    parties.reset();
+    state.ResumeTiming();
+  }
+  state.counters["OTs"] = benchmark::Counter(state.iterations() * number_of_batches * batch_size,
+                                             benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ManySmallXcOtBitBatches)
+    ->ArgsProduct({{1 << 10, 1 << 14, 1 << 17}, {1, 8}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,138 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "base/party.h"
+#include "multiplication_triple/preprocessing_store.h"
+#include "protocols/share_wrapper.h"
+
+namespace {
+
+constexpr std::size_t kNumberOfParties = 2;
+
+std::string GetStorePath(std::size_t party_id) {
+  return (std::filesystem::temp_directory_path() /
+          fmt::format("motion_benchmark_preprocessing_{}.bin", party_id))
+      .string();
+}
+
+// Runs function(party_id, party) for each of the given parties in a separate thread.
+template <typename F>
+void RunParties(std::vector<encrypto::motion::PartyPointer>& parties, F function) {
+  std::vector<std::thread> threads;
+  threads.reserve(parties.size());
+  for (std::size_t party_id = 0; party_id < parties.size(); ++party_id) {
+    threads.emplace_back([&, party_id] {
+      auto& party = parties.at(party_id);
+      party->GetLogger()->SetEnabled(false);
+      function(party_id, party);
+      party->Finish();
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+void PrecomputeMts(std::size_t number_of_mts) {
+  encrypto::motion::PreprocessingDemand demand;
+  demand.number_of_mts_64 = number_of_mts;
+  auto parties = encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, 0);
+  RunParties(parties, [&demand](std::size_t party_id, auto& party) {
+    party->PrecomputePreprocessing(demand, GetStorePath(party_id));
+  });
+}
+
+// Evaluates a single SIMD multiplication of number_of_simd 64-bit values in arithmetic GMW.
+void EvaluateMultiplication(std::vector<encrypto::motion::PartyPointer>& parties,
+                            std::size_t number_of_simd, bool use_store) {
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  RunParties(parties, [number_of_simd, use_store](std::size_t party_id, auto& party) {
+    if (use_store) {
+      party->LoadPreprocessing(GetStorePath(party_id));
+    }
+    const std::vector<std::uint64_t> input(number_of_simd, party_id + 1);
+    encrypto::motion::ShareWrapper a{party->template In<kArithmeticGmw>(input, 0)};
+    encrypto::motion::ShareWrapper b{party->template In<kArithmeticGmw>(input, 1)};
+    (a * b).Out();
+    party->Run();
+  });
+}
+
+}  // namespace
+
+/**
+ * Benchmark for the latency of an arithmetic GMW multiplication of number_of_simd (argument)
+ * values, where the MTs are generated using OT extension during the preprocessing phase.
+ *
+ * @param state the benchmark state
+ */
+static void BM_MultiplicationWithOtPreprocessing(benchmark::State& state) {
+  const std::size_t number_of_simd = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto parties = encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, 0);
+    state.ResumeTiming();
+    EvaluateMultiplication(parties, number_of_simd, false);
+  }
+  state.counters["MTs"] =
+      benchmark::Counter(state.iterations() * number_of_simd, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_MultiplicationWithOtPreprocessing)
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 20)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * Benchmark for the online-only latency of the same multiplication, where the MTs were
+ * precomputed into a preprocessing store outside of the measured time.
+ *
+ * @param state the benchmark state
+ */
+static void BM_MultiplicationWithPreprocessingStore(benchmark::State& state) {
+  const std::size_t number_of_simd = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    PrecomputeMts(number_of_simd);
+    auto parties = encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, 0);
+    state.ResumeTiming();
+    EvaluateMultiplication(parties, number_of_simd, true);
+  }
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    std::filesystem::remove(GetStorePath(party_id));
+  }
+  state.counters["MTs"] =
+      benchmark::Counter(state.iterations() * number_of_simd, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_MultiplicationWithPreprocessingStore)
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 20)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,102 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <vector>
+
+#include "base/party.h"
+#include "protocols/share_wrapper.h"
+
+namespace {
+
+constexpr std::size_t kNumberOfParties = 2;
+constexpr std::size_t kShift = 16;
+constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+
+// Arithmetic shift to the right of a 64-bit value via A2B, rewiring of the bits and B2A.
+encrypto::motion::ShareWrapper TruncateByConversion(const encrypto::motion::ShareWrapper& share) {
+  auto bits = share.Convert<kBooleanGmw>().Split();
+  std::vector<encrypto::motion::ShareWrapper> shifted(bits.begin() + kShift, bits.end());
+  // sign extension
+  shifted.insert(shifted.end(), kShift, bits.back());
+  return encrypto::motion::ShareWrapper::Concatenate(std::move(shifted))
+      .Convert<kArithmeticGmw>();
+}
+
+// Evaluates the truncation of number_of_simd 64-bit values in arithmetic GMW.
+void EvaluateTruncation(std::size_t number_of_simd, bool use_conversion) {
+  auto parties = encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, 0);
+  std::vector<std::thread> threads;
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    threads.emplace_back([&, party_id] {
+      auto& party = parties.at(party_id);
+      party->GetLogger()->SetEnabled(false);
+      const std::vector<std::uint64_t> input(number_of_simd, party_id + 1);
+      encrypto::motion::ShareWrapper a{party->In<kArithmeticGmw>(input, 0)};
+      (use_conversion ? TruncateByConversion(a) : a.Truncate(kShift)).Out();
+      party->Run();
+      party->Finish();
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace
+
+/**
+ * Benchmark for the latency of the native truncation of number_of_simd (argument) 64-bit values,
+ * including the generation of the shared bits of the truncation pairs.
+ *
+ * @param state the benchmark state
+ */
+static void BM_TruncationGate(benchmark::State& state) {
+  const std::size_t number_of_simd = state.range(0);
+  for (auto _ : state) EvaluateTruncation(number_of_simd, false);
+  state.counters["Truncations"] =
+      benchmark::Counter(state.iterations() * number_of_simd, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_TruncationGate)
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * Benchmark for the latency of the same truncation via a conversion to Boolean GMW and back.
+ *
+ * @param state the benchmark state
+ */
+static void BM_TruncationByConversion(benchmark::State& state) {
+  const std::size_t number_of_simd = state.range(0);
+  for (auto _ : state) EvaluateTruncation(number_of_simd, true);
+  state.counters["Truncations"] =
+      benchmark::Counter(state.iterations() * number_of_simd, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_TruncationByConversion)
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -68,7 +68,7 @@ std::vector<Combination> GenerateAllCombinations() {
 
   const std::array kArithmeticBitSizes = {8, 16, 32, 64};
   const std::array kNumbersOfSimd = {1000};
-  const std::array kOperationTypes = {T::kAdd, T::kMul, T::kDiv, T::kEq, T::kGt, T::kSub};
+  const std::array kOperationTypes = {T::kAdd, T::kMul, T::kDiv, T::kEq, T::kGt, T::kSub, T::kB2a};
 
   std::vector<Combination> combinations;
 
@@ -79,6 +79,11 @@ encrypto::motion::RunTimeStatistics EvaluateProtocol(
       a == b;
       break;
     }
+    case encrypto::motion::IntegerOperationType::kB2a: {
+      // BMR shares are converted via Boolean GMW
+      a.Get().Convert<encrypto::motion::MpcProtocol::kArithmeticGmw>();
+      break;
+    }
 
     default:
       throw std::invalid_argument("Unknown operation type");
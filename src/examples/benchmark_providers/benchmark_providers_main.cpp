@@ -32,10 +32,12 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
 
+#include "base/backend.h"
 #include "base/party.h"
 #include "common/benchmark_providers.h"
 #include "communication/communication_layer.h"
 #include "communication/tcp_transport.h"
+#include "oblivious_transfer/ot_provider.h"
 #include "statistics/analysis.h"
 #include "utility/typedefs.h"
 
@@ -106,8 +108,9 @@ int main(int ac, char* av[]) {
       accumulated_communication_statistics.Add(communication_statistics);
     }
     std::cout << encrypto::motion::PrintStatistics(
-        fmt::format("Provider {} bit size {} batch size {}", to_string(combination.provider_),
-                    combination.bit_size_, combination.batch_size_),
+        fmt::format("Provider {} bit size {} batch size {} OT extension {}",
+                    to_string(combination.provider_), combination.bit_size_,
+                    combination.batch_size_, user_options["ot-extension"].as<std::string>()),
         accumulated_statistics, accumulated_communication_statistics);
   }
   return EXIT_SUCCESS;
@@ -149,7 +152,8 @@ std::tuple<program_options::variables_map, bool, bool> ParseProgramOptions(int a
       ("parties", program_options::value<std::vector<std::string>>()->multitoken(), "info (id,IP,port) for each party e.g., --parties 0,127.0.0.1,23000 1,127.0.0.1,23001")
       ("online-after-setup", program_options::value<bool>()->default_value(true), "compute the online phase of the gate evaluations after the setup phase for all of them is completed (true/1 or false/0)")
       ("repetitions", program_options::value<std::size_t>()->default_value(1), "number of repetitions")
-      ("ots,o", program_options::bool_switch(&ots)->default_value(false),"test OTs, otherwise all other providers");
+      ("ots,o", program_options::bool_switch(&ots)->default_value(false),"test OTs, otherwise all other providers")
+      ("ot-extension", program_options::value<std::string>()->default_value("iknp"), "OT extension protocol: iknp or silent");
   // clang-format on
 
   program_options::variables_map user_options;
@@ -232,5 +236,12 @@ encrypto::motion::PartyPointer CreateParty(const program_options::variables_map&
   const auto logging{!user_options.count("disable-logging")};
   configuration->SetLoggingEnabled(logging);
   configuration->SetOnlineAfterSetup(user_options["online-after-setup"].as<bool>());
+  const auto ot_extension{user_options["ot-extension"].as<std::string>()};
+  if (ot_extension == "silent") {
+    party->GetBackend()->GetOtProviderManager().SetOtExtensionProtocol(
+        encrypto::motion::OtExtensionProtocol::kSilent);
+  } else if (ot_extension != "iknp") {
+    throw std::runtime_error(fmt::format("Unknown OT extension protocol {}", ot_extension));
+  }
   return party;
 }
@@ -0,0 +1,122 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <boost/program_options.hpp>
+
+#include "algorithm/algorithm_description.h"
+#include "utility/config.h"
+
+namespace program_options = boost::program_options;
+
+// Converts text circuits into MOTION's binary circuit format, which can be loaded without
+// parsing.  Each converted file is written next to its source with the extension replaced by
+// AlgorithmDescription::kBinaryCircuitExtension.
+
+// Bristol Fashion files have a third header line with the output wires, whereas the third line
+// of a Bristol file is empty
+std::string DetectFormat(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  for (int i = 0; i < 3; ++i) std::getline(file, line);
+  return line.find_first_not_of(" \t\r") == std::string::npos ? "bristol" : "bristol-fashion";
+}
+
+encrypto::motion::AlgorithmDescription ReadCircuit(const std::string& path, std::string format) {
+  using encrypto::motion::AlgorithmDescription;
+  if (format == "auto") {
+    format = DetectFormat(path);
+  }
+  if (format == "bristol") {
+    return AlgorithmDescription::FromBristol(path);
+  } else if (format == "bristol-fashion") {
+    return AlgorithmDescription::FromBristolFashion(path);
+  } else if (format == "aby") {
+    return AlgorithmDescription::FromAby(path);
+  }
+  throw std::invalid_argument(fmt::format(
+      "unknown circuit format {}, only auto, bristol, bristol-fashion or aby are allowed", format));
+}
+
+void ConvertCircuit(const std::filesystem::path& path, const std::string& format) {
+  auto algorithm_description = ReadCircuit(path.string(), format);
+  algorithm_description.ComputeLayers();
+  const auto binary_path = encrypto::motion::AlgorithmDescription::GetBinaryPath(path.string());
+  algorithm_description.ToBinary(binary_path);
+  std::cout << fmt::format("{} -> {} ({} gates, {} layers, depth {})\n", path.string(),
+                           binary_path, algorithm_description.gates.size(),
+                           algorithm_description.layer_offsets.size() - 1,
+                           algorithm_description.depth);
+}
+
+int main(int ac, char* av[]) {
+  bool help;
+  program_options::options_description description("Allowed options");
+  // clang-format off
+  description.add_options()
+      ("help,h", program_options::bool_switch(&help)->default_value(false), "produce help message")
+      ("input", program_options::value<std::vector<std::string>>()->multitoken(), "circuit files or directories which are searched recursively for *.bristol files (default: the circuits directory of MOTION)")
+      ("format", program_options::value<std::string>()->default_value("auto"), "format of the input circuits (auto, bristol, bristol-fashion or aby), auto distinguishes Bristol and Bristol Fashion");
+  // clang-format on
+
+  try {
+    program_options::variables_map user_options;
+    program_options::store(program_options::parse_command_line(ac, av, description),
+                           user_options);
+    program_options::notify(user_options);
+    if (help) {
+      std::cout << description << "\n";
+      return EXIT_SUCCESS;
+    }
+
+    std::vector<std::string> inputs{std::string(encrypto::motion::kRootDir) + "/circuits"};
+    if (user_options.count("input")) {
+      inputs = user_options["input"].as<std::vector<std::string>>();
+    }
+    const auto format{user_options["format"].as<std::string>()};
+
+    for (const auto& input : inputs) {
+      if (std::filesystem::is_directory(input)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(input)) {
+          if (entry.is_regular_file() && entry.path().extension() == ".bristol") {
+            ConvertCircuit(entry.path(), format);
+          }
+        }
+      } else {
+        ConvertCircuit(input, format);
+      }
+    }
+  } catch (std::exception& e) {
+    std::cerr << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -24,9 +24,21 @@
 
 #include "algorithm_description.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <limits>
+#include <numeric>
 #include <regex>
 #include <sstream>
+#include <thread>
 
 #include <fmt/format.h>
 #include <boost/algorithm/string/trim.hpp>
@@ -34,6 +46,90 @@
 
 namespace encrypto::motion {
 
+namespace {
+
+//
+// Binary circuit format (little endian)
+// BinaryCircuitHeader
+// std::uint64_t layer_offsets[number_of_layers + 1]
+// BinaryGate gates[number_of_gates]
+//
+
+constexpr std::uint64_t kBinaryCircuitMagic = 0x4342'4e4f'4954'4f4d;  // "MOTIONBC"
+constexpr std::uint32_t kBinaryCircuitVersion = 1;
+// marks absent optional wires in a BinaryGate
+constexpr std::uint32_t kNoWire = std::numeric_limits<std::uint32_t>::max();
+
+struct BinaryCircuitHeader {
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t has_input_wires_parent_b;
+  std::uint64_t number_of_gates;
+  std::uint64_t number_of_wires;
+  std::uint64_t number_of_input_wires_parent_a;
+  std::uint64_t number_of_input_wires_parent_b;
+  std::uint64_t number_of_output_wires;
+  std::uint64_t depth;
+  std::uint64_t number_of_layers;
+};
+
+struct BinaryGate {
+  std::uint32_t type;
+  std::uint32_t parent_a;
+  std::uint32_t parent_b;
+  std::uint32_t selection_bit;
+  std::uint32_t output_wire;
+};
+
+static_assert(sizeof(BinaryCircuitHeader) == 72);
+static_assert(sizeof(BinaryGate) == 20);
+
+// read-only memory mapping of a whole file
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path) {
+    file_descriptor_ = open(path.c_str(), O_RDONLY);
+    if (file_descriptor_ < 0) {
+      throw std::runtime_error(
+          fmt::format("could not open binary circuit {}: {}", path, std::strerror(errno)));
+    }
+    struct stat file_status;
+    if (fstat(file_descriptor_, &file_status) != 0) {
+      close(file_descriptor_);
+      throw std::runtime_error(
+          fmt::format("could not stat binary circuit {}: {}", path, std::strerror(errno)));
+    }
+    size_ = file_status.st_size;
+    if (size_ > 0) {
+      void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_descriptor_, 0);
+      if (mapping == MAP_FAILED) {
+        close(file_descriptor_);
+        throw std::runtime_error(
+            fmt::format("could not map binary circuit {}: {}", path, std::strerror(errno)));
+      }
+      data_ = static_cast<const std::byte*>(mapping);
+    }
+  }
+
+  ~MappedFile() {
+    if (data_ != nullptr) munmap(const_cast<std::byte*>(data_), size_);
+    close(file_descriptor_);
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const std::byte* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+ private:
+  int file_descriptor_;
+  const std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace
+
 AlgorithmDescription AlgorithmDescription::FromBristol(const std::string& path) {
   std::ifstream file_stream(path);
   return FromBristol(file_stream);
@@ -418,4 +514,206 @@ AlgorithmDescription AlgorithmDescription::FromAby(std::ifstream& stream) {
   return algorithm_description;
 }
 
+AlgorithmDescription AlgorithmDescription::FromBinary(const std::string& path) {
+  const MappedFile file(path);
+  BinaryCircuitHeader header;
+  if (file.size() < sizeof(header)) {
+    throw std::runtime_error(fmt::format("binary circuit {} is truncated", path));
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (header.magic != kBinaryCircuitMagic) {
+    throw std::runtime_error(fmt::format("{} is not a binary circuit", path));
+  }
+  if (header.version != kBinaryCircuitVersion) {
+    throw std::runtime_error(
+        fmt::format("binary circuit {} has version {}, but version {} is required", path,
+                    header.version, kBinaryCircuitVersion));
+  }
+  // bound the counts by the file size first, s.t. computing the expected size cannot overflow
+  if (header.number_of_layers >= file.size() || header.number_of_gates >= file.size()) {
+    throw std::runtime_error(fmt::format("binary circuit {} is corrupt", path));
+  }
+  const std::size_t layer_offsets_size = (header.number_of_layers + 1) * sizeof(std::uint64_t);
+  const std::size_t gates_size = header.number_of_gates * sizeof(BinaryGate);
+  if (file.size() != sizeof(header) + layer_offsets_size + gates_size) {
+    throw std::runtime_error(fmt::format("binary circuit {} is corrupt", path));
+  }
+  if (header.number_of_wires >= kNoWire ||
+      header.number_of_input_wires_parent_a > header.number_of_wires ||
+      header.number_of_input_wires_parent_b >
+          header.number_of_wires - header.number_of_input_wires_parent_a ||
+      header.number_of_output_wires > header.number_of_wires) {
+    throw std::runtime_error(fmt::format("binary circuit {} has invalid wire counts", path));
+  }
+
+  AlgorithmDescription algorithm_description;
+  algorithm_description.number_of_gates = header.number_of_gates;
+  algorithm_description.number_of_wires = header.number_of_wires;
+  algorithm_description.number_of_input_wires_parent_a = header.number_of_input_wires_parent_a;
+  if (header.has_input_wires_parent_b) {
+    algorithm_description.number_of_input_wires_parent_b = header.number_of_input_wires_parent_b;
+  }
+  algorithm_description.number_of_output_wires = header.number_of_output_wires;
+  algorithm_description.depth = header.depth;
+
+  const auto layer_offsets_pointer = file.data() + sizeof(header);
+  algorithm_description.layer_offsets.resize(header.number_of_layers + 1);
+  for (std::size_t i = 0; i <= header.number_of_layers; ++i) {
+    std::uint64_t offset;
+    std::memcpy(&offset, layer_offsets_pointer + i * sizeof(offset), sizeof(offset));
+    // the layers partition the gates in order
+    const auto previous_offset = i == 0 ? 0 : algorithm_description.layer_offsets[i - 1];
+    if (offset < previous_offset || offset > header.number_of_gates ||
+        (i == 0 && offset != 0) ||
+        (i == header.number_of_layers && offset != header.number_of_gates)) {
+      throw std::runtime_error(fmt::format("binary circuit {} has invalid layer offsets", path));
+    }
+    algorithm_description.layer_offsets[i] = offset;
+  }
+
+  const auto gates_pointer = layer_offsets_pointer + layer_offsets_size;
+  algorithm_description.gates.resize(header.number_of_gates);
+  for (std::size_t i = 0; i < header.number_of_gates; ++i) {
+    BinaryGate binary_gate;
+    std::memcpy(&binary_gate, gates_pointer + i * sizeof(BinaryGate), sizeof(BinaryGate));
+    if (binary_gate.type >= static_cast<std::uint32_t>(PrimitiveOperationType::kInvalid)) {
+      throw std::runtime_error(fmt::format("binary circuit {} is corrupt", path));
+    }
+    const auto is_valid_wire = [&header](std::uint32_t wire, bool is_optional) {
+      return wire < header.number_of_wires || (is_optional && wire == kNoWire);
+    };
+    if (!is_valid_wire(binary_gate.parent_a, false) || !is_valid_wire(binary_gate.parent_b, true) ||
+        !is_valid_wire(binary_gate.selection_bit, true) ||
+        !is_valid_wire(binary_gate.output_wire, false)) {
+      throw std::runtime_error(
+          fmt::format("binary circuit {} has a gate with an invalid wire index", path));
+    }
+    auto& gate = algorithm_description.gates[i];
+    gate.type = static_cast<PrimitiveOperationType>(binary_gate.type);
+    gate.parent_a = binary_gate.parent_a;
+    if (binary_gate.parent_b != kNoWire) gate.parent_b = binary_gate.parent_b;
+    if (binary_gate.selection_bit != kNoWire) gate.selection_bit = binary_gate.selection_bit;
+    gate.output_wire = binary_gate.output_wire;
+  }
+  return algorithm_description;
+}
+
+void AlgorithmDescription::ToBinary(const std::string& path) const {
+  if (layer_offsets.empty()) {
+    AlgorithmDescription layered_algorithm_description(*this);
+    layered_algorithm_description.ComputeLayers();
+    layered_algorithm_description.ToBinary(path);
+    return;
+  }
+  if (number_of_wires >= kNoWire) {
+    throw std::invalid_argument(
+        fmt::format("binary circuits support less than {} wires, but the circuit has {}", kNoWire,
+                    number_of_wires));
+  }
+
+  BinaryCircuitHeader header;
+  header.magic = kBinaryCircuitMagic;
+  header.version = kBinaryCircuitVersion;
+  header.has_input_wires_parent_b = number_of_input_wires_parent_b.has_value();
+  header.number_of_gates = gates.size();
+  header.number_of_wires = number_of_wires;
+  header.number_of_input_wires_parent_a = number_of_input_wires_parent_a;
+  header.number_of_input_wires_parent_b = number_of_input_wires_parent_b.value_or(0);
+  header.number_of_output_wires = number_of_output_wires;
+  header.depth = depth;
+  header.number_of_layers = layer_offsets.size() - 1;
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error(fmt::format("could not create binary circuit {}", path));
+  }
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const std::uint64_t offset : layer_offsets) {
+    file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+  }
+  std::vector<BinaryGate> binary_gates(gates.size());
+  std::transform(gates.begin(), gates.end(), binary_gates.begin(), [](const auto& gate) {
+    return BinaryGate{static_cast<std::uint32_t>(gate.type),
+                      static_cast<std::uint32_t>(gate.parent_a),
+                      static_cast<std::uint32_t>(gate.parent_b.value_or(kNoWire)),
+                      static_cast<std::uint32_t>(gate.selection_bit.value_or(kNoWire)),
+                      static_cast<std::uint32_t>(gate.output_wire)};
+  });
+  file.write(reinterpret_cast<const char*>(binary_gates.data()),
+             binary_gates.size() * sizeof(BinaryGate));
+  if (!file) {
+    throw std::runtime_error(fmt::format("could not write binary circuit {}", path));
+  }
+}
+
+std::string AlgorithmDescription::GetBinaryPath(const std::string& path) {
+  return std::filesystem::path(path).replace_extension(kBinaryCircuitExtension).string();
+}
+
+AlgorithmDescription AlgorithmDescription::FromBristolOrBinary(const std::string& path) {
+  const auto binary_path = GetBinaryPath(path);
+  std::error_code error;
+  const auto binary_time = std::filesystem::last_write_time(binary_path, error);
+  if (error) {
+    return FromBristol(path);
+  }
+  // a binary circuit without its source is used as is, a stale one is regenerated
+  const auto bristol_time = std::filesystem::last_write_time(path, error);
+  if (error || bristol_time <= binary_time) {
+    return FromBinary(binary_path);
+  }
+  auto algorithm_description = FromBristol(path);
+  algorithm_description.ComputeLayers();
+  // write to a file unique to this thread and rename it, s.t. parties in other threads or processes
+  // loading the same circuit never map a partially written binary circuit
+  const auto temporary_path = fmt::format("{}.{}.{}", binary_path, getpid(),
+                                          std::hash<std::thread::id>{}(std::this_thread::get_id()));
+  try {
+    algorithm_description.ToBinary(temporary_path);
+    std::filesystem::rename(temporary_path, binary_path);
+  } catch (const std::exception&) {
+    // the stale binary circuit is not used either way, failing to replace it only costs the
+    // parsing of the Bristol circuit the next time
+    std::filesystem::remove(temporary_path, error);
+  }
+  return algorithm_description;
+}
+
+void AlgorithmDescription::ComputeLayers() {
+  // a wire's depth is the number of non-linear gates on the longest path from an input to it
+  std::vector<std::size_t> wire_depths(number_of_wires, 0);
+  // the layer of a gate is the depth of its deepest input wire
+  std::vector<std::size_t> gate_layers(gates.size());
+  std::size_t number_of_layers = 0;
+  depth = 0;
+  for (std::size_t i = 0; i < gates.size(); ++i) {
+    const auto& gate = gates[i];
+    std::size_t layer = wire_depths.at(gate.parent_a);
+    if (gate.parent_b) layer = std::max(layer, wire_depths.at(*gate.parent_b));
+    if (gate.selection_bit) layer = std::max(layer, wire_depths.at(*gate.selection_bit));
+    gate_layers[i] = layer;
+    wire_depths.at(gate.output_wire) = IsLinearOperation(gate.type) ? layer : layer + 1;
+    depth = std::max(depth, wire_depths[gate.output_wire]);
+    number_of_layers = std::max(number_of_layers, layer + 1);
+  }
+
+  // the stable sort keeps the topological order within each class of gates of a layer
+  std::vector<std::size_t> order(gates.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this, &gate_layers](auto a, auto b) {
+    return std::make_pair(gate_layers[a], !IsLinearOperation(gates[a].type)) <
+           std::make_pair(gate_layers[b], !IsLinearOperation(gates[b].type));
+  });
+
+  std::vector<PrimitiveOperation> sorted_gates;
+  sorted_gates.reserve(gates.size());
+  layer_offsets.assign(number_of_layers + 1, 0);
+  for (const auto i : order) {
+    sorted_gates.emplace_back(gates[i]);
+    ++layer_offsets[gate_layers[i] + 1];
+  }
+  std::partial_sum(layer_offsets.begin(), layer_offsets.end(), layer_offsets.begin());
+  gates = std::move(sorted_gates);
+}
+
 }  // namespace encrypto::motion
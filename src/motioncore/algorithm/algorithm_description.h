@@ -26,6 +26,8 @@
 
 #include <cassert>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "utility/typedefs.h"
@@ -40,6 +42,12 @@ struct PrimitiveOperation {
   std::size_t output_wire{0};
 };
 
+// linear operations can be evaluated locally on secret shares
+inline bool IsLinearOperation(PrimitiveOperationType type) {
+  return type == PrimitiveOperationType::kXor || type == PrimitiveOperationType::kInv ||
+         type == PrimitiveOperationType::kAdd;
+}
+
 struct AlgorithmDescription {
   AlgorithmDescription() = default;
 
@@ -61,10 +69,41 @@ struct AlgorithmDescription {
 
   static AlgorithmDescription FromAby(std::ifstream& stream);
 
+  // Reads a circuit in MOTION's binary circuit format as written by ToBinary.  The file is
+  // memory-mapped and its fixed-width gate records are converted without any text parsing.  Throws
+  // std::runtime_error if the wire counts, wire indices or layer offsets are out of range.
+  static AlgorithmDescription FromBinary(const std::string& path);
+
+  // Writes the circuit including its layering in MOTION's binary circuit format.  The layering is
+  // computed first if it was not computed yet.
+  void ToBinary(const std::string& path) const;
+
+  // Returns path with its extension replaced by kBinaryCircuitExtension
+  static std::string GetBinaryPath(const std::string& path);
+
+  // Loads the binary circuit at GetBinaryPath(path) if it exists and the Bristol circuit at path
+  // otherwise.  If the Bristol circuit is newer than the binary circuit, the Bristol circuit is
+  // loaded and the binary circuit is regenerated from it.
+  static AlgorithmDescription FromBristolOrBinary(const std::string& path);
+
+  // Sorts the gates stably into layers of equal multiplicative depth and sets depth and
+  // layer_offsets.  Within a layer, all linear gates (XOR, INV, ADD) precede the non-linear gates,
+  // which only depend on wires computed in the same or a previous layer.  Hence, the non-linear
+  // gates of a layer can be evaluated in parallel.
+  void ComputeLayers();
+
+  static constexpr std::string_view kBinaryCircuitExtension{".bin"};
+
   std::size_t number_of_output_wires{0}, number_of_input_wires_parent_a{0}, number_of_wires{0},
       number_of_gates{0};
   std::optional<std::size_t> number_of_input_wires_parent_b{std::nullopt};
   std::vector<PrimitiveOperation> gates;
+
+  // multiplicative depth of the circuit, only set by ComputeLayers and FromBinary
+  std::size_t depth{0};
+  // index of the first gate of each layer followed by gates.size(), empty if the layering was not
+  // computed
+  std::vector<std::size_t> layer_offsets;
 };
 
 }  // namespace encrypto::motion
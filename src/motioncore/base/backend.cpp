@@ -27,6 +27,7 @@
 #include "backend.h"
 #include "motion_base_provider.h"
 
+#include <algorithm>
 #include <boost/log/trivial.hpp>
 #include <chrono>
 #include <functional>
@@ -42,8 +43,10 @@
 #include "data_storage/base_ot_data.h"
 #include "executor/gate_executor.h"
 #include "multiplication_triple/mt_provider.h"
+#include "multiplication_triple/preprocessing_store.h"
 #include "multiplication_triple/sb_provider.h"
 #include "multiplication_triple/sp_provider.h"
+#include "oblivious_transfer/base_ots/base_ot_cache.h"
 #include "oblivious_transfer/base_ots/base_ot_provider.h"
 #include "oblivious_transfer/ot_provider.h"
 #include "protocols/arithmetic_gmw/arithmetic_gmw_share.h"
@@ -54,6 +57,8 @@
 #include "protocols/boolean_gmw/boolean_gmw_share.h"
 #include "register.h"
 #include "statistics/run_time_statistics.h"
+#include "statistics/trace.h"
+#include "utility/thread.h"
 #include "utility/constants.h"
 
 using namespace std::chrono_literals;
@@ -65,14 +70,16 @@ Backend::Backend(communication::CommunicationLayer& communication_layer,
     : run_time_statistics_(1),
       communication_layer_(communication_layer),
       logger_(logger),
+      tracer_(std::make_shared<Tracer>(communication_layer.GetMyId())),
       configuration_(configuration),
       register_(std::make_shared<Register>(logger_)),
       gate_executor_(std::make_unique<GateExecutor>(
-          *register_, [this] { RunPreprocessing(); }, logger_)) {
+          *register_, [this] { RunPreprocessing(); }, logger_, tracer_)) {
   motion_base_provider_ = std::make_unique<BaseProvider>(communication_layer_, logger_);
   base_ot_provider_ = std::make_unique<BaseOtProvider>(communication_layer, logger_);
 
   communication_layer_.SetLogger(logger_);
+  communication_layer_.SetTracer(tracer_);
   auto my_id = communication_layer_.GetMyId();
 
   ot_provider_manager_ = std::make_unique<OtProviderManager>(
@@ -117,6 +124,8 @@ void Backend::RunPreprocessing() {
   logger_->LogInfo("Start preprocessing");
   run_time_statistics_.back().RecordStart<RunTimeStatistics::StatisticsId::kPreprocessing>();
 
+  LoadBaseOtCache();
+
   // TODO: should this be measured?
   motion_base_provider_->Setup();
 
@@ -137,6 +146,17 @@ void Backend::RunPreprocessing() {
     sp_provider_->PreSetup();
   }
 
+  // BMR AND gates need OTs, which are batched per layer if the circuit is evaluated layer by layer,
+  // and otherwise such that each batch fits into the bounded number of live fibers
+  if (bmr_provider_->NeedOts()) {
+    if (configuration_->GetLayeredEvaluation()) {
+      bmr_provider_->PreSetup(*ot_provider_manager_, &register_->GetGateLayers());
+    } else {
+      bmr_provider_->PreSetup(*ot_provider_manager_, nullptr,
+                              configuration_->GetMaximumNumberOfFibers());
+    }
+  }
+
   if (NeedOts()) {
     OtExtensionSetup();
   }
@@ -150,11 +170,75 @@ void Backend::RunPreprocessing() {
   run_time_statistics_.back().RecordEnd<RunTimeStatistics::StatisticsId::kPreprocessing>();
 }
 
+void Backend::PrecomputePreprocessing(const PreprocessingDemand& demand,
+                                      const std::string& path) {
+  mt_provider_->RequestBinaryMts(demand.number_of_binary_mts);
+  mt_provider_->RequestArithmeticMts<std::uint8_t>(demand.number_of_mts_8);
+  mt_provider_->RequestArithmeticMts<std::uint16_t>(demand.number_of_mts_16);
+  mt_provider_->RequestArithmeticMts<std::uint32_t>(demand.number_of_mts_32);
+  mt_provider_->RequestArithmeticMts<std::uint64_t>(demand.number_of_mts_64);
+  sp_provider_->RequestSps<std::uint8_t>(demand.number_of_sps_8);
+  sp_provider_->RequestSps<std::uint16_t>(demand.number_of_sps_16);
+  sp_provider_->RequestSps<std::uint32_t>(demand.number_of_sps_32);
+  sp_provider_->RequestSps<std::uint64_t>(demand.number_of_sps_64);
+  sb_provider_->RequestSbs<std::uint8_t>(demand.number_of_sbs_8);
+  sb_provider_->RequestSbs<std::uint16_t>(demand.number_of_sbs_16);
+  sb_provider_->RequestSbs<std::uint32_t>(demand.number_of_sbs_32);
+  sb_provider_->RequestSbs<std::uint64_t>(demand.number_of_sbs_64);
+
+  Synchronize();
+  RunPreprocessing();
+  PreprocessingStore::Write(path, communication_layer_.GetMyId(),
+                            communication_layer_.GetNumberOfParties(), demand, *mt_provider_,
+                            *sp_provider_, *sb_provider_);
+  logger_->LogInfo(fmt::format("Wrote preprocessing store {}", path));
+}
+
+void Backend::LoadPreprocessing(const std::string& path) {
+  if (register_->GetTotalNumberOfGates() > 0) {
+    throw std::logic_error("the preprocessing store has to be loaded before creating any gates");
+  }
+  const auto my_id = communication_layer_.GetMyId();
+  const auto number_of_parties = communication_layer_.GetNumberOfParties();
+  auto store = std::make_shared<PreprocessingStore>(path, my_id, number_of_parties);
+  mt_provider_ = std::make_shared<MtProviderFromStore>(store, my_id, number_of_parties, *logger_,
+                                                       run_time_statistics_.back());
+  sp_provider_ =
+      std::make_shared<SpProviderFromStore>(store, my_id, *logger_, run_time_statistics_.back());
+  sb_provider_ =
+      std::make_shared<SbProviderFromStore>(store, my_id, *logger_, run_time_statistics_.back());
+  logger_->LogInfo(fmt::format("Loaded preprocessing store {}", path));
+}
+
+void Backend::ApplyExecutorConfiguration() {
+  const auto number_of_threads = configuration_->GetNumOfThreads();
+  gate_executor_->SetThreads(number_of_threads, configuration_->GetPinThreads());
+  gate_executor_->SetFibers(configuration_->GetMaximumNumberOfFibers(),
+                            configuration_->GetFiberStackSize());
+  register_->SetStreamingEvaluation(configuration_->GetStreamingEvaluation());
+  if (configuration_->GetPinThreads()) {
+    // the gate executor's workers take the first cpus, the communication threads the next ones
+    auto cpus = GetAvailableCpus();
+    std::rotate(cpus.begin(), cpus.begin() + number_of_threads % cpus.size(), cpus.end());
+    communication_layer_.SetThreadAffinity(cpus);
+  }
+}
+
 void Backend::EvaluateSequential() {
+  ApplyExecutorConfiguration();
   gate_executor_->EvaluateSetupOnline(run_time_statistics_.back());
 }
 
-void Backend::EvaluateParallel() { gate_executor_->Evaluate(run_time_statistics_.back()); }
+void Backend::EvaluateParallel() {
+  ApplyExecutorConfiguration();
+  gate_executor_->Evaluate(run_time_statistics_.back());
+}
+
+void Backend::EvaluateLayered() {
+  ApplyExecutorConfiguration();
+  gate_executor_->EvaluateLayered(run_time_statistics_.back(),
+                                  configuration_->GetOnlineAfterSetup());
+}
 
 const GatePointer& Backend::GetGate(std::size_t gate_id) const {
   return register_->GetGate(gate_id);
@@ -162,7 +246,13 @@ const GatePointer& Backend::GetGate(std::size_t gate_id) const {
 
 void Backend::Reset() { register_->Reset(); }
 
-void Backend::Clear() { register_->Clear(); }
+void Backend::Clear() {
+  register_->Clear();
+  mt_provider_->Clear();
+  sp_provider_->Clear();
+  sb_provider_->Clear();
+  bmr_provider_->Clear();
+}
 
 SharePointer Backend::BooleanGmwInput(std::size_t party_id, bool input) {
   return BooleanGmwInput(party_id, BitVector(1, input));
@@ -188,6 +278,14 @@ SharePointer Backend::BooleanGmwInput(std::size_t party_id, std::vector<BitVecto
   return std::static_pointer_cast<Share>(input_gate->GetOutputAsGmwShare());
 }
 
+std::vector<SharePointer> Backend::BooleanGmwInputTable(
+    std::size_t party_id, std::vector<std::vector<BitVector<>>>&& columns) {
+  const auto input_gate = register_->EmplaceGate<proto::boolean_gmw::InputTableGate>(
+      std::move(columns), party_id, *this);
+  auto column_shares = input_gate->GetOutputAsGmwShares();
+  return std::vector<SharePointer>(column_shares.begin(), column_shares.end());
+}
+
 SharePointer Backend::BooleanGmwXor(const proto::boolean_gmw::SharePointer& a,
                                     const proto::boolean_gmw::SharePointer& b) {
   assert(a);
@@ -336,6 +434,26 @@ template SharePointer Backend::ArithmeticGmwInput<std::uint64_t>(
 template SharePointer Backend::ArithmeticGmwInput<__uint128_t>(std::size_t party_id,
                                                                std::vector<__uint128_t>&& input);
 
+template <typename T>
+std::vector<SharePointer> Backend::ArithmeticGmwInputTable(std::size_t party_id,
+                                                           std::vector<std::vector<T>>&& columns) {
+  auto input_gate = register_->EmplaceGate<proto::arithmetic_gmw::InputTableGate<T>>(
+      std::move(columns), party_id, *this);
+  auto column_shares = input_gate->GetOutputAsArithmeticShares();
+  return std::vector<SharePointer>(column_shares.begin(), column_shares.end());
+}
+
+template std::vector<SharePointer> Backend::ArithmeticGmwInputTable<std::uint8_t>(
+    std::size_t party_id, std::vector<std::vector<std::uint8_t>>&& columns);
+template std::vector<SharePointer> Backend::ArithmeticGmwInputTable<std::uint16_t>(
+    std::size_t party_id, std::vector<std::vector<std::uint16_t>>&& columns);
+template std::vector<SharePointer> Backend::ArithmeticGmwInputTable<std::uint32_t>(
+    std::size_t party_id, std::vector<std::vector<std::uint32_t>>&& columns);
+template std::vector<SharePointer> Backend::ArithmeticGmwInputTable<std::uint64_t>(
+    std::size_t party_id, std::vector<std::vector<std::uint64_t>>&& columns);
+template std::vector<SharePointer> Backend::ArithmeticGmwInputTable<__uint128_t>(
+    std::size_t party_id, std::vector<std::vector<__uint128_t>>&& columns);
+
 template <typename T>
 SharePointer Backend::ArithmeticGmwOutput(const proto::arithmetic_gmw::SharePointer<T>& parent,
                                           std::size_t output_owner) {
@@ -478,12 +596,24 @@ void Backend::Synchronize() { communication_layer_.Synchronize(); }
 
 void Backend::ComputeBaseOts() {
   run_time_statistics_.back().RecordStart<RunTimeStatistics::StatisticsId::kBaseOts>();
-  base_ot_provider_->ComputeBaseOts();
+  base_ot_provider_->ComputeBaseOts(configuration_->GetNumOfThreads(),
+                                    configuration_->GetPinThreads());
   run_time_statistics_.back().RecordEnd<RunTimeStatistics::StatisticsId::kBaseOts>();
 
   base_ots_finished_ = true;
 }
 
+void Backend::LoadBaseOtCache() {
+  const auto& directory = configuration_->GetBaseOtCacheDirectory();
+  if (directory.empty() || base_ot_cache_ || base_ots_finished_) {
+    return;
+  }
+  base_ot_cache_ = std::make_unique<BaseOtCache>(directory, communication_layer_.GetMyId(),
+                                                 communication_layer_.GetNumberOfParties());
+  base_ot_cache_->Load();
+  motion_base_provider_->SetBaseOtCacheIds(base_ot_cache_->GetCacheIds());
+}
+
 void Backend::ImportBaseOts(std::size_t i, const ReceiverMessage& messages) {
   base_ot_provider_->ImportBaseOts(i, messages);
 }
@@ -504,8 +634,31 @@ void Backend::OtExtensionSetup() {
     return;
   }
 
+  run_time_statistics_.back().RecordStart<RunTimeStatistics::StatisticsId::kStartup>();
+
   if (!base_ots_finished_) {
+    // the parties whose base OTs are neither imported nor resumed from the cache
+    std::vector<std::size_t> computed_party_ids;
+    if (base_ot_cache_) {
+      // the HelloMessages tell which cached base OTs the other parties can resume
+      motion_base_provider_->Setup();
+      for (auto i = 0ull; i < communication_layer_.GetNumberOfParties(); ++i) {
+        auto& base_ot_data = base_ot_provider_->GetBaseOtsData(i);
+        if (i == communication_layer_.GetMyId() || base_ot_data.GetReceiverData().is_ready ||
+            base_ot_data.GetSenderData().is_ready) {
+          continue;
+        }
+        if (base_ot_cache_->Resume(i, *motion_base_provider_, *base_ot_provider_)) {
+          logger_->LogInfo(fmt::format("Resumed cached base OTs with party {}", i));
+        } else {
+          computed_party_ids.push_back(i);
+        }
+      }
+    }
     ComputeBaseOts();
+    for (auto i : computed_party_ids) {
+      base_ot_cache_->Store(i, *motion_base_provider_, *base_ot_provider_);
+    }
   }
 
   motion_base_provider_->Setup();
@@ -533,6 +686,7 @@ void Backend::OtExtensionSetup() {
   ot_extension_finished_ = true;
 
   run_time_statistics_.back().RecordEnd<RunTimeStatistics::StatisticsId::kOtExtensionSetup>();
+  run_time_statistics_.back().RecordEnd<RunTimeStatistics::StatisticsId::kStartup>();
 
   if constexpr (kDebug) {
     logger_->LogDebug("Finished setup for OTExtensions");
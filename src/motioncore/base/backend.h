@@ -28,6 +28,7 @@
 
 #include <flatbuffers/flatbuffers.h>
 #include <span>
+#include <string>
 
 #include "protocols/arithmetic_gmw/arithmetic_gmw_gate.h"
 #include "protocols/constant/constant_gate.h"
@@ -57,6 +58,7 @@ namespace encrypto::motion {
 
 class OtProvider;
 class OtProviderManager;
+class BaseOtCache;
 class BaseOtProvider;
 class BaseProvider;
 
@@ -68,8 +70,10 @@ using InputGatePointer = std::shared_ptr<InputGate>;
 class MtProvider;
 class SpProvider;
 class SbProvider;
+struct PreprocessingDemand;
 
 struct RunTimeStatistics;
+class Tracer;
 
 struct SenderMessage;
 struct ReceiverMessage;
@@ -108,10 +112,20 @@ class Backend : public std::enable_shared_from_this<Backend> {
 
   void RunPreprocessing();
 
+  // Run the MT/SP/SB providers for the given demand and write the results to a preprocessing
+  // store at path.  The providers cannot be used for gates anymore afterwards.
+  void PrecomputePreprocessing(const PreprocessingDemand& demand, const std::string& path);
+
+  // Replace the MT/SP/SB providers by ones reading from the preprocessing store at path.
+  // Throws if gates were already registered.
+  void LoadPreprocessing(const std::string& path);
+
   void EvaluateSequential();
 
   void EvaluateParallel();
 
+  void EvaluateLayered();
+
   const GatePointer& GetGate(std::size_t gate_id) const;
 
   const std::vector<GatePointer>& GetInputGates() const;
@@ -130,6 +144,11 @@ class Backend : public std::enable_shared_from_this<Backend> {
 
   SharePointer BooleanGmwInput(std::size_t party_id, std::vector<BitVector<>>&& input);
 
+  /// \brief Shares a table of columns in a single gate, see proto::boolean_gmw::InputTableGate
+  /// \return one share per column
+  std::vector<SharePointer> BooleanGmwInputTable(std::size_t party_id,
+                                                 std::vector<std::vector<BitVector<>>>&& columns);
+
   SharePointer BooleanGmwXor(const proto::boolean_gmw::SharePointer& a,
                              const proto::boolean_gmw::SharePointer& b);
 
@@ -189,6 +208,12 @@ class Backend : public std::enable_shared_from_this<Backend> {
   template <typename T>
   SharePointer ArithmeticGmwInput(std::size_t party_id, std::vector<T>&& input_vector);
 
+  /// \brief Shares a table of columns in a single gate, see proto::arithmetic_gmw::InputTableGate
+  /// \return one share per column
+  template <typename T>
+  std::vector<SharePointer> ArithmeticGmwInputTable(std::size_t party_id,
+                                                    std::vector<std::vector<T>>&& columns);
+
   template <typename T>
   SharePointer ArithmeticGmwOutput(const proto::arithmetic_gmw::SharePointer<T>& parent,
                                    std::size_t output_owner);
@@ -233,6 +258,8 @@ class Backend : public std::enable_shared_from_this<Backend> {
 
   OtProvider& GetOtProvider(std::size_t party_id);
 
+  OtProviderManager& GetOtProviderManager() { return *ot_provider_manager_; };
+
   auto& GetMtProvider() { return mt_provider_; };
 
   auto& GetSpProvider() { return sp_provider_; };
@@ -243,17 +270,29 @@ class Backend : public std::enable_shared_from_this<Backend> {
 
   auto& GetMutableRunTimeStatistics() { return run_time_statistics_; }
 
+  Tracer& GetTracer() { return *tracer_; }
+
  private:
+  // pass the configured threads, fibers and streaming evaluation to the gate executor, register
+  // and communication layer
+  void ApplyExecutorConfiguration();
+
+  // load the base OT cache if one is configured, has to happen before the BaseProvider's setup,
+  // which announces the cached base OTs to the other parties
+  void LoadBaseOtCache();
+
   std::list<RunTimeStatistics> run_time_statistics_;
 
   communication::CommunicationLayer& communication_layer_;
   std::shared_ptr<Logger> logger_;
+  std::shared_ptr<Tracer> tracer_;
   ConfigurationPointer configuration_;
   RegisterPointer register_;
   std::unique_ptr<GateExecutor> gate_executor_;
 
   std::unique_ptr<BaseProvider> motion_base_provider_;
   std::unique_ptr<BaseOtProvider> base_ot_provider_;
+  std::unique_ptr<BaseOtCache> base_ot_cache_;
   std::unique_ptr<OtProviderManager> ot_provider_manager_;
   std::shared_ptr<MtProvider> mt_provider_;
   std::shared_ptr<SpProvider> sp_provider_;
@@ -0,0 +1,128 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "compiled_circuit.h"
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "base/backend.h"
+#include "base/party.h"
+#include "base/register.h"
+#include "communication/communication_layer.h"
+#include "multiplication_triple/preprocessing_store.h"
+#include "oblivious_transfer/ot_provider.h"
+#include "protocols/arithmetic_gmw/arithmetic_gmw_gate.h"
+#include "protocols/boolean_gmw/boolean_gmw_gate.h"
+
+namespace encrypto::motion {
+
+namespace {
+
+template <typename InputGateType>
+InputGateType& GetInputGate(const std::vector<GatePointer>& input_gates, std::size_t input_id) {
+  if (input_id >= input_gates.size()) {
+    throw std::out_of_range(
+        fmt::format("input #{} does not exist, there are {} inputs", input_id, input_gates.size()));
+  }
+  auto input_gate = std::dynamic_pointer_cast<InputGateType>(input_gates[input_id]);
+  if (!input_gate) {
+    throw std::invalid_argument(
+        fmt::format("input #{} is of a different protocol or type", input_id));
+  }
+  return *input_gate;
+}
+
+}  // namespace
+
+ShareWrapper CompiledCircuit::In(std::vector<BitVector<>> input, std::size_t input_owner) {
+  auto& backend = *party_.GetBackend();
+  auto input_gate = backend.GetRegister()->EmplaceGate<proto::boolean_gmw::InputGate>(
+      std::move(input), input_owner, backend);
+  input_gates_.push_back(input_gate);
+  return ShareWrapper(std::static_pointer_cast<Share>(input_gate->GetOutputAsGmwShare()));
+}
+
+template <typename T>
+ShareWrapper CompiledCircuit::In(std::vector<T> input, std::size_t input_owner) {
+  auto& backend = *party_.GetBackend();
+  auto input_gate = backend.GetRegister()->EmplaceGate<proto::arithmetic_gmw::InputGate<T>>(
+      std::move(input), input_owner, backend);
+  input_gates_.push_back(input_gate);
+  return ShareWrapper(std::static_pointer_cast<Share>(input_gate->GetOutputAsArithmeticShare()));
+}
+
+template ShareWrapper CompiledCircuit::In(std::vector<std::uint8_t> input,
+                                          std::size_t input_owner);
+template ShareWrapper CompiledCircuit::In(std::vector<std::uint16_t> input,
+                                          std::size_t input_owner);
+template ShareWrapper CompiledCircuit::In(std::vector<std::uint32_t> input,
+                                          std::size_t input_owner);
+template ShareWrapper CompiledCircuit::In(std::vector<std::uint64_t> input,
+                                          std::size_t input_owner);
+
+void CompiledCircuit::SetInput(std::size_t input_id, std::vector<BitVector<>> input) {
+  GetInputGate<proto::boolean_gmw::InputGate>(input_gates_, input_id).SetInput(std::move(input));
+}
+
+template <typename T>
+void CompiledCircuit::SetInput(std::size_t input_id, std::vector<T> input) {
+  GetInputGate<proto::arithmetic_gmw::InputGate<T>>(input_gates_, input_id)
+      .SetInput(std::move(input));
+}
+
+template void CompiledCircuit::SetInput(std::size_t input_id, std::vector<std::uint8_t> input);
+template void CompiledCircuit::SetInput(std::size_t input_id, std::vector<std::uint16_t> input);
+template void CompiledCircuit::SetInput(std::size_t input_id, std::vector<std::uint32_t> input);
+template void CompiledCircuit::SetInput(std::size_t input_id, std::vector<std::uint64_t> input);
+
+void CompiledCircuit::Evaluate() {
+  if (number_of_evaluations_ > 0) {
+    auto& backend = *party_.GetBackend();
+    const bool needs_fresh_randomness =
+        backend.GetMtProvider()->NeedMts() || backend.GetSpProvider()->NeedSps() ||
+        backend.GetSbProvider()->NeedSbs();
+    const bool uses_store =
+        std::dynamic_pointer_cast<MtProviderFromStore>(backend.GetMtProvider()) != nullptr;
+    if (needs_fresh_randomness && !uses_store) {
+      throw std::logic_error(
+          "repeatedly evaluating a circuit which needs MTs, SPs, or SBs requires a preprocessing "
+          "store");
+    }
+    auto& communication_layer = backend.GetCommunicationLayer();
+    for (auto party_id = 0ull; party_id < communication_layer.GetNumberOfParties(); ++party_id) {
+      if (party_id == communication_layer.GetMyId()) continue;
+      auto& ot_provider = backend.GetOtProvider(party_id);
+      if (ot_provider.GetNumOtsSender() > 0 || ot_provider.GetNumOtsReceiver() > 0) {
+        throw std::logic_error("repeatedly evaluating a circuit which uses OTs is not supported");
+      }
+    }
+    party_.Clear();
+  }
+  party_.Run();
+  ++number_of_evaluations_;
+}
+
+}  // namespace encrypto::motion
@@ -0,0 +1,83 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "protocols/share_wrapper.h"
+#include "utility/bit_vector.h"
+
+namespace encrypto::motion {
+
+class Gate;
+using GatePointer = std::shared_ptr<Gate>;
+class Party;
+
+// A circuit which is built once and then evaluated repeatedly with new inputs.
+//
+// The inputs are created via CompiledCircuit::In instead of Party::In, s.t. they can be replaced
+// between two evaluations, and are numbered in the order of their creation.  The rest of the
+// circuit is built on the returned shares as usual.  A repeated evaluation reuses all gates, wires,
+// and their ids, and only draws fresh correlated randomness: the input gates use new sharing ids,
+// and MTs, SPs, and SBs are consumed from the party's preprocessing store (see
+// Party::LoadPreprocessing).  All parties have to create the same inputs and evaluate the circuit
+// the same number of times.
+class CompiledCircuit {
+ public:
+  explicit CompiledCircuit(Party& party) : party_(party) {}
+
+  // Boolean GMW input of input_owner, the other parties pass inputs of the same dimensions
+  ShareWrapper In(std::vector<BitVector<>> input, std::size_t input_owner);
+
+  // arithmetic GMW input of input_owner, the other parties pass inputs of the same size
+  template <typename T>
+  ShareWrapper In(std::vector<T> input, std::size_t input_owner);
+
+  // Replaces the Boolean GMW input #input_id for the following evaluations.  Only the input owner
+  // needs to call this, the input must have the dimensions of the initial one.
+  void SetInput(std::size_t input_id, std::vector<BitVector<>> input);
+
+  // Replaces the arithmetic GMW input #input_id for the following evaluations
+  template <typename T>
+  void SetInput(std::size_t input_id, std::vector<T> input);
+
+  std::size_t GetNumberOfInputs() const { return input_gates_.size(); }
+
+  // Evaluates the circuit.  Throws std::logic_error if the circuit needs MTs, SPs, or SBs for a
+  // repeated evaluation, but they are not read from a preprocessing store, since the OT-based
+  // providers only generate correlated randomness once.  For the same reason, a circuit whose gates
+  // use OTs directly (e.g., BMR AND gates or OT-based conversions) can only be evaluated once.
+  void Evaluate();
+
+  std::size_t GetNumberOfEvaluations() const { return number_of_evaluations_; }
+
+ private:
+  Party& party_;
+  std::vector<GatePointer> input_gates_;
+  std::size_t number_of_evaluations_ = 0;
+};
+
+}  // namespace encrypto::motion
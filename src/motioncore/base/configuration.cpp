@@ -33,7 +33,7 @@ namespace encrypto::motion {
 Configuration::Configuration(std::size_t my_id, std::size_t number_of_parties)
     : my_id_(my_id),
       number_of_parties_(number_of_parties),
-      number_of_threads_(std::max(std::thread::hardware_concurrency(), 8u)) {
+      number_of_threads_(std::max(std::thread::hardware_concurrency(), 1u)) {
   if constexpr (kVerboseDebug) {
     severity_level_ = boost::log::trivial::trace;
   } else if constexpr (kDebug) {
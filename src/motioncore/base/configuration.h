@@ -26,6 +26,7 @@
 
 #include <boost/log/trivial.hpp>
 #include <memory>
+#include <string>
 
 namespace encrypto::motion {
 
@@ -39,6 +40,28 @@ class Configuration {
 
   void SetNumOfThreads(std::size_t n) { number_of_threads_ = n; }
 
+  bool GetPinThreads() const noexcept { return pin_threads_; }
+
+  void SetPinThreads(bool value) { pin_threads_ = value; }
+
+  std::size_t GetMaximumNumberOfFibers() const noexcept { return maximum_number_of_fibers_; }
+
+  void SetMaximumNumberOfFibers(std::size_t n) { maximum_number_of_fibers_ = n; }
+
+  std::size_t GetFiberStackSize() const noexcept { return fiber_stack_size_; }
+
+  void SetFiberStackSize(std::size_t n) { fiber_stack_size_ = n; }
+
+  bool GetStreamingEvaluation() const noexcept { return streaming_evaluation_; }
+
+  void SetStreamingEvaluation(bool value) { streaming_evaluation_ = value; }
+
+  const std::string& GetBaseOtCacheDirectory() const noexcept { return base_ot_cache_directory_; }
+
+  void SetBaseOtCacheDirectory(std::string directory) {
+    base_ot_cache_directory_ = std::move(directory);
+  }
+
   void SetLoggingSeverityLevel(boost::log::trivial::severity_level severity_level) {
     severity_level_ = severity_level;
   }
@@ -47,6 +70,14 @@ class Configuration {
 
   void SetOnlineAfterSetup(bool value);
 
+  bool GetLayeredEvaluation() const noexcept { return layered_evaluation_; }
+
+  void SetLayeredEvaluation(bool value) { layered_evaluation_ = value; }
+
+  bool GetBmrHalfGates() const noexcept { return bmr_half_gates_; }
+
+  void SetBmrHalfGates(bool value) { bmr_half_gates_ = value; }
+
   void SetLoggingEnabled(bool value = true) { logging_enabled_ = value; }
 
   bool GetLoggingEnabled() const noexcept { return logging_enabled_; }
@@ -71,11 +102,54 @@ class Configuration {
   /// until proceeding to the online phase
   bool online_after_setup_ = false;
 
-  // determines how many worker threads are used in openmp, but not in
-  // communication handlers! the latter always use at least 2 threads for each
-  // communication channel to send and receive data to prevent the communication
-  // becoming a bottleneck, e.g., in 10 Gbps networks.
+  /// @param layered_evaluation_ if set true, the gates are evaluated layer by layer, i.e., only the
+  /// gates of the current layer of the circuit are posted to the workers and all their messages
+  /// are exchanged in the same communication round, instead of posting one fiber per gate up front
+  bool layered_evaluation_ = false;
+
+  /// @param bmr_half_gates_ if set true and there are exactly two parties, BMR AND gates are
+  /// garbled with distributed half-gates, i.e., each party garbles its own keys for the other
+  /// party, which reduces a garbled table from 4 * 2 to 3 blocks per party
+  bool bmr_half_gates_ = false;
+
+  // determines how many worker threads the gate executor uses to evaluate the gates' fibers, but
+  // not the communication handlers! the latter always use 2 threads for each communication
+  // channel to send and receive data to prevent the communication becoming a bottleneck, e.g., in
+  // 10 Gbps networks.
   std::size_t number_of_threads_;
+
+  /// @param pin_threads_ if set true, the gate executor's worker threads are pinned to the
+  /// available cpus, grouped by NUMA node, and idle workers steal fibers from workers on the same
+  /// node first. The communication threads are pinned to the cpus following the workers'.
+  bool pin_threads_ = false;
+
+  /// @param maximum_number_of_fibers_ if not 0, at most this many gates are evaluated in
+  /// simultaneously alive fibers, such that the fibers' stack memory does not grow with the size of
+  /// the circuit. Gates are admitted in topological order as earlier gates finish. Must be the same
+  /// for all parties, since it determines the OT batches of BMR AND gates.
+  std::size_t maximum_number_of_fibers_ = 0;
+
+  /// @param fiber_stack_size_ size of each fiber's stack in bytes, 0 for kFiberStackSize
+  std::size_t fiber_stack_size_ = 0;
+
+  /// @param streaming_evaluation_ if set true, the register does not keep the wires alive and
+  /// drops each gate as soon as it is evaluated, which in turn drops the gate's references to its
+  /// parent wires. A wire and its values are thus freed once its producing gate and all gates
+  /// waiting for it are evaluated, unless a share still refers to it. Since the gates allocate the
+  /// values of their output wires only when they are evaluated, the memory for the values grows
+  /// with the width of the circuit rather than its size, see also maximum_number_of_fibers_. The
+  /// gates and wires themselves are still created before the evaluation. The circuit can then
+  /// only be evaluated once, i.e., Party::Run() with repetitions > 1 throws. Has no effect on
+  /// layered evaluation, which keeps the gate layers until the register is reset.
+  bool streaming_evaluation_ = false;
+
+  /// @param base_ot_cache_directory_ if not empty, the base OTs with each party are stored in this
+  /// directory and reused by later sessions with the same party, which then skip the public-key
+  /// operations of the base OTs. Each session derives fresh OT extension seeds from the cached base
+  /// OTs, see BaseOtCache. Has to be set by both parties of a pair, otherwise the base OTs are
+  /// computed as usual. The directory is created accessible only by the user, an existing directory
+  /// that others can access is not used.
+  std::string base_ot_cache_directory_;
 };
 
 using ConfigurationPointer = std::shared_ptr<Configuration>;
@@ -23,6 +23,10 @@
 #include "motion_base_provider.h"
 #include "output_message_handler.h"
 
+#include <stdexcept>
+
+#include <fmt/format.h>
+
 #include "communication/communication_layer.h"
 #include "communication/fbs_headers/hello_message_generated.h"
 #include "communication/fbs_headers/message_generated.h"
@@ -41,7 +45,8 @@ struct HelloMessageHandler : public communication::MessageHandler {
   HelloMessageHandler(std::size_t number_of_parties, std::shared_ptr<Logger> logger)
       : logger_(logger),
         fixed_key_aes_seed_promises(number_of_parties),
-        randomness_sharing_seed_promises(number_of_parties) {
+        randomness_sharing_seed_promises(number_of_parties),
+        base_ot_cache_id_promises(number_of_parties) {
     std::transform(std::begin(fixed_key_aes_seed_promises), std::end(fixed_key_aes_seed_promises),
                    std::back_inserter(fixed_key_aes_seed_futures),
                    [](auto& p) { return p.get_future(); });
@@ -49,6 +54,9 @@ struct HelloMessageHandler : public communication::MessageHandler {
                    std::end(randomness_sharing_seed_promises),
                    std::back_inserter(randomness_sharing_seed_futures),
                    [](auto& p) { return p.get_future(); });
+    std::transform(std::begin(base_ot_cache_id_promises), std::end(base_ot_cache_id_promises),
+                   std::back_inserter(base_ot_cache_id_futures),
+                   [](auto& p) { return p.get_future(); });
   }
 
   // Method which is called on received messages.
@@ -61,6 +69,8 @@ struct HelloMessageHandler : public communication::MessageHandler {
   std::vector<ReusableFuture<std::vector<std::uint8_t>>> fixed_key_aes_seed_futures;
   std::vector<ReusablePromise<std::vector<std::uint8_t>>> randomness_sharing_seed_promises;
   std::vector<ReusableFuture<std::vector<std::uint8_t>>> randomness_sharing_seed_futures;
+  std::vector<ReusablePromise<std::vector<std::uint8_t>>> base_ot_cache_id_promises;
+  std::vector<ReusableFuture<std::vector<std::uint8_t>>> base_ot_cache_id_futures;
 };
 
 void HelloMessageHandler::ReceivedMessage(std::size_t party_id,
@@ -76,6 +86,11 @@ void HelloMessageHandler::ReceivedMessage(std::size_t party_id,
   fb_vec = hello_message_pointer->fixed_key_aes_seed();
   fixed_key_aes_seed_promises.at(party_id).set_value(
       std::vector(std::begin(*fb_vec), std::end(*fb_vec)));
+
+  // the field is absent if the sender has no cached base OTs with us
+  fb_vec = hello_message_pointer->base_ot_cache_id();
+  base_ot_cache_id_promises.at(party_id).set_value(
+      fb_vec ? std::vector(std::begin(*fb_vec), std::end(*fb_vec)) : std::vector<std::uint8_t>());
 }
 
 BaseProvider::BaseProvider(communication::CommunicationLayer& communication_layer,
@@ -86,6 +101,8 @@ BaseProvider::BaseProvider(communication::CommunicationLayer& communication_laye
       my_id_(communication_layer_.GetMyId()),
       my_randomness_generators_(number_of_parties_),
       their_randomness_generators_(number_of_parties_),
+      my_base_ot_cache_ids_(number_of_parties_),
+      their_base_ot_cache_ids_(number_of_parties_),
       hello_message_handler_(std::make_shared<HelloMessageHandler>(number_of_parties_, logger_)),
       output_message_handlers_(number_of_parties_),
       setup_ready_(false),
@@ -140,7 +157,8 @@ void BaseProvider::Setup() {
     }
     auto msg_builder = communication::BuildHelloMessage(
         my_id_, party_id, number_of_parties_, &my_seeds.at(party_id), &aes_fixed_key_,
-        /* TODO: configuration_->GetOnlineAfterSetup()*/ true, kVersion);
+        /* TODO: configuration_->GetOnlineAfterSetup()*/ true, kVersion,
+        my_base_ot_cache_ids_.at(party_id).empty() ? nullptr : &my_base_ot_cache_ids_.at(party_id));
     communication_layer_.SendMessage(party_id, std::move(msg_builder));
   }
   // initialize my randomness generators
@@ -167,6 +185,8 @@ void BaseProvider::Setup() {
     auto their_seed = hello_message_handler_->randomness_sharing_seed_futures.at(party_id).get();
     // initialize randomness generator of the other party
     their_randomness_generators_.at(party_id)->Initialize(their_seed.data());
+    their_base_ot_cache_ids_.at(party_id) =
+        hello_message_handler_->base_ot_cache_id_futures.at(party_id).get();
   }
   {
     std::scoped_lock lock(setup_ready_cond_->GetMutex());
@@ -182,9 +202,20 @@ void BaseProvider::Setup() {
 
 void BaseProvider::WaitForSetup() const { setup_ready_cond_->Wait(); }
 
-std::vector<ReusableFiberFuture<std::vector<std::uint8_t>>> BaseProvider::RegisterForOutputMessages(
-    std::size_t gate_id) {
-  std::vector<ReusableFiberFuture<std::vector<std::uint8_t>>> futures(number_of_parties_);
+void BaseProvider::SetBaseOtCacheIds(std::vector<std::vector<std::uint8_t>> cache_ids) {
+  if (execute_setup_flag_.test()) {
+    throw std::logic_error("base OT cache ids have to be set before the setup");
+  }
+  if (cache_ids.size() != number_of_parties_) {
+    throw std::invalid_argument(fmt::format("expected {} base OT cache ids, but got {}",
+                                            number_of_parties_, cache_ids.size()));
+  }
+  my_base_ot_cache_ids_ = std::move(cache_ids);
+}
+
+std::vector<ReusableFiberFuture<communication::MessageBuffer>>
+BaseProvider::RegisterForOutputMessages(std::size_t gate_id) {
+  std::vector<ReusableFiberFuture<communication::MessageBuffer>> futures(number_of_parties_);
   for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
     if (party_id == my_id_) {
       continue;
@@ -195,4 +226,18 @@ std::vector<ReusableFiberFuture<std::vector<std::uint8_t>>> BaseProvider::Regist
   return futures;
 }
 
+std::vector<std::vector<ReusableFiberFuture<communication::MessageBuffer>>>
+BaseProvider::RegisterForOutputMessages(std::size_t gate_id, std::size_t number_of_messages) {
+  std::vector<std::vector<ReusableFiberFuture<communication::MessageBuffer>>> futures(
+      number_of_parties_);
+  for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    futures.at(party_id) = output_message_handlers_.at(party_id)->register_for_output_messages(
+        gate_id, number_of_messages);
+  }
+  return futures;
+}
+
 }  // namespace encrypto::motion
@@ -24,6 +24,8 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
+#include "communication/message_buffer.h"
 #include "utility/reusable_future.h"
 
 namespace encrypto::motion::communication {
@@ -53,6 +55,15 @@ class BaseProvider {
   void Setup();
   void WaitForSetup() const;
 
+  // set the ids of the cached base OTs with each party, which are announced in the HelloMessages,
+  // has to be called before Setup()
+  void SetBaseOtCacheIds(std::vector<std::vector<std::uint8_t>> cache_ids);
+
+  // id of the cached base OTs with party_id announced by party_id, empty if it has none
+  const std::vector<std::uint8_t>& GetTheirBaseOtCacheId(std::size_t party_id) const {
+    return their_base_ot_cache_ids_.at(party_id);
+  }
+
   const std::vector<std::uint8_t>& GetAesFixedKey() const { return aes_fixed_key_; }
   primitives::SharingRandomnessGenerator& GetMyRandomnessGenerator(std::size_t party_id) {
     return *my_randomness_generators_.at(party_id);
@@ -61,9 +72,14 @@ class BaseProvider {
     return *their_randomness_generators_.at(party_id);
   }
 
-  std::vector<ReusableFiberFuture<std::vector<std::uint8_t>>> RegisterForOutputMessages(
+  std::vector<ReusableFiberFuture<communication::MessageBuffer>> RegisterForOutputMessages(
       std::size_t gate_id);
 
+  // register for number_of_messages consecutive output messages of the gate from each party,
+  // the result is indexed by party id and then by message
+  std::vector<std::vector<ReusableFiberFuture<communication::MessageBuffer>>>
+  RegisterForOutputMessages(std::size_t gate_id, std::size_t number_of_messages);
+
  private:
   communication::CommunicationLayer& communication_layer_;
   std::shared_ptr<Logger> logger_;
@@ -72,6 +88,8 @@ class BaseProvider {
   std::vector<std::uint8_t> aes_fixed_key_;
   std::vector<std::unique_ptr<primitives::SharingRandomnessGenerator>> my_randomness_generators_;
   std::vector<std::unique_ptr<primitives::SharingRandomnessGenerator>> their_randomness_generators_;
+  std::vector<std::vector<std::uint8_t>> my_base_ot_cache_ids_;
+  std::vector<std::vector<std::uint8_t>> their_base_ot_cache_ids_;
   std::shared_ptr<HelloMessageHandler> hello_message_handler_;
   std::vector<std::shared_ptr<OutputMessageHandler>> output_message_handlers_;
 
@@ -34,12 +34,22 @@ namespace encrypto::motion {
 OutputMessageHandler::OutputMessageHandler(std::size_t party_id, std::shared_ptr<Logger> logger)
     : party_id_(party_id), logger_(std::move(logger)) {}
 
-ReusableFiberFuture<std::vector<std::uint8_t>> OutputMessageHandler::register_for_output_message(
+ReusableFiberFuture<communication::MessageBuffer> OutputMessageHandler::register_for_output_message(
     std::size_t gate_id) {
-  ReusableFiberPromise<std::vector<std::uint8_t>> promise;
-  auto future = promise.get_future();
+  return std::move(register_for_output_messages(gate_id, 1).front());
+}
+
+std::vector<ReusableFiberFuture<communication::MessageBuffer>>
+OutputMessageHandler::register_for_output_messages(std::size_t gate_id,
+                                                   std::size_t number_of_messages) {
+  assert(number_of_messages > 0);
+  OutputMessagePromises promises;
+  std::vector<ReusableFiberFuture<communication::MessageBuffer>> futures;
+  promises.promises.resize(number_of_messages);
+  futures.reserve(number_of_messages);
+  for (auto& promise : promises.promises) futures.emplace_back(promise.get_future());
   std::unique_lock<std::mutex> lock(output_message_promises_mutex_);
-  auto [_, success] = output_message_promises_.insert({gate_id, std::move(promise)});
+  auto [_, success] = output_message_promises_.emplace(gate_id, std::move(promises));
   lock.unlock();
   if (!success) {
     if (logger_) {
@@ -55,19 +65,26 @@ ReusableFiberFuture<std::vector<std::uint8_t>> OutputMessageHandler::register_fo
                                     gate_id, party_id_));
     }
   }
-  return future;
+  return futures;
 }
 
-void OutputMessageHandler::ReceivedMessage(std::size_t,
+void OutputMessageHandler::ReceivedMessage(std::size_t party_id,
                                            std::vector<std::uint8_t>&& output_message) {
+  ReceivedMessageBuffer(party_id, communication::MessageBuffer(std::move(output_message)));
+}
+
+void OutputMessageHandler::ReceivedMessageBuffer(std::size_t,
+                                                 communication::MessageBuffer&& output_message) {
   assert(!output_message.empty());
-  auto message = communication::GetMessage(reinterpret_cast<std::uint8_t*>(output_message.data()));
+  auto message = communication::GetMessage(output_message.data());
   auto output_message_pointer = communication::GetOutputMessage(message->payload()->data());
   auto gate_id = output_message_pointer->gate_id();
 
   // find promise
+  std::unique_lock<std::mutex> lock(output_message_promises_mutex_);
   auto iterator = output_message_promises_.find(gate_id);
   if (iterator == output_message_promises_.end()) {
+    lock.unlock();
     // no promise found -> drop message
     if (logger_) {
       logger_->LogError(
@@ -76,7 +93,12 @@ void OutputMessageHandler::ReceivedMessage(std::size_t,
     }
     return;
   }
-  auto& promise = iterator->second;
+  // the promises are reused by later evaluations of the circuit, which start over at the first
+  // promise once the current evaluation received all of its messages
+  auto& [promises, next_promise] = iterator->second;
+  auto& promise = promises.at(next_promise);
+  next_promise = (next_promise + 1) % promises.size();
+  lock.unlock();
   // put the received message into the promise
   try {
     promise.set_value(std::move(output_message));
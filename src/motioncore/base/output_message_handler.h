@@ -22,6 +22,10 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "communication/message_handler.h"
 #include "utility/reusable_future.h"
 
@@ -37,17 +41,32 @@ class OutputMessageHandler : public communication::MessageHandler {
 
   // Register for an OutputMessage.
   // Returns a future which can be used to wait for and retrieve the message.
-  ReusableFiberFuture<std::vector<std::uint8_t>> register_for_output_message(std::size_t gate_id);
+  ReusableFiberFuture<communication::MessageBuffer> register_for_output_message(
+      std::size_t gate_id);
+
+  // Register for number_of_messages consecutive OutputMessages with the same gate id, e.g., for a
+  // gate with several rounds of communication.
+  // Returns a future for each message in the order in which the messages arrive.
+  std::vector<ReusableFiberFuture<communication::MessageBuffer>> register_for_output_messages(
+      std::size_t gate_id, std::size_t number_of_messages);
 
   // Method which is called on received messages.
   void ReceivedMessage(std::size_t, std::vector<std::uint8_t>&& message) override;
 
+  // Receive the message without copying it, s.t. the gate can read the shares in place
+  void ReceivedMessageBuffer(std::size_t, communication::MessageBuffer&& message) override;
+
  private:
   std::size_t party_id_;
   std::shared_ptr<Logger> logger_;
 
-  std::unordered_map<std::size_t, ReusableFiberPromise<std::vector<std::uint8_t>>>
-      output_message_promises_;
+  struct OutputMessagePromises {
+    std::vector<ReusableFiberPromise<communication::MessageBuffer>> promises;
+    // index of the promise for the next message, wraps around for repeated evaluations
+    std::size_t next_promise = 0;
+  };
+
+  std::unordered_map<std::size_t, OutputMessagePromises> output_message_promises_;
   // synchronizes access to above map
   std::mutex output_message_promises_mutex_;
 };
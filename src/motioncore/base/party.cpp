@@ -191,6 +191,12 @@ void Party::Run(std::size_t repetitions) {
   }
 }
 
+void Party::PrecomputePreprocessing(const PreprocessingDemand& demand, const std::string& path) {
+  backend_->PrecomputePreprocessing(demand, path);
+}
+
+void Party::LoadPreprocessing(const std::string& path) { backend_->LoadPreprocessing(path); }
+
 void Party::Reset() {
   backend_->Synchronize();
   logger_->LogDebug("Party reset");
@@ -208,7 +214,9 @@ void Party::Clear() {
 }
 
 void Party::EvaluateCircuit() {
-  if (configuration_->GetOnlineAfterSetup()) {
+  if (configuration_->GetLayeredEvaluation()) {
+    backend_->EvaluateLayered();
+  } else if (configuration_->GetOnlineAfterSetup()) {
     backend_->EvaluateSequential();
   } else {
     backend_->EvaluateParallel();
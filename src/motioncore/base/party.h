@@ -27,15 +27,18 @@
 #include <fmt/format.h>
 #include <memory>
 #include <span>
+#include <string>
 #include <vector>
 
 #include "base/backend.h"
 #include "base/configuration.h"
+#include "multiplication_triple/preprocessing_store.h"
 #include "protocols/arithmetic_gmw/arithmetic_gmw_share.h"
 #include "protocols/arithmetic_gmw/arithmetic_gmw_wire.h"
 #include "protocols/boolean_gmw/boolean_gmw_share.h"
 #include "protocols/boolean_gmw/boolean_gmw_wire.h"
 #include "protocols/share.h"
+#include "protocols/share_wrapper.h"
 #include "utility/typedefs.h"
 
 namespace encrypto::motion::communication {
@@ -228,6 +231,33 @@ class Party {
     }
   }
 
+  /// \brief Shares a whole table of Boolean columns in a single input gate, s.t. the sharing
+  /// randomness for all columns is expanded at once.  A column is given as one BitVector per bit
+  /// with one entry per row.
+  /// \return one ShareWrapper per column
+  template <MpcProtocol P>
+  std::vector<ShareWrapper> InTable(
+      std::vector<std::vector<BitVector<>>>&& columns,
+      std::size_t party_id = std::numeric_limits<std::size_t>::max()) {
+    static_assert(P == MpcProtocol::kBooleanGmw,
+                  "Input tables are only implemented for BooleanGMW");
+    auto shares = backend_->BooleanGmwInputTable(party_id, std::move(columns));
+    return std::vector<ShareWrapper>(shares.begin(), shares.end());
+  }
+
+  /// \brief Shares a whole table of arithmetic columns in a single input gate, s.t. the sharing
+  /// randomness for all columns is expanded at once.
+  /// \return one ShareWrapper per column
+  template <MpcProtocol P, typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  std::vector<ShareWrapper> InTable(
+      std::vector<std::vector<T>>&& columns,
+      std::size_t party_id = std::numeric_limits<std::size_t>::max()) {
+    static_assert(P == MpcProtocol::kArithmeticGmw,
+                  "Input tables are only implemented for ArithmeticGMW");
+    auto shares = backend_->ArithmeticGmwInputTable<T>(party_id, std::move(columns));
+    return std::vector<ShareWrapper>(shares.begin(), shares.end());
+  }
+
   template <MpcProtocol P, typename T = std::uint8_t,
             typename = std::enable_if_t<std::is_unsigned_v<T>>>
   SharePointer SharedIn(T input) {
@@ -341,6 +371,20 @@ class Party {
   /// @param repetitions Number of iterations.
   void Run(std::size_t repetitions = 1);
 
+  /// \brief Precomputes the given amount of correlated randomness and writes it to a memory-mapped
+  /// preprocessing store, s.t. a later run can use it via Party::LoadPreprocessing().
+  /// All parties SHALL call this method with the same demand. The party cannot be used to evaluate
+  /// circuits afterwards.
+  /// @param demand Number of MTs, SPs and SBs to precompute.
+  /// @param path Path of this party's preprocessing store.
+  void PrecomputePreprocessing(const PreprocessingDemand& demand, const std::string& path);
+
+  /// \brief Takes the MTs, SPs and SBs of all gates constructed afterwards from a preprocessing
+  /// store instead of generating them via OT extension during the preprocessing phase.
+  /// SHALL be called before any gate is constructed.
+  /// @param path Path of this party's preprocessing store.
+  void LoadPreprocessing(const std::string& path);
+
   /// \brief Destroys all the gates and wires that were constructed until now.
   void Reset();
 
@@ -350,6 +394,10 @@ class Party {
 
   const auto& GetLogger() { return logger_; }
 
+  /// \brief Returns the tracer which records the evaluation of each gate and the communication
+  /// of this party once enabled, see ToChromeTraceJson in statistics/analysis.h.
+  Tracer& GetTracer() { return backend_->GetTracer(); }
+
   /// \brief Sends a termination message to all of the connected parties.
   /// In case a TCP connection is used, this will internally be interpreted as a signal to
   /// disconnect.
@@ -24,10 +24,12 @@
 
 #include "register.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include <fmt/format.h>
 
+#include "algorithm/algorithm_description.h"
 #include "configuration.h"
 #include "protocols/gate.h"
 #include "protocols/wire.h"
@@ -82,6 +84,74 @@ void Register::RegisterGate(const GatePointer& gate) {
     gates_online_++;
   }
   gates_.push_back(gate);
+  gate_layers_.clear();
+}
+
+void Register::SetStreamingEvaluation(bool value) {
+  if (value) {
+    // the wires are kept alive by the gates computing and using them and by the shares
+    wires_.clear();
+  } else if (streaming_evaluation_) {
+    // wires are indexed by their id, so keep empty slots for the wires which were not kept
+    wires_.resize(global_wire_id_ - wire_id_offset_);
+  }
+  streaming_evaluation_ = value;
+}
+
+void Register::ReleaseEvaluatedGate(std::size_t position) {
+  if (!streaming_evaluation_) {
+    return;
+  }
+  auto& gate = gates_.at(position);
+  assert(gate != nullptr);
+  gate->ReleaseParentWires();
+  gate = nullptr;
+  released_gates_ = true;
+}
+
+const std::vector<std::vector<GatePointer>>& Register::GetGateLayers() {
+  if (gate_layers_.empty() && !gates_.empty()) {
+    ComputeGateLayers();
+  }
+  return gate_layers_;
+}
+
+void Register::ComputeGateLayers() {
+  // wires are numbered consecutively starting from wire_id_offset_, a wire's depth is the layer in
+  // which it becomes available, i.e., the layer following the one of the gate computing it
+  std::vector<std::size_t> wire_depths(global_wire_id_ - wire_id_offset_, 0);
+  auto get_depth = [this, &wire_depths](const Gate& gate) {
+    std::size_t depth = 0;
+    for (auto wire_id : gate.GetWireDependencies()) {
+      assert(wire_id >= wire_id_offset_);
+      depth = std::max(depth, wire_depths.at(wire_id - wire_id_offset_));
+    }
+    return depth;
+  };
+
+  // gates are registered after their parent wires were created, so the registration order is a
+  // topological order of the circuit
+  for (auto& gate : gates_) {
+    // unregistered or already released gates leave empty slots behind
+    if (gate == nullptr) continue;
+    auto layer = get_depth(*gate);
+    if (auto enclosing_gate = gate->GetEnclosingGate(); enclosing_gate != nullptr) {
+      layer = std::max(layer, get_depth(*enclosing_gate));
+    }
+    for (auto& wire : gate->GetOutputWires()) {
+      auto& wire_depth = wire_depths.at(wire->GetWireId() - wire_id_offset_);
+      wire_depth = std::max(wire_depth, layer + 1);
+    }
+    if (gate_layers_.size() <= layer) {
+      gate_layers_.resize(layer + 1);
+    }
+    gate_layers_[layer].push_back(gate);
+  }
+
+  if constexpr (kDebug) {
+    logger_->LogDebug(
+        fmt::format("Split {} gates into {} layers", gates_.size(), gate_layers_.size()));
+  }
 }
 
 void Register::AddToActiveQueue(std::size_t gate_id) {
@@ -152,12 +222,13 @@ void Register::Reset() {
     gate_id_offset_ = global_gate_id_;
   }
 
-  if (!wires_.empty()) {
-    wire_id_offset_ = global_wire_id_;
-  }
+  // in streaming evaluation, the wires are not kept in wires_
+  wire_id_offset_ = global_wire_id_;
 
   wires_.clear();
   gates_.clear();
+  gate_layers_.clear();
+  released_gates_ = false;
 
   evaluated_gates_setup_ = 0;
   evaluated_gates_online_ = 0;
@@ -172,12 +243,15 @@ void Register::Clear() {
   assert(active_gates_.empty());
   assert(evaluated_gates_setup_ == gates_setup_);
   assert(evaluated_gates_online_ == gates_online_);
+  if (released_gates_) {
+    throw std::logic_error("the gates were already released during streaming evaluation");
+  }
   for (auto& gate : gates_) {
-    gate->Clear();
+    if (gate) gate->Clear();
   }
 
   for (auto& wire : wires_) {
-    wire->Clear();
+    if (wire) wire->Clear();
   }
 
   evaluated_gates_setup_ = 0;
@@ -204,4 +278,15 @@ std::shared_ptr<AlgorithmDescription> Register::GetCachedAlgorithmDescription(
   }
 }
 
+std::shared_ptr<AlgorithmDescription> Register::LoadAlgorithmDescription(const std::string& path) {
+  auto algorithm_description =
+      std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristolOrBinary(path));
+  if (algorithm_description->layer_offsets.empty()) {
+    algorithm_description->ComputeLayers();
+  }
+  std::scoped_lock lock(cached_algos_mutex_);
+  // another thread might have loaded the same file in the meantime
+  return cached_algos_.try_emplace(path, std::move(algorithm_description)).first->second;
+}
+
 }  // namespace encrypto::motion
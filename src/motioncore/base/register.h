@@ -29,6 +29,7 @@
 #include <mutex>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 namespace encrypto::motion {
 
@@ -78,7 +79,11 @@ class Register {
     return wire;
   }
 
-  void RegisterWire(const WirePointer& wire) { wires_.push_back(wire); }
+  void RegisterWire(const WirePointer& wire) {
+    if (!streaming_evaluation_) {
+      wires_.push_back(wire);
+    }
+  }
 
   const GatePointer& GetGate(std::size_t gate_id) const {
     return gates_.at(gate_id - gate_id_offset_);
@@ -86,11 +91,34 @@ class Register {
 
   auto& GetGates() const { return gates_; }
 
-  void UnregisterGate(std::size_t gate_id) { gates_.at(gate_id) = nullptr; }
+  /// \brief Gets the registered gates grouped into topological layers, i.e., every gate only
+  ///        depends on wires computed by gates in earlier layers. Gates evaluated on behalf of an
+  ///        enclosing gate are placed in the layer of the enclosing gate.
+  /// \note The layers are computed on the first call and cached until the next gate is registered
+  ///       or the register is reset.
+  const std::vector<std::vector<GatePointer>>& GetGateLayers();
+
+  void UnregisterGate(std::size_t gate_id) { gates_.at(gate_id - gate_id_offset_) = nullptr; }
 
   WirePointer GetWire(std::size_t wire_id) const { return wires_.at(wire_id - wire_id_offset_); }
 
-  void UnregisterWire(std::size_t wire_id) { wires_.at(wire_id) = nullptr; }
+  void UnregisterWire(std::size_t wire_id) { wires_.at(wire_id - wire_id_offset_) = nullptr; }
+
+  /// \brief Enables or disables streaming evaluation, see Configuration. When enabled, the
+  ///        references to the wires registered so far are dropped and new wires are not kept.
+  ///        When disabled again, new wires are kept and GetWire returns nullptr for the wires
+  ///        registered during streaming evaluation.
+  void SetStreamingEvaluation(bool value);
+
+  bool GetStreamingEvaluation() const { return streaming_evaluation_; }
+
+  /// \brief Called by the gate executor once the gate at position in GetGates() is evaluated,
+  ///        i.e., its online phase is finished or it has none. In streaming evaluation,
+  ///        unregisters the gate and drops its references to its parent wires, otherwise does
+  ///        nothing. Clear() throws once a gate was released.
+  /// \note Must only be called from the fiber evaluating the gate or from the thread posting the
+  ///       gates, the other entries of the register may be accessed concurrently.
+  void ReleaseEvaluatedGate(std::size_t position);
 
   void AddToActiveQueue(std::size_t gate_id);
 
@@ -139,6 +167,12 @@ class Register {
   /// \return shared_ptr to the algorithm description or to nullptr if not in the hash table
   std::shared_ptr<AlgorithmDescription> GetCachedAlgorithmDescription(const std::string& path);
 
+  /// \brief Reads the AlgorithmDescription from the file at path (see
+  /// AlgorithmDescription::FromBristolOrBinary), computes its layers if the file does not contain
+  /// them and places it into cached_algos_, s.t. later gates share the layered description
+  /// \return shared_ptr to the cached algorithm description
+  std::shared_ptr<AlgorithmDescription> LoadAlgorithmDescription(const std::string& path);
+
  private:
   std::shared_ptr<Logger> logger_;
 
@@ -147,6 +181,10 @@ class Register {
   std::size_t global_arithmetic_gmw_sharing_id_ = 0, global_boolean_gmw_sharing_id_ = 0;
   std::size_t gate_id_offset_ = 0, wire_id_offset_ = 0;
 
+  bool streaming_evaluation_ = false;
+  // set once a gate was released in streaming evaluation, until the register is reset
+  std::atomic<bool> released_gates_ = false;
+
   std::atomic<std::size_t> gates_setup_ = 0;
   std::atomic<std::size_t> gates_online_ = 0;
 
@@ -167,6 +205,10 @@ class Register {
 
   std::vector<WirePointer> wires_;
 
+  std::vector<std::vector<GatePointer>> gate_layers_;
+
+  void ComputeGateLayers();
+
   std::unordered_map<std::string, std::shared_ptr<AlgorithmDescription>> cached_algos_;
   std::mutex cached_algos_mutex_;
 };
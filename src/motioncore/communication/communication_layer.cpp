@@ -22,10 +22,15 @@
 
 #include "communication_layer.h"
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <limits>
+#include <queue>
 #include <shared_mutex>
+#include <span>
 #include <stdexcept>
 #include <thread>
 #include <unordered_map>
@@ -38,6 +43,7 @@
 #include "message.h"
 #include "message_handler.h"
 #include "sync_handler.h"
+#include "statistics/trace.h"
 #include "tcp_transport.h"
 #include "utility/constants.h"
 #include "utility/logger.h"
@@ -46,6 +52,26 @@
 
 namespace encrypto::motion::communication {
 
+// alignment of the memory returned by operator new, which the message handlers may rely on
+constexpr std::size_t kMessageAlignment = alignof(std::max_align_t);
+
+namespace {
+
+std::span<const std::uint8_t> GetMessageData(const std::vector<std::uint8_t>& message) {
+  return message;
+}
+
+std::span<const std::uint8_t> GetMessageData(const flatbuffers::DetachedBuffer& message) {
+  return {message.data(), message.size()};
+}
+
+template <typename T>
+std::span<const std::uint8_t> GetMessageData(const std::shared_ptr<const T>& message) {
+  return GetMessageData(*message);
+}
+
+}  // namespace
+
 struct CommunicationLayer::CommunicationLayerImplementation {
   CommunicationLayerImplementation(std::size_t my_id,
                                    std::vector<std::unique_ptr<Transport>>&& transports,
@@ -53,6 +79,8 @@ struct CommunicationLayer::CommunicationLayerImplementation {
   // run in a thread for each party
   void ReceiveTask(std::size_t party_id);
   void SendTask(std::size_t party_id);
+  // dispatch a received message to its handler, returns false for termination messages
+  bool HandleMessage(std::size_t party_id, MessageBuffer&& raw_message);
 
   // setup threads and data structures
   void initialize(std::size_t my_id, std::size_t number_of_parties);
@@ -68,11 +96,15 @@ struct CommunicationLayer::CommunicationLayerImplementation {
 
   std::vector<std::unique_ptr<Transport>> transports_;
 
-  // message type
+  // message type, flatbuffers are queued as they are released by the builder to avoid a copy
   using message_t =
-      std::variant<std::vector<std::uint8_t>, std::shared_ptr<const std::vector<std::uint8_t>>>;
+      std::variant<std::vector<std::uint8_t>, std::shared_ptr<const std::vector<std::uint8_t>>,
+                   flatbuffers::DetachedBuffer, std::shared_ptr<const flatbuffers::DetachedBuffer>>;
 
   std::vector<SynchronizedFiberQueue<message_t>> send_queues_;
+  // message batching, disabled if the maximum batch size is 0
+  std::atomic<std::size_t> maximum_batch_size_ = 0;
+  std::atomic<std::chrono::microseconds::rep> batch_time_window_ = 0;
   std::vector<std::thread> receive_threads_;
   std::vector<std::thread> send_threads_;
 
@@ -84,6 +116,7 @@ struct CommunicationLayer::CommunicationLayerImplementation {
   std::shared_ptr<SynchronizationHandler> sync_handler_;
 
   std::shared_ptr<Logger> logger_;
+  std::shared_ptr<Tracer> tracer_;
 };
 
 CommunicationLayer::CommunicationLayerImplementation::CommunicationLayerImplementation(
@@ -119,27 +152,116 @@ void CommunicationLayer::CommunicationLayerImplementation::SendTask(std::size_t
   auto my_start_sfuture = start_sfuture_;
   my_start_sfuture.get();
 
+  const auto get_data = [](const message_t& message) {
+    return std::visit([](const auto& m) { return GetMessageData(m); }, message);
+  };
+
+  // messages which are written to the transport at once
+  std::vector<message_t> outgoing;
+  std::vector<std::span<const std::uint8_t>> outgoing_data;
+
+  const auto send_outgoing = [&] {
+    if (outgoing.empty()) {
+      return;
+    }
+    outgoing_data.clear();
+    std::size_t number_of_bytes = 0;
+    for (const auto& message : outgoing) {
+      outgoing_data.emplace_back(get_data(message));
+      number_of_bytes += outgoing_data.back().size();
+    }
+    const bool trace = tracer_ && tracer_->IsEnabled();
+    const auto begin = trace ? Tracer::ClockType::now() : Tracer::TimePoint();
+    transport.SendMessages(outgoing_data);
+    if (trace) {
+      tracer_->Record(TraceCategory::kSend, party_id, begin, Tracer::ClockType::now(),
+                      number_of_bytes);
+    }
+    if (logger_) {
+      logger_->LogDebug(fmt::format("Sent {} messages to party {}", outgoing.size(), party_id));
+    }
+    outgoing.clear();
+  };
+
+  // messages collected for the next batch
+  std::vector<message_t> batch;
+  std::size_t batch_size = 0;
+  std::chrono::steady_clock::time_point batch_deadline;
+
+  const auto flush_batch = [&] {
+    if (batch.empty()) {
+      return;
+    }
+    if (batch.size() == 1) {
+      outgoing.emplace_back(std::move(batch.front()));
+    } else {
+      // each message is prefixed by its uint32 byte-length
+      std::vector<std::uint8_t> payload;
+      payload.reserve(batch_size + batch.size() * sizeof(std::uint32_t));
+      for (const auto& message : batch) {
+        const auto data = get_data(message);
+        const std::uint32_t message_size = data.size();
+        const auto size_pointer = reinterpret_cast<const std::uint8_t*>(&message_size);
+        payload.insert(payload.end(), size_pointer, size_pointer + sizeof(message_size));
+        payload.insert(payload.end(), data.begin(), data.end());
+      }
+      outgoing.emplace_back(BuildMessage(MessageType::kBatchMessage, &payload).Release());
+      transport.RecordBatchSent(batch.size());
+    }
+    if (logger_) {
+      logger_->LogDebug(
+          fmt::format("Packed batch of {} messages to party {}", batch.size(), party_id));
+    }
+    batch.clear();
+    batch_size = 0;
+  };
+
   while (!queue.IsClosedAndEmpty()) {
-    auto tmp_queue = queue.BatchDequeue();
+    const std::size_t maximum_batch_size = maximum_batch_size_;
+    std::optional<std::queue<message_t>> tmp_queue;
+    if (batch.empty()) {
+      tmp_queue = queue.BatchDequeue();
+    } else {
+      // wait for further messages until the batch's time window has passed
+      const auto now = std::chrono::steady_clock::now();
+      if (now < batch_deadline) {
+        tmp_queue = queue.BatchDequeueFor(batch_deadline - now);
+      } else {
+        tmp_queue.emplace();
+      }
+    }
     if (!tmp_queue.has_value()) {
       assert(queue.IsClosed());
       break;
     }
     while (!tmp_queue->empty()) {
       auto& message = tmp_queue->front();
-      if (message.index() == 0) {
-        // std::vector<std::uint8_t>
-        transport.SendMessage(std::get<0>(message));
-      } else if (message.index() == 1) {
-        // std::shared_ptr<const std::vector<std::uint8_t>>
-        transport.SendMessage(*std::get<1>(message));
+      const auto message_size = get_data(message).size();
+      if (maximum_batch_size == 0 || message_size >= maximum_batch_size) {
+        // keep the order of messages
+        flush_batch();
+        outgoing.emplace_back(std::move(message));
+      } else {
+        if (batch_size + message_size > maximum_batch_size) {
+          flush_batch();
+        }
+        if (batch.empty()) {
+          batch_deadline =
+              std::chrono::steady_clock::now() + std::chrono::microseconds(batch_time_window_);
+        }
+        batch_size += message_size;
+        batch.emplace_back(std::move(message));
       }
       tmp_queue->pop();
-      if (logger_) {
-        logger_->LogDebug(fmt::format("Sent message to party {}", party_id));
-      }
     }
+    if (!batch.empty() && std::chrono::steady_clock::now() >= batch_deadline) {
+      flush_batch();
+    }
+    // all messages dequeued at once are written with a single call
+    send_outgoing();
   }
+  flush_batch();
+  send_outgoing();
 
   transport.ShutdownSend();
 
@@ -150,15 +272,14 @@ void CommunicationLayer::CommunicationLayerImplementation::SendTask(std::size_t
 
 void CommunicationLayer::CommunicationLayerImplementation::ReceiveTask(std::size_t party_id) {
   auto& transport = *transports_.at(party_id);
-  auto& handler_map = message_handlers_.at(party_id);
 
   auto my_start_sfuture = start_sfuture_;
   my_start_sfuture.get();
 
   while (continue_communication_) {
-    std::optional<std::vector<std::uint8_t>> raw_message_opt;
+    std::optional<MessageBuffer> raw_message_opt;
     try {
-      raw_message_opt = transport.ReceiveMessage();
+      raw_message_opt = transport.ReceiveMessageBuffer();
     } catch (std::runtime_error& e) {
       if (logger_) {
         logger_->LogError(
@@ -174,60 +295,108 @@ void CommunicationLayer::CommunicationLayerImplementation::ReceiveTask(std::size
       }
       break;
     }
-    auto raw_message = std::move(*raw_message_opt);
+    const bool trace = tracer_ && tracer_->IsEnabled();
+    const auto begin = trace ? Tracer::ClockType::now() : Tracer::TimePoint();
+    const auto number_of_bytes = raw_message_opt->size();
+    const bool continue_receiving = HandleMessage(party_id, std::move(*raw_message_opt));
+    if (trace) {
+      tracer_->Record(TraceCategory::kReceive, party_id, begin, Tracer::ClockType::now(),
+                      number_of_bytes);
+    }
+    if (!continue_receiving) {
+      break;
+    }
+  }
 
-    flatbuffers::Verifier verifier(reinterpret_cast<std::uint8_t*>(raw_message.data()),
-                                   raw_message.size());
-    if (!VerifyMessageBuffer(verifier)) {
-      if (logger_) {
-        logger_->LogError(fmt::format("received corrupt message from party {}", party_id));
-      }
-      auto fallback_handler = fallback_message_handlers_.at(party_id);
-      if (fallback_handler) {
-        fallback_handler->ReceivedMessage(party_id, std::move(raw_message));
-      }
-      continue;
+  if constexpr (kDebug) {
+    if (logger_) {
+      logger_->LogDebug(fmt::format("ReceiveTask finished for party {}", party_id));
+    }
+  }
+}
+
+bool CommunicationLayer::CommunicationLayerImplementation::HandleMessage(
+    std::size_t party_id, MessageBuffer&& raw_message) {
+  auto& handler_map = message_handlers_.at(party_id);
+
+  flatbuffers::Verifier verifier(reinterpret_cast<std::uint8_t*>(raw_message.data()),
+                                 raw_message.size());
+  if (!VerifyMessageBuffer(verifier)) {
+    if (logger_) {
+      logger_->LogError(fmt::format("received corrupt message from party {}", party_id));
     }
+    auto fallback_handler = fallback_message_handlers_.at(party_id);
+    if (fallback_handler) {
+      fallback_handler->ReceivedMessageBuffer(party_id, std::move(raw_message));
+    }
+    return true;
+  }
 
-    // XXX: maybe use a separate thread for this
-    auto message = GetMessage(raw_message.data());
+  // XXX: maybe use a separate thread for this
+  auto message = GetMessage(raw_message.data());
 
-    auto message_type = message->message_type();
+  auto message_type = message->message_type();
+  if constexpr (kDebug) {
+    if (logger_) {
+      logger_->LogDebug(fmt::format("received message of type {} from party {}",
+                                    EnumNameMessageType(message_type), party_id));
+    }
+  }
+  if (message_type == MessageType::kTerminationMessage) {
     if constexpr (kDebug) {
       if (logger_) {
-        logger_->LogDebug(fmt::format("received message of type {} from party {}",
-                                      EnumNameMessageType(message_type), party_id));
+        logger_->LogDebug(fmt::format("received termination message from party {}", party_id));
       }
     }
-    if (message_type == MessageType::kTerminationMessage) {
-      if constexpr (kDebug) {
+    return false;
+  }
+  if (message_type == MessageType::kBatchMessage) {
+    // unpack the batched messages, which are each prefixed by their uint32 byte-length
+    const auto payload = message->payload();
+    const std::uint8_t* data = payload ? payload->data() : nullptr;
+    const std::size_t payload_size = payload ? payload->size() : 0;
+    std::size_t offset = 0;
+    std::size_t number_of_messages = 0;
+    bool continue_communication = true;
+    while (continue_communication && offset + sizeof(std::uint32_t) <= payload_size) {
+      std::uint32_t message_size;
+      std::memcpy(&message_size, data + offset, sizeof(message_size));
+      offset += sizeof(message_size);
+      if (message_size > payload_size - offset) {
         if (logger_) {
-          logger_->LogDebug(fmt::format("received termination message from party {}", party_id));
+          logger_->LogError(fmt::format("received corrupt batch message from party {}", party_id));
         }
+        break;
       }
-      break;
+      // hand out a view of the batch without copying, unless that would break the alignment
+      // which a freshly allocated message buffer guarantees
+      const std::uint8_t* message_data = data + offset;
+      MessageBuffer batched_message =
+          reinterpret_cast<std::uintptr_t>(message_data) % kMessageAlignment == 0
+              ? raw_message.Slice(message_data - raw_message.data(), message_size)
+              : MessageBuffer(std::vector<std::uint8_t>(message_data, message_data + message_size));
+      continue_communication = HandleMessage(party_id, std::move(batched_message));
+      offset += message_size;
+      ++number_of_messages;
     }
-    std::shared_lock lock(message_handlers_mutex_);
-    auto iterator = handler_map.find(message_type);
-    if (iterator != handler_map.end()) {
-      iterator->second->ReceivedMessage(party_id, std::move(raw_message));
-    } else {
-      auto fallback_handler = fallback_message_handlers_.at(party_id);
-      if (fallback_handler) {
-        fallback_handler->ReceivedMessage(party_id, std::move(raw_message));
-      }
-      if (logger_) {
-        logger_->LogError(fmt::format("dropping message of type {} from party {}",
-                                      EnumNameMessageType(message_type), party_id));
-      }
+    transports_.at(party_id)->RecordBatchReceived(number_of_messages);
+    return continue_communication;
+  }
+  std::shared_lock lock(message_handlers_mutex_);
+  auto iterator = handler_map.find(message_type);
+  if (iterator != handler_map.end()) {
+    iterator->second->ReceivedMessageBuffer(party_id, std::move(raw_message));
+  } else {
+    auto fallback_handler = fallback_message_handlers_.at(party_id);
+    if (fallback_handler) {
+      fallback_handler->ReceivedMessageBuffer(party_id, std::move(raw_message));
     }
-  }
-
-  if constexpr (kDebug) {
     if (logger_) {
-      logger_->LogDebug(fmt::format("ReceiveTask finished for party {}", party_id));
+      logger_->LogError(fmt::format("dropping message of type {} from party {}",
+                                    EnumNameMessageType(message_type), party_id));
     }
   }
+  return true;
 }
 
 void CommunicationLayer::CommunicationLayerImplementation::Shutdown() {
@@ -344,10 +513,7 @@ void CommunicationLayer::SendMessage(std::size_t party_id,
 
 void CommunicationLayer::SendMessage(std::size_t party_id,
                                      flatbuffers::FlatBufferBuilder&& message_builder) {
-  auto message_detached = message_builder.Release();
-  auto message_buffer = message_detached.data();
-  SendMessage(party_id,
-              std::vector<std::uint8_t>(message_buffer, message_buffer + message_detached.size()));
+  implementation_->send_queues_.at(party_id).enqueue(message_builder.Release());
 }
 
 void CommunicationLayer::BroadcastMessage(std::vector<std::uint8_t>&& message) {
@@ -379,15 +545,18 @@ void CommunicationLayer::BroadcastMessage(
 }
 
 void CommunicationLayer::BroadcastMessage(flatbuffers::FlatBufferBuilder&& message_builder) {
-  auto message_detached = message_builder.Release();
-  auto message_buffer = message_detached.data();
   if (number_of_parties_ == 2) {
-    SendMessage(1 - my_id_, std::vector<std::uint8_t>(message_buffer,
-                                                      message_buffer + message_detached.size()));
+    SendMessage(1 - my_id_, std::move(message_builder));
     return;
   }
-  BroadcastMessage(std::make_shared<std::vector<std::uint8_t>>(
-      message_buffer, message_buffer + message_detached.size()));
+  const auto message =
+      std::make_shared<const flatbuffers::DetachedBuffer>(message_builder.Release());
+  for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    implementation_->send_queues_.at(party_id).enqueue(message);
+  }
 }
 
 void CommunicationLayer::RegisterMessageHandler(MessageHandlerFunction handler_factory,
@@ -465,6 +634,30 @@ MessageHandler& CommunicationLayer::GetFallbackMessageHandler(std::size_t party_
   return *implementation_->fallback_message_handlers_.at(party_id);
 }
 
+void CommunicationLayer::SetMessageBatching(std::size_t maximum_batch_size,
+                                            std::chrono::microseconds time_window) {
+  if (maximum_batch_size > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::invalid_argument(
+        fmt::format("maximum batch size {} exceeds the maximum message size", maximum_batch_size));
+  }
+  implementation_->maximum_batch_size_ = maximum_batch_size;
+  implementation_->batch_time_window_ = time_window.count();
+}
+
+void CommunicationLayer::SetThreadAffinity(const std::vector<std::size_t>& cpus) {
+  if (cpus.empty()) {
+    return;
+  }
+  std::size_t i = 0;
+  for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    ThreadSetAffinity(implementation_->send_threads_.at(party_id), cpus.at(i++ % cpus.size()));
+    ThreadSetAffinity(implementation_->receive_threads_.at(party_id), cpus.at(i++ % cpus.size()));
+  }
+}
+
 void CommunicationLayer::Shutdown() {
   if (is_shutdown_) {
     return;
@@ -501,6 +694,14 @@ void CommunicationLayer::SetLogger(std::shared_ptr<Logger> logger) {
   implementation_->logger_ = logger;
 }
 
+void CommunicationLayer::SetTracer(std::shared_ptr<Tracer> tracer) {
+  if (is_started_) {
+    throw std::logic_error(
+        "changing the tracer is not allowed after the CommunicationLayer has been started");
+  }
+  implementation_->tracer_ = std::move(tracer);
+}
+
 std::vector<std::unique_ptr<CommunicationLayer>> MakeDummyCommunicationLayers(
     std::size_t number_of_parties) {
   std::vector<std::vector<std::unique_ptr<Transport>>> transports;
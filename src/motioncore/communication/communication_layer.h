@@ -23,6 +23,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -43,6 +44,7 @@
 namespace encrypto::motion {
 
 class Logger;
+class Tracer;
 
 }  // namespace encrypto::motion
 
@@ -97,6 +99,17 @@ class CommunicationLayer {
   void RegisterFallbackMessageHandler(MessageHandlerFunction);
   MessageHandler& GetFallbackMessageHandler(std::size_t party_id);
 
+  // Coalesce messages to the same party into batch messages of at most maximum_batch_size bytes.
+  // A batch is sent once it is full or time_window has passed since its first message was queued,
+  // such that the messages of all gates in a round are sent together.  Messages which are larger
+  // than maximum_batch_size are sent directly.  A maximum_batch_size of 0 disables batching.
+  void SetMessageBatching(std::size_t maximum_batch_size,
+                          std::chrono::microseconds time_window = std::chrono::microseconds(0));
+
+  // Pin the send and receive threads of the channels to the given cpus, the i-th thread to
+  // cpus[i % cpus.size()].
+  void SetThreadAffinity(const std::vector<std::size_t>& cpus);
+
   // shutdown the communication layer
   void Shutdown();
 
@@ -104,6 +117,9 @@ class CommunicationLayer {
 
   void SetLogger(std::shared_ptr<Logger> logger);
 
+  // Record sends and received messages as TraceEvents if tracer is enabled
+  void SetTracer(std::shared_ptr<Tracer> tracer);
+
  private:
   struct CommunicationLayerImplementation;
 
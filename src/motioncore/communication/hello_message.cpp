@@ -34,11 +34,12 @@ flatbuffers::FlatBufferBuilder BuildHelloMessage(uint16_t source_id, uint16_t de
                                                  uint16_t number_of_parties,
                                                  const std::vector<uint8_t>* input_sharing_seed,
                                                  const std::vector<uint8_t>* fixed_key_aes_seed,
-                                                 bool online_after_setup, float motion_version) {
+                                                 bool online_after_setup, float motion_version,
+                                                 const std::vector<uint8_t>* base_ot_cache_id) {
   flatbuffers::FlatBufferBuilder builder_hello_message(256);
   auto hello_message_root = CreateHelloMessageDirect(
       builder_hello_message, source_id, destination_id, number_of_parties, input_sharing_seed,
-      fixed_key_aes_seed, online_after_setup, motion_version);
+      fixed_key_aes_seed, online_after_setup, motion_version, base_ot_cache_id);
   FinishHelloMessageBuffer(builder_hello_message, hello_message_root);
 
   return BuildMessage(MessageType::kHelloMessage, builder_hello_message.GetBufferPointer(),
@@ -77,6 +77,10 @@ std::string to_string(MessageType message_type) {
       return "MessageType::SharedBitsMask"s;
     case MessageType::kSharedBitsReconstruct:
       return "MessageType::SharedBitsReconstruct"s;
+    case MessageType::kBatchMessage:
+      return "MessageType::BatchMessage"s;
+    case MessageType::kSilentOtSender:
+      return "MessageType::SilentOtSender"s;
     default:
       return "Unknown MessageType => update to_string function"s;
   }
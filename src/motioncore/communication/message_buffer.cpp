@@ -0,0 +1,133 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "message_buffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <mutex>
+
+namespace encrypto::motion::communication {
+
+MessageBuffer::MessageBuffer(std::vector<std::uint8_t>&& data)
+    : storage_(std::make_shared<std::vector<std::uint8_t>>(std::move(data))),
+      offset_(0),
+      size_(storage_->size()) {}
+
+MessageBuffer::MessageBuffer(std::shared_ptr<std::vector<std::uint8_t>> storage,
+                             std::size_t offset, std::size_t size)
+    : storage_(std::move(storage)), offset_(offset), size_(size) {
+  assert(size_ == 0 || (storage_ && offset_ + size_ <= storage_->size()));
+}
+
+MessageBuffer MessageBuffer::Slice(std::size_t offset, std::size_t size) const {
+  assert(offset + size <= size_);
+  return MessageBuffer(storage_, offset_ + offset, size);
+}
+
+std::vector<std::uint8_t> MessageBuffer::ReleaseVector() && {
+  std::vector<std::uint8_t> result;
+  if (storage_ && storage_.use_count() == 1 && offset_ == 0) {
+    result = std::move(*storage_);
+    result.resize(size_);
+  } else {
+    result.assign(begin(), end());
+  }
+  storage_.reset();
+  offset_ = size_ = 0;
+  return result;
+}
+
+struct BufferPool::State {
+  std::size_t maximum_number_of_buffers;
+  std::vector<std::vector<std::uint8_t>> free_buffers;
+  std::size_t number_of_allocations = 0;
+  std::size_t number_of_reuses = 0;
+  mutable std::mutex mutex;
+};
+
+BufferPool::BufferPool(std::size_t maximum_number_of_buffers)
+    : state_(std::make_shared<State>()) {
+  state_->maximum_number_of_buffers = maximum_number_of_buffers;
+}
+
+BufferPool::~BufferPool() = default;
+
+MessageBuffer BufferPool::Allocate(std::size_t size) {
+  std::vector<std::uint8_t> buffer;
+  {
+    std::scoped_lock lock(state_->mutex);
+    auto& free_buffers = state_->free_buffers;
+    // prefer the smallest free buffer which is large enough, otherwise grow the largest one
+    auto best = free_buffers.end();
+    for (auto it = free_buffers.begin(); it != free_buffers.end(); ++it) {
+      if (it->capacity() >= size &&
+          (best == free_buffers.end() || it->capacity() < best->capacity())) {
+        best = it;
+      }
+    }
+    if (best == free_buffers.end()) {
+      best = std::max_element(
+          free_buffers.begin(), free_buffers.end(),
+          [](const auto& a, const auto& b) { return a.capacity() < b.capacity(); });
+    }
+    if (best != free_buffers.end()) {
+      std::iter_swap(best, std::prev(free_buffers.end()));
+      buffer = std::move(free_buffers.back());
+      free_buffers.pop_back();
+      if (buffer.capacity() >= size) ++state_->number_of_reuses;
+    }
+    if (buffer.capacity() < size) ++state_->number_of_allocations;
+  }
+  // only the bytes beyond the previous size are initialized
+  buffer.resize(std::max(buffer.size(), size));
+
+  std::weak_ptr<State> weak_state = state_;
+  std::shared_ptr<std::vector<std::uint8_t>> storage(
+      new std::vector<std::uint8_t>(std::move(buffer)),
+      [weak_state](std::vector<std::uint8_t>* released) {
+        if (auto state = weak_state.lock()) {
+          std::scoped_lock lock(state->mutex);
+          if (released->capacity() > 0 &&
+              state->free_buffers.size() < state->maximum_number_of_buffers) {
+            state->free_buffers.emplace_back(std::move(*released));
+          }
+        }
+        delete released;
+      });
+  return MessageBuffer(std::move(storage), 0, size);
+}
+
+std::size_t BufferPool::GetNumberOfAllocations() const {
+  std::scoped_lock lock(state_->mutex);
+  return state_->number_of_allocations;
+}
+
+std::size_t BufferPool::GetNumberOfReuses() const {
+  std::scoped_lock lock(state_->mutex);
+  return state_->number_of_reuses;
+}
+
+}  // namespace encrypto::motion::communication
@@ -0,0 +1,103 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace encrypto::motion::communication {
+
+// Reference-counted view of (a slice of) a received message.
+//
+// Copying a MessageBuffer or taking a slice of it only copies the reference, s.t. a message
+// handler can keep the part of a message it is interested in alive and read it in place.  If the
+// memory was allocated from a BufferPool, it is returned to the pool once the last reference to it
+// is gone.
+class MessageBuffer {
+ public:
+  MessageBuffer() = default;
+
+  // take ownership of data without copying it
+  explicit MessageBuffer(std::vector<std::uint8_t>&& data);
+
+  MessageBuffer(std::shared_ptr<std::vector<std::uint8_t>> storage, std::size_t offset,
+                std::size_t size);
+
+  std::uint8_t* data() noexcept { return storage_ ? storage_->data() + offset_ : nullptr; }
+  const std::uint8_t* data() const noexcept {
+    return storage_ ? storage_->data() + offset_ : nullptr;
+  }
+
+  std::size_t size() const noexcept { return size_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  std::uint8_t* begin() noexcept { return data(); }
+  const std::uint8_t* begin() const noexcept { return data(); }
+  std::uint8_t* end() noexcept { return data() + size_; }
+  const std::uint8_t* end() const noexcept { return data() + size_; }
+
+  // Returns a view of size bytes starting at offset which shares ownership of the memory
+  MessageBuffer Slice(std::size_t offset, std::size_t size) const;
+
+  // Returns the content as a vector.  The memory is moved out of the buffer if this is the only
+  // reference to it and the view starts at its beginning, otherwise it is copied.
+  std::vector<std::uint8_t> ReleaseVector() &&;
+
+ private:
+  std::shared_ptr<std::vector<std::uint8_t>> storage_;
+  std::size_t offset_ = 0;
+  std::size_t size_ = 0;
+};
+
+// Pool of byte buffers for received messages.
+//
+// Allocate hands out MessageBuffers whose memory is recycled once they are no longer referenced.
+// This avoids allocating (and zero-initializing) a new vector for every received message.  The
+// pool may be destroyed while buffers are still alive, which are then freed normally.
+class BufferPool {
+ public:
+  // at most maximum_number_of_buffers unused buffers are kept
+  explicit BufferPool(std::size_t maximum_number_of_buffers = 16);
+  ~BufferPool();
+
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  // Returns a buffer of size bytes with unspecified content
+  MessageBuffer Allocate(std::size_t size);
+
+  std::size_t GetNumberOfAllocations() const;
+  std::size_t GetNumberOfReuses() const;
+
+ private:
+  struct State;
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace encrypto::motion::communication
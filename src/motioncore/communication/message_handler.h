@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "message_buffer.h"
 #include "utility/synchronized_queue.h"
 
 namespace encrypto::motion::communication {
@@ -46,6 +47,13 @@ class MessageHandler {
   // This method may be called concurrently with different values of party_id.
   // The client is responsible for the necessary synchronization.
   virtual void ReceivedMessage(std::size_t party_id, std::vector<std::uint8_t>&& message) = 0;
+
+  // Variant of the above which is actually called by the CommunicationLayer.  Handlers can
+  // override it to keep (slices of) the network buffer alive and read payloads in place.  The
+  // default implementation forwards the message as a vector, which avoids a copy if possible.
+  virtual void ReceivedMessageBuffer(std::size_t party_id, MessageBuffer&& message) {
+    ReceivedMessage(party_id, std::move(message).ReleaseVector());
+  }
 };
 
 // Example message handler which puts received messages into a queue
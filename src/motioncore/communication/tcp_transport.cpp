@@ -114,6 +114,35 @@ void TcpTransport::SendMessage(const std::vector<std::uint8_t>& message) {
   statistics_.number_of_messages_sent += 1;
 }
 
+void TcpTransport::SendMessages(const std::vector<std::span<const std::uint8_t>>& messages) {
+  std::vector<std::array<std::uint8_t, sizeof(std::uint32_t)>> message_sizes(messages.size());
+  std::vector<boost::asio::const_buffer> buffers;
+  buffers.reserve(2 * messages.size());
+  std::size_t number_of_bytes = 0;
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    const auto message = messages[i];
+    if (message.size() > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::runtime_error(fmt::format("Max message size is {} B but tried to send {} B",
+                                           std::numeric_limits<std::uint32_t>::max(),
+                                           message.size()));
+    }
+    u32tou8(message.size(), message_sizes[i].data());
+    buffers.emplace_back(boost::asio::buffer(message_sizes[i]));
+    buffers.emplace_back(boost::asio::buffer(message.data(), message.size()));
+    number_of_bytes += message.size() + sizeof(std::uint32_t);
+  }
+
+  boost::system::error_code ec;
+  std::shared_lock lock(implementation_->socket_mutex_);
+  // the buffers are gathered into as few writev/sendmsg calls as possible
+  boost::asio::write(implementation_->socket_, buffers, boost::asio::transfer_all(), ec);
+  if (ec) {
+    throw std::runtime_error(fmt::format("Error while writing to socket: {}", ec.message()));
+  }
+  statistics_.number_of_bytes_sent += number_of_bytes;
+  statistics_.number_of_messages_sent += messages.size();
+}
+
 static std::uint32_t u8tou32(std::array<std::uint8_t, sizeof(std::uint32_t)>& v) {
   std::uint32_t result = 0;
   for (auto i = 0u; i < sizeof(std::uint32_t); ++i) {
@@ -122,10 +151,9 @@ static std::uint32_t u8tou32(std::array<std::uint8_t, sizeof(std::uint32_t)>& v)
   return result;
 }
 
-std::optional<std::vector<std::uint8_t>> TcpTransport::ReceiveMessage() {
+std::optional<std::uint32_t> TcpTransport::ReceiveMessageSize() {
   std::array<std::uint8_t, sizeof(std::uint32_t)> message_size_buffer;
   boost::system::error_code ec;
-  std::shared_lock lock(implementation_->socket_mutex_);
   implementation_->socket_.wait(tcp::socket::wait_read, ec);
   if (ec) {
     throw std::runtime_error(
@@ -141,15 +169,44 @@ std::optional<std::vector<std::uint8_t>> TcpTransport::ReceiveMessage() {
     throw std::runtime_error(fmt::format("Error while reading message size from socket: {} ({})",
                                          ec.message(), ec.value()));
   }
-  std::uint32_t message_size = u8tou32(message_size_buffer);
-  std::vector<std::uint8_t> message_buffer(message_size);
+  return u8tou32(message_size_buffer);
+}
+
+std::optional<std::vector<std::uint8_t>> TcpTransport::ReceiveMessage() {
+  std::shared_lock lock(implementation_->socket_mutex_);
+  const auto message_size = ReceiveMessageSize();
+  if (!message_size.has_value()) {
+    return std::nullopt;
+  }
+  std::vector<std::uint8_t> message_buffer(*message_size);
+  boost::system::error_code ec;
   boost::asio::read(implementation_->socket_, boost::asio::buffer(message_buffer),
                     boost::asio::transfer_exactly(message_buffer.size()), ec);
   if (ec) {
     throw std::runtime_error(
         fmt::format("Error while reading message size socket: {} ({})", ec.message(), ec.value()));
   }
-  statistics_.number_of_bytes_received += message_size + sizeof(uint32_t);
+  statistics_.number_of_bytes_received += *message_size + sizeof(uint32_t);
+  statistics_.number_of_messages_received += 1;
+  return message_buffer;
+}
+
+std::optional<MessageBuffer> TcpTransport::ReceiveMessageBuffer() {
+  std::shared_lock lock(implementation_->socket_mutex_);
+  const auto message_size = ReceiveMessageSize();
+  if (!message_size.has_value()) {
+    return std::nullopt;
+  }
+  auto message_buffer = buffer_pool_.Allocate(*message_size);
+  boost::system::error_code ec;
+  boost::asio::read(implementation_->socket_,
+                    boost::asio::buffer(message_buffer.data(), message_buffer.size()),
+                    boost::asio::transfer_exactly(message_buffer.size()), ec);
+  if (ec) {
+    throw std::runtime_error(
+        fmt::format("Error while reading message size socket: {} ({})", ec.message(), ec.value()));
+  }
+  statistics_.number_of_bytes_received += *message_size + sizeof(uint32_t);
   statistics_.number_of_messages_received += 1;
   return message_buffer;
 }
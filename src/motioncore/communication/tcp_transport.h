@@ -47,14 +47,22 @@ class TcpTransport : public Transport {
 
   void SendMessage(std::vector<std::uint8_t>&& message) override;
   void SendMessage(const std::vector<std::uint8_t>& message) override;
+  // writes all messages with their size prefixes using scatter/gather I/O
+  void SendMessages(const std::vector<std::span<const std::uint8_t>>& messages) override;
 
   bool Available() const override;
   std::optional<std::vector<std::uint8_t>> ReceiveMessage() override;
+  // reads the message into a buffer from a pool of receive buffers
+  std::optional<MessageBuffer> ReceiveMessageBuffer() override;
   void ShutdownSend() override;
   void Shutdown() override;
 
  private:
+  // reads the size of the next message, returns std::nullopt if the connection was closed
+  std::optional<std::uint32_t> ReceiveMessageSize();
+
   bool is_connected_;
+  BufferPool buffer_pool_;
   std::unique_ptr<detail::TcpTransportImplementation> implementation_;
 };
 
@@ -24,6 +24,20 @@
 
 namespace encrypto::motion::communication {
 
+void Transport::SendMessages(const std::vector<std::span<const std::uint8_t>>& messages) {
+  for (const auto message : messages) {
+    SendMessage(std::vector<std::uint8_t>(message.begin(), message.end()));
+  }
+}
+
+std::optional<MessageBuffer> Transport::ReceiveMessageBuffer() {
+  auto message = ReceiveMessage();
+  if (!message.has_value()) {
+    return std::nullopt;
+  }
+  return MessageBuffer(std::move(*message));
+}
+
 const TransportStatistics& Transport::GetStatistics() const { return statistics_; }
 
 void Transport::ResetStatistics() {
@@ -31,6 +45,20 @@ void Transport::ResetStatistics() {
   statistics_.number_of_messages_received = 0;
   statistics_.number_of_bytes_sent = 0;
   statistics_.number_of_bytes_received = 0;
+  statistics_.number_of_batches_sent = 0;
+  statistics_.number_of_batched_messages_sent = 0;
+  statistics_.number_of_batches_received = 0;
+  statistics_.number_of_batched_messages_received = 0;
+}
+
+void Transport::RecordBatchSent(std::size_t number_of_messages) {
+  ++statistics_.number_of_batches_sent;
+  statistics_.number_of_batched_messages_sent += number_of_messages;
+}
+
+void Transport::RecordBatchReceived(std::size_t number_of_messages) {
+  ++statistics_.number_of_batches_received;
+  statistics_.number_of_batched_messages_received += number_of_messages;
 }
 
 }  // namespace encrypto::motion::communication
@@ -24,9 +24,12 @@
 
 #include <cstddef>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
+#include "message_buffer.h"
+
 namespace encrypto::motion::communication {
 
 struct TransportStatistics {
@@ -34,6 +37,12 @@ struct TransportStatistics {
   std::size_t number_of_messages_received = 0;
   std::size_t number_of_bytes_sent = 0;
   std::size_t number_of_bytes_received = 0;
+  // messages packed into batches by the CommunicationLayer, i.e., the batching factor is
+  // number_of_batched_messages_sent / number_of_batches_sent
+  std::size_t number_of_batches_sent = 0;
+  std::size_t number_of_batched_messages_sent = 0;
+  std::size_t number_of_batches_received = 0;
+  std::size_t number_of_batched_messages_received = 0;
 };
 
 // underlying transport between two parties
@@ -51,12 +60,21 @@ class Transport {
   virtual void SendMessage(std::vector<std::uint8_t>&& message) = 0;
   virtual void SendMessage(const std::vector<std::uint8_t>& message) = 0;
 
+  // send several messages at once, they are received as separate messages in the same order
+  // transports may override this to write all messages with a single system call, the default
+  // sends each message separately
+  virtual void SendMessages(const std::vector<std::span<const std::uint8_t>>& messages);
+
   // check if a new message is available
   virtual bool Available() const = 0;
 
   // receive message, possibly blocking
   virtual std::optional<std::vector<std::uint8_t>> ReceiveMessage() = 0;
 
+  // receive message into a reference-counted buffer, possibly blocking
+  // transports may override this to read into pooled buffers, the default wraps ReceiveMessage
+  virtual std::optional<MessageBuffer> ReceiveMessageBuffer();
+
   // shutdown the outgoing part of the transport to signal end of communication
   virtual void ShutdownSend() = 0;
 
@@ -66,6 +84,10 @@ class Transport {
   const TransportStatistics& GetStatistics() const;
   void ResetStatistics();
 
+  // account for a batch of messages sent/received over this transport
+  void RecordBatchSent(std::size_t number_of_messages);
+  void RecordBatchReceived(std::size_t number_of_messages);
+
  protected:
   TransportStatistics statistics_;
 };
@@ -24,7 +24,10 @@
 
 #include "ot_extension_data.h"
 
+#include <cassert>
+#include <string_view>
 #include <thread>
+#include <type_traits>
 
 #include "utility/block.h"
 #include "utility/condition.h"
@@ -44,6 +47,33 @@ OtExtensionSenderData::OtExtensionSenderData() {
   for (std::size_t i = 0; i < u_promises.size(); ++i) u_futures[i] = u_promises[i].get_future();
 }
 
+OtExtensionSenderData::Batch::Batch(std::size_t number_of_ots)
+    : number_of_ots(number_of_ots),
+      received_corrections_condition(
+          std::make_unique<FiberCondition>([this]() { return received_corrections.load(); })) {}
+
+void OtExtensionSenderData::RegisterBatch(std::size_t ot_id, std::size_t number_of_ots) {
+  if (batches.size() <= ot_id) {
+    batches.resize(ot_id + 1);
+  }
+  batches[ot_id] = std::make_unique<Batch>(number_of_ots);
+}
+
+void OtExtensionSenderData::WaitForCorrections(std::size_t ot_id) const {
+  batches.at(ot_id)->received_corrections_condition->Wait();
+}
+
+template <typename T>
+static void SetSenderMessage(OtExtensionReceiverData::SenderMessagePromise& sender_message_promise,
+                             const std::uint8_t* message,
+                             [[maybe_unused]] std::size_t message_size) {
+  const auto size = sender_message_promise.size;
+  assert(size * sizeof(T) == message_size);
+  auto message_pointer = reinterpret_cast<const T*>(message);
+  std::get<ReusableFiberPromise<std::vector<T>>>(sender_message_promise.promise)
+      .set_value(std::vector(message_pointer, message_pointer + size));
+}
+
 void OtExtensionData::MessageReceived(const std::uint8_t* message,
                                       [[maybe_unused]] std::size_t message_size,
                                       const OtExtensionDataType type, const std::size_t i) {
@@ -62,116 +92,75 @@ void OtExtensionData::MessageReceived(const std::uint8_t* message,
       break;
     }
     case OtExtensionDataType::kReceptionCorrection: {
-      auto condition = sender_data.received_correction_offsets_condition.find(i);
-      assert(condition != sender_data.received_correction_offsets_condition.end());
+      assert(i < sender_data.batches.size() && sender_data.batches[i]);
+      auto& batch = *sender_data.batches[i];
       {
-        std::scoped_lock lock(condition->second->GetMutex(), sender_data.corrections_mutex);
-        auto number_of_ots = sender_data.number_of_ots_in_batch.find(i);
-        assert(number_of_ots != sender_data.number_of_ots_in_batch.end());
-        BitVector<> local_corrections(message, number_of_ots->second);
-        sender_data.corrections.Copy(i, i + number_of_ots->second, local_corrections);
-        sender_data.received_correction_offsets.emplace(i);
+        std::scoped_lock lock(sender_data.corrections_mutex);
+        BitVector<> local_corrections(message, batch.number_of_ots);
+        sender_data.corrections.Copy(i, i + batch.number_of_ots, local_corrections);
       }
-      condition->second->NotifyAll();
+      {
+        std::scoped_lock lock(batch.received_corrections_condition->GetMutex());
+        batch.received_corrections = true;
+      }
+      batch.received_corrections_condition->NotifyAll();
       break;
     }
     case OtExtensionDataType::kSendMessage: {
-      {
-        receiver_data.setup_finished_condition->Wait();
-
-        auto message_type = receiver_data.message_type.find(i);
-        if (message_type != receiver_data.message_type.end()) {
-          switch (message_type->second) {
-            case OtMessageType::kBlock128: {
-              auto promise_iterator = receiver_data.message_promises_block128.find(i);
-              assert(promise_iterator != receiver_data.message_promises_block128.end());
-              auto& [size, promise] = promise_iterator->second;
-              assert(size * 16 == message_size);
-              promise.set_value(Block128Vector(size, message));
-              return;
-            } break;
-            case OtMessageType::kBit: {
-              auto promise_iterator = receiver_data.message_promises_bit.find(i);
-              assert(promise_iterator != receiver_data.message_promises_bit.end());
-              auto& [size, promise] = promise_iterator->second;
-              assert((size + 7) / 8 == message_size);
-              promise.set_value(BitVector<>(message, size));
-              return;
-            } break;
-            case OtMessageType::kGenericBoolean: {
-              auto promise_iterator = receiver_data.message_promises_generic.find(i);
-              assert(promise_iterator != receiver_data.message_promises_generic.end());
-              auto& [vector_size, bitlength, promise] = promise_iterator->second;
-              assert((vector_size * bitlength + 7) / 8 == message_size);
-              BitSpan bit_span(const_cast<std::uint8_t*>(message), vector_size * bitlength);
-              std::vector<BitVector<>> result;
-              result.reserve(vector_size);
-              for (std::size_t i = 0; i < vector_size; ++i) {
-                result.emplace_back(bit_span.Subset(i * bitlength, (i + 1) * bitlength));
-              }
-              promise.set_value(std::move(result));
-              return;
-            } break;
-            case OtMessageType::kUint8: {
-              constexpr auto type_c = boost::hana::type_c<std::uint8_t>;
-              auto& promise_map = receiver_data.message_promises_int[type_c];
-              auto promise_iterator = promise_map.find(i);
-              assert(promise_iterator != promise_map.end());
-              auto& [size, promise] = promise_iterator->second;
-              assert(size * sizeof(decltype(type_c)::type) == message_size);
-              auto message_pointer = reinterpret_cast<const decltype(type_c)::type*>(message);
-              promise.set_value(std::vector(message_pointer, message_pointer + size));
-              return;
-            } break;
-            case OtMessageType::kUint16: {
-              constexpr auto type_c = boost::hana::type_c<std::uint16_t>;
-              auto& promise_map = receiver_data.message_promises_int[type_c];
-              auto promise_iterator = promise_map.find(i);
-              assert(promise_iterator != promise_map.end());
-              auto& [size, promise] = promise_iterator->second;
-              assert(size * sizeof(decltype(type_c)::type) == message_size);
-              auto message_pointer = reinterpret_cast<const decltype(type_c)::type*>(message);
-              promise.set_value(std::vector(message_pointer, message_pointer + size));
-              return;
-            } break;
-            case OtMessageType::kUint32: {
-              constexpr auto type_c = boost::hana::type_c<std::uint32_t>;
-              auto& promise_map = receiver_data.message_promises_int[type_c];
-              auto promise_iterator = promise_map.find(i);
-              assert(promise_iterator != promise_map.end());
-              auto& [size, promise] = promise_iterator->second;
-              assert(size * sizeof(decltype(type_c)::type) == message_size);
-              auto message_pointer = reinterpret_cast<const decltype(type_c)::type*>(message);
-              promise.set_value(std::vector(message_pointer, message_pointer + size));
-              return;
-            } break;
-            case OtMessageType::kUint64: {
-              constexpr auto type_c = boost::hana::type_c<std::uint64_t>;
-              auto& promise_map = receiver_data.message_promises_int[type_c];
-              auto promise_iterator = promise_map.find(i);
-              assert(promise_iterator != promise_map.end());
-              auto& [size, promise] = promise_iterator->second;
-              assert(size * sizeof(decltype(type_c)::type) == message_size);
-              auto message_pointer = reinterpret_cast<const decltype(type_c)::type*>(message);
-              promise.set_value(std::vector(message_pointer, message_pointer + size));
-              return;
-            } break;
-            case OtMessageType::kUint128: {
-              constexpr auto type_c = boost::hana::type_c<__uint128_t>;
-              auto& promise_map = receiver_data.message_promises_int[type_c];
-              auto promise_iterator = promise_map.find(i);
-              assert(promise_iterator != promise_map.end());
-              auto& [size, promise] = promise_iterator->second;
-              assert(size * sizeof(decltype(type_c)::type) == message_size);
-              auto message_pointer = reinterpret_cast<const decltype(type_c)::type*>(message);
-              promise.set_value(std::vector(message_pointer, message_pointer + size));
-              return;
-            } break;
+      receiver_data.setup_finished_condition->Wait();
+
+      if (i >= receiver_data.sender_message_promises.size() ||
+          !receiver_data.sender_message_promises[i]) {
+        break;
+      }
+      auto& sender_message_promise = *receiver_data.sender_message_promises[i];
+      const auto size = sender_message_promise.size;
+      switch (sender_message_promise.type) {
+        case OtMessageType::kBlock128: {
+          assert(size * 16 == message_size);
+          std::get<ReusableFiberPromise<Block128Vector>>(sender_message_promise.promise)
+              .set_value(Block128Vector(size, message));
+        } break;
+        case OtMessageType::kBit: {
+          assert((size + 7) / 8 == message_size);
+          std::get<ReusableFiberPromise<BitVector<>>>(sender_message_promise.promise)
+              .set_value(BitVector<>(message, size));
+        } break;
+        case OtMessageType::kGenericBoolean: {
+          const auto bitlength = sender_message_promise.bitlength;
+          assert((size * bitlength + 7) / 8 == message_size);
+          BitSpan bit_span(const_cast<std::uint8_t*>(message), size * bitlength);
+          std::vector<BitVector<>> result;
+          result.reserve(size);
+          for (std::size_t j = 0; j < size; ++j) {
+            result.emplace_back(bit_span.Subset(j * bitlength, (j + 1) * bitlength));
           }
-        }
+          std::get<ReusableFiberPromise<std::vector<BitVector<>>>>(sender_message_promise.promise)
+              .set_value(std::move(result));
+        } break;
+        case OtMessageType::kUint8: {
+          SetSenderMessage<std::uint8_t>(sender_message_promise, message, message_size);
+        } break;
+        case OtMessageType::kUint16: {
+          SetSenderMessage<std::uint16_t>(sender_message_promise, message, message_size);
+        } break;
+        case OtMessageType::kUint32: {
+          SetSenderMessage<std::uint32_t>(sender_message_promise, message, message_size);
+        } break;
+        case OtMessageType::kUint64: {
+          SetSenderMessage<std::uint64_t>(sender_message_promise, message, message_size);
+        } break;
+        case OtMessageType::kUint128: {
+          SetSenderMessage<__uint128_t>(sender_message_promise, message, message_size);
+        } break;
       }
       break;
     }
+    case OtExtensionDataType::kSilentOtSenderMessage: {
+      receiver_data.silent_ot_sender_messages.enqueue(
+          std::vector<std::uint8_t>(message, message + message_size));
+      break;
+    }
     default: {
       throw std::runtime_error(fmt::format(
           "DataStorage::OtExtensionDataType: unknown data type {}; data_type must be <{}", type,
@@ -180,58 +169,66 @@ void OtExtensionData::MessageReceived(const std::uint8_t* message,
   }
 }
 
-ReusableFiberFuture<Block128Vector> OtExtensionReceiverData::RegisterForBlock128SenderMessage(
-    std::size_t ot_id, std::size_t size) {
-  ReusableFiberPromise<Block128Vector> promise;
-  auto future = promise.get_future();
-  auto [it, success] =
-      message_promises_block128.emplace(ot_id, std::make_pair(size, std::move(promise)));
-  if (!success) {
-    throw std::runtime_error(
-        fmt::format("tried to register twice for Block128SenderMessage for OT#{}", ot_id));
+// register a promise of type ReusableFiberPromise<T> for the sender message of the batch starting
+// at ot_id
+template <typename T>
+static ReusableFiberFuture<T> RegisterForSenderMessage(
+    std::vector<std::unique_ptr<OtExtensionReceiverData::SenderMessagePromise>>&
+        sender_message_promises,
+    std::size_t ot_id, OtMessageType type, std::size_t size, std::size_t bitlength,
+    std::string_view name) {
+  if (sender_message_promises.size() <= ot_id) {
+    sender_message_promises.resize(ot_id + 1);
+  } else if (sender_message_promises[ot_id]) {
+    throw std::runtime_error(fmt::format("tried to register twice for {} for OT#{}", name, ot_id));
   }
+  ReusableFiberPromise<T> promise;
+  auto future = promise.get_future();
+  sender_message_promises[ot_id] = std::make_unique<OtExtensionReceiverData::SenderMessagePromise>(
+      type, size, bitlength, std::move(promise));
   return future;
 }
 
+ReusableFiberFuture<Block128Vector> OtExtensionReceiverData::RegisterForBlock128SenderMessage(
+    std::size_t ot_id, std::size_t size) {
+  return RegisterForSenderMessage<Block128Vector>(sender_message_promises, ot_id,
+                                                  OtMessageType::kBlock128, size, 0,
+                                                  "Block128SenderMessage");
+}
+
 ReusableFiberFuture<BitVector<>> OtExtensionReceiverData::RegisterForBitSenderMessage(
     std::size_t ot_id, std::size_t size) {
-  ReusableFiberPromise<BitVector<>> promise;
-  auto future = promise.get_future();
-  auto [it, success] =
-      message_promises_bit.emplace(ot_id, std::make_pair(size, std::move(promise)));
-  if (!success) {
-    throw std::runtime_error(
-        fmt::format("tried to register twice for BitSenderMessage for OT#{}", ot_id));
-  }
-  return future;
+  return RegisterForSenderMessage<BitVector<>>(sender_message_promises, ot_id, OtMessageType::kBit,
+                                               size, 0, "BitSenderMessage");
 }
 
 ReusableFiberFuture<std::vector<BitVector<>>>
 OtExtensionReceiverData::RegisterForGenericSenderMessage(std::size_t ot_id, std::size_t size,
                                                          std::size_t bitlength) {
-  ReusableFiberPromise<std::vector<BitVector<>>> promise;
-  auto future = promise.get_future();
-  auto [it, success] =
-      message_promises_generic.emplace(ot_id, std::make_tuple(size, bitlength, std::move(promise)));
-  if (!success) {
-    throw std::runtime_error(
-        fmt::format("tried to register twice for GenericSenderMessage for OT#{}", ot_id));
-  }
-  return future;
+  return RegisterForSenderMessage<std::vector<BitVector<>>>(
+      sender_message_promises, ot_id, OtMessageType::kGenericBoolean, size, bitlength,
+      "GenericSenderMessage");
 }
 
 template <typename T>
 ReusableFiberFuture<std::vector<T>> OtExtensionReceiverData::RegisterForIntSenderMessage(
     std::size_t ot_id, std::size_t size) {
-  ReusableFiberPromise<std::vector<T>> promise;
-  auto future = promise.get_future();
-  auto [it, success] = message_promises_int[boost::hana::type_c<T>].emplace(
-      ot_id, std::make_pair(size, std::move(promise)));
-  if (!success) {
-    throw std::runtime_error(
-        fmt::format("tried to register twice for IntSenderMessage for OT#{}", ot_id));
-  }
-  return future;
+  constexpr auto kType = [] {
+    if constexpr (std::is_same_v<T, std::uint8_t>) {
+      return OtMessageType::kUint8;
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+      return OtMessageType::kUint16;
+    } else if constexpr (std::is_same_v<T, std::uint32_t>) {
+      return OtMessageType::kUint32;
+    } else if constexpr (std::is_same_v<T, std::uint64_t>) {
+      return OtMessageType::kUint64;
+    } else {
+      static_assert(std::is_same_v<T, __uint128_t>);
+      return OtMessageType::kUint128;
+    }
+  }();
+  return RegisterForSenderMessage<std::vector<T>>(sender_message_promises, ot_id, kType, size, 0,
+                                                  "IntSenderMessage");
 }
 
 template ReusableFiberFuture<std::vector<std::uint8_t>>
@@ -30,15 +30,14 @@
 #include <memory>
 #include <mutex>
 #include <queue>
-#include <unordered_map>
-#include <unordered_set>
+#include <variant>
 #include <vector>
 
 #include "utility/bit_matrix.h"
 #include "utility/bit_vector.h"
 #include "utility/block.h"
-#include "utility/meta.hpp"
 #include "utility/reusable_future.h"
+#include "utility/synchronized_queue.h"
 
 namespace encrypto::motion {
 
@@ -48,7 +47,8 @@ enum OtExtensionDataType : unsigned int {
   kReceptionMask = 0,
   kReceptionCorrection = 1,
   kSendMessage = 2,
-  kOtExtensionInvalidDataType = 3
+  kSilentOtSenderMessage = 3,
+  kOtExtensionInvalidDataType = 4
 };
 
 enum class OtMessageType {
@@ -80,47 +80,37 @@ struct OtExtensionReceiverData {
   // XXX: can't we delete this after setup?
   std::shared_ptr<BitMatrix> T;
 
-  // if many OTs are received in batches, it is not necessary to store all of the flags
-  // for received messages but only for the first OT id in the batch. Thus, use a hash table.
-  std::unordered_set<std::size_t> received_outputs;
   std::vector<BitVector<>> outputs;
-  std::unordered_map<std::size_t, std::unique_ptr<FiberCondition>> output_conditions;
-  std::mutex received_outputs_mutex;
 
   // bit length of every OT
   std::vector<std::size_t> bitlengths;
 
-  // store the message types of new-style OTs
-  std::unordered_map<std::size_t, OtMessageType> message_type;
-
-  // Promises for the sender messages
-  // ot_id -> (vector size, vector promise)
-  std::unordered_map<std::size_t, std::pair<std::size_t, ReusableFiberPromise<BitVector<>>>>
-      message_promises_bit;
-  std::unordered_map<std::size_t, std::pair<std::size_t, ReusableFiberPromise<Block128Vector>>>
-      message_promises_block128;
-
-  // Promises for the generic sender messages
-  // ot_id -> (vector size, length of each bitvector, vector promise)
-  std::unordered_map<std::size_t, std::tuple<std::size_t, std::size_t,
-                                             ReusableFiberPromise<std::vector<BitVector<>>>>>
-      message_promises_generic;
-
-  template <typename T>
-  using PromiseMapType =
-      std::unordered_map<std::size_t, std::pair<std::size_t, ReusableFiberPromise<std::vector<T>>>>;
-  TypeMap<PromiseMapType, std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, __uint128_t>
-      message_promises_int;
-
-  // have we already set the choices for this OT batch?
-  std::unordered_set<std::size_t> set_real_choices;
-  std::mutex real_choices_mutex;
+  // promise for the sender message of a batch of new-style OTs
+  struct SenderMessagePromise {
+    OtMessageType type;
+    // number of OTs, or of integers for integer OTs
+    std::size_t size;
+    // length of each bit vector of generic Boolean OTs, 0 otherwise
+    std::size_t bitlength;
+    std::variant<ReusableFiberPromise<std::vector<BitVector<>>>, ReusableFiberPromise<BitVector<>>,
+                 ReusableFiberPromise<Block128Vector>,
+                 ReusableFiberPromise<std::vector<std::uint8_t>>,
+                 ReusableFiberPromise<std::vector<std::uint16_t>>,
+                 ReusableFiberPromise<std::vector<std::uint32_t>>,
+                 ReusableFiberPromise<std::vector<std::uint64_t>>,
+                 ReusableFiberPromise<std::vector<__uint128_t>>>
+        promise;
+  };
+
+  // OT ids are assigned consecutively, so the promises are indexed by the id of the first OT of
+  // their batch and the other ids stay empty
+  std::vector<std::unique_ptr<SenderMessagePromise>> sender_message_promises;
 
   // random choices from OT precomputation
   std::unique_ptr<AlignedBitVector> random_choices;
 
-  // how many ots are in each batch?
-  std::unordered_map<std::size_t, std::size_t> number_of_ots_in_batch;
+  // messages of the silent OT extension sender, one per LPN instance and in order
+  SynchronizedQueue<std::vector<std::uint8_t>> silent_ot_sender_messages;
 
   // flag and condition variable: is setup is done?
   std::unique_ptr<FiberCondition> setup_finished_condition;
@@ -148,15 +138,30 @@ struct OtExtensionSenderData {
   // XXX: can't we delete this after setup?
   std::shared_ptr<BitMatrix> V;
 
-  // offset, number_of_ots
-  std::unordered_map<std::size_t, std::size_t> number_of_ots_in_batch;
+  // a batch of OTs which waits for the receiver's corrections
+  struct Batch {
+    Batch(std::size_t number_of_ots);
+
+    std::size_t number_of_ots;
+    // set once the corrections of the batch were received, reset by Clear()
+    std::atomic<bool> received_corrections{false};
+    std::unique_ptr<FiberCondition> received_corrections_condition;
+  };
+
+  // register the batch of number_of_ots OTs starting at ot_id
+  void RegisterBatch(std::size_t ot_id, std::size_t number_of_ots);
+
+  // block until the receiver's corrections for the batch starting at ot_id were received
+  void WaitForCorrections(std::size_t ot_id) const;
+
+  // OT ids are assigned consecutively, so the batches are indexed by the id of their first OT and
+  // the other ids stay empty
+  std::vector<std::unique_ptr<Batch>> batches;
 
   // corrections for GOTs, i.e., if random choice bit is not the real choice bit
   // send 1 to flip the messages before encoding or 0 otherwise for each GOT
-  std::unordered_set<std::size_t> received_correction_offsets;
-  std::unordered_map<std::size_t, std::unique_ptr<FiberCondition>>
-      received_correction_offsets_condition;
   BitVector<> corrections;
+  // batches may share bytes of corrections, so it is only accessed under this lock
   mutable std::mutex corrections_mutex;
 
   // random sender outputs
@@ -22,19 +22,147 @@
 
 #include "gate_executor.h"
 
+#include <fmt/format.h>
+#include <algorithm>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
 #include "base/register.h"
 #include "protocols/gate.h"
 #include "statistics/run_time_statistics.h"
+#include "statistics/trace.h"
+#include "utility/fiber_condition.h"
 #include "utility/fiber_thread_pool/fiber_thread_pool.hpp"
 #include "utility/logger.h"
 
 namespace encrypto::motion {
 
+// Evaluates function on every gate of the layer in a separate fiber and blocks
+// until all of them are finished.
+template <typename F>
+static void EvaluateLayer(FiberThreadPool& fiber_pool, const std::vector<GatePointer>& layer,
+                          F function) {
+  std::size_t number_of_remaining_gates = layer.size();
+  FiberCondition layer_done_condition(
+      [&number_of_remaining_gates] { return number_of_remaining_gates == 0; });
+
+  for (auto& gate : layer) {
+    fiber_pool.post([&, gate_pointer = gate.get()] {
+      function(*gate_pointer);
+      // notify while holding the lock, since the condition lives on the
+      // waiting thread's stack and is destroyed as soon as Wait() returns
+      std::scoped_lock lock(layer_done_condition.GetMutex());
+      --number_of_remaining_gates;
+      layer_done_condition.NotifyAll();
+    });
+  }
+
+  layer_done_condition.Wait();
+}
+
+namespace {
+
+// Bounds the number of gates whose fibers are alive at the same time.  Gates are admitted in
+// registration order, which is a topological order of the circuit, so all parents of the oldest
+// live gate are evaluated, and it can finish and make room for the next gate.  The only gates
+// which wait for a later gate are enclosed gates, e.g., the output gates that open the masked
+// values of a multiplication or the BMR input gates of an arithmetic GMW to BMR conversion.  The
+// enclosing gate is registered after them, possibly behind further gates depending on the
+// enclosed gates, such as the BMR addition circuit of the conversion.  Hence, all gates from an
+// enclosed gate up to its enclosing gate are admitted as one group.
+class GateAdmission {
+ public:
+  // 0 for no limit
+  GateAdmission(std::size_t maximum_number_of_gates, const std::vector<GatePointer>& gates)
+      : maximum_number_of_gates_(maximum_number_of_gates) {
+    if (maximum_number_of_gates_ == 0) return;
+    for (const auto& gate : gates) {
+      if (gate && gate->GetEnclosingGate()) {
+        enclosing_gate_positions_.emplace(gate->GetEnclosingGate(), 0);
+      }
+    }
+    for (std::size_t position = 0; position < gates.size(); ++position) {
+      auto iterator = enclosing_gate_positions_.find(gates[position].get());
+      if (iterator != enclosing_gate_positions_.end()) iterator->second = position;
+    }
+  }
+
+  // blocks until the gate at position in the registered gates may be posted to the pool
+  void Admit(std::size_t position, const Gate& gate) {
+    if (maximum_number_of_gates_ == 0) return;
+    std::unique_lock lock(mutex_);
+    // only the first gate of a group waits for room
+    const bool is_in_group = group_end_ && position <= *group_end_;
+    if (!is_in_group) {
+      condition_.wait(lock, [this] { return number_of_gates_ < maximum_number_of_gates_; });
+    }
+    if (const auto enclosing_gate = gate.GetEnclosingGate(); enclosing_gate != nullptr) {
+      const auto enclosing_gate_position = enclosing_gate_positions_.at(enclosing_gate);
+      group_end_ = is_in_group ? std::max(*group_end_, enclosing_gate_position)
+                               : enclosing_gate_position;
+    }
+    ++number_of_gates_;
+  }
+
+  // called by an admitted gate when it is finished
+  void Release() {
+    if (maximum_number_of_gates_ == 0) return;
+    {
+      std::scoped_lock lock(mutex_);
+      --number_of_gates_;
+    }
+    condition_.notify_one();
+  }
+
+ private:
+  const std::size_t maximum_number_of_gates_;
+  std::size_t number_of_gates_ = 0;
+  // enclosing gate -> its position in the registered gates
+  std::unordered_map<const Gate*, std::size_t> enclosing_gate_positions_;
+  // position of the last gate of the current group
+  std::optional<std::size_t> group_end_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+
+}  // namespace
+
 GateExecutor::GateExecutor(Register& reg, std::function<void(void)> preprocessing_function,
-                           std::shared_ptr<Logger> logger)
+                           std::shared_ptr<Logger> logger, std::shared_ptr<Tracer> tracer)
     : register_(reg),
       preprocessing_function_(std::move(preprocessing_function)),
-      logger_(std::move(logger)) {}
+      logger_(std::move(logger)),
+      tracer_(std::move(tracer)) {}
+
+void GateExecutor::SetThreads(std::size_t number_of_threads, bool pin_threads) {
+  number_of_threads_ = number_of_threads;
+  pin_threads_ = pin_threads;
+}
+
+void GateExecutor::SetFibers(std::size_t maximum_number_of_fibers, std::size_t stack_size) {
+  maximum_number_of_fibers_ = maximum_number_of_fibers;
+  fiber_stack_size_ = stack_size;
+}
+
+void GateExecutor::RecordFiberStatistics(const FiberThreadPool& fiber_pool,
+                                         RunTimeStatistics& statistics) {
+  statistics.peak_number_of_fibers = fiber_pool.get_peak_number_of_fibers();
+  statistics.peak_fiber_stack_memory =
+      fiber_pool.get_peak_number_of_fibers() * fiber_pool.get_stack_size();
+}
+
+void GateExecutor::EvaluateSetup(Gate& gate) {
+  GateTraceScope trace_scope(tracer_.get(), TraceCategory::kGateSetup, gate.GetId());
+  gate.EvaluateSetup();
+}
+
+void GateExecutor::EvaluateOnline(Gate& gate) {
+  GateTraceScope trace_scope(tracer_.get(), TraceCategory::kGateOnline, gate.GetId());
+  gate.EvaluateOnline();
+}
 
 void GateExecutor::EvaluateSetupOnline(RunTimeStatistics& statistics) {
   statistics.RecordStart<RunTimeStatistics::StatisticsId::kEvaluate>();
@@ -46,20 +174,25 @@ void GateExecutor::EvaluateSetupOnline(RunTimeStatistics& statistics) {
         "Start evaluating the circuit gates sequentially (online after all finished setup)");
   }
 
-  // create a pool with std::thread::hardware_concurrency() no. of threads
-  // to execute fibers
-  FiberThreadPool fiber_pool(0, 2 * register_.GetTotalNumberOfGates());
+  // create a pool with the configured no. of threads to execute fibers
+  FiberThreadPool fiber_pool(number_of_threads_, 2 * register_.GetTotalNumberOfGates(), true,
+                             pin_threads_, fiber_stack_size_);
+  auto& gates = register_.GetGates();
+  GateAdmission setup_admission(maximum_number_of_fibers_, gates);
 
   // ------------------------------ setup phase ------------------------------
   statistics.RecordStart<RunTimeStatistics::StatisticsId::kGatesSetup>();
 
   // Evaluate the setup phase of all the gates
-  for (auto& gate : register_.GetGates()) {
+  for (std::size_t position = 0; position < gates.size(); ++position) {
+    auto& gate = gates[position];
     if (gate->NeedsSetup()) {
+      setup_admission.Admit(position, *gate);
       fiber_pool.post([&] {
-        gate->EvaluateSetup();
+        EvaluateSetup(*gate);
         gate->SetSetupIsReady();
         register_.IncrementEvaluatedGatesSetupCounter();
+        setup_admission.Release();
       });
     } else {
       // cannot be done earlier because output wires did not yet exist
@@ -77,16 +210,23 @@ void GateExecutor::EvaluateSetupOnline(RunTimeStatistics& statistics) {
   statistics.RecordStart<RunTimeStatistics::StatisticsId::kGatesOnline>();
 
   // Evaluate the online phase of all the gates
-  for (auto& gate : register_.GetGates()) {
+  GateAdmission online_admission(maximum_number_of_fibers_, gates);
+  for (std::size_t position = 0; position < gates.size(); ++position) {
+    auto& gate = gates[position];
     if (gate->NeedsOnline()) {
-      fiber_pool.post([&] {
-        gate->EvaluateOnline();
+      online_admission.Admit(position, *gate);
+      fiber_pool.post([&, position] {
+        EvaluateOnline(*gate);
         gate->SetOnlineIsReady();
         register_.IncrementEvaluatedGatesOnlineCounter();
+        register_.ReleaseEvaluatedGate(position);
+        online_admission.Release();
       });
     } else {
       // cannot be done earlier because output wires did not yet exist
       gate->SetOnlineIsReady();
+      // the setup phase, if any, is finished, so the gate is evaluated
+      register_.ReleaseEvaluatedGate(position);
     }
   }
 
@@ -99,6 +239,7 @@ void GateExecutor::EvaluateSetupOnline(RunTimeStatistics& statistics) {
   // --------------------------------------------------------------------------
 
   fiber_pool.join();
+  RecordFiberStatistics(fiber_pool, statistics);
 
   // XXX: since we never pop elements from the active queue, clear it manually for now
   // otherwise there will be complains that it is not empty upon repeated execution
@@ -117,31 +258,38 @@ void GateExecutor::Evaluate(RunTimeStatistics& statistics) {
   // Run preprocessing setup in a separate thread
   auto preprocessing_future = std::async(std::launch::async, [this] { preprocessing_function_(); });
 
-  // create a pool with std::thread::hardware_concurrency() no. of threads
-  // to execute fibers
-  FiberThreadPool fiber_pool(0, register_.GetTotalNumberOfGates());
+  // create a pool with the configured no. of threads to execute fibers
+  FiberThreadPool fiber_pool(number_of_threads_, register_.GetTotalNumberOfGates(), true,
+                             pin_threads_, fiber_stack_size_);
+  auto& gates = register_.GetGates();
+  GateAdmission admission(maximum_number_of_fibers_, gates);
 
   // Evaluate all the gates
-  for (auto& gate : register_.GetGates()) {
+  for (std::size_t position = 0; position < gates.size(); ++position) {
+    auto& gate = gates[position];
     if (gate->NeedsSetup() || gate->NeedsOnline()) {
-      fiber_pool.post([&] {
-        gate->EvaluateSetup();
+      admission.Admit(position, *gate);
+      fiber_pool.post([&, position] {
+        EvaluateSetup(*gate);
         gate->SetSetupIsReady();
         if (gate->NeedsSetup()) {
           register_.IncrementEvaluatedGatesSetupCounter();
         }
 
         // XXX: maybe insert a 'yield' here?
-        gate->EvaluateOnline();
+        EvaluateOnline(*gate);
         gate->SetOnlineIsReady();
         if (gate->NeedsOnline()) {
           register_.IncrementEvaluatedGatesOnlineCounter();
         }
+        register_.ReleaseEvaluatedGate(position);
+        admission.Release();
       });
     } else {
       // cannot be done earlier because output wires did not yet exist
       gate->SetSetupIsReady();
       gate->SetOnlineIsReady();
+      register_.ReleaseEvaluatedGate(position);
     }
   }
 
@@ -151,6 +299,135 @@ void GateExecutor::Evaluate(RunTimeStatistics& statistics) {
   register_.CheckOnlineCondition();
   register_.GetGatesOnlineDoneCondition()->Wait();
   fiber_pool.join();
+  RecordFiberStatistics(fiber_pool, statistics);
+
+  // XXX: since we never pop elements from the active queue, clear it manually for now
+  // otherwise there will be complains that it is not empty upon repeated execution
+  // -> maybe remove the active queue in the future
+  register_.ClearActiveQueue();
+
+  statistics.RecordEnd<RunTimeStatistics::StatisticsId::kEvaluate>();
+}
+
+void GateExecutor::EvaluateLayered(RunTimeStatistics& statistics, bool online_after_setup) {
+  statistics.RecordStart<RunTimeStatistics::StatisticsId::kEvaluate>();
+
+  // Run preprocessing setup in a separate thread if the online phase does not
+  // need to wait for it anyway
+  std::future<void> preprocessing_future;
+  if (online_after_setup) {
+    preprocessing_function_();
+  } else {
+    preprocessing_future = std::async(std::launch::async, [this] { preprocessing_function_(); });
+  }
+
+  const auto& layers = register_.GetGateLayers();
+  std::size_t maximum_layer_width = 0;
+  for (const auto& layer : layers) {
+    maximum_layer_width = std::max(maximum_layer_width, layer.size());
+  }
+
+  if (logger_) {
+    logger_->LogInfo(fmt::format(
+        "Start evaluating the circuit gates layer by layer ({} layers, at most {} gates per layer)",
+        layers.size(), maximum_layer_width));
+  }
+
+  // create a pool with the configured no. of threads to execute fibers, at
+  // most one layer of gates is alive at any time
+  FiberThreadPool fiber_pool(number_of_threads_, maximum_layer_width, true, pin_threads_,
+                             fiber_stack_size_);
+
+  // gates without any work can be marked ready immediately, they are not
+  // posted to the pool
+  auto needs_evaluation = [online_after_setup](const GatePointer& gate) {
+    return online_after_setup ? gate->NeedsSetup() : gate->NeedsSetup() || gate->NeedsOnline();
+  };
+  std::vector<GatePointer> active_gates;
+  active_gates.reserve(maximum_layer_width);
+
+  if (online_after_setup) {
+    // ------------------------------ setup phase ------------------------------
+    statistics.RecordStart<RunTimeStatistics::StatisticsId::kGatesSetup>();
+
+    for (const auto& layer : layers) {
+      active_gates.clear();
+      for (const auto& gate : layer) {
+        if (needs_evaluation(gate)) {
+          active_gates.push_back(gate);
+        } else {
+          gate->SetSetupIsReady();
+        }
+      }
+      EvaluateLayer(fiber_pool, active_gates, [this](Gate& gate) {
+        EvaluateSetup(gate);
+        gate.SetSetupIsReady();
+        register_.IncrementEvaluatedGatesSetupCounter();
+      });
+    }
+
+    register_.CheckSetupCondition();
+    register_.GetGatesSetupDoneCondition()->Wait();
+
+    statistics.RecordEnd<RunTimeStatistics::StatisticsId::kGatesSetup>();
+
+    // ------------------------------ online phase ------------------------------
+    statistics.RecordStart<RunTimeStatistics::StatisticsId::kGatesOnline>();
+
+    for (const auto& layer : layers) {
+      active_gates.clear();
+      for (const auto& gate : layer) {
+        if (gate->NeedsOnline()) {
+          active_gates.push_back(gate);
+        } else {
+          gate->SetOnlineIsReady();
+        }
+      }
+      EvaluateLayer(fiber_pool, active_gates, [this](Gate& gate) {
+        EvaluateOnline(gate);
+        gate.SetOnlineIsReady();
+        register_.IncrementEvaluatedGatesOnlineCounter();
+      });
+    }
+
+    register_.CheckOnlineCondition();
+    register_.GetGatesOnlineDoneCondition()->Wait();
+
+    statistics.RecordEnd<RunTimeStatistics::StatisticsId::kGatesOnline>();
+  } else {
+    for (const auto& layer : layers) {
+      active_gates.clear();
+      for (const auto& gate : layer) {
+        if (needs_evaluation(gate)) {
+          active_gates.push_back(gate);
+        } else {
+          gate->SetSetupIsReady();
+          gate->SetOnlineIsReady();
+        }
+      }
+      EvaluateLayer(fiber_pool, active_gates, [this](Gate& gate) {
+        EvaluateSetup(gate);
+        gate.SetSetupIsReady();
+        if (gate.NeedsSetup()) {
+          register_.IncrementEvaluatedGatesSetupCounter();
+        }
+
+        EvaluateOnline(gate);
+        gate.SetOnlineIsReady();
+        if (gate.NeedsOnline()) {
+          register_.IncrementEvaluatedGatesOnlineCounter();
+        }
+      });
+    }
+
+    preprocessing_future.get();
+
+    register_.CheckOnlineCondition();
+    register_.GetGatesOnlineDoneCondition()->Wait();
+  }
+
+  fiber_pool.join();
+  RecordFiberStatistics(fiber_pool, statistics);
 
   // XXX: since we never pop elements from the active queue, clear it manually for now
   // otherwise there will be complains that it is not empty upon repeated execution
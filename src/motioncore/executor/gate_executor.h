@@ -29,24 +29,53 @@ namespace encrypto::motion {
 
 struct RunTimeStatistics;
 
+class FiberThreadPool;
 class Logger;
+class Gate;
 class Register;
+class Tracer;
 
 // Evaluates all registered gates.
 class GateExecutor {
  public:
-  GateExecutor(Register&, std::function<void()> preprocessing_function, std::shared_ptr<Logger>);
+  // If tracer is given and enabled, the setup and online phase of each gate is recorded.
+  GateExecutor(Register&, std::function<void()> preprocessing_function, std::shared_ptr<Logger>,
+               std::shared_ptr<Tracer> tracer = nullptr);
 
   // Run the setup phases first for all gates before starting with the online
   // phases.
   void EvaluateSetupOnline(RunTimeStatistics& statistics);
   // Run setup and online phase of each gate as soon as possible.
   void Evaluate(RunTimeStatistics& statistics);
+  // Evaluate the circuit layer by layer: only the gates of the current layer
+  // are posted to the worker pool, so all interactive gates of a layer send
+  // their messages in the same communication round.  If online_after_setup is
+  // set, the setup phases of all layers are run before the online phases.
+  void EvaluateLayered(RunTimeStatistics& statistics, bool online_after_setup);
+
+  // Set the number of worker threads of the fiber pool, 0 for
+  // std::thread::hardware_concurrency(), and whether they are pinned to cpus.
+  void SetThreads(std::size_t number_of_threads, bool pin_threads);
+
+  // Bound the number of gates whose fibers are alive at the same time in
+  // Evaluate and EvaluateSetupOnline, 0 for no limit, and set the size of the
+  // fibers' stacks, 0 for kFiberStackSize.
+  void SetFibers(std::size_t maximum_number_of_fibers, std::size_t stack_size);
 
  private:
   Register& register_;
   std::function<void()> preprocessing_function_;
   std::shared_ptr<Logger> logger_;
+  std::shared_ptr<Tracer> tracer_;
+  std::size_t number_of_threads_ = 0;
+  bool pin_threads_ = false;
+  std::size_t maximum_number_of_fibers_ = 0;
+  std::size_t fiber_stack_size_ = 0;
+
+  void EvaluateSetup(Gate& gate);
+  void EvaluateOnline(Gate& gate);
+  static void RecordFiberStatistics(const FiberThreadPool& fiber_pool,
+                                    RunTimeStatistics& statistics);
 };
 
 }  // namespace encrypto::motion
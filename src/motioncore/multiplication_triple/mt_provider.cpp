@@ -34,7 +34,13 @@ namespace encrypto::motion {
 bool MtProvider::NeedMts() const noexcept {
   return 0 < (GetNumberOfMts<bool>() + GetNumberOfMts<std::uint8_t>() +
               GetNumberOfMts<std::uint16_t>() + GetNumberOfMts<std::uint32_t>() +
-              GetNumberOfMts<std::uint64_t>());
+              GetNumberOfMts<std::uint64_t>()) ||
+         NeedMatrixMts();
+}
+
+bool MtProvider::NeedMatrixMts() const noexcept {
+  return std::apply([](const auto&... matrix_mts) { return (!matrix_mts.empty() || ...); },
+                    matrix_mts_);
 }
 
 std::size_t MtProvider::RequestBinaryMts(const std::size_t number_of_mts) noexcept {
@@ -166,6 +172,16 @@ static void GenerateRandomTriples(IntegerMtVector<T>& mts, std::size_t number_of
   }
 }
 
+template <typename T>
+static void GenerateRandomMatrixTriples(std::vector<MatrixMtVector<T>>& matrix_mts) {
+  for (auto& mt : matrix_mts) {
+    mt.a = RandomVector<T>(mt.rows * mt.inner);
+    mt.b = RandomVector<T>(mt.inner * mt.columns);
+    mt.c.assign(mt.rows * mt.columns, 0);
+    MatrixMultiplyAdd<T>(mt.a, mt.b, mt.c, mt.rows, mt.inner, mt.columns);
+  }
+}
+
 static void RegisterHelperBool(OtProvider& ot_provider, std::unique_ptr<XcOtBitSender>& ots_sender,
                                std::unique_ptr<XcOtBitReceiver>& ots_receiver,
                                const BinaryMtVector& bit_mts, std::size_t number_of_bit_mts) {
@@ -215,6 +231,47 @@ static void RegisterHelper(OtProvider& ot_provider,
   }
 }
 
+// The cross term a_i * b_j of party i's a and party j's b is computed row by row: for each entry
+// a_i[row][l] and each of its bits, party j inputs the row b_j[l] shifted by the bit position as
+// vector correlation of an AC-OT and party i uses the bit as choice.
+template <typename T>
+static void RegisterMatrixHelper(OtProvider& ot_provider,
+                                 std::list<std::unique_ptr<AcOtSender<T>>>& ots_sender,
+                                 std::list<std::unique_ptr<AcOtReceiver<T>>>& ots_receiver,
+                                 const std::vector<MatrixMtVector<T>>& matrix_mts) {
+  constexpr std::size_t bit_size = sizeof(T) * 8;
+
+  for (const auto& mt : matrix_mts) {
+    const auto number_of_ots = mt.rows * mt.inner * bit_size;
+    auto ot_to_send = ot_provider.template RegisterSendAcOt<T>(number_of_ots, mt.columns);
+    std::vector<T> vector_to_send;
+    vector_to_send.reserve(number_of_ots * mt.columns);
+    for (std::size_t row = 0; row < mt.rows; ++row) {
+      for (std::size_t l = 0; l < mt.inner; ++l) {
+        for (auto bit_i = 0u; bit_i < bit_size; ++bit_i) {
+          for (std::size_t column = 0; column < mt.columns; ++column) {
+            vector_to_send.emplace_back(mt.b[l * mt.columns + column] << bit_i);
+          }
+        }
+      }
+    }
+    ot_to_send->SetCorrelations(std::move(vector_to_send));
+
+    auto ot_to_receive = ot_provider.template RegisterReceiveAcOt<T>(number_of_ots, mt.columns);
+    BitVector<> choices;
+    choices.Reserve(number_of_ots);
+    for (const T a_value : mt.a) {
+      for (auto bit_i = 0u; bit_i < bit_size; ++bit_i) {
+        choices.Append(((a_value >> bit_i) & 1u) == 1);
+      }
+    }
+    ot_to_receive->SetChoices(std::move(choices));
+
+    ots_sender.emplace_back(std::move(ot_to_send));
+    ots_receiver.emplace_back(std::move(ot_to_receive));
+  }
+}
+
 void MtProviderFromOts::RegisterOts() {
   if (number_of_bit_mts_ > 0) {
     GenerateRandomTriplesBool(bit_mts_, number_of_bit_mts_);
@@ -223,6 +280,10 @@ void MtProviderFromOts::RegisterOts() {
   GenerateRandomTriples<std::uint16_t>(mts16_, number_of_mts_16_);
   GenerateRandomTriples<std::uint32_t>(mts32_, number_of_mts_32_);
   GenerateRandomTriples<std::uint64_t>(mts64_, number_of_mts_64_);
+  GenerateRandomMatrixTriples(std::get<0>(matrix_mts_));
+  GenerateRandomMatrixTriples(std::get<1>(matrix_mts_));
+  GenerateRandomMatrixTriples(std::get<2>(matrix_mts_));
+  GenerateRandomMatrixTriples(std::get<3>(matrix_mts_));
 
   for (auto i = 0ull; i < number_of_parties_; ++i) {
     if (i == my_id_) {
@@ -240,6 +301,15 @@ void MtProviderFromOts::RegisterOts() {
                                   ots_receiver_32_.at(i), kMaxBatchSize, mts32_, number_of_mts_32_);
     RegisterHelper<std::uint64_t>(*ot_providers_.at(i), ots_sender_64_.at(i),
                                   ots_receiver_64_.at(i), kMaxBatchSize, mts64_, number_of_mts_64_);
+
+    RegisterMatrixHelper<std::uint8_t>(*ot_providers_.at(i), ots_sender_8_.at(i),
+                                       ots_receiver_8_.at(i), std::get<0>(matrix_mts_));
+    RegisterMatrixHelper<std::uint16_t>(*ot_providers_.at(i), ots_sender_16_.at(i),
+                                        ots_receiver_16_.at(i), std::get<1>(matrix_mts_));
+    RegisterMatrixHelper<std::uint32_t>(*ot_providers_.at(i), ots_sender_32_.at(i),
+                                        ots_receiver_32_.at(i), std::get<2>(matrix_mts_));
+    RegisterMatrixHelper<std::uint64_t>(*ot_providers_.at(i), ots_sender_64_.at(i),
+                                        ots_receiver_64_.at(i), std::get<3>(matrix_mts_));
   }
 }
 
@@ -281,6 +351,35 @@ static void ParseHelper(std::list<std::unique_ptr<AcOtSender<T>>>& ots_sender,
   }
 }
 
+template <typename T>
+static void ParseMatrixHelper(std::list<std::unique_ptr<AcOtSender<T>>>& ots_sender,
+                              std::list<std::unique_ptr<AcOtReceiver<T>>>& ots_receiver,
+                              std::vector<MatrixMtVector<T>>& matrix_mts) {
+  constexpr std::size_t bit_size = sizeof(T) * 8;
+
+  for (auto& mt : matrix_mts) {
+    const auto& ot_to_send = ots_sender.front();
+    const auto& ot_to_receive = ots_receiver.front();
+    ot_to_send->ComputeOutputs();
+    const auto& output_sender = ot_to_send->GetOutputs();
+    ot_to_receive->ComputeOutputs();
+    const auto& output_receiver = ot_to_receive->GetOutputs();
+    for (std::size_t row = 0; row < mt.rows; ++row) {
+      T* c_row = mt.c.data() + row * mt.columns;
+      for (std::size_t ot_i = row * mt.inner * bit_size; ot_i < (row + 1) * mt.inner * bit_size;
+           ++ot_i) {
+        const T* received = output_receiver.data() + ot_i * mt.columns;
+        const T* sent = output_sender.data() + ot_i * mt.columns;
+        for (std::size_t column = 0; column < mt.columns; ++column) {
+          c_row[column] += received[column] - sent[column];
+        }
+      }
+    }
+    ots_sender.pop_front();
+    ots_receiver.pop_front();
+  }
+}
+
 void MtProviderFromOts::ParseOutputs() {
   for (auto i = 0ull; i < number_of_parties_; ++i) {
     if (i == my_id_) {
@@ -298,6 +397,15 @@ void MtProviderFromOts::ParseOutputs() {
                                number_of_mts_32_);
     ParseHelper<std::uint64_t>(ots_sender_64_.at(i), ots_receiver_64_.at(i), kMaxBatchSize, mts64_,
                                number_of_mts_64_);
+
+    ParseMatrixHelper<std::uint8_t>(ots_sender_8_.at(i), ots_receiver_8_.at(i),
+                                    std::get<0>(matrix_mts_));
+    ParseMatrixHelper<std::uint16_t>(ots_sender_16_.at(i), ots_receiver_16_.at(i),
+                                     std::get<1>(matrix_mts_));
+    ParseMatrixHelper<std::uint32_t>(ots_sender_32_.at(i), ots_receiver_32_.at(i),
+                                     std::get<2>(matrix_mts_));
+    ParseMatrixHelper<std::uint64_t>(ots_sender_64_.at(i), ots_receiver_64_.at(i),
+                                     std::get<3>(matrix_mts_));
   }
 }
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <list>
+#include <tuple>
 
 #include "oblivious_transfer/ot_flavors.h"
 #include "utility/bit_vector.h"
@@ -45,6 +46,13 @@ struct BinaryMtVector {
   BitVector<> a, b, c;  // c[i] = a[i] ^ b[i]
 };
 
+// c = a * b for the row-major matrices a (rows x inner), b (inner x columns) and c (rows x columns)
+template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+struct MatrixMtVector {
+  std::size_t rows, inner, columns;
+  std::vector<T> a, b, c;
+};
+
 class MtProvider {
  public:
   virtual ~MtProvider() = default;
@@ -70,6 +78,25 @@ class MtProvider {
 
   std::size_t RequestBinaryMts(const std::size_t number_of_mts) noexcept;
 
+  bool NeedMatrixMts() const noexcept;
+
+  /// \brief Requests a single matrix MT for the product of a rows x inner and an inner x columns
+  /// matrix. Its generation costs rows * inner * bitlength OTs with (columns * bitlength)-bit
+  /// messages per pair of parties.
+  /// \return the id of the matrix MT to be passed to GetMatrixMt
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  std::size_t RequestMatrixMt(std::size_t rows, std::size_t inner, std::size_t columns) {
+    auto& matrix_mts = std::get<std::vector<MatrixMtVector<T>>>(matrix_mts_);
+    matrix_mts.push_back({rows, inner, columns, {}, {}, {}});
+    return matrix_mts.size() - 1;
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  const MatrixMtVector<T>& GetMatrixMt(std::size_t matrix_mt_id) const {
+    WaitFinished();
+    return std::get<std::vector<MatrixMtVector<T>>>(matrix_mts_).at(matrix_mt_id);
+  }
+
   template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
   std::size_t RequestArithmeticMts(const std::size_t number_of_mts) noexcept {
     std::size_t offset;
@@ -131,6 +158,10 @@ class MtProvider {
   virtual void PreSetup() = 0;
   virtual void Setup() = 0;
 
+  // Prepares a repeated evaluation of the same circuit.  Providers that hand out fresh MTs in
+  // every Setup() reset their finished flag, s.t. the gates wait for the fresh MTs.
+  virtual void Clear() {}
+
   // blocking wait
   void WaitFinished() const { finished_condition_->Wait(); }
 
@@ -148,6 +179,10 @@ class MtProvider {
   IntegerMtVector<std::uint32_t> mts32_;
   IntegerMtVector<std::uint64_t> mts64_;
 
+  std::tuple<std::vector<MatrixMtVector<std::uint8_t>>, std::vector<MatrixMtVector<std::uint16_t>>,
+             std::vector<MatrixMtVector<std::uint32_t>>, std::vector<MatrixMtVector<std::uint64_t>>>
+      matrix_mts_;
+
   const std::size_t my_id_;
   const std::size_t number_of_parties_;
 
@@ -187,6 +222,7 @@ class MtProviderFromOts final : public MtProvider {
   std::vector<std::unique_ptr<OtProvider>>& ot_providers_;
 
   // use alternating party roles for load balancing
+  // the OTs for matrix MTs are appended to the lists after the ones for the MTs of the same type
   std::vector<std::list<std::unique_ptr<AcOtReceiver<std::uint8_t>>>> ots_receiver_8_;
   std::vector<std::list<std::unique_ptr<AcOtSender<std::uint8_t>>>> ots_sender_8_;
 
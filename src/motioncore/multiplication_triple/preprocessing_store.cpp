@@ -0,0 +1,464 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "preprocessing_store.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "statistics/run_time_statistics.h"
+#include "utility/constants.h"
+#include "utility/logger.h"
+
+namespace encrypto::motion {
+
+namespace {
+
+using Section = PreprocessingStore::Section;
+
+constexpr std::size_t kNumberOfSections = static_cast<std::size_t>(Section::kNumberOfSections);
+
+// columns are aligned to cache lines
+constexpr std::size_t kColumnAlignment = 64;
+
+struct SectionLayout {
+  std::size_t element_bit_size;
+  std::size_t number_of_columns;
+};
+
+constexpr std::array<SectionLayout, kNumberOfSections> kSectionLayouts = {{
+    // MTs consist of the columns a, b, c
+    {1, 3}, {8, 3}, {16, 3}, {32, 3}, {64, 3},
+    // SPs consist of the columns a, c
+    {8, 2}, {16, 2}, {32, 2}, {64, 2},
+    // SBs consist of the shared bits
+    {8, 1}, {16, 1}, {32, 1}, {64, 1},
+}};
+
+constexpr std::size_t RoundUp(std::size_t value, std::size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+std::size_t ColumnSize(Section section, std::size_t number_of_elements) {
+  const auto& layout = kSectionLayouts.at(static_cast<std::size_t>(section));
+  return RoundUp((number_of_elements * layout.element_bit_size + 7) / 8, kColumnAlignment);
+}
+
+}  // namespace
+
+struct PreprocessingStore::Header {
+  struct SectionEntry {
+    std::uint64_t offset;
+    std::uint64_t number_of_elements;
+    std::uint64_t number_of_consumed_elements;
+  };
+
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t number_of_sections;
+  std::uint64_t my_id;
+  std::uint64_t number_of_parties;
+  std::array<SectionEntry, kNumberOfSections> sections;
+};
+
+PreprocessingStore::PreprocessingStore(const std::string& path, std::size_t my_id,
+                                       std::size_t number_of_parties)
+    : path_(path) {
+  file_descriptor_ = open(path_.c_str(), O_RDWR);
+  if (file_descriptor_ < 0) {
+    throw std::runtime_error(
+        fmt::format("could not open preprocessing store {}: {}", path_, std::strerror(errno)));
+  }
+  struct stat file_status;
+  if (fstat(file_descriptor_, &file_status) != 0 ||
+      static_cast<std::size_t>(file_status.st_size) < sizeof(Header)) {
+    close(file_descriptor_);
+    throw std::runtime_error(fmt::format("preprocessing store {} is truncated", path_));
+  }
+  size_ = file_status.st_size;
+  void* mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor_, 0);
+  if (mapping == MAP_FAILED) {
+    close(file_descriptor_);
+    throw std::runtime_error(
+        fmt::format("could not map preprocessing store {}: {}", path_, std::strerror(errno)));
+  }
+  data_ = static_cast<std::byte*>(mapping);
+
+  const auto& header = GetHeader();
+  std::string error;
+  if (header.magic != kMagic) {
+    error = "is not a preprocessing store";
+  } else if (header.version != kVersion) {
+    error = fmt::format("has version {}, but version {} is required", header.version, kVersion);
+  } else if (header.number_of_sections != kNumberOfSections) {
+    error = fmt::format("has {} sections, but {} sections are required", header.number_of_sections,
+                        kNumberOfSections);
+  } else if (header.my_id != my_id || header.number_of_parties != number_of_parties) {
+    error = fmt::format("belongs to party {} of {}, but is used by party {} of {}", header.my_id,
+                        header.number_of_parties, my_id, number_of_parties);
+  } else {
+    for (std::size_t i = 0; i < kNumberOfSections; ++i) {
+      const auto& entry = header.sections.at(i);
+      const auto section_size = kSectionLayouts.at(i).number_of_columns *
+                                ColumnSize(static_cast<Section>(i), entry.number_of_elements);
+      if (entry.offset + section_size > size_ ||
+          entry.number_of_consumed_elements > entry.number_of_elements) {
+        error = "is corrupt";
+        break;
+      }
+    }
+  }
+  if (!error.empty()) {
+    munmap(data_, size_);
+    close(file_descriptor_);
+    throw std::runtime_error(fmt::format("preprocessing store {} {}", path_, error));
+  }
+}
+
+PreprocessingStore::~PreprocessingStore() {
+  msync(data_, sizeof(Header), MS_SYNC);
+  munmap(data_, size_);
+  close(file_descriptor_);
+}
+
+PreprocessingStore::Header& PreprocessingStore::GetHeader() const {
+  return *reinterpret_cast<Header*>(data_);
+}
+
+template <typename T>
+static void WriteColumn(std::ofstream& file, const T* data, Section section,
+                        std::size_t number_of_elements) {
+  const auto number_of_bytes = section == Section::kBinaryMts ? (number_of_elements + 7) / 8
+                                                              : number_of_elements * sizeof(T);
+  file.write(reinterpret_cast<const char*>(data), number_of_bytes);
+  const std::vector<char> padding(ColumnSize(section, number_of_elements) - number_of_bytes, 0);
+  file.write(padding.data(), padding.size());
+}
+
+template <typename T>
+static void CheckNumberOfElements(const std::vector<T>& elements, std::size_t number_of_elements) {
+  if (elements.size() < number_of_elements) {
+    throw std::logic_error(fmt::format("cannot store {} elements, only {} were precomputed",
+                                       number_of_elements, elements.size()));
+  }
+}
+
+void PreprocessingStore::Write(const std::string& path, std::size_t my_id,
+                               std::size_t number_of_parties, const PreprocessingDemand& demand,
+                               MtProvider& mt_provider, SpProvider& sp_provider,
+                               SbProvider& sb_provider) {
+  const std::array<std::size_t, kNumberOfSections> numbers_of_elements = {
+      demand.number_of_binary_mts, demand.number_of_mts_8, demand.number_of_mts_16,
+      demand.number_of_mts_32,     demand.number_of_mts_64, demand.number_of_sps_8,
+      demand.number_of_sps_16,     demand.number_of_sps_32, demand.number_of_sps_64,
+      demand.number_of_sbs_8,      demand.number_of_sbs_16, demand.number_of_sbs_32,
+      demand.number_of_sbs_64};
+
+  Header header{};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.number_of_sections = kNumberOfSections;
+  header.my_id = my_id;
+  header.number_of_parties = number_of_parties;
+  std::size_t offset = RoundUp(sizeof(Header), kColumnAlignment);
+  for (std::size_t i = 0; i < kNumberOfSections; ++i) {
+    header.sections.at(i) = {offset, numbers_of_elements.at(i), 0};
+    offset += kSectionLayouts.at(i).number_of_columns *
+              ColumnSize(static_cast<Section>(i), numbers_of_elements.at(i));
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error(fmt::format("could not create preprocessing store {}", path));
+  }
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  const std::vector<char> padding(RoundUp(sizeof(Header), kColumnAlignment) - sizeof(Header), 0);
+  file.write(padding.data(), padding.size());
+
+  // the sections have to be written in the order of the Section enum
+  const auto write_mts = [&file](const auto& mts, Section section, std::size_t n) {
+    CheckNumberOfElements(mts.a, n);
+    WriteColumn(file, mts.a.data(), section, n);
+    WriteColumn(file, mts.b.data(), section, n);
+    WriteColumn(file, mts.c.data(), section, n);
+  };
+  const auto write_sps = [&file](const auto& sps, Section section, std::size_t n) {
+    CheckNumberOfElements(sps.a, n);
+    WriteColumn(file, sps.a.data(), section, n);
+    WriteColumn(file, sps.c.data(), section, n);
+  };
+  const auto write_sbs = [&file](const auto& sbs, Section section, std::size_t n) {
+    CheckNumberOfElements(sbs, n);
+    WriteColumn(file, sbs.data(), section, n);
+  };
+
+  const auto& binary_mts = mt_provider.GetBinaryAll();
+  if (binary_mts.a.GetSize() < demand.number_of_binary_mts) {
+    throw std::logic_error(fmt::format("cannot store {} binary MTs, only {} were precomputed",
+                                       demand.number_of_binary_mts, binary_mts.a.GetSize()));
+  }
+  WriteColumn(file, binary_mts.a.GetData().data(), Section::kBinaryMts,
+              demand.number_of_binary_mts);
+  WriteColumn(file, binary_mts.b.GetData().data(), Section::kBinaryMts,
+              demand.number_of_binary_mts);
+  WriteColumn(file, binary_mts.c.GetData().data(), Section::kBinaryMts,
+              demand.number_of_binary_mts);
+  write_mts(mt_provider.GetIntegerAll<std::uint8_t>(), Section::kMts8, demand.number_of_mts_8);
+  write_mts(mt_provider.GetIntegerAll<std::uint16_t>(), Section::kMts16, demand.number_of_mts_16);
+  write_mts(mt_provider.GetIntegerAll<std::uint32_t>(), Section::kMts32, demand.number_of_mts_32);
+  write_mts(mt_provider.GetIntegerAll<std::uint64_t>(), Section::kMts64, demand.number_of_mts_64);
+  write_sps(sp_provider.GetSpsAll<std::uint8_t>(), Section::kSps8, demand.number_of_sps_8);
+  write_sps(sp_provider.GetSpsAll<std::uint16_t>(), Section::kSps16, demand.number_of_sps_16);
+  write_sps(sp_provider.GetSpsAll<std::uint32_t>(), Section::kSps32, demand.number_of_sps_32);
+  write_sps(sp_provider.GetSpsAll<std::uint64_t>(), Section::kSps64, demand.number_of_sps_64);
+  write_sbs(sb_provider.GetSbsAll<std::uint8_t>(), Section::kSbs8, demand.number_of_sbs_8);
+  write_sbs(sb_provider.GetSbsAll<std::uint16_t>(), Section::kSbs16, demand.number_of_sbs_16);
+  write_sbs(sb_provider.GetSbsAll<std::uint32_t>(), Section::kSbs32, demand.number_of_sbs_32);
+  write_sbs(sb_provider.GetSbsAll<std::uint64_t>(), Section::kSbs64, demand.number_of_sbs_64);
+
+  file.close();
+  if (!file) {
+    throw std::runtime_error(fmt::format("could not write preprocessing store {}", path));
+  }
+}
+
+std::size_t PreprocessingStore::GetNumberOfAvailable(Section section) const {
+  const auto& entry = GetHeader().sections.at(static_cast<std::size_t>(section));
+  return entry.number_of_elements - entry.number_of_consumed_elements;
+}
+
+std::size_t PreprocessingStore::Consume(Section section, std::size_t number_of_elements) {
+  auto& entry = GetHeader().sections.at(static_cast<std::size_t>(section));
+  auto first_element = entry.number_of_consumed_elements;
+  // binary MTs are handed out at byte granularity
+  if (section == Section::kBinaryMts) {
+    first_element = RoundUp(first_element, 8);
+  }
+  if (first_element + number_of_elements > entry.number_of_elements) {
+    throw std::runtime_error(fmt::format(
+        "preprocessing store {} is exhausted: requested {} elements of section {}, but only {} "
+        "are left",
+        path_, number_of_elements, static_cast<std::size_t>(section),
+        entry.number_of_elements - std::min<std::size_t>(first_element, entry.number_of_elements)));
+  }
+  entry.number_of_consumed_elements = first_element + number_of_elements;
+  // persist the consumption before handing out the elements
+  msync(data_, sizeof(Header), MS_SYNC);
+  return first_element;
+}
+
+const std::byte* PreprocessingStore::GetColumn(Section section, std::size_t column) const {
+  const auto& entry = GetHeader().sections.at(static_cast<std::size_t>(section));
+  assert(column < kSectionLayouts.at(static_cast<std::size_t>(section)).number_of_columns);
+  return data_ + entry.offset + column * ColumnSize(section, entry.number_of_elements);
+}
+
+template <typename T>
+static std::vector<T> ReadColumn(const PreprocessingStore& store, Section section,
+                                 std::size_t column, std::size_t offset, std::size_t n) {
+  const auto begin = reinterpret_cast<const T*>(store.GetColumn(section, column)) + offset;
+  return std::vector<T>(begin, begin + n);
+}
+
+template <typename T>
+static void ReadMts(PreprocessingStore& store, Section section, IntegerMtVector<T>& mts,
+                    std::size_t n) {
+  if (n == 0) {
+    return;
+  }
+  const auto offset = store.Consume(section, n);
+  mts.a = ReadColumn<T>(store, section, 0, offset, n);
+  mts.b = ReadColumn<T>(store, section, 1, offset, n);
+  mts.c = ReadColumn<T>(store, section, 2, offset, n);
+}
+
+template <typename T>
+static void ReadSps(PreprocessingStore& store, Section section, SpVector<T>& sps, std::size_t n) {
+  if (n == 0) {
+    return;
+  }
+  const auto offset = store.Consume(section, n);
+  sps.a = ReadColumn<T>(store, section, 0, offset, n);
+  sps.c = ReadColumn<T>(store, section, 1, offset, n);
+}
+
+template <typename T>
+static void ReadSbs(PreprocessingStore& store, Section section, std::vector<T>& sbs,
+                    std::size_t n) {
+  if (n == 0) {
+    return;
+  }
+  const auto offset = store.Consume(section, n);
+  sbs = ReadColumn<T>(store, section, 0, offset, n);
+}
+
+MtProviderFromStore::MtProviderFromStore(std::shared_ptr<PreprocessingStore> store,
+                                         std::size_t my_id, std::size_t number_of_parties,
+                                         Logger& logger, RunTimeStatistics& run_time_statistics)
+    : MtProvider(my_id, number_of_parties),
+      store_(std::move(store)),
+      logger_(logger),
+      run_time_statistics_(run_time_statistics) {}
+
+void MtProviderFromStore::Setup() {
+  if (!NeedMts()) {
+    return;
+  }
+  if (NeedMatrixMts()) {
+    throw std::logic_error("matrix MTs cannot be loaded from a preprocessing store");
+  }
+
+  if constexpr (kDebug) {
+    logger_.LogDebug("Start loading MTs from the preprocessing store");
+  }
+  run_time_statistics_.RecordStart<RunTimeStatistics::StatisticsId::kMtSetup>();
+
+  if (number_of_bit_mts_ > 0) {
+    const auto offset = store_->Consume(Section::kBinaryMts, number_of_bit_mts_);
+    bit_mts_.a = BitVector<>(store_->GetColumn(Section::kBinaryMts, 0) + offset / 8,
+                             number_of_bit_mts_);
+    bit_mts_.b = BitVector<>(store_->GetColumn(Section::kBinaryMts, 1) + offset / 8,
+                             number_of_bit_mts_);
+    bit_mts_.c = BitVector<>(store_->GetColumn(Section::kBinaryMts, 2) + offset / 8,
+                             number_of_bit_mts_);
+  }
+  ReadMts(*store_, Section::kMts8, mts8_, number_of_mts_8_);
+  ReadMts(*store_, Section::kMts16, mts16_, number_of_mts_16_);
+  ReadMts(*store_, Section::kMts32, mts32_, number_of_mts_32_);
+  ReadMts(*store_, Section::kMts64, mts64_, number_of_mts_64_);
+
+  {
+    std::scoped_lock lock(finished_condition_->GetMutex());
+    finished_ = true;
+  }
+  finished_condition_->NotifyAll();
+
+  run_time_statistics_.RecordEnd<RunTimeStatistics::StatisticsId::kMtSetup>();
+  if constexpr (kDebug) {
+    logger_.LogDebug("Finished loading MTs from the preprocessing store");
+  }
+}
+
+void MtProviderFromStore::Clear() {
+  std::scoped_lock lock(finished_condition_->GetMutex());
+  finished_ = false;
+}
+
+SpProviderFromStore::SpProviderFromStore(std::shared_ptr<PreprocessingStore> store,
+                                         std::size_t my_id, Logger& logger,
+                                         RunTimeStatistics& run_time_statistics)
+    : SpProvider(my_id),
+      store_(std::move(store)),
+      logger_(logger),
+      run_time_statistics_(run_time_statistics) {}
+
+void SpProviderFromStore::Setup() {
+  if (!NeedSps()) {
+    return;
+  }
+  if (number_of_sps_128_ > 0) {
+    throw std::runtime_error("the preprocessing store does not contain 128 bit SPs");
+  }
+
+  if constexpr (kDebug) {
+    logger_.LogDebug("Start loading SPs from the preprocessing store");
+  }
+  run_time_statistics_.RecordStart<RunTimeStatistics::StatisticsId::kSpSetup>();
+
+  ReadSps(*store_, Section::kSps8, sps_8_, number_of_sps_8_);
+  ReadSps(*store_, Section::kSps16, sps_16_, number_of_sps_16_);
+  ReadSps(*store_, Section::kSps32, sps_32_, number_of_sps_32_);
+  ReadSps(*store_, Section::kSps64, sps_64_, number_of_sps_64_);
+
+  {
+    std::scoped_lock lock(finished_condition_->GetMutex());
+    finished_ = true;
+  }
+  finished_condition_->NotifyAll();
+
+  run_time_statistics_.RecordEnd<RunTimeStatistics::StatisticsId::kSpSetup>();
+  if constexpr (kDebug) {
+    logger_.LogDebug("Finished loading SPs from the preprocessing store");
+  }
+}
+
+void SpProviderFromStore::Clear() {
+  std::scoped_lock lock(finished_condition_->GetMutex());
+  finished_ = false;
+}
+
+SbProviderFromStore::SbProviderFromStore(std::shared_ptr<PreprocessingStore> store,
+                                         std::size_t my_id, Logger& logger,
+                                         RunTimeStatistics& run_time_statistics)
+    : SbProvider(my_id),
+      store_(std::move(store)),
+      logger_(logger),
+      run_time_statistics_(run_time_statistics) {}
+
+void SbProviderFromStore::Setup() {
+  if (!NeedSbs()) {
+    return;
+  }
+
+  if constexpr (kDebug) {
+    logger_.LogDebug("Start loading SBs from the preprocessing store");
+  }
+  run_time_statistics_.RecordStart<RunTimeStatistics::StatisticsId::kSbSetup>();
+
+  ReadSbs(*store_, Section::kSbs8, sbs_8_, number_of_sbs_8_);
+  ReadSbs(*store_, Section::kSbs16, sbs_16_, number_of_sbs_16_);
+  ReadSbs(*store_, Section::kSbs32, sbs_32_, number_of_sbs_32_);
+  ReadSbs(*store_, Section::kSbs64, sbs_64_, number_of_sbs_64_);
+
+  {
+    std::scoped_lock lock(finished_condition_->GetMutex());
+    finished_ = true;
+  }
+  finished_condition_->NotifyAll();
+
+  run_time_statistics_.RecordEnd<RunTimeStatistics::StatisticsId::kSbSetup>();
+  if constexpr (kDebug) {
+    logger_.LogDebug("Finished loading SBs from the preprocessing store");
+  }
+}
+
+void SbProviderFromStore::Clear() {
+  std::scoped_lock lock(finished_condition_->GetMutex());
+  finished_ = false;
+}
+
+}  // namespace encrypto::motion
@@ -0,0 +1,164 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "mt_provider.h"
+#include "sb_provider.h"
+#include "sp_provider.h"
+
+namespace encrypto::motion {
+
+struct RunTimeStatistics;
+class Logger;
+
+// Amount of correlated randomness to be precomputed into a PreprocessingStore
+struct PreprocessingDemand {
+  std::size_t number_of_binary_mts = 0;
+  std::size_t number_of_mts_8 = 0, number_of_mts_16 = 0, number_of_mts_32 = 0,
+              number_of_mts_64 = 0;
+  std::size_t number_of_sps_8 = 0, number_of_sps_16 = 0, number_of_sps_32 = 0,
+              number_of_sps_64 = 0;
+  std::size_t number_of_sbs_8 = 0, number_of_sbs_16 = 0, number_of_sbs_32 = 0,
+              number_of_sbs_64 = 0;
+};
+
+// Versioned, memory-mapped file holding one party's shares of precomputed MTs, SPs and SBs.
+//
+// The file starts with a header describing one section per kind of correlated randomness.  Each
+// section stores its components (e.g., a, b, c for MTs) as contiguous columns.  The header also
+// records how many elements of each section were already consumed, s.t. the same correlated
+// randomness is never handed out twice, even across several runs.  All parties have to consume
+// their stores in the same order, i.e., evaluate the same circuits.
+class PreprocessingStore {
+ public:
+  static constexpr std::uint64_t kMagic = 0x5045525052544f4d;  // "MOTRPREP"
+  static constexpr std::uint32_t kVersion = 1;
+
+  enum class Section : std::uint32_t {
+    kBinaryMts = 0,
+    kMts8,
+    kMts16,
+    kMts32,
+    kMts64,
+    kSps8,
+    kSps16,
+    kSps32,
+    kSps64,
+    kSbs8,
+    kSbs16,
+    kSbs32,
+    kSbs64,
+    kNumberOfSections  // must be the last entry
+  };
+
+  // Map an existing store, throws if it is not compatible with this party
+  PreprocessingStore(const std::string& path, std::size_t my_id, std::size_t number_of_parties);
+  ~PreprocessingStore();
+
+  PreprocessingStore(const PreprocessingStore&) = delete;
+  PreprocessingStore& operator=(const PreprocessingStore&) = delete;
+
+  // Write the correlated randomness of finished providers which was requested by demand
+  static void Write(const std::string& path, std::size_t my_id, std::size_t number_of_parties,
+                    const PreprocessingDemand& demand, MtProvider& mt_provider,
+                    SpProvider& sp_provider, SbProvider& sb_provider);
+
+  std::size_t GetNumberOfAvailable(Section section) const;
+
+  // Mark the next number_of_elements elements of section as consumed and return the index of
+  // the first one.  Throws if the store does not contain enough elements.
+  std::size_t Consume(Section section, std::size_t number_of_elements);
+
+  // Pointer to the beginning of a column, i.e., the a, b, or c component, of a section
+  const std::byte* GetColumn(Section section, std::size_t column) const;
+
+ private:
+  struct Header;
+
+  Header& GetHeader() const;
+
+  std::string path_;
+  int file_descriptor_ = -1;
+  std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+// Providers handing out correlated randomness from a PreprocessingStore instead of generating it
+// using OTs.  Setup only copies the requested elements out of the memory-mapped file, and every
+// Setup after a Clear consumes the next elements, s.t. a repeatedly evaluated circuit gets fresh
+// correlated randomness.
+
+class MtProviderFromStore final : public MtProvider {
+ public:
+  MtProviderFromStore(std::shared_ptr<PreprocessingStore> store, std::size_t my_id,
+                      std::size_t number_of_parties, Logger& logger,
+                      RunTimeStatistics& run_time_statistics);
+
+  void PreSetup() final override {}
+  void Setup() final override;
+  void Clear() final override;
+
+ private:
+  std::shared_ptr<PreprocessingStore> store_;
+  Logger& logger_;
+  RunTimeStatistics& run_time_statistics_;
+};
+
+class SpProviderFromStore final : public SpProvider {
+ public:
+  SpProviderFromStore(std::shared_ptr<PreprocessingStore> store, std::size_t my_id,
+                      Logger& logger, RunTimeStatistics& run_time_statistics);
+
+  void PreSetup() final override {}
+  void Setup() final override;
+  void Clear() final override;
+
+ private:
+  std::shared_ptr<PreprocessingStore> store_;
+  Logger& logger_;
+  RunTimeStatistics& run_time_statistics_;
+};
+
+class SbProviderFromStore final : public SbProvider {
+ public:
+  SbProviderFromStore(std::shared_ptr<PreprocessingStore> store, std::size_t my_id,
+                      Logger& logger, RunTimeStatistics& run_time_statistics);
+
+  void PreSetup() final override {}
+  void Setup() final override;
+  void Clear() final override;
+
+ private:
+  std::shared_ptr<PreprocessingStore> store_;
+  Logger& logger_;
+  RunTimeStatistics& run_time_statistics_;
+};
+
+}  // namespace encrypto::motion
@@ -122,6 +122,10 @@ class SbProvider {
   virtual void PreSetup() = 0;
   virtual void Setup() = 0;
 
+  // Prepares a repeated evaluation of the same circuit.  Providers that hand out fresh SBs in
+  // every Setup() reset their finished flag, s.t. the gates wait for the fresh SBs.
+  virtual void Clear() {}
+
   // blocking wait
   void WaitFinished() { finished_condition_->Wait(); }
 
@@ -135,6 +135,10 @@ class SpProvider {
   virtual void PreSetup() = 0;
   virtual void Setup() = 0;
 
+  // Prepares a repeated evaluation of the same circuit.  Providers that hand out fresh SPs in
+  // every Setup() reset their finished flag, s.t. the gates wait for the fresh SPs.
+  virtual void Clear() {}
+
   // blocking wait
   void WaitFinished() { finished_condition_->Wait(); }
 
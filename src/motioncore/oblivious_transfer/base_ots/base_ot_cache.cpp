@@ -0,0 +1,275 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "base_ot_cache.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "base/motion_base_provider.h"
+#include "primitives/blake2b.h"
+#include "primitives/sharing_randomness_generator.h"
+
+namespace encrypto::motion {
+
+namespace {
+
+// domain separation of the values derived from the sessions' HelloMessage seeds
+constexpr std::string_view kSessionTagDomain = "MOTION base OT cache session";
+constexpr std::string_view kCacheIdDomain = "MOTION base OT cache id";
+constexpr std::string_view kKeyDomain = "MOTION base OT cache key";
+
+using Digest = std::array<std::uint8_t, EVP_MAX_MD_SIZE>;
+
+Digest Hash(std::vector<std::uint8_t>& input, Blake2bCtx& md_context) {
+  Digest digest;
+  Blake2b(input.data(), digest.data(), input.size(), md_context);
+  return digest;
+}
+
+// H(domain || seed of the lower party id || seed of the higher party id), which only the two
+// parties of the pair know
+Digest SessionTag(std::size_t my_id, std::size_t party_id, BaseProvider& base_provider,
+                  Blake2bCtx& md_context) {
+  const auto my_seed = base_provider.GetMyRandomnessGenerator(party_id).GetSeed();
+  const auto their_seed = base_provider.GetTheirRandomnessGenerator(party_id).GetSeed();
+  const auto& first_seed = my_id < party_id ? my_seed : their_seed;
+  const auto& second_seed = my_id < party_id ? their_seed : my_seed;
+  std::vector<std::uint8_t> input(kSessionTagDomain.begin(), kSessionTagDomain.end());
+  input.insert(input.end(), first_seed.begin(), first_seed.end());
+  input.insert(input.end(), second_seed.begin(), second_seed.end());
+  return Hash(input, md_context);
+}
+
+// H(domain || session tag || index || key) truncated to the size of a base OT key
+std::array<std::byte, 16> DeriveKey(const Digest& session_tag, std::uint64_t index,
+                                    const std::array<std::byte, 16>& key, Blake2bCtx& md_context) {
+  std::vector<std::uint8_t> input(kKeyDomain.begin(), kKeyDomain.end());
+  input.insert(input.end(), session_tag.begin(), session_tag.end());
+  const auto* index_pointer = reinterpret_cast<const std::uint8_t*>(&index);
+  input.insert(input.end(), index_pointer, index_pointer + sizeof(index));
+  const auto* key_pointer = reinterpret_cast<const std::uint8_t*>(key.data());
+  input.insert(input.end(), key_pointer, key_pointer + key.size());
+  const auto digest = Hash(input, md_context);
+  std::array<std::byte, 16> derived_key;
+  std::copy_n(reinterpret_cast<const std::byte*>(digest.data()), derived_key.size(),
+              derived_key.begin());
+  return derived_key;
+}
+
+BaseOtMessages DeriveKeys(const Digest& session_tag, const BaseOtMessages& keys,
+                          Blake2bCtx& md_context) {
+  BaseOtMessages derived_keys;
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    derived_keys[i] = DeriveKey(session_tag, i, keys[i], md_context);
+  }
+  return derived_keys;
+}
+
+// layout of a cache entry on disk
+struct Entry {
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t number_of_base_ots;
+  std::uint64_t my_id;
+  std::uint64_t party_id;
+  std::array<std::uint8_t, BaseOtCache::kCacheIdSize> cache_id;
+  std::array<std::byte, kKappa / 8> c;
+  BaseOtMessages messages_c;
+  BaseOtMessages messages_0;
+  BaseOtMessages messages_1;
+  // Blake2b of all preceding members to detect corrupt entries
+  Digest digest;
+};
+
+Digest EntryDigest(Entry& entry, Blake2bCtx& md_context) {
+  Digest digest;
+  Blake2b(reinterpret_cast<std::uint8_t*>(&entry), digest.data(), offsetof(Entry, digest),
+          md_context);
+  return digest;
+}
+
+// the directory without trailing separators, s.t. lstat does not follow a symbolic link
+std::string DirectoryPath(const std::string& directory) {
+  std::filesystem::path path(directory);
+  while (!path.has_filename() && path.has_relative_path()) path = path.parent_path();
+  return path.string();
+}
+
+// the cache holds raw base OT keys, so it must be a real directory which only we can access
+bool IsPrivateDirectory(const std::string& directory) {
+  struct stat status;
+  return lstat(directory.c_str(), &status) == 0 && S_ISDIR(status.st_mode) &&
+         status.st_uid == geteuid() && (status.st_mode & (S_IRWXG | S_IRWXO)) == 0;
+}
+
+void CreatePrivateDirectory(const std::string& directory) {
+  if (const auto parent = std::filesystem::path(directory).parent_path(); !parent.empty()) {
+    std::filesystem::create_directories(parent);
+  }
+  if (mkdir(directory.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+    throw std::runtime_error(fmt::format("could not create base OT cache directory {}: {}",
+                                         directory, std::strerror(errno)));
+  }
+  if (!IsPrivateDirectory(directory)) {
+    throw std::runtime_error(fmt::format(
+        "base OT cache directory {} must be a directory owned and only accessible by the user",
+        directory));
+  }
+}
+
+}  // namespace
+
+BaseOtCache::BaseOtCache(std::string directory, std::size_t my_id, std::size_t number_of_parties)
+    : directory_(DirectoryPath(directory)),
+      my_id_(my_id),
+      number_of_parties_(number_of_parties),
+      cache_ids_(number_of_parties),
+      receiver_messages_(number_of_parties),
+      sender_messages_(number_of_parties) {}
+
+std::string BaseOtCache::GetPath(std::size_t party_id) const {
+  return (std::filesystem::path(directory_) / fmt::format("base_ots_{}_{}.bin", my_id_, party_id))
+      .string();
+}
+
+void BaseOtCache::Load() {
+  // entries in a directory which others can write to might have been planted
+  if (!IsPrivateDirectory(directory_)) {
+    return;
+  }
+  auto md_context = NewBlakeCtx();
+  for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    std::ifstream file(GetPath(party_id), std::ios::binary);
+    if (!file) {
+      continue;
+    }
+    Entry entry;
+    file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+    if (!file || file.peek() != std::ifstream::traits_type::eof()) {
+      continue;
+    }
+    if (entry.magic != kMagic || entry.version != kVersion || entry.number_of_base_ots != kKappa ||
+        entry.my_id != my_id_ || entry.party_id != party_id ||
+        EntryDigest(entry, md_context) != entry.digest) {
+      continue;
+    }
+    cache_ids_.at(party_id).assign(entry.cache_id.begin(), entry.cache_id.end());
+    receiver_messages_.at(party_id) = {entry.messages_c, BitVector<>(entry.c.data(), kKappa)};
+    sender_messages_.at(party_id) = {entry.messages_0, entry.messages_1};
+  }
+}
+
+bool BaseOtCache::Resume(std::size_t party_id, BaseProvider& base_provider,
+                         BaseOtProvider& base_ot_provider) {
+  const auto& cache_id = cache_ids_.at(party_id);
+  if (cache_id.empty() || cache_id != base_provider.GetTheirBaseOtCacheId(party_id)) {
+    return false;
+  }
+  auto md_context = NewBlakeCtx();
+  const auto session_tag = SessionTag(my_id_, party_id, base_provider, md_context);
+  const auto& receiver_message = receiver_messages_.at(party_id);
+  const auto& sender_message = sender_messages_.at(party_id);
+  base_ot_provider.ImportBaseOts(
+      party_id,
+      ReceiverMessage{DeriveKeys(session_tag, receiver_message.messages_c, md_context),
+                      receiver_message.c});
+  base_ot_provider.ImportBaseOts(
+      party_id, SenderMessage{DeriveKeys(session_tag, sender_message.messages_0, md_context),
+                              DeriveKeys(session_tag, sender_message.messages_1, md_context)});
+  return true;
+}
+
+void BaseOtCache::Store(std::size_t party_id, BaseProvider& base_provider,
+                        BaseOtProvider& base_ot_provider) {
+  auto [receiver_message, sender_message] = base_ot_provider.ExportBaseOts(party_id);
+  auto md_context = NewBlakeCtx();
+
+  Entry entry{};
+  entry.magic = kMagic;
+  entry.version = kVersion;
+  entry.number_of_base_ots = kKappa;
+  entry.my_id = my_id_;
+  entry.party_id = party_id;
+  // both parties derive the same cache id from this session
+  const auto session_tag = SessionTag(my_id_, party_id, base_provider, md_context);
+  std::vector<std::uint8_t> input(kCacheIdDomain.begin(), kCacheIdDomain.end());
+  input.insert(input.end(), session_tag.begin(), session_tag.end());
+  const auto cache_id = Hash(input, md_context);
+  std::copy_n(cache_id.begin(), kCacheIdSize, entry.cache_id.begin());
+  std::copy_n(receiver_message.c.GetData().begin(), entry.c.size(), entry.c.begin());
+  entry.messages_c = receiver_message.messages_c;
+  entry.messages_0 = sender_message.messages_0;
+  entry.messages_1 = sender_message.messages_1;
+  entry.digest = EntryDigest(entry, md_context);
+
+  // write to a fresh temporary file, which mkstemp creates exclusively and only accessible by the
+  // owner, and rename it, s.t. a concurrent or interrupted session never sees a partially written
+  // entry
+  CreatePrivateDirectory(directory_);
+  const auto path = GetPath(party_id);
+  std::string temporary_path = path + ".XXXXXX";
+  const int file_descriptor = mkstemp(temporary_path.data());
+  if (file_descriptor < 0) {
+    throw std::runtime_error(fmt::format("could not create base OT cache entry {}: {}",
+                                         temporary_path, std::strerror(errno)));
+  }
+  bool success =
+      write(file_descriptor, &entry, sizeof(entry)) == static_cast<ssize_t>(sizeof(entry)) &&
+      fsync(file_descriptor) == 0;
+  int error = errno;
+  close(file_descriptor);
+  if (success && std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    success = false;
+    error = errno;
+  }
+  if (!success) {
+    std::remove(temporary_path.c_str());
+    throw std::runtime_error(
+        fmt::format("could not write base OT cache entry {}: {}", path, std::strerror(error)));
+  }
+
+  cache_ids_.at(party_id).assign(entry.cache_id.begin(), entry.cache_id.end());
+  receiver_messages_.at(party_id) = std::move(receiver_message);
+  sender_messages_.at(party_id) = std::move(sender_message);
+}
+
+}  // namespace encrypto::motion
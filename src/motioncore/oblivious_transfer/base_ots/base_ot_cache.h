@@ -0,0 +1,87 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base_ot_provider.h"
+
+namespace encrypto::motion {
+
+class BaseProvider;
+
+// Opt-in cache of the base OTs with each other party, s.t. later sessions between the same
+// parties skip the public-key operations of the base OTs (see
+// Configuration::SetBaseOtCacheDirectory).
+//
+// The base OTs with party j are stored in <directory>/base_ots_<my id>_<j>.bin, which is replaced
+// atomically and is only accessible by its owner.  Each entry carries a cache id that both
+// parties of a pair derive from the session in which the base OTs were computed.  The parties
+// announce their cache ids in the HelloMessages and an entry is only used if both parties hold the
+// same one, otherwise the base OTs are computed anew and the entries are overwritten.
+//
+// The cached OTs are never used directly by a resumed session.  Instead, each session derives
+// fresh base OT keys by hashing the cached keys together with the seeds exchanged in its
+// HelloMessages, s.t. the OT extension of every session starts from independent seeds.  The choice
+// bits are kept, which corresponds to extending more OTs from the same base OTs.
+class BaseOtCache {
+ public:
+  static constexpr std::uint64_t kMagic = 0x53544f4252544f4d;  // "MOTRBOTS"
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::size_t kCacheIdSize = 16;
+
+  BaseOtCache(std::string directory, std::size_t my_id, std::size_t number_of_parties);
+
+  // Path of the entry for the base OTs with party_id
+  std::string GetPath(std::size_t party_id) const;
+
+  // Load the entries for all other parties, missing or invalid entries are skipped.  Nothing is
+  // loaded if the directory is not owned by the user or accessible by others.
+  void Load();
+
+  // Cache ids of the loaded entries indexed by party id, empty if there is no entry
+  const std::vector<std::vector<std::uint8_t>>& GetCacheIds() const noexcept { return cache_ids_; }
+
+  // Import base OTs derived for this session from the entry for party_id into base_ot_provider if
+  // party_id announced the same cache id.  Returns whether the entry was used.
+  bool Resume(std::size_t party_id, BaseProvider& base_provider, BaseOtProvider& base_ot_provider);
+
+  // Store the computed base OTs with party_id, replacing the previous entry.  Creates the
+  // directory accessible only by the user and throws std::runtime_error if it is not private.
+  void Store(std::size_t party_id, BaseProvider& base_provider, BaseOtProvider& base_ot_provider);
+
+ private:
+  std::string directory_;
+  std::size_t my_id_;
+  std::size_t number_of_parties_;
+  std::vector<std::vector<std::uint8_t>> cache_ids_;
+  std::vector<ReceiverMessage> receiver_messages_;
+  std::vector<SenderMessage> sender_messages_;
+};
+
+}  // namespace encrypto::motion
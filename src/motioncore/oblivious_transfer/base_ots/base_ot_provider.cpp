@@ -33,6 +33,7 @@
 #include "communication/message_handler.h"
 #include "data_storage/base_ot_data.h"
 #include "utility/fiber_condition.h"
+#include "utility/fiber_thread_pool/fiber_thread_pool.hpp"
 #include "utility/logger.h"
 
 namespace encrypto::motion {
@@ -94,7 +95,7 @@ BaseOtProvider::~BaseOtProvider() {
        communication::MessageType::kBaseROtMessageReceiver});
 }
 
-void BaseOtProvider::ComputeBaseOts() {
+void BaseOtProvider::ComputeBaseOts(std::size_t number_of_threads, bool pin_threads) {
   if constexpr (kDebug) {
     if (logger_) {
       logger_->LogDebug("Start computing base OTs");
@@ -107,6 +108,25 @@ void BaseOtProvider::ComputeBaseOts() {
   task_futures.reserve(2 * (number_of_parties_ - 1));
   base_ots.reserve(number_of_parties_);
 
+  // The base OTs with all parties in both directions run concurrently as fibers on a shared pool
+  // of workers.  Waiting for the other party's messages suspends only the respective fiber.
+  FiberThreadPool fiber_pool(number_of_threads, 2 * (number_of_parties_ - 1), true, pin_threads);
+
+  // runs the function as a fiber on the pool and returns a future for its completion
+  const auto post_task = [&fiber_pool](auto function) {
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future();
+    fiber_pool.post([promise, function = std::move(function)]() mutable {
+      try {
+        function();
+        promise->set_value();
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    });
+    return future;
+  };
+
   for (auto i = 0ull; i < number_of_parties_; ++i) {
     if (i == my_id_) {
       base_ots.emplace_back(nullptr);
@@ -119,9 +139,16 @@ void BaseOtProvider::ComputeBaseOts() {
 
     auto& base_ots_data = data_.at(i);
     base_ots.emplace_back(std::make_unique<OtHL17>(send_function, base_ots_data));
+  }
+
+  for (auto i = 0ull; i < number_of_parties_; ++i) {
+    if (i == my_id_) {
+      continue;
+    }
+    auto& base_ots_data = data_.at(i);
 
     if (!base_ots_data.GetReceiverData().is_ready) {
-      task_futures.emplace_back(std::async(std::launch::async, [this, &base_ots, i] {
+      task_futures.emplace_back(post_task([this, &base_ots, i] {
         auto choices = BitVector<>::SecureRandom(128);
         auto chosen_messages = base_ots[i]->Receive(choices);  // sender base ots
         auto& receiver_data = data_[i].GetReceiverData();
@@ -136,7 +163,7 @@ void BaseOtProvider::ComputeBaseOts() {
     }
 
     if (!base_ots_data.GetSenderData().is_ready) {
-      task_futures.emplace_back(std::async(std::launch::async, [this, &base_ots, i] {
+      task_futures.emplace_back(post_task([this, &base_ots, i] {
         auto both_messages = base_ots[i]->Send(128);  // receiver base ots
         auto& sender_data = data_[i].GetSenderData();
         for (std::size_t i = 0; i < both_messages.size(); ++i) {
@@ -154,6 +181,7 @@ void BaseOtProvider::ComputeBaseOts() {
   }
 
   std::for_each(task_futures.begin(), task_futures.end(), [](auto& f) { f.get(); });
+  fiber_pool.join();
   finished_ = true;
 
   if constexpr (kDebug) {
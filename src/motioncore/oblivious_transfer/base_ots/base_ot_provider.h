@@ -59,7 +59,9 @@ class BaseOtProvider {
  public:
   BaseOtProvider(communication::CommunicationLayer&, std::shared_ptr<Logger>);
   ~BaseOtProvider();
-  void ComputeBaseOts();
+  /// \brief Computes the base OTs with all other parties in both directions concurrently on a pool
+  /// of number_of_threads workers (0 for the number of hardware threads)
+  void ComputeBaseOts(std::size_t number_of_threads = 0, bool pin_threads = false);
   void ImportBaseOts(std::size_t party_id, const ReceiverMessage& messages);
   void ImportBaseOts(std::size_t party_id, const SenderMessage& messages);
   std::pair<ReceiverMessage, SenderMessage> ExportBaseOts(std::size_t party_id);
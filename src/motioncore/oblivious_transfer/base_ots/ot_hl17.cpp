@@ -47,176 +47,105 @@ OtHL17::OtHL17(std::function<void(flatbuffers::FlatBufferBuilder&&)> send,
 // * random oracle G: GG -> GG
 // * random oracle H: GG^3 -> K
 
-void HashPoint(curve25519::ge_p3& output, const curve25519::ge_p3& input) {
-  std::array<uint8_t, 32> hash_input;
-  std::vector<uint8_t> hash_output(EVP_MAX_MD_SIZE);
+constexpr std::size_t kCurve25519GeByteSize = 32;
 
-  curve25519::ge_p3_tobytes(hash_input.data(), &input);
-  Blake2b(hash_input.data(), hash_output.data(), hash_input.size());
-  hash_output.resize(32);
+using PointBytes = std::array<std::byte, kCurve25519GeByteSize>;
 
-  curve25519::x25519_sc_reduce(hash_output.data());
-  curve25519::x25519_ge_scalarmult_base(&output, hash_output.data());
+// view on serialized points as expected by the batched curve25519 functions
+static std::uint8_t (*AsBytes(std::vector<PointBytes>& points))[kCurve25519GeByteSize] {
+  return reinterpret_cast<std::uint8_t(*)[kCurve25519GeByteSize]>(points.data());
 }
 
-void OtHL17::Send0(SenderState& state,
-                   std::array<std::byte, kCurve25519GeByteSize>& message_output) {
-  // sample y <- Zp
-  curve25519::sc_random(state.y);
-
-  // S = g^y
-  curve25519::x25519_ge_scalarmult_base(&state.S, state.y);
-
-  std::vector<std::byte> S_bytes(kCurve25519GeByteSize);
-  curve25519::ge_p3_tobytes(reinterpret_cast<std::uint8_t*>(message_output.data()), &state.S);
-}
-
-void OtHL17::Send1(SenderState& state) {
-  // T = G(S)
-  HashPoint(state.T, state.S);
-}
-
-std::pair<std::vector<std::byte>, std::vector<std::byte>> OtHL17::Send2(
-    SenderState& state, const std::array<std::byte, kCurve25519GeByteSize>& message_input) {
-  // assert R in GG
-  if (!x25519_ge_frombytes_vartime(&state.R,
-                                   reinterpret_cast<const std::uint8_t*>(message_input.data()))) {
-    throw std::runtime_error("Base OT: R is not in G - abort");
-  }
-
+// output[i] = G(input[i]) for serialized points input[i].  A single hash context is reused for
+// the whole batch.
+static void HashPoints(std::vector<curve25519::ge_p3>& output,
+                       const std::vector<PointBytes>& input) {
   auto md_context = NewBlakeCtx();
-
-  auto output = std::make_pair<>(std::vector<std::byte>(EVP_MAX_MD_SIZE),
-                                 std::vector<std::byte>(EVP_MAX_MD_SIZE));
-  assert(output.first.size() == EVP_MAX_MD_SIZE);
-  assert(output.second.size() == EVP_MAX_MD_SIZE);
-
-  std::array<uint8_t, 3 * kCurve25519GeByteSize> hash_input;
-  curve25519::ge_p3_tobytes(hash_input.data(), &state.S);
-  curve25519::ge_p3_tobytes(hash_input.data() + 32, &state.R);
-
-  // j = 0:
-  // y*R
-  curve25519::ge_p2 y_times_R_p2;
-  curve25519::x25519_ge_scalarmult(&y_times_R_p2, state.y, &state.R);
-  curve25519::x25519_ge_tobytes(hash_input.data() + 64, &y_times_R_p2);
-
-  // H(S, R, y*R)
-  Blake2b(hash_input.data(), reinterpret_cast<uint8_t*>(output.first.data()), hash_input.size(),
-          md_context);
-
-  // j = 1:
-  // y*R + (-y)*T = y*(R - T)
-  {
-    curve25519::ge_cached T_cached;
-    curve25519::x25519_ge_p3_to_cached(&T_cached, &state.T);
-
-    curve25519::ge_p1p1 R_minus_T_p1p1;
-    curve25519::x25519_ge_sub(&R_minus_T_p1p1, &state.R, &T_cached);
-
-    curve25519::ge_p3 R_minus_T_p3;
-    curve25519::x25519_ge_p1p1_to_p3(&R_minus_T_p3, &R_minus_T_p1p1);
-
-    curve25519::ge_p2 y_times_R_minus_T_p2;
-    curve25519::x25519_ge_scalarmult(&y_times_R_minus_T_p2, state.y, &R_minus_T_p3);
-    curve25519::x25519_ge_tobytes(hash_input.data() + 64, &y_times_R_minus_T_p2);
+  std::array<std::uint8_t, EVP_MAX_MD_SIZE> hash_output;
+  std::array<std::uint8_t, kCurve25519GeByteSize> hash_input;
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    std::copy_n(reinterpret_cast<const std::uint8_t*>(input[i].data()), hash_input.size(),
+                hash_input.begin());
+    Blake2b(hash_input.data(), hash_output.data(), hash_input.size(), md_context);
+    curve25519::x25519_sc_reduce(hash_output.data());
+    curve25519::x25519_ge_scalarmult_base(&output[i], hash_output.data());
   }
+}
 
-  // H(S, R, y*R - y*T)
-  Blake2b(hash_input.data(), reinterpret_cast<uint8_t*>(output.second.data()), hash_input.size(),
+// H(S, R, key) for the serialized points S, R and key, truncated to 16 bytes
+static std::vector<std::byte> HashKey(const PointBytes& S, const PointBytes& R,
+                                      const PointBytes& key, Blake2bCtx& md_context) {
+  std::array<std::uint8_t, 3 * kCurve25519GeByteSize> hash_input;
+  auto output_iterator = hash_input.begin();
+  for (const auto* point : {&S, &R, &key}) {
+    output_iterator = std::copy_n(reinterpret_cast<const std::uint8_t*>(point->data()),
+                                  kCurve25519GeByteSize, output_iterator);
+  }
+  std::vector<std::byte> output(EVP_MAX_MD_SIZE);
+  Blake2b(hash_input.data(), reinterpret_cast<std::uint8_t*>(output.data()), hash_input.size(),
           md_context);
-
-  output.first.resize(16);
-  output.second.resize(16);
-
+  output.resize(16);
   return output;
 }
 
-void OtHL17::Receive0(ReceiverState& state, bool choice) {
-  state.choice = choice;
-  // sample x <- Zp
-  curve25519::sc_random(state.x);
-}
-
-void OtHL17::Receive1(ReceiverState& state,
-                      std::array<std::byte, kCurve25519GeByteSize>& message_output,
-                      const std::array<std::byte, kCurve25519GeByteSize>& message_input) {
-  // recv S
-  auto res = curve25519::x25519_ge_frombytes_vartime(
-      &state.S, reinterpret_cast<const std::uint8_t*>(message_input.data()));
-  // assert S in GG
-  if (res == 0) {
-    throw std::runtime_error("Base OT: S is not in G - abort");
-  }
+// All phases below process the whole batch of OTs at once: points are serialized with a single
+// field inversion per batch and all hashes of a batch share one hash context.
 
-  // T = G(S)
-  HashPoint(state.T, state.S);
-
-  // R = T^c * g^x
+std::vector<std::pair<std::vector<std::byte>, std::vector<std::byte>>> OtHL17::Send(
+    size_t number_of_ots) {
+  auto& base_ots_sender = base_ots_data_.GetSenderData();
 
-  // R = g^x
-  curve25519::x25519_ge_scalarmult_base(&state.R, state.x);
+  std::vector<std::array<std::uint8_t, 32>> y(number_of_ots);
+  std::vector<curve25519::ge_p3> S(number_of_ots), T(number_of_ots), R(number_of_ots);
+  std::vector<PointBytes> S_bytes(number_of_ots);
 
-  // FIXME: not constant time
-  // R = R * T
-  if (state.choice) {
-    curve25519::ge_p1p1 R_p1p1;
-    curve25519::ge_cached T_cached;
-    curve25519::x25519_ge_p3_to_cached(&T_cached, &state.T);
-    curve25519::x25519_ge_add(&R_p1p1, &state.R, &T_cached);
-    curve25519::x25519_ge_p1p1_to_p3(&state.R, &R_p1p1);
+  // sample y <- Zp and compute S = g^y
+  for (std::size_t i = 0; i < number_of_ots; ++i) {
+    curve25519::sc_random(y[i].data());
+    curve25519::x25519_ge_scalarmult_base(&S[i], y[i].data());
   }
+  curve25519::ge_p3_tobytes_batch(AsBytes(S_bytes), S.data(), number_of_ots);
 
-  std::vector<std::byte> R_bytes(32);
-  curve25519::ge_p3_tobytes(reinterpret_cast<std::uint8_t*>(message_output.data()), &state.R);
-}
-
-std::vector<std::byte> OtHL17::Receive2(ReceiverState& state) {
-  // k_R = H_(S,R)(S^x)
-  //     = H_(S,R)(g^xy)
-
-  std::vector<std::byte> hash_output(EVP_MAX_MD_SIZE);
-
-  std::array<uint8_t, 3 * kCurve25519GeByteSize> hash_input;
-  curve25519::ge_p3_tobytes(hash_input.data(), &state.S);
-  curve25519::ge_p3_tobytes(hash_input.data() + kCurve25519GeByteSize, &state.R);
-
-  curve25519::ge_p2 S_to_the_x;
-  curve25519::x25519_ge_scalarmult(&S_to_the_x, state.x, &state.S);
-  curve25519::x25519_ge_tobytes(hash_input.data() + 2 * kCurve25519GeByteSize, &S_to_the_x);
-
-  assert(hash_output.size() == EVP_MAX_MD_SIZE);
-  Blake2b(hash_input.data(), reinterpret_cast<uint8_t*>(hash_output.data()), hash_input.size());
-
-  hash_output.resize(16);
-  return hash_output;
-}
-
-std::vector<std::pair<std::vector<std::byte>, std::vector<std::byte>>> OtHL17::Send(
-    size_t number_of_ots) {
-  std::vector<SenderState> states;
   for (std::size_t i = 0; i < number_of_ots; ++i) {
-    states.emplace_back(i);
+    send_function_(
+        communication::BuildBaseROtMessageSender(S_bytes[i].data(), S_bytes[i].size(), i));
   }
 
-  auto& base_ots_sender = base_ots_data_.GetSenderData();
-
-  std::vector<std::array<std::byte, kCurve25519GeByteSize>> messages_s0(number_of_ots);
-  std::vector<std::pair<std::vector<std::byte>, std::vector<std::byte>>> output(number_of_ots);
+  // T = G(S)
+  HashPoints(T, S_bytes);
 
+  // recv R and assert R in GG
   for (std::size_t i = 0; i < number_of_ots; ++i) {
-    Send0(states.at(i), messages_s0.at(i));
+    base_ots_sender.received_R_condition.at(i)->Wait();
+    if (!curve25519::x25519_ge_frombytes_vartime(
+            &R[i], reinterpret_cast<const std::uint8_t*>(base_ots_sender.R.at(i).data()))) {
+      throw std::runtime_error("Base OT: R is not in G - abort");
+    }
   }
 
+  // keys[2i] = y*R, keys[2i + 1] = y*R + (-y)*T = y*(R - T)
+  std::vector<curve25519::ge_p2> keys(2 * number_of_ots);
   for (std::size_t i = 0; i < number_of_ots; ++i) {
-    send_function_(communication::BuildBaseROtMessageSender(messages_s0.at(i).data(),
-                                                            messages_s0.at(i).size(), i));
-    Send1(states.at(i));
+    curve25519::x25519_ge_scalarmult(&keys[2 * i], y[i].data(), &R[i]);
+
+    curve25519::ge_cached T_cached;
+    curve25519::x25519_ge_p3_to_cached(&T_cached, &T[i]);
+    curve25519::ge_p1p1 R_minus_T_p1p1;
+    curve25519::x25519_ge_sub(&R_minus_T_p1p1, &R[i], &T_cached);
+    curve25519::ge_p3 R_minus_T_p3;
+    curve25519::x25519_ge_p1p1_to_p3(&R_minus_T_p3, &R_minus_T_p1p1);
+    curve25519::x25519_ge_scalarmult(&keys[2 * i + 1], y[i].data(), &R_minus_T_p3);
   }
+  std::vector<PointBytes> key_bytes(keys.size());
+  curve25519::x25519_ge_tobytes_batch(AsBytes(key_bytes), keys.data(), keys.size());
 
+  // H(S, R, y*R) and H(S, R, y*R - y*T)
+  auto md_context = NewBlakeCtx();
+  std::vector<std::pair<std::vector<std::byte>, std::vector<std::byte>>> output(number_of_ots);
   for (std::size_t i = 0; i < number_of_ots; ++i) {
-    base_ots_sender.received_R_condition.at(i)->Wait();
-    output.at(i) = Send2(states.at(i), base_ots_sender.R.at(i));
+    const auto& R_bytes = base_ots_sender.R.at(i);
+    output[i].first = HashKey(S_bytes[i], R_bytes, key_bytes[2 * i], md_context);
+    output[i].second = HashKey(S_bytes[i], R_bytes, key_bytes[2 * i + 1], md_context);
   }
 
   base_ots_sender.is_ready = true;
@@ -227,26 +156,61 @@ std::vector<std::pair<std::vector<std::byte>, std::vector<std::byte>>> OtHL17::S
 std::vector<std::vector<std::byte>> OtHL17::Receive(const BitVector<>& choices) {
   const auto number_of_ots = choices.GetSize();
   auto& base_ots_receiver = base_ots_data_.GetReceiverData();
-  std::vector<ReceiverState> states;
+
+  std::vector<std::array<std::uint8_t, 32>> x(number_of_ots);
+  std::vector<curve25519::ge_p3> S(number_of_ots), T(number_of_ots), R(number_of_ots);
+
+  // sample x <- Zp
   for (std::size_t i = 0; i < number_of_ots; ++i) {
-    states.emplace_back(i);
+    curve25519::sc_random(x[i].data());
   }
-  std::vector<std::array<std::byte, kCurve25519GeByteSize>> messages_r1(number_of_ots);
-  std::vector<std::vector<std::byte>> output(number_of_ots);
 
+  // recv S and assert S in GG
+  std::vector<PointBytes> S_bytes(number_of_ots);
   for (std::size_t i = 0; i < number_of_ots; ++i) {
-    Receive0(states.at(i), choices.Get(i));
     base_ots_receiver.received_S_condition.at(i)->Wait();
+    S_bytes[i] = base_ots_receiver.S.at(i);
+    if (!curve25519::x25519_ge_frombytes_vartime(
+            &S[i], reinterpret_cast<const std::uint8_t*>(S_bytes[i].data()))) {
+      throw std::runtime_error("Base OT: S is not in G - abort");
+    }
   }
 
+  // T = G(S)
+  HashPoints(T, S_bytes);
+
+  // R = T^c * g^x
   for (std::size_t i = 0; i < number_of_ots; ++i) {
-    Receive1(states.at(i), messages_r1.at(i), base_ots_receiver.S.at(i));
-    send_function_(communication::BuildBaseROtMessageReceiver(messages_r1.at(i).data(),
-                                                              messages_r1.at(i).size(), i));
+    curve25519::x25519_ge_scalarmult_base(&R[i], x[i].data());
+    // FIXME: not constant time
+    if (choices.Get(i)) {
+      curve25519::ge_p1p1 R_p1p1;
+      curve25519::ge_cached T_cached;
+      curve25519::x25519_ge_p3_to_cached(&T_cached, &T[i]);
+      curve25519::x25519_ge_add(&R_p1p1, &R[i], &T_cached);
+      curve25519::x25519_ge_p1p1_to_p3(&R[i], &R_p1p1);
+    }
   }
+  std::vector<PointBytes> R_bytes(number_of_ots);
+  curve25519::ge_p3_tobytes_batch(AsBytes(R_bytes), R.data(), number_of_ots);
 
   for (std::size_t i = 0; i < number_of_ots; ++i) {
-    output.at(i) = Receive2(states.at(i));
+    send_function_(
+        communication::BuildBaseROtMessageReceiver(R_bytes[i].data(), R_bytes[i].size(), i));
+  }
+
+  // k_R = H_(S,R)(S^x) = H_(S,R)(g^xy)
+  std::vector<curve25519::ge_p2> keys(number_of_ots);
+  for (std::size_t i = 0; i < number_of_ots; ++i) {
+    curve25519::x25519_ge_scalarmult(&keys[i], x[i].data(), &S[i]);
+  }
+  std::vector<PointBytes> key_bytes(number_of_ots);
+  curve25519::x25519_ge_tobytes_batch(AsBytes(key_bytes), keys.data(), number_of_ots);
+
+  auto md_context = NewBlakeCtx();
+  std::vector<std::vector<std::byte>> output(number_of_ots);
+  for (std::size_t i = 0; i < number_of_ots; ++i) {
+    output[i] = HashKey(S_bytes[i], R_bytes[i], key_bytes[i], md_context);
   }
 
   base_ots_receiver.is_ready = true;
@@ -68,58 +68,6 @@ class OtHL17 final : public RandomOt {
   std::function<void(flatbuffers::FlatBufferBuilder&&)> send_function_;
 
   BaseOtData& base_ots_data_;
-
-  // public:  // for testing
-  struct SenderState {
-    SenderState(std::size_t ot_id) : i(ot_id) {}
-    // i-th OT
-    const std::size_t i;
-    // y
-    uint8_t y[32];
-    // // S
-    curve25519::ge_p3 S;
-    // // T
-    curve25519::ge_p3 T;
-    // // R
-    curve25519::ge_p3 R;
-  };
-
-  struct ReceiverState {
-    ReceiverState(std::size_t ot_id) : i(ot_id) {}
-
-    // i-th OT
-    const std::size_t i;
-
-    bool choice;
-    // x
-    uint8_t x[32];
-    // S
-    curve25519::ge_p3 S;
-    // T
-    curve25519::ge_p3 T;
-    // R
-    curve25519::ge_p3 R;
-    // k_R
-    // e_c
-  };
-
-  static constexpr size_t kCurve25519GeByteSize = 32;
-
-  /**
-   * Parts of the sender side.
-   */
-  void Send0(SenderState& state, std::array<std::byte, kCurve25519GeByteSize>& message_output);
-  void Send1(SenderState& state);
-  std::pair<std::vector<std::byte>, std::vector<std::byte>> Send2(
-      SenderState& state, const std::array<std::byte, kCurve25519GeByteSize>& message_input);
-
-  /**
-   * Parts of the receiver side.
-   */
-  void Receive0(ReceiverState& state, bool choice);
-  void Receive1(ReceiverState& state, std::array<std::byte, kCurve25519GeByteSize>& message_output,
-                const std::array<std::byte, kCurve25519GeByteSize>& message_input);
-  std::vector<std::byte> Receive2(ReceiverState& state);
 };
 
 }  // namespace encrypto::motion
@@ -35,17 +35,11 @@ BasicOtSender::BasicOtSender(
     const std::function<void(flatbuffers::FlatBufferBuilder&&)>& send_function,
     OtExtensionSenderData& data)
     : OtVector(ot_id, number_of_ots, bitlength, p, send_function), data_(data) {
-  data_.received_correction_offsets_condition.emplace(
-      ot_id_, std::make_unique<FiberCondition>([this]() {
-        std::scoped_lock lock(data_.corrections_mutex);
-        return data_.received_correction_offsets.find(ot_id_) !=
-               data_.received_correction_offsets.end();
-      }));
   data_.y0.resize(data_.y0.size() + number_of_ots);
   data_.y1.resize(data_.y1.size() + number_of_ots);
   data_.bitlengths.resize(data_.bitlengths.size() + number_of_ots, bitlength);
   data_.corrections.Resize(data_.corrections.GetSize() + number_of_ots);
-  data_.number_of_ots_in_batch.emplace(ot_id, number_of_ots);
+  data_.RegisterBatch(ot_id, number_of_ots);
 }
 
 void BasicOtSender::WaitSetup() const { data_.setup_finished_condition->Wait(); }
@@ -59,7 +53,6 @@ BasicOtReceiver::BasicOtReceiver(
     : OtVector(ot_id, number_of_ots, bitlength, p, send_function), data_(data) {
   data_.outputs.resize(ot_id + number_of_ots);
   data_.bitlengths.resize(ot_id + number_of_ots, bitlength);
-  data_.number_of_ots_in_batch.emplace(ot_id, number_of_ots);
 }
 
 void BasicOtReceiver::WaitSetup() const { data_.setup_finished_condition->Wait(); }
@@ -78,16 +71,10 @@ ROtSender::ROtSender(std::size_t ot_id, std::size_t number_of_ots, std::size_t b
                      OtExtensionSenderData& data,
                      const std::function<void(flatbuffers::FlatBufferBuilder&&)>& send_function)
     : OtVector(ot_id, number_of_ots, bitlength, kROt, send_function), data_(data) {
-  data_.received_correction_offsets_condition.emplace(
-      ot_id_, std::make_unique<FiberCondition>([this]() {
-        std::scoped_lock lock(data_.corrections_mutex);
-        return data_.received_correction_offsets.find(ot_id_) !=
-               data_.received_correction_offsets.end();
-      }));
   data_.y0.resize(data_.y0.size() + number_of_ots);
   data_.y1.resize(data_.y1.size() + number_of_ots);
   data_.bitlengths.resize(data_.bitlengths.size() + number_of_ots, bitlength);
-  data_.number_of_ots_in_batch.emplace(ot_id, number_of_ots);
+  data_.RegisterBatch(ot_id, number_of_ots);
 }
 
 void ROtSender::WaitSetup() const { data_.setup_finished_condition->Wait(); }
@@ -124,7 +111,6 @@ ROtReceiver::ROtReceiver(std::size_t ot_id, std::size_t number_of_ots, std::size
     : OtVector(ot_id, number_of_ots, bitlength, kROt, send_function), data_(data) {
   data_.outputs.resize(ot_id + number_of_ots);
   data_.bitlengths.resize(ot_id + number_of_ots, bitlength);
-  data_.number_of_ots_in_batch.emplace(ot_id, number_of_ots);
 }
 
 void ROtReceiver::WaitSetup() const { data_.setup_finished_condition->Wait(); }
@@ -168,7 +154,7 @@ void XcOtSender::ComputeOutputs() {
   const auto& ot_extension_sender_data = data_;
 
   // wait until the receiver has sent its correction bits
-  ot_extension_sender_data.received_correction_offsets_condition.at(ot_id_)->Wait();
+  ot_extension_sender_data.WaitForCorrections(ot_id_);
 
   // make space for all the OTs
   outputs_.resize(number_of_ots_);
@@ -215,7 +201,6 @@ XcOtReceiver::XcOtReceiver(
     const std::function<void(flatbuffers::FlatBufferBuilder&&)>& send_function)
     : BasicOtReceiver(ot_id, number_of_ots, bitlength, kXcOt, send_function, data),
       outputs_(number_of_ots) {
-  data_.message_type.emplace(ot_id, OtMessageType::kGenericBoolean);
   sender_message_future_ = data_.RegisterForGenericSenderMessage(ot_id, number_of_ots, bitlength);
 }
 
@@ -261,7 +246,7 @@ void FixedXcOt128Sender::ComputeOutputs() {
   const auto& ot_extension_sender_data = data_;
 
   // wait until the receiver has sent its correction bits
-  ot_extension_sender_data.received_correction_offsets_condition.at(ot_id_)->Wait();
+  ot_extension_sender_data.WaitForCorrections(ot_id_);
 
   // make space for all the OTs
   outputs_.resize(number_of_ots_);
@@ -304,7 +289,6 @@ FixedXcOt128Receiver::FixedXcOt128Receiver(
     const std::function<void(flatbuffers::FlatBufferBuilder&&)>& send_function)
     : BasicOtReceiver(ot_id, number_of_ots, 128, kFixedXcOt128, send_function, data),
       outputs_(number_of_ots) {
-  data_.message_type.emplace(ot_id, OtMessageType::kBlock128);
   sender_message_future_ = data_.RegisterForBlock128SenderMessage(ot_id, number_of_ots);
 }
 
@@ -345,7 +329,7 @@ void XcOtBitSender::ComputeOutputs() {
   WaitSetup();
 
   // wait until the receiver has sent its correction bits
-  data_.received_correction_offsets_condition.at(ot_id_)->Wait();
+  data_.WaitForCorrections(ot_id_);
 
   // make space for all the OTs
   outputs_.Resize(number_of_ots_);
@@ -388,7 +372,6 @@ XcOtBitReceiver::XcOtBitReceiver(
     const std::function<void(flatbuffers::FlatBufferBuilder&&)>& send_function)
     : BasicOtReceiver(ot_id, number_of_ots, 1, kXcOtBit, send_function, data),
       outputs_(number_of_ots) {
-  data_.message_type.emplace(ot_id, OtMessageType::kBit);
   sender_message_future_ = data_.RegisterForBitSenderMessage(ot_id, number_of_ots);
 }
 
@@ -433,7 +416,7 @@ void AcOtSender<T>::ComputeOutputs() {
   WaitSetup();
 
   // wait until the receiver has sent its correction bits
-  data_.received_correction_offsets_condition.at(ot_id_)->Wait();
+  data_.WaitForCorrections(ot_id_);
 
   // make space for all the OTs
   outputs_.resize(number_of_ots_ * vector_size_);
@@ -504,13 +487,6 @@ AcOtReceiver<T>::AcOtReceiver(
                       data),
       vector_size_(vector_size),
       outputs_(number_of_ots * vector_size) {
-  constexpr auto kIntegralTypeToOtMessageEnumTypemap = boost::hana::make_map(
-      boost::hana::make_pair(boost::hana::type_c<std::uint8_t>, OtMessageType::kUint8),
-      boost::hana::make_pair(boost::hana::type_c<std::uint16_t>, OtMessageType::kUint16),
-      boost::hana::make_pair(boost::hana::type_c<std::uint32_t>, OtMessageType::kUint32),
-      boost::hana::make_pair(boost::hana::type_c<std::uint64_t>, OtMessageType::kUint64),
-      boost::hana::make_pair(boost::hana::type_c<__uint128_t>, OtMessageType::kUint128));
-  data_.message_type.emplace(ot_id, kIntegralTypeToOtMessageEnumTypemap[boost::hana::type_c<T>]);
   sender_message_future_ = data_.RegisterForIntSenderMessage<T>(ot_id, number_of_ots * vector_size);
 }
 
@@ -578,7 +554,7 @@ void GOt128Sender::SendMessages() const {
   Block128Vector buffer = std::move(inputs_);
 
   const auto& ot_extension_sender_data = data_;
-  ot_extension_sender_data.received_correction_offsets_condition.at(ot_id_)->Wait();
+  ot_extension_sender_data.WaitForCorrections(ot_id_);
   std::unique_lock lock(ot_extension_sender_data.corrections_mutex);
   const auto corrections =
       ot_extension_sender_data.corrections.Subset(ot_id_, ot_id_ + number_of_ots_);
@@ -605,7 +581,6 @@ GOt128Receiver::GOt128Receiver(
     const std::function<void(flatbuffers::FlatBufferBuilder&&)>& send_function)
     : BasicOtReceiver(ot_id, number_of_ots, 128, kGOt, send_function, data),
       outputs_(number_of_ots) {
-  data_.message_type.emplace(ot_id, OtMessageType::kBlock128);
   sender_message_future_ = data_.RegisterForBlock128SenderMessage(ot_id, 2 * number_of_ots);
 }
 
@@ -644,7 +619,7 @@ void GOtBitSender::SendMessages() const {
   auto buffer = std::move(inputs_);
 
   const auto& ot_extension_sender_data = data_;
-  ot_extension_sender_data.received_correction_offsets_condition.at(ot_id_)->Wait();
+  ot_extension_sender_data.WaitForCorrections(ot_id_);
   std::unique_lock lock(ot_extension_sender_data.corrections_mutex);
   const auto corrections =
       ot_extension_sender_data.corrections.Subset(ot_id_, ot_id_ + number_of_ots_);
@@ -671,7 +646,6 @@ GOtBitReceiver::GOtBitReceiver(
     const std::size_t ot_id, const std::size_t number_of_ots, OtExtensionReceiverData& data,
     const std::function<void(flatbuffers::FlatBufferBuilder&&)>& send_function)
     : BasicOtReceiver(ot_id, number_of_ots, 1, kGOt, send_function, data), outputs_(number_of_ots) {
-  data_.message_type.emplace(ot_id, OtMessageType::kBit);
   sender_message_future_ = data_.RegisterForBitSenderMessage(ot_id, 2 * number_of_ots);
 }
 
@@ -710,7 +684,7 @@ void GOtSender::SendMessages() const {
   auto inputs = std::move(inputs_);
 
   const auto& ot_extension_sender_data = data_;
-  ot_extension_sender_data.received_correction_offsets_condition.at(ot_id_)->Wait();
+  ot_extension_sender_data.WaitForCorrections(ot_id_);
   std::unique_lock lock(ot_extension_sender_data.corrections_mutex);
   const auto corrections =
       ot_extension_sender_data.corrections.Subset(ot_id_, ot_id_ + number_of_ots_);
@@ -744,7 +718,6 @@ GOtReceiver::GOtReceiver(const std::size_t ot_id, const std::size_t number_of_ot
                          const std::function<void(flatbuffers::FlatBufferBuilder&&)>& send_function)
     : BasicOtReceiver(ot_id, number_of_ots, bitlength, kGOt, send_function, data),
       outputs_(number_of_ots) {
-  data_.message_type.emplace(ot_id, OtMessageType::kGenericBoolean);
   sender_message_future_ =
       data_.RegisterForGenericSenderMessage(ot_id, 2 * number_of_ots, bitlength);
 }
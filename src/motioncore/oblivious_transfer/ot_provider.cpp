@@ -25,6 +25,7 @@
 #include "ot_provider.h"
 #include "base_ots/base_ot_provider.h"
 #include "ot_flavors.h"
+#include "silent_ot_provider.h"
 
 #include "base/motion_base_provider.h"
 #include "communication/communication_layer.h"
@@ -555,9 +556,11 @@ void OtProviderSender::Clear() {
     std::scoped_lock lock(data_.setup_finished_condition->GetMutex());
     data_.setup_finished = false;
   }
-  {
-    std::scoped_lock lock(data_.corrections_mutex);
-    data_.received_correction_offsets.clear();
+  for (auto& batch : data_.batches) {
+    if (batch) {
+      std::scoped_lock lock(batch->received_corrections_condition->GetMutex());
+      batch->received_corrections = false;
+    }
   }
 }
 
@@ -714,16 +717,6 @@ void OtProviderReceiver::Clear() {
     std::scoped_lock lock(data_.setup_finished_condition->GetMutex());
     data_.setup_finished = false;
   }
-
-  {
-    std::scoped_lock lock(data_.real_choices_mutex);
-    data_.set_real_choices.clear();
-  }
-
-  {
-    std::scoped_lock lock(data_.received_outputs_mutex);
-    data_.received_outputs.clear();
-  }
 }
 void OtProviderReceiver::Reset() { Clear(); }
 
@@ -759,6 +752,11 @@ void OtExtensionMessageHandler::ReceivedMessage(std::size_t,
       data_.MessageReceived(ot_data, ot_data_size, OtExtensionDataType::kSendMessage, index_i);
       break;
     }
+    case communication::MessageType::kSilentOtSender: {
+      data_.MessageReceived(ot_data, ot_data_size, OtExtensionDataType::kSilentOtSenderMessage,
+                            index_i);
+      break;
+    }
     default: {
       assert(false);
       break;
@@ -769,8 +767,12 @@ void OtExtensionMessageHandler::ReceivedMessage(std::size_t,
 OtProviderManager::OtProviderManager(communication::CommunicationLayer& communication_layer,
                                      const BaseOtProvider& base_ot_provider,
                                      BaseProvider& motion_base_provider,
-                                     std::shared_ptr<Logger> logger)
+                                     std::shared_ptr<Logger> logger, OtExtensionProtocol protocol)
     : communication_layer_(communication_layer),
+      base_ot_provider_(base_ot_provider),
+      motion_base_provider_(motion_base_provider),
+      logger_(std::move(logger)),
+      protocol_(protocol),
       number_of_parties_(communication_layer_.GetNumberOfParties()),
       providers_(number_of_parties_),
       data_(number_of_parties_) {
@@ -779,14 +781,9 @@ OtProviderManager::OtProviderManager(communication::CommunicationLayer& communic
     if (party_id == my_id) {
       continue;
     }
-    auto send_function = [this, party_id](flatbuffers::FlatBufferBuilder&& message_builder) {
-      communication_layer_.SendMessage(party_id, std::move(message_builder));
-    };
     data_.at(party_id) = std::make_unique<OtExtensionData>();
-    providers_.at(party_id) = std::make_unique<OtProviderFromOtExtension>(
-        send_function, *data_.at(party_id), base_ot_provider.GetBaseOtsData(party_id),
-        motion_base_provider, party_id, logger);
   }
+  CreateProviders();
 
   communication_layer_.RegisterMessageHandler(
       [this](std::size_t party_id) {
@@ -794,14 +791,54 @@ OtProviderManager::OtProviderManager(communication::CommunicationLayer& communic
       },
       {communication::MessageType::kOtExtensionReceiverMasks,
        communication::MessageType::kOtExtensionReceiverCorrections,
-       communication::MessageType::kOtExtensionSender});
+       communication::MessageType::kOtExtensionSender,
+       communication::MessageType::kSilentOtSender});
+}
+
+void OtProviderManager::SetOtExtensionProtocol(OtExtensionProtocol protocol) {
+  if (protocol == protocol_) return;
+  for (const auto& provider : providers_) {
+    if (provider && (provider->GetNumOtsReceiver() > 0 || provider->GetNumOtsSender() > 0)) {
+      throw std::logic_error(
+          "The OT extension protocol cannot be changed after OTs have been registered");
+    }
+  }
+  protocol_ = protocol;
+  CreateProviders();
+}
+
+void OtProviderManager::CreateProviders() {
+  auto my_id = communication_layer_.GetMyId();
+  for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
+    if (party_id == my_id) {
+      continue;
+    }
+    auto send_function = [this, party_id](flatbuffers::FlatBufferBuilder&& message_builder) {
+      communication_layer_.SendMessage(party_id, std::move(message_builder));
+    };
+    switch (protocol_) {
+      case OtExtensionProtocol::kIknp: {
+        providers_.at(party_id) = std::make_unique<OtProviderFromOtExtension>(
+            send_function, *data_.at(party_id), base_ot_provider_.GetBaseOtsData(party_id),
+            motion_base_provider_, party_id, logger_);
+        break;
+      }
+      case OtExtensionProtocol::kSilent: {
+        providers_.at(party_id) = std::make_unique<OtProviderFromSilentOt>(
+            send_function, *data_.at(party_id), base_ot_provider_.GetBaseOtsData(party_id),
+            motion_base_provider_, party_id, logger_);
+        break;
+      }
+    }
+  }
 }
 
 OtProviderManager::~OtProviderManager() {
   communication_layer_.DeregisterMessageHandler(
       {communication::MessageType::kOtExtensionReceiverMasks,
        communication::MessageType::kOtExtensionReceiverCorrections,
-       communication::MessageType::kOtExtensionSender});
+       communication::MessageType::kOtExtensionSender,
+       communication::MessageType::kSilentOtSender});
 }
 
 }  // namespace encrypto::motion
@@ -290,17 +290,17 @@ class OtProviderFromBaseOTs : public OtProvider {
   // TODO
 };
 
-class OtProviderFromOtExtension final : public OtProvider {
+class OtProviderFromOtExtension : public OtProvider {
  public:
-  void SendSetup() final;
+  void SendSetup() override;
 
-  void ReceiveSetup() final;
+  void ReceiveSetup() override;
 
   OtProviderFromOtExtension(std::function<void(flatbuffers::FlatBufferBuilder&&)> send_function,
                             OtExtensionData& data, const BaseOtData& base_ot_data, BaseProvider&,
                             std::size_t party_id, std::shared_ptr<Logger> logger);
 
- private:
+ protected:
   const BaseOtData& base_ot_data_;
   BaseProvider& motion_base_provider_;
 };
@@ -313,17 +313,36 @@ class OtProviderFromMultipleThirdParties : public OtProvider {
   // TODO
 };
 
+// Protocol used to extend the base OTs
+enum class OtExtensionProtocol : unsigned int {
+  kIknp = 0,    // IKNP-style OT extension, see OtProviderFromOtExtension
+  kSilent = 1,  // LPN-based silent OT extension, see OtProviderFromSilentOt
+};
+
 class OtProviderManager {
  public:
   OtProviderManager(communication::CommunicationLayer&, const BaseOtProvider&, BaseProvider&,
-                    std::shared_ptr<Logger> logger);
+                    std::shared_ptr<Logger> logger,
+                    OtExtensionProtocol protocol = OtExtensionProtocol::kIknp);
   ~OtProviderManager();
 
   std::vector<std::unique_ptr<OtProvider>>& GetProviders() { return providers_; }
   OtProvider& GetProvider(std::size_t party_id) { return *providers_.at(party_id); }
 
+  OtExtensionProtocol GetOtExtensionProtocol() const { return protocol_; }
+
+  // Replaces the providers by ones using the given protocol.  All parties need to use the same
+  // protocol.  Throws if OTs were already registered at any of the current providers.
+  void SetOtExtensionProtocol(OtExtensionProtocol protocol);
+
  private:
+  void CreateProviders();
+
   communication::CommunicationLayer& communication_layer_;
+  const BaseOtProvider& base_ot_provider_;
+  BaseProvider& motion_base_provider_;
+  std::shared_ptr<Logger> logger_;
+  OtExtensionProtocol protocol_;
   std::size_t number_of_parties_;
   std::vector<std::unique_ptr<OtProvider>> providers_;
   std::vector<std::unique_ptr<OtExtensionData>> data_;
@@ -0,0 +1,434 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "silent_ot_provider.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "base/motion_base_provider.h"
+#include "communication/ot_extension_message.h"
+#include "data_storage/base_ot_data.h"
+#include "data_storage/ot_extension_data.h"
+#include "primitives/pseudo_random_generator.h"
+#include "utility/bit_matrix.h"
+#include "utility/constants.h"
+#include "utility/fiber_condition.h"
+#include "utility/helpers.h"
+
+namespace encrypto::motion {
+
+namespace {
+
+using Silent = OtProviderFromSilentOt;
+
+// every GGM tree needs two sender messages per level and one correction for the leaves
+constexpr std::size_t kMessageBlocksPerTree = 2 * Silent::kLogNoiseBlockSize + 1;
+
+// number of LPN matrix columns which are sampled at once
+constexpr std::size_t kLpnBatchSize = 1024;
+constexpr std::size_t kLpnBatchBytes = kLpnBatchSize * Silent::kLpnSparsity * sizeof(std::uint32_t);
+static_assert(kLpnBatchBytes % Block128::size() == 0);
+
+// domains of the public PRGs derived from the fixed AES key
+enum PublicPrg : std::size_t { kGgmLeft = 1, kGgmRight = 2, kLpnMatrix = 3 };
+
+// OTs that are generated by a single LPN instance
+struct LpnInstance {
+  std::size_t output_offset;
+  std::size_t number_of_outputs;
+  std::size_t number_of_trees;
+  std::size_t base_cot_offset;
+};
+
+// Splits number_of_ots into LPN instances.  The last instance only uses a prefix of the outputs,
+// which is at least as hard as the full instance, and thus needs fewer GGM trees.
+std::vector<LpnInstance> GetLpnInstances(std::size_t number_of_ots) {
+  std::vector<LpnInstance> instances;
+  std::size_t base_cot_offset = 0;
+  for (std::size_t offset = 0; offset < number_of_ots;
+       offset += Silent::kNumberOfOutputsPerInstance) {
+    const std::size_t number_of_outputs =
+        std::min(Silent::kNumberOfOutputsPerInstance, number_of_ots - offset);
+    const std::size_t number_of_trees =
+        (number_of_outputs + Silent::kNoiseBlockSize - 1) / Silent::kNoiseBlockSize;
+    instances.push_back({offset, number_of_outputs, number_of_trees, base_cot_offset});
+    base_cot_offset += Silent::kLpnDimension + number_of_trees * Silent::kLogNoiseBlockSize;
+  }
+  return instances;
+}
+
+// Keys prg with a public key which is derived from the jointly chosen fixed AES key
+void SetPublicKey(primitives::Prg& prg, primitives::Prg& prg_fixed_key, PublicPrg domain) {
+  auto input = Block128::MakeZero();
+  auto key = Block128::MakeZero();
+  prg_fixed_key.FixedKeyAes(input.data(), static_cast<std::size_t>(domain), key.data());
+  prg.SetKey(key.data());
+}
+
+// Transposes the kKappa rows of the IKNP matrix into one 128-bit block per column
+Block128Vector TransposeToBlocks(std::vector<AlignedBitVector>& rows,
+                                 std::size_t number_of_columns) {
+  std::array<std::byte*, kKappa> pointers;
+  for (std::size_t i = 0; i < kKappa; ++i) {
+    pointers[i] = rows[i].GetMutableData().data();
+  }
+  BitMatrix::TransposeUsingBitSlicing(pointers, number_of_columns);
+  Block128Vector blocks(number_of_columns);
+  for (std::size_t j = 0; j < number_of_columns; ++j) {
+    blocks[j].LoadFromMemory(pointers[j % kKappa] + (j / kKappa) * Block128::size());
+  }
+  return blocks;
+}
+
+// Expands the first number_of_parents nodes in place, s.t. node i is replaced by its children
+// 2i and 2i + 1, where child b is AES_{k_b}(parent) ^ parent
+void ExpandGgmLevel(Block128* nodes, std::size_t number_of_parents, primitives::Prg& left_prg,
+                    primitives::Prg& right_prg) {
+  const std::size_t byte_size = number_of_parents * Block128::size();
+  const auto left = left_prg.Encrypt(nodes->data(), byte_size);
+  const auto right = right_prg.Encrypt(nodes->data(), byte_size);
+  // iterate backwards, s.t. no parent is overwritten before it was expanded
+  for (std::size_t i = number_of_parents; i-- > 0;) {
+    const Block128 parent = nodes[i];
+    nodes[2 * i] = parent ^ (left.data() + i * Block128::size());
+    nodes[2 * i + 1] = parent ^ (right.data() + i * Block128::size());
+  }
+}
+
+// Samples the kLpnSparsity row indices of the public LPN matrix for each column of a batch
+void SampleLpnColumns(primitives::Prg& matrix_prg, std::size_t instance_index,
+                      std::size_t first_column, std::vector<std::uint32_t>& indices) {
+  const std::size_t first_byte =
+      (instance_index * Silent::kNumberOfOutputsPerInstance + first_column) *
+      Silent::kLpnSparsity * sizeof(std::uint32_t);
+  matrix_prg.SetOffset(first_byte / Block128::size());
+  const auto randomness = matrix_prg.Encrypt(kLpnBatchBytes);
+  indices.resize(kLpnBatchSize * Silent::kLpnSparsity);
+  std::memcpy(indices.data(), randomness.data(), kLpnBatchBytes);
+  for (auto& index : indices) index %= Silent::kLpnDimension;
+}
+
+// Hashes the correlated block into the random OT output in the same way as IKNP, i.e., using
+// MMO and expanding the result using a PRG for OTs longer than kKappa bits
+BitVector<> HashToOutput(const Block128& block, std::size_t bitlength,
+                         primitives::Prg& prg_fixed_key, primitives::Prg& prg_variable_key) {
+  BitVector<> output(block.data(), kKappa);
+  prg_fixed_key.Mmo(output.GetMutableData().data());
+  if (bitlength <= kKappa) {
+    output.Resize(bitlength);
+  } else {
+    prg_variable_key.SetKey(output.GetData().data());
+    output = BitVector<>(prg_variable_key.Encrypt(BitsToBytes(bitlength)), bitlength);
+  }
+  return output;
+}
+
+}  // namespace
+
+OtProviderFromSilentOt::OtProviderFromSilentOt(
+    std::function<void(flatbuffers::FlatBufferBuilder&&)> send_function, OtExtensionData& data,
+    const BaseOtData& base_ot_data, BaseProvider& motion_base_provider, std::size_t party_id,
+    std::shared_ptr<Logger> logger)
+    : OtProviderFromOtExtension(send_function, data, base_ot_data, motion_base_provider, party_id,
+                                logger) {}
+
+std::size_t OtProviderFromSilentOt::GetNumberOfBaseCots(std::size_t number_of_ots) {
+  std::size_t number_of_base_cots = 0;
+  for (const auto& instance : GetLpnInstances(number_of_ots)) {
+    number_of_base_cots += kLpnDimension + instance.number_of_trees * kLogNoiseBlockSize;
+  }
+  // round up to a multiple of kKappa
+  return (number_of_base_cots + kKappa - 1) / kKappa * kKappa;
+}
+
+bool OtProviderFromSilentOt::UseSilentOt(std::size_t number_of_ots) {
+  return GetNumberOfBaseCots(number_of_ots) < number_of_ots;
+}
+
+Block128Vector OtProviderFromSilentOt::ExtendSenderBaseCots(std::size_t number_of_cots) {
+  const auto& base_ots_receiver_data = base_ot_data_.GetReceiverData();
+  auto& ot_extension_sender_data = data_.GetSenderData();
+  ot_extension_sender_data.bit_size = number_of_cots;
+  const std::size_t byte_size = BitsToBytes(number_of_cots);
+
+  // V[i] = Prg(s_{i,c_i})
+  std::vector<AlignedBitVector> v(kKappa);
+  primitives::Prg prg_variable_key;
+  for (std::size_t i = 0; i < kKappa; ++i) {
+    prg_variable_key.SetKey(base_ots_receiver_data.messages_c.at(i).data());
+    prg_variable_key.SetOffset(base_ots_receiver_data.consumed_offset);
+    v[i] = AlignedBitVector(prg_variable_key.Encrypt(byte_size), number_of_cots);
+  }
+
+  // V[i] ^= c_i * u_i
+  for (auto it = ot_extension_sender_data.u_futures.begin();
+       it < ot_extension_sender_data.u_futures.end(); ++it) {
+    const std::size_t u_id{it->get()};
+    if (base_ots_receiver_data.c[u_id]) {
+      const auto& u = ot_extension_sender_data.u[u_id];
+      BitSpan bs(v[u_id].GetMutableData().data(), number_of_cots, true);
+      bs ^= u;
+    }
+  }
+  ot_extension_sender_data.u = {};
+
+  return TransposeToBlocks(v, number_of_cots);
+}
+
+std::pair<AlignedBitVector, Block128Vector> OtProviderFromSilentOt::ExtendReceiverBaseCots(
+    std::size_t number_of_cots) {
+  const auto& base_ots_sender_data = base_ot_data_.GetSenderData();
+  const std::size_t byte_size = BitsToBytes(number_of_cots);
+  auto choices = AlignedBitVector::SecureRandom(number_of_cots);
+
+  // T[i] = Prg(s_{i,0}) and u_i = T[i] ^ r ^ Prg(s_{i,1})
+  std::vector<AlignedBitVector> t(kKappa);
+  primitives::Prg prg_variable_key;
+  for (std::size_t i = 0; i < kKappa; ++i) {
+    prg_variable_key.SetKey(base_ots_sender_data.messages_0.at(i).data());
+    prg_variable_key.SetOffset(base_ots_sender_data.consumed_offset);
+    t[i] = AlignedBitVector(prg_variable_key.Encrypt(byte_size), number_of_cots);
+    auto u = t[i];
+    u ^= choices;
+    prg_variable_key.SetKey(base_ots_sender_data.messages_1.at(i).data());
+    prg_variable_key.SetOffset(base_ots_sender_data.consumed_offset);
+    u ^= AlignedBitVector(prg_variable_key.Encrypt(byte_size), number_of_cots);
+    send_function_(communication::BuildOtExtensionMessageReceiverMasks(u.GetData().data(),
+                                                                       u.GetData().size(), i));
+  }
+
+  return {std::move(choices), TransposeToBlocks(t, number_of_cots)};
+}
+
+void OtProviderFromSilentOt::SendSetup() {
+  const std::size_t number_of_ots = sender_provider_.GetNumOts();
+  if (number_of_ots == 0) return;  // no OTs needed
+  if (!UseSilentOt(number_of_ots)) {
+    OtProviderFromOtExtension::SendSetup();
+    return;
+  }
+
+  auto& ot_extension_sender_data = data_.GetSenderData();
+  const auto base_cots = ExtendSenderBaseCots(GetNumberOfBaseCots(number_of_ots));
+  // global correlation of the base COTs and thus of the silent COTs
+  const auto delta = Block128::MakeFromMemory(base_ot_data_.GetReceiverData().c.GetData().data());
+
+  motion_base_provider_.Setup();
+  primitives::Prg prg_fixed_key, prg_variable_key, left_prg, right_prg, matrix_prg;
+  prg_fixed_key.SetKey(motion_base_provider_.GetAesFixedKey().data());
+  SetPublicKey(left_prg, prg_fixed_key, kGgmLeft);
+  SetPublicKey(right_prg, prg_fixed_key, kGgmRight);
+  SetPublicKey(matrix_prg, prg_fixed_key, kLpnMatrix);
+
+  auto& y0 = ot_extension_sender_data.y0;
+  auto& y1 = ot_extension_sender_data.y1;
+  const auto& bitlengths = ot_extension_sender_data.bitlengths;
+  if (y0.size() < number_of_ots) {
+    y0.resize(number_of_ots);
+    y1.resize(number_of_ots);
+  }
+
+  const auto instances = GetLpnInstances(number_of_ots);
+  std::vector<std::uint32_t> indices;
+  for (std::size_t instance_index = 0; instance_index < instances.size(); ++instance_index) {
+    const auto& instance = instances[instance_index];
+    const Block128* lpn_secret = base_cots.data() + instance.base_cot_offset;
+    const Block128* tree_cots = lpn_secret + kLpnDimension;
+
+    // expand one GGM tree per noise block and let the receiver learn all but one leaf of each
+    Block128Vector noise(instance.number_of_trees * kNoiseBlockSize);
+    Block128Vector message(instance.number_of_trees * kMessageBlocksPerTree);
+    const auto seeds = Block128Vector::MakeRandom(instance.number_of_trees);
+    for (std::size_t tree = 0; tree < instance.number_of_trees; ++tree) {
+      Block128* leaves = noise.data() + tree * kNoiseBlockSize;
+      Block128* tree_message = message.data() + tree * kMessageBlocksPerTree;
+      leaves[0] = seeds[tree];
+      for (std::size_t level = 0; level < kLogNoiseBlockSize; ++level) {
+        const std::size_t number_of_nodes = std::size_t(2) << level;
+        ExpandGgmLevel(leaves, number_of_nodes / 2, left_prg, right_prg);
+        std::array<Block128, 2> sums{Block128::MakeZero(), Block128::MakeZero()};
+        for (std::size_t i = 0; i < number_of_nodes; ++i) sums[i & 1] ^= leaves[i];
+
+        // the receiver can decrypt the sum of the side given by its choice bit of the base COT
+        const std::size_t tweak = instance.base_cot_offset + kLpnDimension +
+                                  tree * kLogNoiseBlockSize + level;
+        const Block128& q = tree_cots[tree * kLogNoiseBlockSize + level];
+        const auto q_xor_delta = q ^ delta;
+        Block128 mask;
+        prg_fixed_key.FixedKeyAes(q.data(), tweak, mask.data());
+        tree_message[2 * level] = sums[0] ^ mask;
+        prg_fixed_key.FixedKeyAes(q_xor_delta.data(), tweak, mask.data());
+        tree_message[2 * level + 1] = sums[1] ^ mask;
+      }
+      // correction s.t. the receiver's punctured leaf becomes leaf ^ delta
+      auto& correction = tree_message[2 * kLogNoiseBlockSize];
+      correction = delta;
+      for (std::size_t i = 0; i < kNoiseBlockSize; ++i) correction ^= leaves[i];
+    }
+    send_function_(communication::BuildSilentOtMessageSender(message.data()->data(),
+                                                             message.ByteSize(), instance_index));
+
+    // z_i = v_i ^ sum of the base COTs selected by column i of the LPN matrix
+    for (std::size_t column = 0; column < instance.number_of_outputs; column += kLpnBatchSize) {
+      SampleLpnColumns(matrix_prg, instance_index, column, indices);
+      const std::size_t batch_size = std::min(kLpnBatchSize, instance.number_of_outputs - column);
+      for (std::size_t j = 0; j < batch_size; ++j) {
+        Block128 z = noise[column + j];
+        for (std::size_t k = 0; k < kLpnSparsity; ++k) {
+          z ^= lpn_secret[indices[j * kLpnSparsity + k]];
+        }
+        const std::size_t ot_id = instance.output_offset + column + j;
+        const std::size_t bitlength = ot_id < bitlengths.size() ? bitlengths[ot_id] : kKappa;
+        y0[ot_id] = HashToOutput(z, bitlength, prg_fixed_key, prg_variable_key);
+        y1[ot_id] = HashToOutput(z ^ delta, bitlength, prg_fixed_key, prg_variable_key);
+      }
+    }
+  }
+
+  {
+    std::scoped_lock lock(ot_extension_sender_data.setup_finished_condition->GetMutex());
+    ot_extension_sender_data.setup_finished = true;
+  }
+  ot_extension_sender_data.setup_finished_condition->NotifyAll();
+}
+
+void OtProviderFromSilentOt::ReceiveSetup() {
+  const std::size_t number_of_ots = receiver_provider_.GetNumOts();
+  if (number_of_ots == 0) return;  // nothing to do
+  if (!UseSilentOt(number_of_ots)) {
+    OtProviderFromOtExtension::ReceiveSetup();
+    return;
+  }
+
+  auto& ot_extension_receiver_data = data_.GetReceiverData();
+  const auto [base_choices, base_cots] =
+      ExtendReceiverBaseCots(GetNumberOfBaseCots(number_of_ots));
+
+  motion_base_provider_.Setup();
+  primitives::Prg prg_fixed_key, prg_variable_key, left_prg, right_prg, matrix_prg;
+  prg_fixed_key.SetKey(motion_base_provider_.GetAesFixedKey().data());
+  SetPublicKey(left_prg, prg_fixed_key, kGgmLeft);
+  SetPublicKey(right_prg, prg_fixed_key, kGgmRight);
+  SetPublicKey(matrix_prg, prg_fixed_key, kLpnMatrix);
+
+  auto& outputs = ot_extension_receiver_data.outputs;
+  const auto& bitlengths = ot_extension_receiver_data.bitlengths;
+  if (outputs.size() < number_of_ots) outputs.resize(number_of_ots);
+  ot_extension_receiver_data.random_choices = std::make_unique<AlignedBitVector>(number_of_ots);
+  auto& random_choices = *ot_extension_receiver_data.random_choices;
+
+  const auto instances = GetLpnInstances(number_of_ots);
+  std::vector<std::uint32_t> indices;
+  for (std::size_t instance_index = 0; instance_index < instances.size(); ++instance_index) {
+    const auto& instance = instances[instance_index];
+    const Block128* lpn_secret = base_cots.data() + instance.base_cot_offset;
+    const Block128* tree_cots = lpn_secret + kLpnDimension;
+
+    auto message = ot_extension_receiver_data.silent_ot_sender_messages.dequeue();
+    if (!message) {
+      throw std::runtime_error("Connection closed before receiving the silent OT sender message");
+    }
+    assert(message->size() ==
+           instance.number_of_trees * kMessageBlocksPerTree * Block128::size());
+    auto message_block = [&message](std::size_t i) {
+      return Block128::MakeFromMemory(
+          reinterpret_cast<const std::byte*>(message->data()) + i * Block128::size());
+    };
+
+    // reconstruct all leaves of each GGM tree but the punctured one, which is at a position
+    // given by the negated choice bits of the base COTs
+    Block128Vector noise(instance.number_of_trees * kNoiseBlockSize);
+    std::vector<std::size_t> punctured_leaves(instance.number_of_trees);
+    for (std::size_t tree = 0; tree < instance.number_of_trees; ++tree) {
+      Block128* leaves = noise.data() + tree * kNoiseBlockSize;
+      const std::size_t tree_message = tree * kMessageBlocksPerTree;
+      // index of the unknown node on the current level, whose children are garbage
+      std::size_t path = 0;
+      leaves[0].SetToZero();
+      for (std::size_t level = 0; level < kLogNoiseBlockSize; ++level) {
+        const std::size_t number_of_nodes = std::size_t(2) << level;
+        ExpandGgmLevel(leaves, number_of_nodes / 2, left_prg, right_prg);
+
+        // learn the sum of all children on side b and use it to recover the missing one
+        const std::size_t base_cot = instance.base_cot_offset + kLpnDimension +
+                                     tree * kLogNoiseBlockSize + level;
+        const bool b = base_choices.Get(base_cot);
+        Block128 missing;
+        prg_fixed_key.FixedKeyAes(tree_cots[tree * kLogNoiseBlockSize + level].data(), base_cot,
+                                  missing.data());
+        missing ^= message_block(tree_message + 2 * level + b);
+        for (std::size_t i = b; i < number_of_nodes; i += 2) {
+          if (i != 2 * path + b) missing ^= leaves[i];
+        }
+        leaves[2 * path + b] = missing;
+        path = 2 * path + !b;
+        leaves[path].SetToZero();
+      }
+      // w_alpha = correction ^ sum of all other leaves = v_alpha ^ delta
+      auto punctured = message_block(tree_message + 2 * kLogNoiseBlockSize);
+      for (std::size_t i = 0; i < kNoiseBlockSize; ++i) punctured ^= leaves[i];
+      leaves[path] = punctured;
+      punctured_leaves[tree] = tree * kNoiseBlockSize + path;
+    }
+
+    // x_i = w_i ^ sum of the selected base COTs and r_i = e_i ^ sum of the selected choices
+    for (std::size_t column = 0; column < instance.number_of_outputs; column += kLpnBatchSize) {
+      SampleLpnColumns(matrix_prg, instance_index, column, indices);
+      const std::size_t batch_size = std::min(kLpnBatchSize, instance.number_of_outputs - column);
+      for (std::size_t j = 0; j < batch_size; ++j) {
+        Block128 x = noise[column + j];
+        bool choice = false;
+        for (std::size_t k = 0; k < kLpnSparsity; ++k) {
+          const auto index = indices[j * kLpnSparsity + k];
+          x ^= lpn_secret[index];
+          choice ^= base_choices.Get(instance.base_cot_offset + index);
+        }
+        const std::size_t ot_id = instance.output_offset + column + j;
+        const std::size_t bitlength = ot_id < bitlengths.size() ? bitlengths[ot_id] : kKappa;
+        outputs[ot_id] = HashToOutput(x, bitlength, prg_fixed_key, prg_variable_key);
+        random_choices.Set(choice, ot_id);
+      }
+    }
+    for (const auto leaf : punctured_leaves) {
+      if (leaf < instance.number_of_outputs) {
+        const std::size_t ot_id = instance.output_offset + leaf;
+        random_choices.Set(!random_choices.Get(ot_id), ot_id);
+      }
+    }
+  }
+
+  {
+    std::scoped_lock lock(ot_extension_receiver_data.setup_finished_condition->GetMutex());
+    ot_extension_receiver_data.setup_finished = true;
+  }
+  ot_extension_receiver_data.setup_finished_condition->NotifyAll();
+}
+
+}  // namespace encrypto::motion
@@ -0,0 +1,85 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "ot_provider.h"
+#include "utility/bit_vector.h"
+#include "utility/block.h"
+
+namespace encrypto::motion {
+
+// Correlated OT extension based on the silent OT / PCG approach of Ferret
+// (https://eprint.iacr.org/2020/924) for semi-honest security.
+//
+// A small number of base COTs with the global correlation Delta is produced using IKNP.  Most of
+// them serve as the secret of a primal LPN instance with regular noise, the rest is used to
+// distribute the noise via punctured GGM trees.  The LPN encoding of both is a (pseudo-)random COT
+// of almost arbitrary length, which is then hashed in the same way as the IKNP outputs s.t. all
+// OT flavors work unchanged.  The communication hence only depends on the number of base COTs
+// instead of growing linearly in the number of OTs.
+//
+// If fewer OTs are requested than the LPN encoding needs base COTs, this provider falls back to
+// plain IKNP.
+class OtProviderFromSilentOt final : public OtProviderFromOtExtension {
+ public:
+  // regular-noise primal LPN parameters of Ferret for 128-bit security
+  static constexpr std::size_t kLpnDimension = 452'000;
+  static constexpr std::size_t kNumberOfNoiseBlocks = 1'280;
+  static constexpr std::size_t kLogNoiseBlockSize = 13;
+  static constexpr std::size_t kNoiseBlockSize = std::size_t(1) << kLogNoiseBlockSize;
+  static constexpr std::size_t kNumberOfOutputsPerInstance =
+      kNumberOfNoiseBlocks * kNoiseBlockSize;
+  // number of non-zero entries in each column of the public LPN matrix
+  static constexpr std::size_t kLpnSparsity = 10;
+
+  OtProviderFromSilentOt(std::function<void(flatbuffers::FlatBufferBuilder&&)> send_function,
+                         OtExtensionData& data, const BaseOtData& base_ot_data, BaseProvider&,
+                         std::size_t party_id, std::shared_ptr<Logger> logger);
+
+  void SendSetup() final;
+
+  void ReceiveSetup() final;
+
+  // number of base COTs that are needed to silently generate number_of_ots OTs, padded to a
+  // multiple of 128 for the IKNP matrix transposition
+  [[nodiscard]] static std::size_t GetNumberOfBaseCots(std::size_t number_of_ots);
+
+  // true if generating number_of_ots OTs silently is cheaper than using IKNP directly
+  [[nodiscard]] static bool UseSilentOt(std::size_t number_of_ots);
+
+ private:
+  // IKNP without the final hashing, i.e., returns the sender's side q_i of the COTs
+  // t_i = q_i ^ (r_i * Delta), where Delta are the choice bits of the base OTs
+  Block128Vector ExtendSenderBaseCots(std::size_t number_of_cots);
+
+  // IKNP without the final hashing, i.e., returns the receiver's random choices r and the t_i
+  std::pair<AlignedBitVector, Block128Vector> ExtendReceiverBaseCots(std::size_t number_of_cots);
+};
+
+}  // namespace encrypto::motion
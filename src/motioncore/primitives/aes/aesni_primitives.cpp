@@ -277,6 +277,58 @@ void AesniTmmoBatch4(const void* round_keys_input, void* input, __uint128_t twea
   for (std::size_t j = 0; j < 4; ++j) input_pointer[j] = _mm_xor_si128(wb_2[j], wb_1[j]);
 }
 
+template <std::size_t kBatchSize>
+static void AesniTmmoTweakedBatch(const __m128i* round_keys, __m128i* input,
+                                  const __m128i* tweaks) {
+  alignas(16) std::array<__m128i, kBatchSize> wb_1;
+  alignas(16) std::array<__m128i, kBatchSize> wb_2;
+
+  // compute wb_1 <- \pi(x)
+  for (std::size_t j = 0; j < kBatchSize; ++j) wb_1[j] = _mm_xor_si128(input[j], round_keys[0]);
+  for (std::size_t r = 1; r < kAesNumRoundKeys128 - 1; ++r) {
+    for (std::size_t j = 0; j < kBatchSize; ++j) wb_1[j] = _mm_aesenc_si128(wb_1[j], round_keys[r]);
+  }
+  for (std::size_t j = 0; j < kBatchSize; ++j) {
+    wb_1[j] = _mm_aesenclast_si128(wb_1[j], round_keys[kAesNumRoundKeys128 - 1]);
+  }
+
+  // compute wb_2 <- \pi(\pi(x) ^ i)
+  for (std::size_t j = 0; j < kBatchSize; ++j) {
+    wb_2[j] = _mm_xor_si128(_mm_xor_si128(wb_1[j], tweaks[j]), round_keys[0]);
+  }
+  for (std::size_t r = 1; r < kAesNumRoundKeys128 - 1; ++r) {
+    for (std::size_t j = 0; j < kBatchSize; ++j) wb_2[j] = _mm_aesenc_si128(wb_2[j], round_keys[r]);
+  }
+  for (std::size_t j = 0; j < kBatchSize; ++j) {
+    wb_2[j] = _mm_aesenclast_si128(wb_2[j], round_keys[kAesNumRoundKeys128 - 1]);
+  }
+
+  // store \pi(\pi(x) ^ i) ^ \pi(x)
+  for (std::size_t j = 0; j < kBatchSize; ++j) input[j] = _mm_xor_si128(wb_2[j], wb_1[j]);
+}
+
+void AesniTmmoTweaked(const void* round_keys_input, void* input, const void* tweaks,
+                      std::size_t number_of_blocks) {
+  alignas(16) std::array<__m128i, kAesNumRoundKeys128> round_keys;
+  std::copy(reinterpret_cast<const __m128i*>(
+                __builtin_assume_aligned(round_keys_input, kAesBlockSize)),
+            reinterpret_cast<const __m128i*>(
+                __builtin_assume_aligned(round_keys_input, kAesBlockSize)) +
+                kAesNumRoundKeys128,
+            round_keys.data());
+  auto input_pointer = reinterpret_cast<__m128i*>(__builtin_assume_aligned(input, kAesBlockSize));
+  auto tweak_pointer =
+      reinterpret_cast<const __m128i*>(__builtin_assume_aligned(tweaks, kAesBlockSize));
+
+  std::size_t j = 0;
+  for (; j + 4 <= number_of_blocks; j += 4) {
+    AesniTmmoTweakedBatch<4>(round_keys.data(), input_pointer + j, tweak_pointer + j);
+  }
+  for (; j < number_of_blocks; ++j) {
+    AesniTmmoTweakedBatch<1>(round_keys.data(), input_pointer + j, tweak_pointer + j);
+  }
+}
+
 void AesniMmoSingle(const void* round_keys_input, void* input) {
   alignas(16) __m128i input_block;
   alignas(16) __m128i wb_1;
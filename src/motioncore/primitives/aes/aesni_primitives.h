@@ -58,6 +58,14 @@ void AesniCtrStreamSingleBlock128Unaligned(const void* round_keys, std::uint64_t
 // * round_keys and output are 16B aligned
 void AesniTmmoBatch4(const void* round_keys, void* input, __uint128_t tweak);
 
+// Compute the fixed-key contruction TMMO^\pi (see above) on `number_of_blocks` input blocks
+// inplace, where the j-th block is hashed with its own tweak tweaks[j].  Blocks are processed in
+// batches of four to pipeline the AES rounds.
+//
+// * round_keys, input and tweaks are 16B aligned
+void AesniTmmoTweaked(const void* round_keys, void* input, const void* tweaks,
+                      std::size_t number_of_blocks);
+
 // Compute the fixed-key contruction MMO^\pi from Guo et al.
 // (https://eprint.iacr.org/2019/074).
 //
@@ -37,6 +37,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 namespace encrypto::motion::curve25519 {
 #include "mycurve25519_tables.h"  // Various pre-computed constants.
@@ -3763,6 +3764,50 @@ void x25519_ge_tobytes(uint8_t s[32], const ge_p2* h) {
   s[31] ^= fe_isnegative(&x) << 7;
 }
 
+// Serializes number_of_points points with a single field inversion (Montgomery's trick): the
+// inverse of each Z is derived from the inverse of the product of all Zs.
+template <typename Point>
+static void ge_tobytes_batch(uint8_t (*s)[32], const Point* h, size_t number_of_points) {
+  if (number_of_points == 0) {
+    return;
+  }
+
+  // products[i] = Z_0 * ... * Z_i
+  std::vector<fe> products(number_of_points);
+  fe_copy(&products[0], &h[0].Z);
+  for (size_t i = 1; i < number_of_points; ++i) {
+    fe_mul_ttt(&products[i], &products[i - 1], &h[i].Z);
+  }
+
+  // inverse = (Z_0 * ... * Z_i)^-1
+  fe inverse;
+  fe_invert(&inverse, &products[number_of_points - 1]);
+  for (size_t i = number_of_points; i-- > 0;) {
+    fe recip;
+    fe x;
+    fe y;
+
+    if (i > 0) {
+      fe_mul_ttt(&recip, &inverse, &products[i - 1]);
+      fe_mul_ttt(&inverse, &inverse, &h[i].Z);
+    } else {
+      fe_copy(&recip, &inverse);
+    }
+    fe_mul_ttt(&x, &h[i].X, &recip);
+    fe_mul_ttt(&y, &h[i].Y, &recip);
+    fe_tobytes(s[i], &y);
+    s[i][31] ^= fe_isnegative(&x) << 7;
+  }
+}
+
+void x25519_ge_tobytes_batch(uint8_t (*s)[32], const ge_p2* h, size_t number_of_points) {
+  ge_tobytes_batch(s, h, number_of_points);
+}
+
+void ge_p3_tobytes_batch(uint8_t (*s)[32], const ge_p3* h, size_t number_of_points) {
+  ge_tobytes_batch(s, h, number_of_points);
+}
+
 int x25519_ge_frombytes_vartime(ge_p3* h, const uint8_t* s) {
   fe u;
   fe_loose v;
@@ -31,6 +31,7 @@
 extern "C" {
 #endif
 
+#include <cstddef>
 #include <cstdint>
 
 #ifdef __cplusplus
@@ -138,6 +139,9 @@ typedef struct {
 void sc_random(uint8_t s[32]);
 void x25519_ge_p2_to_p3(ge_p3* r, const ge_p2* p);
 void ge_p3_tobytes(uint8_t s[32], const ge_p3* h);
+// batched versions of x25519_ge_tobytes and ge_p3_tobytes that need a single field inversion
+void x25519_ge_tobytes_batch(uint8_t (*s)[32], const ge_p2* h, size_t number_of_points);
+void ge_p3_tobytes_batch(uint8_t (*s)[32], const ge_p3* h, size_t number_of_points);
 void ge_double_scalarmult_vartime(ge_p2* r, const uint8_t* a, const ge_p3* A, const uint8_t* b);
 
 void ge_p2_0(ge_p2* h);
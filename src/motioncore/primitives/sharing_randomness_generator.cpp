@@ -26,11 +26,7 @@
 
 namespace encrypto::motion::primitives {
 
-SharingRandomnessGenerator::SharingRandomnessGenerator(std::size_t party_id)
-    : party_id_(party_id), context_arithmetic_(MakeCipherCtx()), context_boolean_(MakeCipherCtx()) {
-  if (!context_arithmetic_ || !context_boolean_) {
-    throw(std::runtime_error(fmt::format("Could not initialize EVP context")));
-  }
+SharingRandomnessGenerator::SharingRandomnessGenerator(std::size_t party_id) : party_id_(party_id) {
   initialized_condition_ = std::make_unique<FiberCondition>([this]() { return initialized_; });
 }
 
@@ -42,21 +38,17 @@ void SharingRandomnessGenerator::Initialize(
     auto digest = HashKey(master_seed_, KeyType::kArithmeticGmwKey);
     std::copy(digest.data(), digest.data() + kAesKeySize, raw_key_arithmetic_);
   }
-  {
-    auto digest = HashKey(master_seed_, KeyType::kArithmeticGmwNonce);
-    std::copy(digest.data(), digest.data() + AES_BLOCK_SIZE / 2, aes_ctr_nonce_arithmetic_);
-  }
   {
     auto digest = HashKey(master_seed_, KeyType::kBooleanGmwKey);
     std::copy(digest.data(), digest.data() + kAesKeySize, raw_key_boolean_);
   }
-  {
-    auto digest = HashKey(master_seed_, KeyType::kBooleanGmwNonce);
-    std::copy(digest.data(), digest.data() + AES_BLOCK_SIZE / 2, aes_ctr_nonce_boolean_);
-  }
 
-  prg_a.SetKey(raw_key_arithmetic_);
-  prg_b.SetKey(raw_key_boolean_);
+  std::copy_n(reinterpret_cast<const std::byte*>(raw_key_arithmetic_), kAesKeySize,
+              round_keys_arithmetic_.data());
+  AesniKeyExpansion128(round_keys_arithmetic_.data());
+  std::copy_n(reinterpret_cast<const std::byte*>(raw_key_boolean_), kAesKeySize,
+              round_keys_boolean_.data());
+  AesniKeyExpansion128(round_keys_boolean_.data());
 
   {
     std::scoped_lock lock(initialized_condition_->GetMutex());
@@ -65,56 +57,48 @@ void SharingRandomnessGenerator::Initialize(
   initialized_condition_->NotifyAll();
 }
 
-BitVector<> SharingRandomnessGenerator::GetBits(const std::size_t gate_id,
-                                                const std::size_t number_of_bits) {
-  std::scoped_lock lock(random_bits_mutex_);
-
+void SharingRandomnessGenerator::FillBits(const std::size_t sharing_id, BitSpan output) {
+  const auto number_of_bits = output.GetSize();
   if (number_of_bits == 0) {
-    return {};  // return an empty vector if number_of_gates is zero
+    return;
   }
 
-  while (!initialized_) {
-    initialized_condition_->Wait();
-  }
-
-  constexpr std::size_t kBitsInCiphertext = AES_BLOCK_SIZE * 8;
-  constexpr std::size_t kCipherTextsInBatch = 100;
-  // initialization for the encryption is costly, so perform random bit generation in a batch
-  constexpr std::size_t kBitsInBatch = kBitsInCiphertext * kCipherTextsInBatch;
-  constexpr std::size_t kBytesInBatch = kBitsInBatch / 8;
-
-  while (random_bits_.GetSize() < (gate_id - random_bits_offset_ + number_of_bits)) {
-    std::vector<std::byte> input(kBytesInBatch + AES_BLOCK_SIZE),
-        output(kBytesInBatch + AES_BLOCK_SIZE);
-    for (auto offset = random_bits_.GetSize() / kAesBlockSize; offset < kCipherTextsInBatch;
-         ++offset) {
-      auto pointer = reinterpret_cast<std::uint8_t*>(input.data()) + offset * kAesBlockSize;
-      // copy nonce
-      std::copy(std::begin(aes_ctr_nonce_boolean_), std::end(aes_ctr_nonce_boolean_), pointer);
-      // copy counter value
-      *reinterpret_cast<uint64_t*>(pointer + kAesBlockSize / 2) = offset;
+  initialized_condition_->Wait();
+
+  constexpr std::size_t kBitsInBlock = kAesBlockSize * 8;
+  const auto number_of_full_blocks = number_of_bits / kBitsInBlock;
+  const auto number_of_remaining_bits = number_of_bits % kBitsInBlock;
+  std::byte* pointer = output.GetMutableData();
+  std::uint64_t counter = sharing_id;
+
+  if (number_of_full_blocks > 0) {
+    if (output.IsAligned()) {
+      AesniCtrStreamBlocks128(round_keys_boolean_.data(), &counter, pointer,
+                              number_of_full_blocks);
+    } else {
+      AesniCtrStreamBlocks128Unaligned(round_keys_boolean_.data(), &counter, pointer,
+                                       number_of_full_blocks);
     }
-
-    // encrypt as in CTR mode, but without sequentially incrementing the counter
-    // after each encryption
-    std::vector<std::byte> output_bytes =
-        prg_b.Encrypt(input.data(), kCipherTextsInBatch * AES_BLOCK_SIZE);
-
-    for (auto i = 0ull; i < kBytesInBatch; ++i) {
-      output_bytes.push_back(std::byte(output.at(i)));
-    }
-    auto randomness = BitVector(std::move(output_bytes), kBitsInBatch);
-    random_bits_.Append(randomness);
   }
 
-  const auto requested = gate_id - random_bits_offset_ + number_of_bits;
-  if (requested > random_bits_used_) {
-    random_bits_used_ = requested;
+  if (number_of_remaining_bits > 0) {
+    // the last block does not fit into the output and is truncated to the remaining bits
+    alignas(kAesBlockSize) std::array<std::byte, kAesBlockSize> block;
+    AesniCtrStreamSingleBlock128Unaligned(round_keys_boolean_.data(), &counter, block.data());
+    const auto number_of_remaining_bytes = BitsToBytes(number_of_remaining_bits);
+    std::byte* last_block = pointer + number_of_full_blocks * kAesBlockSize;
+    std::copy_n(block.data(), number_of_remaining_bytes, last_block);
+    if (number_of_remaining_bits % 8 != 0) {
+      last_block[number_of_remaining_bytes - 1] &= TruncationBitMask[number_of_remaining_bits % 8];
+    }
   }
+}
 
-  assert(gate_id >= random_bits_offset_);
-  return random_bits_.Subset(gate_id - random_bits_offset_,
-                             gate_id + number_of_bits - random_bits_offset_);
+BitVector<> SharingRandomnessGenerator::GetBits(const std::size_t sharing_id,
+                                                const std::size_t number_of_bits) {
+  BitVector<> result(number_of_bits);
+  FillBits(sharing_id, result);
+  return result;
 }
 
 std::vector<std::uint8_t> SharingRandomnessGenerator::HashKey(
@@ -144,16 +128,4 @@ std::vector<std::uint8_t> SharingRandomnessGenerator::GetSeed() {
   return std::vector<std::uint8_t>(master_seed_, master_seed_ + sizeof(master_seed_));
 }
 
-void SharingRandomnessGenerator::ClearBitPool() { random_bits_ = BitVector<>(); }
-
-void SharingRandomnessGenerator::ResetBitPool() {
-  if (random_bits_used_ == random_bits_.GetSize()) {
-    random_bits_.Clear();
-  } else {
-    random_bits_ = random_bits_.Subset(random_bits_used_, random_bits_.GetSize() - 1);
-  }
-  random_bits_offset_ += random_bits_used_;
-  random_bits_used_ = 0;
-}
-
 }  // namespace encrypto::motion::primitives
@@ -24,12 +24,12 @@
 
 #pragma once
 
-#include <boost/fiber/mutex.hpp>
-#include <limits>
-#include <thread>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
 #include <vector>
 
-#include <openssl/aes.h>
 #include <openssl/conf.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
@@ -42,7 +42,7 @@ static auto& EVP_MD_CTX_free = EVP_MD_CTX_destroy;
 
 #include <fmt/format.h>
 
-#include "pseudo_random_generator.h"
+#include "primitives/aes/aesni_primitives.h"
 #include "utility/bit_vector.h"
 #include "utility/constants.h"
 #include "utility/fiber_condition.h"
@@ -81,98 +81,74 @@ class SharingRandomnessGenerator {
 
   //---------------------------------------------- Template funtions
   //----------------------------------------------
-  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
-  T GetUnsigned(const std::size_t gate_id) {
-    initialized_condition_->Wait();
-
-    std::byte input[AES_BLOCK_SIZE];
-
-    std::copy(std::begin(aes_ctr_nonce_arithmetic_), std::end(aes_ctr_nonce_arithmetic_),
-              reinterpret_cast<std::uint8_t*>(input));
-    std::copy(reinterpret_cast<const std::byte*>(&gate_id),
-              reinterpret_cast<const std::byte*>(&gate_id) + sizeof(gate_id),
-              input + SharingRandomnessGenerator::kCounterOffset);
-
-    auto output = prg_a.Encrypt(input, AES_BLOCK_SIZE);
-
-    // combine resulting randomness xored with the gate_id, which is the actual
-    // input to AES-CTR
-    __uint128_t result = reinterpret_cast<std::uint64_t*>(output.data())[0],
-                modulus = std::numeric_limits<T>::max();
-    result <<= 64;
-    result ^= reinterpret_cast<std::uint64_t*>(output.data())[1] ^ gate_id;
-    result %= modulus;
-
-    return static_cast<T>(result);  // static-cast the result to the smaller
-                                    // ring
-  }
 
+  /// \brief Writes the arithmetic input-sharing randomness for the sharing ids
+  /// [sharing_id, sharing_id + output.size()) into \p output without allocating.
+  ///
+  /// The value for sharing id j is the AES-CTR keystream block with counter j truncated to its
+  /// lower sizeof(T) bytes, i.e., it is reduced modulo 2^(8 * sizeof(T)) by masking.
   template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
-  std::vector<T> GetUnsigned(std::size_t gate_id, const std::size_t number_of_gates) {
-    if (number_of_gates == 0) {
-      return {};  // return an empty vector if number_of_gates is zero
+  void FillUnsigned(const std::size_t sharing_id, std::span<T> output) {
+    if (output.empty()) {
+      return;
     }
 
     initialized_condition_->Wait();
 
-    // Pre-initialize output vector
-    std::vector<T> results;
-    results.reserve(number_of_gates);
-
-    auto size_in_bytes = AES_BLOCK_SIZE * (number_of_gates);
-    std::vector<std::byte> input(size_in_bytes + AES_BLOCK_SIZE);
-
-    auto gate_id_copy = gate_id;
-    for (auto i = 0u; i < number_of_gates; ++i, ++gate_id_copy) {
-      std::copy(std::begin(aes_ctr_nonce_arithmetic_), std::end(aes_ctr_nonce_arithmetic_),
-                reinterpret_cast<std::uint8_t*>(input.data()) + i * AES_BLOCK_SIZE);
-      std::copy(reinterpret_cast<std::byte*>(&gate_id_copy),
-                reinterpret_cast<std::byte*>(&gate_id_copy) + sizeof(gate_id_copy),
-                input.data() + i * AES_BLOCK_SIZE + SharingRandomnessGenerator::kCounterOffset);
+    std::uint64_t counter = sharing_id;
+    if constexpr (sizeof(T) == kAesBlockSize) {
+      AesniCtrStreamBlocks128Unaligned(round_keys_arithmetic_.data(), &counter, output.data(),
+                                       output.size());
+    } else {
+      alignas(kAesBlockSize) std::array<std::byte, kBlocksInBatch * kAesBlockSize> blocks;
+      for (std::size_t offset = 0; offset < output.size(); offset += kBlocksInBatch) {
+        const auto number_of_blocks = std::min(kBlocksInBatch, output.size() - offset);
+        AesniCtrStreamBlocks128(round_keys_arithmetic_.data(), &counter, blocks.data(),
+                                number_of_blocks);
+        for (std::size_t i = 0; i < number_of_blocks; ++i) {
+          std::memcpy(&output[offset + i], blocks.data() + i * kAesBlockSize, sizeof(T));
+        }
+      }
     }
+  }
 
-    auto output = prg_a.Encrypt(input.data(), number_of_gates * AES_BLOCK_SIZE);
-    __uint128_t modulus = std::numeric_limits<T>::max(), single_result;
-    // combine resulting randomness xored with the gate_id, which is the actual
-    // input to AES-CTR
-    for (auto i = 0u; i < number_of_gates; ++i) {
-      single_result = reinterpret_cast<std::uint64_t*>(output.data())[i * 2];
-      single_result <<= 64;
-      single_result ^= reinterpret_cast<std::uint64_t*>(output.data())[i * 2 + 1] ^ gate_id++;
-      single_result %= modulus;
-      results.push_back(
-          static_cast<T>(single_result));  // static-cast the result to the smaller ring
-    }
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  T GetUnsigned(const std::size_t sharing_id) {
+    T result;
+    FillUnsigned<T>(sharing_id, std::span<T>(&result, 1));
+    return result;
+  }
 
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  std::vector<T> GetUnsigned(const std::size_t sharing_id, const std::size_t number_of_gates) {
+    std::vector<T> results(number_of_gates);
+    FillUnsigned<T>(sharing_id, results);
     return results;
   }
 
-  BitVector<> GetBits(const std::size_t gate_id, const std::size_t number_of_bits);
-
-  void ClearBitPool();
+  /// \brief Writes the Boolean input-sharing randomness for the sharing ids
+  /// [sharing_id, sharing_id + output.GetSize()) into \p output without allocating.
+  ///
+  /// The bits are taken from the ceil(output.GetSize() / 128) AES-CTR keystream blocks starting at
+  /// counter sharing_id.  Since these are never more than output.GetSize() blocks, disjoint ranges
+  /// of sharing ids never share a counter.
+  void FillBits(const std::size_t sharing_id, BitSpan output);
 
-  void ResetBitPool();
+  BitVector<> GetBits(const std::size_t sharing_id, const std::size_t number_of_bits);
 
  private:
-  static constexpr std::size_t kCounterOffset =
-      AES_BLOCK_SIZE / 2;  /// Byte length of the AES-CTR nonce
-  std::int64_t party_id_ = -1;
+  /// Number of AES blocks that are generated at once on the stack in FillUnsigned
+  static constexpr std::size_t kBlocksInBatch = 64;
 
-  /// AES context, created only once and reused further
-  using EvpCipherCtxPointer = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
-  static constexpr auto MakeCipherCtx = []() {
-    return EvpCipherCtxPointer(EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free);
-  };
-  EvpCipherCtxPointer context_arithmetic_, context_boolean_;
+  std::int64_t party_id_ = -1;
 
   std::uint8_t master_seed_[SharingRandomnessGenerator::kMasterSeedByteLength] = {0};
   std::uint8_t raw_key_arithmetic_[kAesKeySize] = {0};
   std::uint8_t raw_key_boolean_[kAesKeySize] = {0};  /// AES key in raw std::uint8_t format
-  std::uint8_t aes_ctr_nonce_arithmetic_[AES_BLOCK_SIZE / 2] = {0};
-  std::uint8_t aes_ctr_nonce_boolean_[AES_BLOCK_SIZE / 2] = {0};  /// Raw AES CTR nonce that is used
-  /// in the left part of IV
 
-  primitives::Prg prg_a, prg_b;
+  /// Expanded AES round keys for the AES-NI counter mode
+  alignas(kAesBlockSize) std::array<std::byte, kAesRoundKeysSize128> round_keys_arithmetic_;
+  alignas(kAesBlockSize) std::array<std::byte, kAesRoundKeysSize128> round_keys_boolean_;
 
   enum KeyType : unsigned int {
     kArithmeticGmwKey = 0,
@@ -187,13 +163,6 @@ class SharingRandomnessGenerator {
 
   bool initialized_ = false;
 
-  BitVector<> random_bits_;
-
-  std::size_t random_bits_offset_ = 0;
-  std::size_t random_bits_used_ = 0;
-
-  boost::fibers::mutex random_bits_mutex_;
-
   std::unique_ptr<FiberCondition> initialized_condition_;
 };
 }  // namespace encrypto::motion::primitives
@@ -26,12 +26,15 @@
 
 #include <fmt/format.h>
 #include <math.h>
+#include <algorithm>
+#include <cstring>
 
 #include "base/backend.h"
 #include "base/register.h"
 #include "communication/communication_layer.h"
 #include "communication/output_message.h"
 #include "multiplication_triple/mt_provider.h"
+#include "multiplication_triple/sb_provider.h"
 #include "multiplication_triple/sp_provider.h"
 #include "primitives/sharing_randomness_generator.h"
 #include "protocols/boolean_gmw/boolean_gmw_wire.h"
@@ -89,14 +92,14 @@ void InputGate<T>::EvaluateOnline() {
 
   if (static_cast<std::size_t>(input_owner_id_) == my_id) {
     result.resize(input_.size());
+    std::vector<T> randomness(input_.size());
     auto log_string = std::string("");
     for (auto party_id = 0u; party_id < number_of_parties; ++party_id) {
       if (party_id == my_id) {
         continue;
       }
       auto& randomness_generator = GetBaseProvider().GetMyRandomnessGenerator(party_id);
-      auto randomness =
-          randomness_generator.template GetUnsigned<T>(arithmetic_sharing_id_, input_.size());
+      randomness_generator.template FillUnsigned<T>(arithmetic_sharing_id_, randomness);
       if constexpr (kVerboseDebug) {
         log_string.append(fmt::format("id#{}:{} ", party_id, randomness.at(0)));
       }
@@ -117,7 +120,8 @@ void InputGate<T>::EvaluateOnline() {
     }
   } else {
     auto& randomness_generator = GetBaseProvider().GetTheirRandomnessGenerator(input_owner_id_);
-    result = randomness_generator.template GetUnsigned<T>(arithmetic_sharing_id_, input_.size());
+    result.resize(input_.size());
+    randomness_generator.template FillUnsigned<T>(arithmetic_sharing_id_, result);
 
     if constexpr (kVerboseDebug) {
       auto s = fmt::format(
@@ -152,12 +156,150 @@ arithmetic_gmw::WirePointer<T> InputGate<T>::GetOutputArithmeticWire() {
   return result;
 }
 
+template <typename T>
+void InputGate<T>::SetInput(std::vector<T>&& input) {
+  if (input.size() != input_.size()) {
+    throw std::invalid_argument(fmt::format("arithmetic_gmw::InputGate#{} expects {} SIMD values",
+                                            gate_id_, input_.size()));
+  }
+  input_ = std::move(input);
+}
+
+template <typename T>
+void InputGate<T>::DynamicClear() {
+  arithmetic_sharing_id_ = GetRegister().NextArithmeticSharingId(input_.size());
+}
+
 template class InputGate<std::uint8_t>;
 template class InputGate<std::uint16_t>;
 template class InputGate<std::uint32_t>;
 template class InputGate<std::uint64_t>;
 template class InputGate<__uint128_t>;
 
+template <typename T>
+InputTableGate<T>::InputTableGate(std::vector<std::vector<T>>&& columns, std::size_t input_owner,
+                                  Backend& backend)
+    : Base(backend), columns_(std::move(columns)) {
+  input_owner_id_ = input_owner;
+  auto& communication_layer = GetCommunicationLayer();
+  if (static_cast<std::size_t>(input_owner_id_) >= communication_layer.GetNumberOfParties()) {
+    throw std::runtime_error(fmt::format("Invalid input owner: {} of {}", input_owner_id_,
+                                         communication_layer.GetNumberOfParties()));
+  }
+  if (columns_.empty() || columns_.at(0).empty()) {
+    throw std::invalid_argument("arithmetic_gmw::InputTableGate expects a non-empty table");
+  }
+  number_of_rows_ = columns_.at(0).size();
+  for (const auto& column : columns_) {
+    if (column.size() != number_of_rows_) {
+      throw std::invalid_argument(fmt::format(
+          "arithmetic_gmw::InputTableGate expects all columns to have {} rows", number_of_rows_));
+    }
+  }
+
+  gate_id_ = GetRegister().NextGateId();
+  arithmetic_sharing_id_ =
+      GetRegister().NextArithmeticSharingId(columns_.size() * number_of_rows_);
+
+  output_wires_.reserve(columns_.size());
+  for (std::size_t column = 0; column < columns_.size(); ++column) {
+    output_wires_.push_back(
+        GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(backend_, number_of_rows_));
+  }
+
+  auto gate_info = fmt::format("uint{}_t type, gate id {}, owner {}, {} columns of {} rows",
+                               sizeof(T) * 8, gate_id_, input_owner_id_, columns_.size(),
+                               number_of_rows_);
+  GetLogger().LogDebug(fmt::format(
+      "Allocate an arithmetic_gmw::InputTableGate with following properties: {}", gate_info));
+}
+
+template <typename T>
+void InputTableGate<T>::EvaluateSetup() {}
+
+template <typename T>
+void InputTableGate<T>::EvaluateOnline() {
+  GetBaseProvider().WaitForSetup();
+
+  auto& communication_layer = GetCommunicationLayer();
+  auto my_id = communication_layer.GetMyId();
+  auto number_of_parties = communication_layer.GetNumberOfParties();
+
+  // the randomness of all columns is laid out column by column in a single buffer
+  std::vector<T> randomness(columns_.size() * number_of_rows_);
+
+  if (static_cast<std::size_t>(input_owner_id_) == my_id) {
+    std::vector<T> masks(randomness.size());
+    for (auto party_id = 0u; party_id < number_of_parties; ++party_id) {
+      if (party_id == my_id) {
+        continue;
+      }
+      auto& randomness_generator = GetBaseProvider().GetMyRandomnessGenerator(party_id);
+      randomness_generator.template FillUnsigned<T>(arithmetic_sharing_id_, randomness);
+      for (std::size_t i = 0; i < masks.size(); ++i) {
+        masks[i] += randomness[i];
+      }
+    }
+    for (std::size_t column = 0; column < columns_.size(); ++column) {
+      auto wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(column));
+      assert(wire);
+      auto& values = wire->GetAllocatedValues();
+      const T* column_masks = masks.data() + column * number_of_rows_;
+      for (std::size_t row = 0; row < number_of_rows_; ++row) {
+        values[row] = columns_[column][row] - column_masks[row];
+      }
+    }
+  } else {
+    auto& randomness_generator = GetBaseProvider().GetTheirRandomnessGenerator(input_owner_id_);
+    randomness_generator.template FillUnsigned<T>(arithmetic_sharing_id_, randomness);
+    for (std::size_t column = 0; column < columns_.size(); ++column) {
+      auto wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(column));
+      assert(wire);
+      const auto column_begin = randomness.begin() + column * number_of_rows_;
+      wire->GetMutableValues().assign(column_begin, column_begin + number_of_rows_);
+    }
+  }
+
+  GetLogger().LogDebug(
+      fmt::format("Evaluated arithmetic_gmw::InputTableGate with id#{}", gate_id_));
+}
+
+template <typename T>
+std::vector<arithmetic_gmw::SharePointer<T>> InputTableGate<T>::GetOutputAsArithmeticShares() {
+  std::vector<arithmetic_gmw::SharePointer<T>> result;
+  result.reserve(output_wires_.size());
+  for (auto& wire : output_wires_) {
+    auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(wire);
+    assert(arithmetic_wire);
+    result.push_back(std::make_shared<arithmetic_gmw::Share<T>>(arithmetic_wire));
+  }
+  return result;
+}
+
+template <typename T>
+void InputTableGate<T>::SetInput(std::vector<std::vector<T>>&& columns) {
+  if (columns.size() != columns_.size() ||
+      std::any_of(columns.begin(), columns.end(),
+                  [this](const auto& column) { return column.size() != number_of_rows_; })) {
+    throw std::invalid_argument(
+        fmt::format("arithmetic_gmw::InputTableGate#{} expects {} columns of {} rows", gate_id_,
+                    columns_.size(), number_of_rows_));
+  }
+  columns_ = std::move(columns);
+}
+
+template <typename T>
+void InputTableGate<T>::DynamicClear() {
+  arithmetic_sharing_id_ =
+      GetRegister().NextArithmeticSharingId(columns_.size() * number_of_rows_);
+}
+
+template class InputTableGate<std::uint8_t>;
+template class InputTableGate<std::uint16_t>;
+template class InputTableGate<std::uint32_t>;
+template class InputTableGate<std::uint64_t>;
+template class InputTableGate<__uint128_t>;
+
 template <typename T>
 OutputGate<T>::OutputGate(const arithmetic_gmw::WirePointer<T>& parent, std::size_t output_owner)
     : Base(parent->GetBackend()) {
@@ -259,13 +401,15 @@ void OutputGate<T>::EvaluateOnline() {
 
   // we receive shares from other parties
   if (is_my_output_) {
-    // collect shares from all parties
+    // collect shares from all parties, they are only kept for the debug output below
     std::vector<std::vector<T>> shared_outputs;
-    shared_outputs.reserve(number_of_parties);
+    if constexpr (kVerboseDebug) {
+      shared_outputs.resize(number_of_parties);
+      shared_outputs.at(my_id) = output;
+    }
 
     for (std::size_t i = 0; i < number_of_parties; ++i) {
       if (i == my_id) {
-        shared_outputs.push_back(output);
         continue;
       }
       const auto output_message = output_message_futures_.at(i).get();
@@ -274,18 +418,19 @@ void OutputGate<T>::EvaluateOnline() {
       assert(output_message_pointer);
       assert(output_message_pointer->wires()->size() == 1);
 
-      shared_outputs.push_back(
-          FromByteVector<T>(*output_message_pointer->wires()->Get(0)->payload()));
-      assert(shared_outputs[i].size() == parent_[0]->GetNumberOfSimdValues());
-    }
+      const auto payload = output_message_pointer->wires()->Get(0)->payload();
+      assert(payload->size() == parent_[0]->GetNumberOfSimdValues() * sizeof(T));
+      if constexpr (kVerboseDebug) {
+        shared_outputs.at(i) = FromByteVector<T>(*payload);
+      }
 
-    // reconstruct the shared value
-    if constexpr (kVerboseDebug) {
-      // we need to copy since we have to keep shared_outputs for the debug output below
-      output = AddVectors(shared_outputs);
-    } else {
-      // we can move
-      output = AddVectors(std::move(shared_outputs));
+      // reconstruct the shared value by reading the share directly from the received buffer,
+      // which is not necessarily aligned for T
+      for (std::size_t j = 0; j < output.size(); ++j) {
+        T share;
+        std::memcpy(&share, payload->data() + j * sizeof(T), sizeof(T));
+        output[j] += share;
+      }
     }
 
     // set the value of the output wire
@@ -347,6 +492,8 @@ AdditionGate<T>::AdditionGate(const arithmetic_gmw::WirePointer<T>& a,
   RegisterWaitingFor(parent_b_.at(0)->GetWireId());
   parent_b_.at(0)->RegisterWaitingGate(gate_id_);
 
+  // the output values are allocated in the online phase, such that only gates which are being
+  // evaluated hold their values
   output_wires_ = {GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(
       backend_, a->GetNumberOfSimdValues())};
 
@@ -372,11 +519,8 @@ void AdditionGate<T>::EvaluateOnline() {
   assert(wire_a);
   assert(wire_b);
 
-  std::vector<T> output;
-  output = RestrictAddVectors(wire_a->GetValues(), wire_b->GetValues());
-
   auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
-  arithmetic_wire->GetMutableValues() = std::move(output);
+  AddVectors<T>(wire_a->GetValues(), wire_b->GetValues(), arithmetic_wire->GetAllocatedValues());
 
   GetLogger().LogDebug(fmt::format("Evaluated arithmetic_gmw::AdditionGate with id#{}", gate_id_));
 }
@@ -440,10 +584,8 @@ void SubtractionGate<T>::EvaluateOnline() {
   assert(wire_a);
   assert(wire_b);
 
-  std::vector<T> output = SubVectors(wire_a->GetValues(), wire_b->GetValues());
-
   auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
-  arithmetic_wire->GetMutableValues() = std::move(output);
+  SubVectors<T>(wire_a->GetValues(), wire_b->GetValues(), arithmetic_wire->GetAllocatedValues());
 
   GetLogger().LogDebug(
       fmt::format("Evaluated arithmetic_gmw::SubtractionGate with id#{}", gate_id_));
@@ -475,13 +617,15 @@ MultiplicationGate<T>::MultiplicationGate(const arithmetic_gmw::WirePointer<T>&
   requires_online_interaction_ = true;
   gate_type_ = GateType::kInteractive;
 
-  d_ = GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(backend_,
-                                                                   a->GetNumberOfSimdValues());
-  e_ = GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(backend_,
-                                                                   a->GetNumberOfSimdValues());
+  d_ = GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(
+      backend_, a->GetNumberOfSimdValues());
+  e_ = GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(
+      backend_, a->GetNumberOfSimdValues());
 
   d_output_ = GetRegister().template EmplaceGate<OutputGate<T>>(d_);
   e_output_ = GetRegister().template EmplaceGate<OutputGate<T>>(e_);
+  d_output_->SetEnclosingGate(this);
+  e_output_->SetEnclosingGate(this);
 
   gate_id_ = GetRegister().NextGateId();
 
@@ -516,27 +660,18 @@ void MultiplicationGate<T>::EvaluateOnline() {
   auto& mt_provider = GetMtProvider();
   mt_provider.WaitFinished();
   const auto& mts = mt_provider.template GetIntegerAll<T>();
+  const std::span<const T> mts_a{mts.a.data() + mt_offset_, number_of_mts_};
+  const std::span<const T> mts_b{mts.b.data() + mt_offset_, number_of_mts_};
+  const std::span<const T> mts_c{mts.c.data() + mt_offset_, number_of_mts_};
   {
     const auto x = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_a_.at(0));
     assert(x);
-    d_->GetMutableValues() = std::vector<T>(
-        mts.a.begin() + mt_offset_, mts.a.begin() + mt_offset_ + x->GetNumberOfSimdValues());
-    T* __restrict__ d_v = d_->GetMutableValues().data();
-    const T* __restrict__ x_v = x->GetValues().data();
-    const auto number_of_simd_values{x->GetNumberOfSimdValues()};
-
-    std::transform(x_v, x_v + number_of_simd_values, d_v, d_v,
-                   [](const T& a, const T& b) { return a + b; });
+    AddVectors<T>(x->GetValues(), mts_a, d_->GetAllocatedValues());
     d_->SetOnlineFinished();
 
     const auto y = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_b_.at(0));
     assert(y);
-    e_->GetMutableValues() = std::vector<T>(
-        mts.b.begin() + mt_offset_, mts.b.begin() + mt_offset_ + x->GetNumberOfSimdValues());
-    T* __restrict__ e_v = e_->GetMutableValues().data();
-    const T* __restrict__ y_v = y->GetValues().data();
-    std::transform(y_v, y_v + number_of_simd_values, e_v, e_v,
-                   [](const T& a, const T& b) { return a + b; });
+    AddVectors<T>(y->GetValues(), mts_b, e_->GetAllocatedValues());
     e_->SetOnlineFinished();
   }
 
@@ -561,24 +696,25 @@ void MultiplicationGate<T>::EvaluateOnline() {
 
   auto output = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
   assert(output);
-  output->GetMutableValues() =
-      std::vector<T>(mts.c.begin() + mt_offset_,
-                     mts.c.begin() + mt_offset_ + parent_a_.at(0)->GetNumberOfSimdValues());
 
   const T* __restrict__ d{d_w->GetValues().data()};
   const T* __restrict__ s_x{x_i_w->GetValues().data()};
   const T* __restrict__ e{e_w->GetValues().data()};
   const T* __restrict__ s_y{y_i_w->GetValues().data()};
-  T* __restrict__ output_pointer{output->GetMutableValues().data()};
+  const T* __restrict__ c{mts_c.data()};
+  T* __restrict__ output_pointer{output->GetAllocatedValues().data()};
 
+  // fused c + d * y + e * x (- e * d), writing into the output values
   if (GetCommunicationLayer().GetMyId() ==
       (gate_id_ % GetCommunicationLayer().GetNumberOfParties())) {
-    for (auto i = 0ull; i < output->GetNumberOfSimdValues(); ++i) {
-      output_pointer[i] += (d[i] * s_y[i]) + (e[i] * s_x[i]) - (e[i] * d[i]);
+#pragma omp simd
+    for (std::size_t i = 0; i < number_of_mts_; ++i) {
+      output_pointer[i] = c[i] + (d[i] * s_y[i]) + (e[i] * s_x[i]) - (e[i] * d[i]);
     }
   } else {
-    for (auto i = 0ull; i < output->GetNumberOfSimdValues(); ++i) {
-      output_pointer[i] += (d[i] * s_y[i]) + (e[i] * s_x[i]);
+#pragma omp simd
+    for (std::size_t i = 0; i < number_of_mts_; ++i) {
+      output_pointer[i] = c[i] + (d[i] * s_y[i]) + (e[i] * s_x[i]);
     }
   }
 
@@ -722,9 +858,10 @@ SquareGate<T>::SquareGate(const arithmetic_gmw::WirePointer<T>& a) : OneGate(a->
   requires_online_interaction_ = true;
   gate_type_ = GateType::kInteractive;
 
-  d_ = GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(backend_,
-                                                                   a->GetNumberOfSimdValues());
+  d_ = GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(
+      backend_, a->GetNumberOfSimdValues());
   d_output_ = GetRegister().template EmplaceGate<OutputGate<T>>(d_);
+  d_output_->SetEnclosingGate(this);
 
   gate_id_ = GetRegister().NextGateId();
 
@@ -754,16 +891,12 @@ void SquareGate<T>::EvaluateOnline() {
   auto& sp_provider = GetSpProvider();
   sp_provider.WaitFinished();
   const auto& sps = sp_provider.template GetSpsAll<T>();
+  const std::span<const T> sps_a{sps.a.data() + sp_offset_, number_of_sps_};
+  const std::span<const T> sps_c{sps.c.data() + sp_offset_, number_of_sps_};
   {
     const auto x = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_.at(0));
     assert(x);
-    d_->GetMutableValues() = std::vector<T>(
-        sps.a.begin() + sp_offset_, sps.a.begin() + sp_offset_ + x->GetNumberOfSimdValues());
-    T* __restrict__ d_v{d_->GetMutableValues().data()};
-    const T* __restrict__ x_v{x->GetValues().data()};
-    const auto number_of_simd_values{x->GetNumberOfSimdValues()};
-    std::transform(x_v, x_v + number_of_simd_values, d_v, d_v,
-                   [](const T& a, const T& b) { return a + b; });
+    AddVectors<T>(x->GetValues(), sps_a, d_->GetAllocatedValues());
     d_->SetOnlineFinished();
   }
 
@@ -781,21 +914,21 @@ void SquareGate<T>::EvaluateOnline() {
 
   auto output = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
   assert(output);
-  output->GetMutableValues() =
-      std::vector<T>(sps.c.begin() + sp_offset_,
-                     sps.c.begin() + sp_offset_ + parent_.at(0)->GetNumberOfSimdValues());
 
   const T* __restrict__ d{d_w->GetValues().data()};
   const T* __restrict__ s_x{x_i_w->GetValues().data()};
-  T* __restrict__ output_pointer{output->GetMutableValues().data()};
+  const T* __restrict__ c{sps_c.data()};
+  T* __restrict__ output_pointer{output->GetAllocatedValues().data()};
   if (GetCommunicationLayer().GetMyId() ==
       (gate_id_ % GetCommunicationLayer().GetNumberOfParties())) {
-    for (auto i = 0ull; i < output->GetNumberOfSimdValues(); ++i) {
-      output_pointer[i] += 2 * (d[i] * s_x[i]) - (d[i] * d[i]);
+#pragma omp simd
+    for (std::size_t i = 0; i < number_of_sps_; ++i) {
+      output_pointer[i] = c[i] + 2 * (d[i] * s_x[i]) - (d[i] * d[i]);
     }
   } else {
-    for (auto i = 0ull; i < output->GetNumberOfSimdValues(); ++i) {
-      output_pointer[i] += 2 * (d[i] * s_x[i]);
+#pragma omp simd
+    for (std::size_t i = 0; i < number_of_sps_; ++i) {
+      output_pointer[i] = c[i] + 2 * (d[i] * s_x[i]);
     }
   }
 
@@ -816,4 +949,240 @@ template class SquareGate<std::uint32_t>;
 template class SquareGate<std::uint64_t>;
 template class SquareGate<__uint128_t>;
 
+template <typename T>
+TruncationGate<T>::TruncationGate(const arithmetic_gmw::WirePointer<T>& a, std::size_t shift)
+    : OneGate(a->GetBackend()), shift_(shift) {
+  constexpr auto kBitLength = sizeof(T) * 8;
+  if (shift >= kBitLength) {
+    throw std::invalid_argument(fmt::format(
+        "TruncationGate cannot shift {}-bit values by {} bits", kBitLength, shift));
+  }
+
+  parent_ = {std::static_pointer_cast<motion::Wire>(a)};
+
+  requires_online_interaction_ = true;
+  gate_type_ = GateType::kInteractive;
+
+  const auto number_of_simd = a->GetNumberOfSimdValues();
+  d_ = GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(backend_, number_of_simd);
+  d_output_ = GetRegister().template EmplaceGate<OutputGate<T>>(d_);
+  d_output_->SetEnclosingGate(this);
+
+  gate_id_ = GetRegister().NextGateId();
+
+  RegisterWaitingFor(parent_.at(0)->GetWireId());
+  parent_.at(0)->RegisterWaitingGate(gate_id_);
+
+  output_wires_ = {
+      GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(backend_, number_of_simd)};
+
+  // one shared bit per bit of the mask r
+  number_of_sbs_ = number_of_simd * kBitLength;
+  sb_offset_ = GetSbProvider().template RequestSbs<T>(number_of_sbs_);
+
+  auto gate_info = fmt::format("uint{}_t type, gate id {}, parent: {}, shift: {}", kBitLength,
+                               gate_id_, parent_.at(0)->GetWireId(), shift_);
+  GetLogger().LogDebug(fmt::format(
+      "Created an arithmetic_gmw::TruncationGate with following properties: {}", gate_info));
+}
+
+template <typename T>
+void TruncationGate<T>::EvaluateSetup() {}
+
+template <typename T>
+void TruncationGate<T>::EvaluateOnline() {
+  // nothing to setup, no need to wait/check
+  parent_.at(0)->GetIsReadyCondition().Wait();
+
+  auto& sb_provider = GetSbProvider();
+  sb_provider.WaitFinished();
+
+  constexpr auto kBitLength = sizeof(T) * 8;
+  // avoid the promotion of small types to signed int, which may overflow when shifted
+  using U = std::conditional_t<(sizeof(T) < sizeof(unsigned)), unsigned, T>;
+  const auto number_of_simd = parent_.at(0)->GetNumberOfSimdValues();
+  {
+    const auto x = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_.at(0));
+    assert(x);
+    // the shared bits are stored bit-major, i.e., bit j of the i-th mask is at j * simd + i
+    const T* __restrict__ sbs{sb_provider.template GetSbsAll<T>().data() + sb_offset_};
+    T* __restrict__ d{d_->GetAllocatedValues().data()};
+    truncated_mask_.resize(number_of_simd);
+    T* __restrict__ truncated_mask{truncated_mask_.data()};
+    std::copy_n(x->GetValues().data(), number_of_simd, d);
+    std::fill_n(truncated_mask, number_of_simd, T(0));
+    for (std::size_t j = 0; j < kBitLength; ++j) {
+      const T* __restrict__ bits{sbs + j * number_of_simd};
+#pragma omp simd
+      for (std::size_t i = 0; i < number_of_simd; ++i) {
+        d[i] += static_cast<T>(static_cast<U>(bits[i]) << j);
+      }
+      if (j >= shift_) {
+#pragma omp simd
+        for (std::size_t i = 0; i < number_of_simd; ++i) {
+          truncated_mask[i] += static_cast<T>(static_cast<U>(bits[i]) << (j - shift_));
+        }
+      }
+    }
+    d_->SetOnlineFinished();
+  }
+
+  d_output_->WaitOnline();
+
+  const auto& d_clear = d_output_->GetOutputWires().at(0);
+  d_clear->GetIsReadyCondition().Wait();
+  const auto d_w = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(d_clear);
+  assert(d_w);
+
+  auto output = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+  assert(output);
+
+  // (x + r) >> shift - (r >> shift)
+  const T* __restrict__ d{d_w->GetValues().data()};
+  const T* __restrict__ truncated_mask{truncated_mask_.data()};
+  T* __restrict__ output_pointer{output->GetAllocatedValues().data()};
+  if (GetCommunicationLayer().GetMyId() ==
+      (gate_id_ % GetCommunicationLayer().GetNumberOfParties())) {
+#pragma omp simd
+    for (std::size_t i = 0; i < number_of_simd; ++i) {
+      output_pointer[i] = static_cast<T>(d[i] >> shift_) - truncated_mask[i];
+    }
+  } else {
+#pragma omp simd
+    for (std::size_t i = 0; i < number_of_simd; ++i) {
+      output_pointer[i] = -truncated_mask[i];
+    }
+  }
+
+  GetLogger().LogDebug(
+      fmt::format("Evaluated arithmetic_gmw::TruncationGate with id#{}", gate_id_));
+}
+
+template <typename T>
+arithmetic_gmw::SharePointer<T> TruncationGate<T>::GetOutputAsArithmeticShare() {
+  auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+  assert(arithmetic_wire);
+  auto result = std::make_shared<arithmetic_gmw::Share<T>>(arithmetic_wire);
+  return result;
+}
+
+template class TruncationGate<std::uint8_t>;
+template class TruncationGate<std::uint16_t>;
+template class TruncationGate<std::uint32_t>;
+template class TruncationGate<std::uint64_t>;
+
+template <typename T>
+MatrixMultiplicationGate<T>::MatrixMultiplicationGate(const arithmetic_gmw::WirePointer<T>& a,
+                                                      const arithmetic_gmw::WirePointer<T>& b,
+                                                      std::size_t rows, std::size_t inner,
+                                                      std::size_t columns)
+    : TwoGate(a->GetBackend()), rows_(rows), inner_(inner), columns_(columns) {
+  if (a->GetNumberOfSimdValues() != rows * inner || b->GetNumberOfSimdValues() != inner * columns) {
+    throw std::invalid_argument(fmt::format(
+        "MatrixMultiplicationGate expects {}x{} and {}x{} matrices, but got {} and {} SIMD values",
+        rows, inner, inner, columns, a->GetNumberOfSimdValues(), b->GetNumberOfSimdValues()));
+  }
+
+  parent_a_ = {std::static_pointer_cast<motion::Wire>(a)};
+  parent_b_ = {std::static_pointer_cast<motion::Wire>(b)};
+
+  requires_online_interaction_ = true;
+  gate_type_ = GateType::kInteractive;
+
+  d_ = GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(backend_, rows * inner);
+  e_ = GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(backend_, inner * columns);
+
+  d_output_ = GetRegister().template EmplaceGate<OutputGate<T>>(d_);
+  e_output_ = GetRegister().template EmplaceGate<OutputGate<T>>(e_);
+  d_output_->SetEnclosingGate(this);
+  e_output_->SetEnclosingGate(this);
+
+  gate_id_ = GetRegister().NextGateId();
+
+  RegisterWaitingFor(parent_a_.at(0)->GetWireId());
+  parent_a_.at(0)->RegisterWaitingGate(gate_id_);
+
+  RegisterWaitingFor(parent_b_.at(0)->GetWireId());
+  parent_b_.at(0)->RegisterWaitingGate(gate_id_);
+
+  output_wires_ = {
+      GetRegister().template EmplaceWire<arithmetic_gmw::Wire<T>>(backend_, rows * columns)};
+
+  matrix_mt_id_ = GetMtProvider().template RequestMatrixMt<T>(rows, inner, columns);
+
+  auto gate_info = fmt::format("uint{}_t type, gate id {}, parents: {}, {}, dimensions {}x{}x{}",
+                               sizeof(T) * 8, gate_id_, parent_a_.at(0)->GetWireId(),
+                               parent_b_.at(0)->GetWireId(), rows, inner, columns);
+  GetLogger().LogDebug(fmt::format(
+      "Created an arithmetic_gmw::MatrixMultiplicationGate with following properties: {}",
+      gate_info));
+}
+
+template <typename T>
+void MatrixMultiplicationGate<T>::EvaluateSetup() {}
+
+template <typename T>
+void MatrixMultiplicationGate<T>::EvaluateOnline() {
+  // nothing to setup, no need to wait/check
+  parent_a_.at(0)->GetIsReadyCondition().Wait();
+  parent_b_.at(0)->GetIsReadyCondition().Wait();
+
+  const auto& mt = GetMtProvider().template GetMatrixMt<T>(matrix_mt_id_);
+  const auto x = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_a_.at(0));
+  const auto y = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_b_.at(0));
+  assert(x);
+  assert(y);
+
+  // D = X + A and E = Y + B
+  AddVectors<T>(x->GetValues(), mt.a, d_->GetAllocatedValues());
+  d_->SetOnlineFinished();
+  AddVectors<T>(y->GetValues(), mt.b, e_->GetAllocatedValues());
+  e_->SetOnlineFinished();
+
+  d_output_->WaitOnline();
+  e_output_->WaitOnline();
+
+  const auto d_w =
+      std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(d_output_->GetOutputWires().at(0));
+  const auto e_w =
+      std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(e_output_->GetOutputWires().at(0));
+  assert(d_w);
+  assert(e_w);
+  d_w->GetIsReadyCondition().Wait();
+  e_w->GetIsReadyCondition().Wait();
+
+  auto output = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+  assert(output);
+  auto& output_values = output->GetAllocatedValues();
+
+  // XY = C + DY + XE - DE, where one party computes C + DY + (X - D)E and the others C + DY + XE
+  std::copy(mt.c.begin(), mt.c.end(), output_values.begin());
+  MatrixMultiplyAdd<T>(d_w->GetValues(), y->GetValues(), output_values, rows_, inner_, columns_);
+  if (GetCommunicationLayer().GetMyId() !=
+      (gate_id_ % GetCommunicationLayer().GetNumberOfParties())) {
+    MatrixMultiplyAdd<T>(x->GetValues(), e_w->GetValues(), output_values, rows_, inner_, columns_);
+  } else {
+    x_minus_d_.resize(rows_ * inner_);
+    SubVectors<T>(x->GetValues(), d_w->GetValues(), x_minus_d_);
+    MatrixMultiplyAdd<T>(x_minus_d_, e_w->GetValues(), output_values, rows_, inner_, columns_);
+  }
+
+  GetLogger().LogDebug(
+      fmt::format("Evaluated arithmetic_gmw::MatrixMultiplicationGate with id#{}", gate_id_));
+}
+
+template <typename T>
+arithmetic_gmw::SharePointer<T> MatrixMultiplicationGate<T>::GetOutputAsArithmeticShare() {
+  auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+  assert(arithmetic_wire);
+  auto result = std::make_shared<arithmetic_gmw::Share<T>>(arithmetic_wire);
+  return result;
+}
+
+template class MatrixMultiplicationGate<std::uint8_t>;
+template class MatrixMultiplicationGate<std::uint16_t>;
+template class MatrixMultiplicationGate<std::uint32_t>;
+template class MatrixMultiplicationGate<std::uint64_t>;
+// template class MatrixMultiplicationGate<__uint128_t>; not yet supported
+
 }  // namespace encrypto::motion::proto::arithmetic_gmw
@@ -33,6 +33,7 @@
 #include "base/motion_base_provider.h"
 #include "communication/fbs_headers/output_message_generated.h"
 #include "multiplication_triple/mt_provider.h"
+#include "multiplication_triple/sb_provider.h"
 #include "multiplication_triple/sp_provider.h"
 #include "protocols/gate.h"
 #include "utility/reusable_future.h"
@@ -77,12 +78,62 @@ class InputGate final : public motion::InputGate {
   arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare();
   arithmetic_gmw::WirePointer<T> GetOutputArithmeticWire();
 
+  /// \brief Replaces the input for the following evaluations of the circuit
+  /// \throws std::invalid_argument if the number of SIMD values differs from the initial input
+  void SetInput(std::vector<T>&& input);
+
+ protected:
+  /// draws a fresh sharing id, s.t. a repeated evaluation uses fresh sharing randomness
+  void DynamicClear() final override;
+
  private:
   std::size_t arithmetic_sharing_id_;
 
   std::vector<T> input_;
 };
 
+/// \brief Shares a whole table of inputs, i.e., a set of columns with the same number of rows, in
+/// a single gate.
+///
+/// Each column gets its own output wire, but the sharing randomness for all columns is expanded in
+/// one bulk call per party, s.t. the overhead is constant per table instead of per column.
+template <typename T>
+class InputTableGate final : public motion::InputGate {
+  using Base = motion::InputGate;
+
+ public:
+  /// \throws std::runtime_error if input_owner is not a valid party id
+  /// \throws std::invalid_argument if the table is empty or the columns differ in their lengths
+  InputTableGate(std::vector<std::vector<T>>&& columns, std::size_t input_owner,
+                 Backend& backend);
+
+  ~InputTableGate() final = default;
+
+  void EvaluateSetup() final override;
+
+  void EvaluateOnline() final override;
+
+  bool NeedsSetup() const override { return false; }
+
+  /// \brief Returns one share per column
+  std::vector<arithmetic_gmw::SharePointer<T>> GetOutputAsArithmeticShares();
+
+  /// \brief Replaces the table for the following evaluations of the circuit
+  /// \throws std::invalid_argument if the dimensions differ from the ones of the initial table
+  void SetInput(std::vector<std::vector<T>>&& columns);
+
+ protected:
+  /// draws a fresh sharing id, s.t. a repeated evaluation uses fresh sharing randomness
+  void DynamicClear() final override;
+
+ private:
+  std::size_t arithmetic_sharing_id_;
+
+  std::size_t number_of_rows_;
+
+  std::vector<std::vector<T>> columns_;
+};
+
 constexpr std::size_t kAll = std::numeric_limits<std::int64_t>::max();
 
 template <typename T>
@@ -109,7 +160,8 @@ class OutputGate final : public motion::OutputGate {
   // indicates whether this party obtains the output
   bool is_my_output_ = false;
 
-  std::vector<motion::ReusableFiberFuture<std::vector<std::uint8_t>>> output_message_futures_;
+  std::vector<motion::ReusableFiberFuture<communication::MessageBuffer>>
+      output_message_futures_;
 
   std::mutex m;
 };
@@ -231,4 +283,85 @@ class SquareGate final : public motion::OneGate {
   std::size_t number_of_sps_, sp_offset_;
 };
 
+// Probabilistic truncation of the two's complement values of a by a public number of bits, e.g.,
+// to rescale fixed-point values after a multiplication. Uses a truncation pair (r, r >> shift)
+// composed of bitlength shared bits and opens x + r, i.e., a single round. The result may be off
+// by one in the least significant bit and is wrong with probability |x| / 2^bitlength.
+template <typename T>
+class TruncationGate final : public motion::OneGate {
+ public:
+  TruncationGate(const arithmetic_gmw::WirePointer<T>& a, std::size_t shift);
+  ~TruncationGate() final = default;
+
+  void EvaluateSetup() final override;
+  void EvaluateOnline() final override;
+
+  bool NeedsSetup() const override { return false; }
+
+  // perhaps, we should return a copy of the pointer and not move it for the case we need it
+  // multiple times
+  arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare();
+
+  TruncationGate() = delete;
+  TruncationGate(Gate&) = delete;
+
+ private:
+  std::size_t shift_;
+
+  arithmetic_gmw::WirePointer<T> d_;
+  std::shared_ptr<OutputGate<T>> d_output_;
+
+  std::size_t number_of_sbs_, sb_offset_;
+
+  // shares of r >> shift
+  std::vector<T> truncated_mask_;
+};
+
+// Product of the row-major matrices a (rows x inner) and b (inner x columns), stored as the SIMD
+// values of the parent wires, using a matrix MT. Only the masked inputs are opened, i.e.,
+// rows * inner + inner * columns values instead of 2 * rows * inner * columns with MTs.
+template <typename T>
+class MatrixMultiplicationGate : public motion::TwoGate {
+ public:
+  MatrixMultiplicationGate(const arithmetic_gmw::WirePointer<T>& a,
+                           const arithmetic_gmw::WirePointer<T>& b, std::size_t rows,
+                           std::size_t inner, std::size_t columns);
+  ~MatrixMultiplicationGate() override = default;
+
+  void EvaluateSetup() final override;
+  void EvaluateOnline() final override;
+
+  bool NeedsSetup() const override { return false; }
+
+  // perhaps, we should return a copy of the pointer and not move it for the case we need it
+  // multiple times
+  arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare();
+
+  MatrixMultiplicationGate() = delete;
+  MatrixMultiplicationGate(Gate&) = delete;
+
+ private:
+  std::size_t rows_, inner_, columns_;
+
+  arithmetic_gmw::WirePointer<T> d_, e_;
+  std::shared_ptr<OutputGate<T>> d_output_, e_output_;
+
+  std::size_t matrix_mt_id_;
+
+  // x - d for the party that accounts for the d * e term, allocated in the online phase
+  std::vector<T> x_minus_d_;
+};
+
+// Inner product of the SIMD values of a and b, i.e., a 1 x n times n x 1 matrix multiplication.
+template <typename T>
+class DotProductGate final : public MatrixMultiplicationGate<T> {
+ public:
+  DotProductGate(const arithmetic_gmw::WirePointer<T>& a, const arithmetic_gmw::WirePointer<T>& b)
+      : MatrixMultiplicationGate<T>(a, b, 1, a->GetNumberOfSimdValues(), 1) {}
+  ~DotProductGate() final = default;
+
+  DotProductGate() = delete;
+  DotProductGate(Gate&) = delete;
+};
+
 }  // namespace encrypto::motion::proto::arithmetic_gmw
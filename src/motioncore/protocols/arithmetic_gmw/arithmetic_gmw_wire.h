@@ -54,6 +54,14 @@ class Wire final : public motion::Wire {
 
   std::vector<T>& GetMutableValues() { return values_; }
 
+  /// \brief Gets the values for writing them. Gates create their output wires without values and
+  ///        allocate them only when they are evaluated, such that the circuit's memory does not
+  ///        grow with the number of not yet evaluated gates.
+  std::vector<T>& GetAllocatedValues() {
+    values_.resize(n_simd_);
+    return values_;
+  }
+
   std::size_t GetBitLength() const final { return sizeof(T) * 8; }
 
   bool IsConstant() const noexcept final { return false; }
@@ -24,12 +24,16 @@
 
 #include "bmr_gate.h"
 #include "bmr_data.h"
+#include "bmr_ot_batch.h"
 #include "bmr_provider.h"
 #include "bmr_wire.h"
 
+#include <algorithm>
+#include <functional>
 #include <span>
 
 #include "base/backend.h"
+#include "base/configuration.h"
 #include "base/motion_base_provider.h"
 #include "communication/bmr_message.h"
 #include "communication/communication_layer.h"
@@ -367,6 +371,7 @@ OutputGate::OutputGate(const motion::SharePointer& parent, std::size_t output_ow
   gmw_output_share_ = std::make_shared<boolean_gmw::Share>(gmw_wires);
   output_gate_ =
       GetRegister().EmplaceGate<boolean_gmw::OutputGate>(gmw_output_share_, output_owner_);
+  output_gate_->SetEnclosingGate(this);
 
   gate_id_ = GetRegister().NextGateId();
 
@@ -705,11 +710,13 @@ AndGate::AndGate(const motion::SharePointer& a, const motion::SharePointer& b)
   gate_id_ = GetRegister().NextGateId();
 
   auto& communication_layer = GetCommunicationLayer();
-  const auto my_id = communication_layer.GetMyId();
   const auto number_of_parties = communication_layer.GetNumberOfParties();
   const auto number_of_simd{parent_a_.at(0)->GetNumberOfSimdValues()};
   const auto number_of_wires{parent_a_.size()};
-  const auto size_of_all_garbled_tables = number_of_wires * number_of_simd * 4 * number_of_parties;
+  half_gates_ = number_of_parties == 2 && backend_.GetConfiguration()->GetBmrHalfGates();
+  const auto size_of_all_garbled_tables =
+      half_gates_ ? number_of_wires * number_of_simd * 3
+                  : number_of_wires * number_of_simd * 4 * number_of_parties;
 
   for (auto& wire : parent_a_) {
     RegisterWaitingFor(wire->GetWireId());
@@ -727,33 +734,9 @@ AndGate::AndGate(const motion::SharePointer& a, const motion::SharePointer& b)
     w = GetRegister().template EmplaceWire<bmr::Wire>(tmp_bv, backend_);
   }
 
-  sender_ots_1_.resize(number_of_parties);
-  for (auto& v : sender_ots_1_) v.resize(number_of_wires);
-  sender_ots_kappa_.resize(number_of_parties);
-  for (auto& v : sender_ots_kappa_) v.resize(number_of_wires);
-  receiver_ots_1_.resize(number_of_parties);
-  for (auto& v : receiver_ots_1_) v.resize(number_of_wires);
-  receiver_ots_kappa_.resize(number_of_parties);
-  for (auto& v : receiver_ots_kappa_) v.resize(number_of_wires);
-  for (auto wire_i = 0ull; wire_i < number_of_wires; ++wire_i) {
-    for (auto party_j = 0ull; party_j < number_of_parties; ++party_j) {
-      if (party_j == my_id) continue;
-      // we need 1 bit C-OT and ...
-      sender_ots_1_.at(party_j).at(wire_i) =
-          GetOtProvider(party_j).RegisterSendXcOtBit(number_of_simd);
-      receiver_ots_1_.at(party_j).at(wire_i) =
-          GetOtProvider(party_j).RegisterReceiveXcOtBit(number_of_simd);
-      // ... 3 string C-OTs per gate (in each direction)
-      sender_ots_kappa_.at(party_j).at(wire_i) =
-          GetOtProvider(party_j).RegisterSendFixedXcOt128(3 * number_of_simd);
-      receiver_ots_kappa_.at(party_j).at(wire_i) =
-          GetOtProvider(party_j).RegisterReceiveFixedXcOt128(3 * number_of_simd);
-    }
-  }
-
-  // allocate enough space for number_of_wires * number_of_simd garbled tables
-  garbled_tables_.resize(size_of_all_garbled_tables);
-  garbled_tables_.SetToZero();
+  // we need 1 bit C-OT and 3 string C-OTs per wire and SIMD value (in each direction), which
+  // the BMR provider registers in a batch with the C-OTs of the other AND gates
+  backend_.GetBmrProvider().RegisterAndGate(gate_id_, number_of_wires * number_of_simd);
 
   // store futures for the (partial) garbled tables we will receive during garbling
   received_garbled_rows_ =
@@ -776,6 +759,10 @@ void AndGate::GenerateRandomness() {
     assert(bmr_output);
     bmr_output->GenerateRandomPermutationBits();
     bmr_output->GenerateRandomPrivateKeys();
+    if (half_gates_) {
+      // the least significant bit of a key then equals the public value of the wire
+      for (auto& key : bmr_output->GetMutableSecretKeys()) *key.data() &= std::byte{0xFE};
+    }
     if constexpr (kVerboseDebug) {
       const auto my_id = GetCommunicationLayer().GetMyId();
       const auto number_of_simd{parent_a_.at(0)->GetNumberOfSimdValues()};
@@ -826,96 +813,77 @@ void AndGate::EvaluateSetup() {
         fmt::format("Gate#{} (BMR AND gate) Party#{} R {}\n", gate_id_, my_id, R.AsString()));
   }
 
+  // allocate enough space for number_of_wires * number_of_simd garbled tables, not before the gate
+  // is evaluated, such that only gates which are being evaluated hold their tables
+  garbled_tables_.resize(half_gates_ ? number_of_wires * number_of_simd * 3
+                                     : number_of_wires * number_of_simd * 4 * number_of_parties);
+  garbled_tables_.SetToZero();
+
   // generate random keys and masking bits for the outgoing wires
   GenerateRandomness();
 
-  // 1-bit OTs
+  // 1-bit OTs, batched with the other AND gates
 
-  // structure: parties X wires X choice bits
-  std::vector<std::vector<motion::BitVector<>>> choices(
-      number_of_parties, std::vector<motion::BitVector<>>(number_of_wires));
+  auto [ot_batch, ot_offset] = backend_.GetBmrProvider().GetOtBatch(gate_id_);
 
+  // compute C-OTs for the real value, ie, b = (lambda_u ^ alpha) * (lambda_v ^ beta)
+  motion::BitVector<> bit_ot_choices, bit_ot_correlations;
+  bit_ot_choices.Reserve(number_of_wires * number_of_simd);
+  bit_ot_correlations.Reserve(number_of_wires * number_of_simd);
   for (auto wire_i = 0ull; wire_i < number_of_wires; ++wire_i) {
-    auto bmr_output{std::dynamic_pointer_cast<bmr::Wire>(output_wires_.at(wire_i))};
     const auto bmr_a{std::dynamic_pointer_cast<const bmr::Wire>(parent_a_.at(wire_i))};
     const auto bmr_b{std::dynamic_pointer_cast<const bmr::Wire>(parent_b_.at(wire_i))};
-    assert(bmr_output);
     assert(bmr_a);
     assert(bmr_b);
     bmr_a->GetSetupReadyCondition()->Wait();
     bmr_b->GetSetupReadyCondition()->Wait();
+    bit_ot_choices.Append(bmr_b->GetPermutationBits());
+    bit_ot_correlations.Append(bmr_a->GetPermutationBits());
+  }
+  ot_batch.ExchangeBitOts(ot_offset, bit_ot_choices, bit_ot_correlations);
 
-    const motion::BitVector<>& a_permutation_bits = bmr_a->GetPermutationBits();
-    const motion::BitVector<>& b_permutation_bits = bmr_b->GetPermutationBits();
-
-    for (auto party_i = 0ull; party_i < number_of_parties; ++party_i) {
-      if (party_i == my_id) {
-        choices.at(party_i).at(wire_i) = a_permutation_bits & b_permutation_bits;
-        continue;
-      }
-
-      auto& receiver_ot_1{receiver_ots_1_.at(party_i).at(wire_i)};
-      auto& sender_ot_1{sender_ots_1_.at(party_i).at(wire_i)};
-
-      if constexpr (kVerboseDebug) {
-        GetLogger().LogTrace(fmt::format(
-            "Gate#{} (BMR AND gate)  Party#{}-#{} bit-C-OTs wire_i {} perm_bits {} bits_a {} "
-            "bits_b {} a&b {}\n",
-            gate_id_, my_id, party_i, wire_i, bmr_output->GetPermutationBits().AsString(),
-            bmr_a->GetPermutationBits().AsString(), bmr_b->GetPermutationBits().AsString(),
-            choices.at(party_i).at(wire_i).AsString()));
-      }
-      // compute C-OTs for the real value, ie, b = (lambda_u ^ alpha) * (lambda_v ^ beta)
-
-      receiver_ot_1->WaitSetup();
-      sender_ot_1->WaitSetup();
-
-      receiver_ot_1->SetChoices(b_permutation_bits);
-      receiver_ot_1->SendCorrections();
-
-      sender_ot_1->SetCorrelations(a_permutation_bits);
-      sender_ot_1->SendMessages();
-    }  // for each party
-  }    // for each wire
-
-  // kKappa-bit OTs
+  // structure: parties X wires X choice bits
+  std::vector<std::vector<motion::BitVector<>>> choices(
+      number_of_parties, std::vector<motion::BitVector<>>(number_of_wires));
 
   for (auto wire_i = 0ull; wire_i < number_of_wires; ++wire_i) {
-    auto bmr_output{std::dynamic_pointer_cast<bmr::Wire>(output_wires_.at(wire_i))};
     const auto bmr_a{std::dynamic_pointer_cast<const bmr::Wire>(parent_a_.at(wire_i))};
     const auto bmr_b{std::dynamic_pointer_cast<const bmr::Wire>(parent_b_.at(wire_i))};
-    assert(bmr_output);
     assert(bmr_a);
     assert(bmr_b);
+    const auto bits_from = ot_offset + wire_i * number_of_simd;
     for (auto party_i = 0ull; party_i < number_of_parties; ++party_i) {
-      if (party_i == my_id) continue;
-      auto& receiver_ot_1{receiver_ots_1_.at(party_i).at(wire_i)};
-      auto& sender_ot_1{sender_ots_1_.at(party_i).at(wire_i)};
-
-      assert(receiver_ot_1->AreChoicesSet());
-      receiver_ot_1->ComputeOutputs();
-      const auto& receiver_bitvector = receiver_ot_1->GetOutputs();
-      sender_ot_1->ComputeOutputs();
-      const auto& sender_bitvector = sender_ot_1->GetOutputs();
-
-      choices.at(party_i).at(wire_i) = receiver_bitvector ^ sender_bitvector;
+      if (party_i == my_id) {
+        choices.at(party_i).at(wire_i) = bmr_a->GetPermutationBits() & bmr_b->GetPermutationBits();
+      } else {
+        choices.at(party_i).at(wire_i) =
+            ot_batch.GetBitOtOutputs(party_i).Subset(bits_from, bits_from + number_of_simd);
+      }
 
       if constexpr (kVerboseDebug) {
-        const auto& receiver_bitvector_check = receiver_ot_1->GetChoices();
-        const auto& sender_bitvector_check = sender_ot_1->GetCorrelations();
         GetLogger().LogTrace(fmt::format(
-            "Gate#{} (BMR AND gate) Party#{}-#{} bit-C-OTs wire_i {} bits from C-OTs r {} s {} "
-            "result {} (r {} s {})\n",
-            gate_id_, my_id, party_i, wire_i, receiver_bitvector.AsString(),
-            sender_bitvector.AsString(), choices.at(party_i).at(wire_i).AsString(),
-            receiver_bitvector_check.AsString(), sender_bitvector_check.AsString()));
+            "Gate#{} (BMR AND gate) Party#{}-#{} bit-C-OTs wire_i {} perm_bits a {} b {} "
+            "result {}\n",
+            gate_id_, my_id, party_i, wire_i, bmr_a->GetPermutationBits().AsString(),
+            bmr_b->GetPermutationBits().AsString(), choices.at(party_i).at(wire_i).AsString()));
       }
     }  // for each party
   }    // for each wire
 
   // choices contain now shares of \lambda_{uv}^i
 
+  if (half_gates_) {
+    GarbleHalfGates(choices, ot_batch, ot_offset);
+    if constexpr (kDebug) {
+      GetLogger().LogDebug(
+          fmt::format("Finished evaluating setup phase of BMR AND Gate with id#{}", gate_id_));
+    }
+    return;
+  }
+
   std::vector<motion::BitVector<>> aggregated_choices(number_of_wires);
+  motion::BitVector<> string_ot_choices;
+  string_ot_choices.Reserve(3 * number_of_wires * number_of_simd);
 
   for (auto wire_i = 0ull; wire_i < number_of_wires; ++wire_i) {
     auto bmr_output{std::dynamic_pointer_cast<bmr::Wire>(output_wires_.at(wire_i))};
@@ -942,18 +910,13 @@ void AndGate::EvaluateSetup() {
       aggregated_choices_fw.Set(bit_value ^ b_permutation_bits[bit_i], bit_i * 3 + 2);
     }
 
-    for (auto party_i = 0ull; party_i < number_of_parties; ++party_i) {
-      if (party_i == my_id) continue;
-      // multiply individual parties' R's with the secret-shared real value XORed with
-      // the permutation bit of the output wire, ie, R * (b ^ lambda_w)
-      receiver_ots_kappa_.at(party_i).at(wire_i)->SetChoices(aggregated_choices.at(wire_i));
-      receiver_ots_kappa_.at(party_i).at(wire_i)->SendCorrections();
-
-      sender_ots_kappa_.at(party_i).at(wire_i)->SetCorrelation(R);
-      sender_ots_kappa_.at(party_i).at(wire_i)->SendMessages();
-    }
+    string_ot_choices.Append(aggregated_choices_fw);
   }  // for each wire
 
+  // multiply individual parties' R's with the secret-shared real value XORed with
+  // the permutation bit of the output wire, ie, R * (b ^ lambda_w)
+  ot_batch.ExchangeStringOts(ot_offset, string_ot_choices);
+
   // AES key expansion
   motion::primitives::Prg prg;
   prg.SetKey(GetBaseProvider().GetAesFixedKey().data());
@@ -970,6 +933,8 @@ void AndGate::EvaluateSetup() {
     assert(bmr_b);
 
     for (auto simd_i = 0ull; simd_i < number_of_simd; ++simd_i) {
+      // index of the first of the 3 string C-OTs of this wire and SIMD value in the batch
+      const auto ot_i = 3 * (ot_offset + wire_i * number_of_simd + simd_i);
       const auto& key_a_0{bmr_a->GetSecretKeys().at(simd_i)};
       const auto& key_a_1{key_a_0 ^ R};
       const auto& key_b_0{bmr_b->GetSecretKeys().at(simd_i)};
@@ -1010,12 +975,10 @@ void AndGate::EvaluateSetup() {
           for (auto party_j = 0ull; party_j < number_of_parties; ++party_j) {
             if (party_j == my_id) continue;
 
-            sender_ots_kappa_.at(party_j).at(wire_i)->ComputeOutputs();
-            const auto& sender_output = sender_ots_kappa_.at(party_j).at(wire_i)->GetOutputs();
-            assert(sender_output.size() == number_of_simd * 3);
-            const auto R00 = sender_output[simd_i * 3];
-            const auto R01 = sender_output[simd_i * 3 + 1];
-            const auto R10 = sender_output[simd_i * 3 + 2];
+            const auto& sender_output = ot_batch.GetStringOtSenderOutputs(party_j);
+            const auto R00 = sender_output[ot_i];
+            const auto R01 = sender_output[ot_i + 1];
+            const auto R10 = sender_output[ot_i + 2];
 
             shared_R.at(0) ^= R00;
             shared_R.at(1) ^= R01;
@@ -1029,13 +992,10 @@ void AndGate::EvaluateSetup() {
             }
           }
         } else {
-          assert(receiver_ots_kappa_.at(party_i).at(wire_i)->AreChoicesSet());
-          receiver_ots_kappa_.at(party_i).at(wire_i)->ComputeOutputs();
-          const auto& receiver_output = receiver_ots_kappa_.at(party_i).at(wire_i)->GetOutputs();
-          assert(receiver_output.size() == number_of_simd * 3);
-          const auto R00 = receiver_output[simd_i * 3];
-          const auto R01 = receiver_output[simd_i * 3 + 1];
-          const auto R10 = receiver_output[simd_i * 3 + 2];
+          const auto& receiver_output = ot_batch.GetStringOtReceiverOutputs(party_i);
+          const auto R00 = receiver_output[ot_i];
+          const auto R01 = receiver_output[ot_i + 1];
+          const auto R10 = receiver_output[ot_i + 2];
 
           shared_R.at(0) ^= R00;
           shared_R.at(1) ^= R01;
@@ -1112,6 +1072,12 @@ void AndGate::EvaluateOnline() {
         fmt::format("Start evaluating online phase of BMR AND Gate with id#{}", gate_id_));
   }
 
+  if (half_gates_) {
+    EvaluateHalfGates();
+    assert(!online_is_ready_);
+    return;
+  }
+
   auto& communication_layer = GetCommunicationLayer();
   const auto my_id = communication_layer.GetMyId();
   const auto number_of_parties = communication_layer.GetNumberOfParties();
@@ -1233,6 +1199,216 @@ void AndGate::EvaluateOnline() {
   assert(!online_is_ready_);
 }
 
+// Two-party distributed half-gates (cf. Zahur et al., https://eprint.iacr.org/2014/756, and
+// Katz et al., https://eprint.iacr.org/2018/578): each party i acts as the garbler of its own
+// keys K^i with offset R^i, and the other party evaluates them. With the shared permutation bits
+// \lambda_a, \lambda_b, \lambda_w of the input and output wires, and
+// x = \lambda_w ^ \lambda_a * \lambda_b, the garbled table for party i's keys consists of
+//   G_a = H(K^i_a0) ^ H(K^i_a1) ^ \lambda_b * R^i
+//   G_b = H(K^i_b0) ^ H(K^i_b1) ^ K^i_a0 ^ \lambda_a * R^i
+//   T   = K^i_w0 ^ H(K^i_a0) ^ H(K^i_b0) ^ x * R^i,
+// where the products with R^i are secret-shared between both parties using C-OTs. Given the
+// public values \Lambda_a, \Lambda_b and the active keys K^i_a, K^i_b, the evaluator computes
+//   K^i_w = H(K^i_a) ^ H(K^i_b) ^ T ^ \Lambda_a * G_a ^ \Lambda_b * (G_b ^ K^i_a)
+//         = K^i_w0 ^ \Lambda_w * R^i,
+// and learns \Lambda_w as the least significant bit of K^i_w, since lsb(K^i_w0) = 0 and
+// lsb(R^i) = 1. H is the fixed-key TMMO construction with a tweak unique to the gate.
+
+namespace {
+
+// the tweaks for the two halves of the SIMD value simd_i of the output wire wire_id
+std::array<__uint128_t, 2> GetHalfGatesTweaks(std::size_t wire_id, std::size_t simd_i) {
+  const auto base = static_cast<__uint128_t>(wire_id) << 64;
+  return {base | (2 * simd_i), base | (2 * simd_i + 1)};
+}
+
+bool GetLeastSignificantBit(const motion::Block128& block) {
+  return std::to_integer<bool>(*block.data() & std::byte{0x01});
+}
+
+}  // namespace
+
+void AndGate::GarbleHalfGates(
+    const std::vector<std::vector<motion::BitVector<>>>& shared_products, OtBatch& ot_batch,
+    std::size_t ot_offset) {
+  const auto& R{backend_.GetBmrProvider().GetGlobalOffset()};
+  const auto number_of_wires{parent_a_.size()};
+  const auto number_of_simd{parent_a_.at(0)->GetNumberOfSimdValues()};
+  auto& communication_layer = GetCommunicationLayer();
+  const auto my_id = communication_layer.GetMyId();
+  const auto other_id = 1 - my_id;
+  const auto zero_block = motion::Block128::MakeZero();
+
+  // our shares of \lambda_b, \lambda_a, and x for the 3 C-OTs with the other party's offset
+  // structure: wires X (simd X (\lambda_b || \lambda_a || x))
+  motion::BitVector<> string_ot_choices;
+  string_ot_choices.Reserve(3 * number_of_wires * number_of_simd);
+
+  for (auto wire_i = 0ull; wire_i < number_of_wires; ++wire_i) {
+    const auto bmr_output{std::dynamic_pointer_cast<const bmr::Wire>(output_wires_.at(wire_i))};
+    const auto bmr_a{std::dynamic_pointer_cast<const bmr::Wire>(parent_a_.at(wire_i))};
+    const auto bmr_b{std::dynamic_pointer_cast<const bmr::Wire>(parent_b_.at(wire_i))};
+    assert(bmr_output);
+    assert(bmr_a);
+    assert(bmr_b);
+
+    const auto& out_permutation_bits = bmr_output->GetPermutationBits();
+    const auto& a_permutation_bits = bmr_a->GetPermutationBits();
+    const auto& b_permutation_bits = bmr_b->GetPermutationBits();
+
+    motion::BitVector<> choices(3 * number_of_simd, false);
+    for (auto simd_i = 0ull; simd_i < number_of_simd; ++simd_i) {
+      const bool x = out_permutation_bits.Get(simd_i) ^
+                     shared_products.at(my_id).at(wire_i).Get(simd_i) ^
+                     shared_products.at(other_id).at(wire_i).Get(simd_i);
+      choices.Set(b_permutation_bits.Get(simd_i), simd_i * 3);
+      choices.Set(a_permutation_bits.Get(simd_i), simd_i * 3 + 1);
+      choices.Set(x, simd_i * 3 + 2);
+    }
+    string_ot_choices.Append(choices);
+  }
+  ot_batch.ExchangeStringOts(ot_offset, string_ot_choices);
+  const auto& sender_output = ot_batch.GetStringOtSenderOutputs(other_id);
+  const auto& receiver_output = ot_batch.GetStringOtReceiverOutputs(other_id);
+
+  // AES key expansion
+  motion::primitives::Prg prg;
+  prg.SetKey(GetBaseProvider().GetAesFixedKey().data());
+  const auto aes_round_keys = prg.GetRoundKeys();
+
+  // hash inputs/outputs and tweaks, structure: simd X (K_a0 || K_a1 || K_b0 || K_b1)
+  motion::Block128Vector hashes(4 * number_of_simd);
+  std::vector<__uint128_t> tweaks(4 * number_of_simd);
+
+  for (auto wire_i = 0ull; wire_i < number_of_wires; ++wire_i) {
+    const auto bmr_output{std::dynamic_pointer_cast<const bmr::Wire>(output_wires_.at(wire_i))};
+    const auto bmr_a{std::dynamic_pointer_cast<const bmr::Wire>(parent_a_.at(wire_i))};
+    const auto bmr_b{std::dynamic_pointer_cast<const bmr::Wire>(parent_b_.at(wire_i))};
+    assert(bmr_output);
+    assert(bmr_a);
+    assert(bmr_b);
+    const auto& keys_a{bmr_a->GetSecretKeys()};
+    const auto& keys_b{bmr_b->GetSecretKeys()};
+    const auto& keys_w{bmr_output->GetSecretKeys()};
+
+    for (auto simd_i = 0ull; simd_i < number_of_simd; ++simd_i) {
+      hashes[4 * simd_i] = keys_a[simd_i];
+      hashes[4 * simd_i + 1] = keys_a[simd_i] ^ R;
+      hashes[4 * simd_i + 2] = keys_b[simd_i];
+      hashes[4 * simd_i + 3] = keys_b[simd_i] ^ R;
+      const auto [tweak_a, tweak_b] = GetHalfGatesTweaks(bmr_output->GetWireId(), simd_i);
+      tweaks[4 * simd_i] = tweaks[4 * simd_i + 1] = tweak_a;
+      tweaks[4 * simd_i + 2] = tweaks[4 * simd_i + 3] = tweak_b;
+    }
+    AesniTmmoTweaked(aes_round_keys, hashes.data(), tweaks.data(), hashes.size());
+
+    for (auto simd_i = 0ull; simd_i < number_of_simd; ++simd_i) {
+      const auto table_offset = (wire_i * number_of_simd + simd_i) * 3;
+      const auto ot_i = 3 * ot_offset + table_offset;
+      // our shares of \lambda_b * R, \lambda_a * R, and x * R
+      std::array<motion::Block128, 3> shared_R;
+      for (auto k = 0ull; k < 3; ++k) {
+        shared_R[k] =
+            sender_output[ot_i + k] ^ (string_ot_choices[table_offset + k] ? R : zero_block);
+      }
+      const auto& hash_a_0{hashes[4 * simd_i]};
+      const auto& hash_a_1{hashes[4 * simd_i + 1]};
+      const auto& hash_b_0{hashes[4 * simd_i + 2]};
+      const auto& hash_b_1{hashes[4 * simd_i + 3]};
+      garbled_tables_[table_offset] = hash_a_0 ^ hash_a_1 ^ shared_R[0];
+      garbled_tables_[table_offset + 1] = hash_b_0 ^ hash_b_1 ^ keys_a[simd_i] ^ shared_R[1];
+      garbled_tables_[table_offset + 2] = keys_w[simd_i] ^ hash_a_0 ^ hash_b_0 ^ shared_R[2];
+    }
+  }
+
+  // send out our half-gates
+  const std::vector<std::uint8_t> send_message_buffer(
+      reinterpret_cast<const std::uint8_t*>(garbled_tables_.data()),
+      reinterpret_cast<const std::uint8_t*>(garbled_tables_.data()) + garbled_tables_.ByteSize());
+  communication_layer.SendMessage(
+      other_id,
+      communication::BuildBmrAndMessage(static_cast<std::size_t>(gate_id_), send_message_buffer));
+
+  // finalize the other party's half-gates with our shares of the products with its offset
+  garbled_tables_ = received_garbled_rows_.at(other_id).get();
+  assert(garbled_tables_.size() == number_of_wires * number_of_simd * 3);
+  std::transform(garbled_tables_.begin(), garbled_tables_.end(),
+                 receiver_output.begin() + 3 * ot_offset, garbled_tables_.begin(),
+                 std::bit_xor<>());
+}
+
+void AndGate::EvaluateHalfGates() {
+  const auto& R{backend_.GetBmrProvider().GetGlobalOffset()};
+  const auto my_id = GetCommunicationLayer().GetMyId();
+  const auto other_id = 1 - my_id;
+  const auto number_of_wires = output_wires_.size();
+  const auto number_of_simd = output_wires_.at(0)->GetNumberOfSimdValues();
+  const auto zero_block = motion::Block128::MakeZero();
+
+  // index function for the public/active keys stored in the wires
+  const auto PublicKeyIndex = [](auto simd_i, auto party_i) { return simd_i * 2 + party_i; };
+
+  // AES key expansion
+  motion::primitives::Prg prg;
+  prg.SetKey(GetBaseProvider().GetAesFixedKey().data());
+  const auto aes_round_keys = prg.GetRoundKeys();
+
+  // hash inputs/outputs and tweaks, structure: simd X (K_a || K_b)
+  motion::Block128Vector hashes(2 * number_of_simd);
+  std::vector<__uint128_t> tweaks(2 * number_of_simd);
+
+  for (auto wire_i = 0ull; wire_i < number_of_wires; ++wire_i) {
+    auto bmr_output = std::dynamic_pointer_cast<bmr::Wire>(output_wires_.at(wire_i));
+    const auto wire_a = std::dynamic_pointer_cast<const bmr::Wire>(parent_a_.at(wire_i));
+    const auto wire_b = std::dynamic_pointer_cast<const bmr::Wire>(parent_b_.at(wire_i));
+    assert(bmr_output);
+    assert(wire_a);
+    assert(wire_b);
+
+    wire_a->GetIsReadyCondition().Wait();
+    wire_b->GetIsReadyCondition().Wait();
+
+    const auto& public_keys_a = wire_a->GetPublicKeys();
+    const auto& public_keys_b = wire_b->GetPublicKeys();
+    for (auto simd_i = 0ull; simd_i < number_of_simd; ++simd_i) {
+      hashes[2 * simd_i] = public_keys_a[PublicKeyIndex(simd_i, other_id)];
+      hashes[2 * simd_i + 1] = public_keys_b[PublicKeyIndex(simd_i, other_id)];
+      const auto [tweak_a, tweak_b] = GetHalfGatesTweaks(bmr_output->GetWireId(), simd_i);
+      tweaks[2 * simd_i] = tweak_a;
+      tweaks[2 * simd_i + 1] = tweak_b;
+    }
+    AesniTmmoTweaked(aes_round_keys, hashes.data(), tweaks.data(), hashes.size());
+
+    const auto& public_values_a = wire_a->GetPublicValues();
+    const auto& public_values_b = wire_b->GetPublicValues();
+    auto& public_keys = bmr_output->GetMutablePublicKeys();
+    auto& public_values = bmr_output->GetMutablePublicValues();
+    const auto& secret_keys = bmr_output->GetSecretKeys();
+    for (auto simd_i = 0ull; simd_i < number_of_simd; ++simd_i) {
+      const auto table_offset = (wire_i * number_of_simd + simd_i) * 3;
+      auto key = hashes[2 * simd_i] ^ hashes[2 * simd_i + 1] ^ garbled_tables_[table_offset + 2];
+      if (public_values_a[simd_i]) key ^= garbled_tables_[table_offset];
+      if (public_values_b[simd_i]) {
+        key ^= garbled_tables_[table_offset + 1] ^ public_keys_a[PublicKeyIndex(simd_i, other_id)];
+      }
+      const bool public_value = GetLeastSignificantBit(key);
+      public_keys[PublicKeyIndex(simd_i, other_id)] = key;
+      public_keys[PublicKeyIndex(simd_i, my_id)] =
+          secret_keys[simd_i] ^ (public_value ? R : zero_block);
+      public_values.Set(public_value, simd_i);
+    }
+    if constexpr (kVerboseDebug) {
+      GetLogger().LogTrace(fmt::format("Party#{} wire#{} public values result {}\n", my_id, wire_i,
+                                       bmr_output->GetPublicValues().AsString()));
+    }
+  }  // for each wire
+
+  if constexpr (kDebug) {
+    GetLogger().LogDebug(
+        fmt::format("Finished evaluating online phase of BMR AND Gate with id#{}", gate_id_));
+  }
+}
+
 const bmr::SharePointer AndGate::GetOutputAsBmrShare() const {
   auto result = std::make_shared<bmr::Share>(output_wires_);
   assert(result);
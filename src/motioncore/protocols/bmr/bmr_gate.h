@@ -39,15 +39,13 @@ namespace encrypto::motion {
 
 class OtVectorSender;
 class OtVectorReceiver;
-class FixedXcOt128Sender;
-class FixedXcOt128Receiver;
-class XcOtBitSender;
-class XcOtBitReceiver;
 
 }  // namespace encrypto::motion
 
 namespace encrypto::motion::proto::bmr {
 
+class OtBatch;
+
 class InputGate final : public motion::InputGate {
   using Base = motion::InputGate;
 
@@ -172,18 +170,27 @@ class AndGate final : public TwoGate {
   AndGate(const Gate&) = delete;
 
  private:
-  std::vector<std::vector<std::unique_ptr<motion::XcOtBitSender>>> sender_ots_1_;
-  std::vector<std::vector<std::unique_ptr<motion::FixedXcOt128Sender>>> sender_ots_kappa_;
-  std::vector<std::vector<std::unique_ptr<motion::XcOtBitReceiver>>> receiver_ots_1_;
-  std::vector<std::vector<std::unique_ptr<motion::FixedXcOt128Receiver>>> receiver_ots_kappa_;
-
   std::vector<motion::ReusableFiberFuture<motion::Block128Vector>> received_garbled_rows_;
 
   // buffer to store all garbled tables for all wires
   // structure: wires X (simd X (row_00 || row_01 || row_10 || row_11))
+  // or, in the half-gates mode: wires X (simd X (half_a || half_b || output_key_correction))
   motion::Block128Vector garbled_tables_;
 
+  // if true, the gate is garbled using two-party distributed half-gates instead of multi-party
+  // BMR garbled tables, see Configuration::SetBmrHalfGates
+  bool half_gates_{false};
+
   void GenerateRandomness();
+
+  // garbles this party's keys with half-gates for the other party, and receives and finalizes the
+  // other party's half-gates, given the shares of the permutation bit products \lambda_{uv}
+  void GarbleHalfGates(const std::vector<std::vector<motion::BitVector<>>>& shared_products,
+                       OtBatch& ot_batch, std::size_t ot_offset);
+
+  // evaluates the other party's half-gates and derives the public values and the public keys of
+  // both parties
+  void EvaluateHalfGates();
 };
 
 }  // namespace encrypto::motion::proto::bmr
@@ -0,0 +1,169 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bmr_ot_batch.h"
+
+#include <mutex>
+
+#include "oblivious_transfer/ot_flavors.h"
+#include "oblivious_transfer/ot_provider.h"
+
+namespace encrypto::motion::proto::bmr {
+
+OtBatch::OtBatch(std::size_t number_of_gates, std::size_t number_of_ots,
+                 const Block128& global_offset, std::size_t my_id,
+                 OtProviderManager& ot_provider_manager)
+    : my_id_(my_id),
+      global_offset_(global_offset),
+      bit_ot_choices_(number_of_ots),
+      bit_ot_correlations_(number_of_ots),
+      string_ot_choices_(3 * number_of_ots),
+      number_of_gates_(number_of_gates),
+      number_of_missing_bit_ot_gates_(number_of_gates),
+      number_of_missing_string_ot_gates_(number_of_gates),
+      bit_ot_condition_([this] { return bit_ot_outputs_ready_; }),
+      string_ot_condition_([this] { return string_ot_outputs_ready_; }) {
+  const auto number_of_parties = ot_provider_manager.GetProviders().size();
+  bit_ot_senders_.resize(number_of_parties);
+  bit_ot_receivers_.resize(number_of_parties);
+  string_ot_senders_.resize(number_of_parties);
+  string_ot_receivers_.resize(number_of_parties);
+  bit_ot_outputs_.resize(number_of_parties);
+  string_ot_sender_outputs_.resize(number_of_parties);
+  string_ot_receiver_outputs_.resize(number_of_parties);
+  for (auto party_id = 0ull; party_id < number_of_parties; ++party_id) {
+    if (party_id == my_id_) continue;
+    auto& ot_provider = ot_provider_manager.GetProvider(party_id);
+    bit_ot_senders_.at(party_id) = ot_provider.RegisterSendXcOtBit(number_of_ots);
+    bit_ot_receivers_.at(party_id) = ot_provider.RegisterReceiveXcOtBit(number_of_ots);
+    string_ot_senders_.at(party_id) = ot_provider.RegisterSendFixedXcOt128(3 * number_of_ots);
+    string_ot_receivers_.at(party_id) = ot_provider.RegisterReceiveFixedXcOt128(3 * number_of_ots);
+  }
+}
+
+OtBatch::~OtBatch() = default;
+
+void OtBatch::Clear() {
+  {
+    std::scoped_lock lock(bit_ot_condition_.GetMutex());
+    number_of_missing_bit_ot_gates_ = number_of_gates_;
+    bit_ot_outputs_ready_ = false;
+  }
+  {
+    std::scoped_lock lock(string_ot_condition_.GetMutex());
+    number_of_missing_string_ot_gates_ = number_of_gates_;
+    string_ot_outputs_ready_ = false;
+  }
+}
+
+void OtBatch::ExchangeBitOts(std::size_t offset, const BitVector<>& choices,
+                             const BitVector<>& correlations) {
+  assert(choices.GetSize() == correlations.GetSize());
+  bool is_last;
+  {
+    std::scoped_lock lock(bit_ot_condition_.GetMutex());
+    bit_ot_choices_.Copy(offset, offset + choices.GetSize(), choices);
+    bit_ot_correlations_.Copy(offset, offset + correlations.GetSize(), correlations);
+    assert(number_of_missing_bit_ot_gates_ > 0);
+    is_last = --number_of_missing_bit_ot_gates_ == 0;
+  }
+  if (is_last) {
+    ComputeBitOts();
+    {
+      std::scoped_lock lock(bit_ot_condition_.GetMutex());
+      bit_ot_outputs_ready_ = true;
+    }
+    bit_ot_condition_.NotifyAll();
+  }
+  bit_ot_condition_.Wait();
+}
+
+void OtBatch::ExchangeStringOts(std::size_t offset, const BitVector<>& choices) {
+  bool is_last;
+  {
+    std::scoped_lock lock(string_ot_condition_.GetMutex());
+    string_ot_choices_.Copy(3 * offset, 3 * offset + choices.GetSize(), choices);
+    assert(number_of_missing_string_ot_gates_ > 0);
+    is_last = --number_of_missing_string_ot_gates_ == 0;
+  }
+  if (is_last) {
+    ComputeStringOts();
+    {
+      std::scoped_lock lock(string_ot_condition_.GetMutex());
+      string_ot_outputs_ready_ = true;
+    }
+    string_ot_condition_.NotifyAll();
+  }
+  string_ot_condition_.Wait();
+}
+
+void OtBatch::ComputeBitOts() {
+  const auto number_of_parties = bit_ot_senders_.size();
+  // send the messages to all parties first and only then wait for theirs
+  for (auto party_id = 0ull; party_id < number_of_parties; ++party_id) {
+    if (party_id == my_id_) continue;
+    auto& receiver_ot = bit_ot_receivers_.at(party_id);
+    auto& sender_ot = bit_ot_senders_.at(party_id);
+    receiver_ot->WaitSetup();
+    sender_ot->WaitSetup();
+    receiver_ot->SetChoices(bit_ot_choices_);
+    receiver_ot->SendCorrections();
+    sender_ot->SetCorrelations(bit_ot_correlations_);
+    sender_ot->SendMessages();
+  }
+  for (auto party_id = 0ull; party_id < number_of_parties; ++party_id) {
+    if (party_id == my_id_) continue;
+    auto& receiver_ot = bit_ot_receivers_.at(party_id);
+    auto& sender_ot = bit_ot_senders_.at(party_id);
+    receiver_ot->ComputeOutputs();
+    sender_ot->ComputeOutputs();
+    bit_ot_outputs_.at(party_id) = receiver_ot->GetOutputs() ^ sender_ot->GetOutputs();
+  }
+}
+
+void OtBatch::ComputeStringOts() {
+  const auto number_of_parties = string_ot_senders_.size();
+  for (auto party_id = 0ull; party_id < number_of_parties; ++party_id) {
+    if (party_id == my_id_) continue;
+    auto& receiver_ot = string_ot_receivers_.at(party_id);
+    auto& sender_ot = string_ot_senders_.at(party_id);
+    receiver_ot->WaitSetup();
+    sender_ot->WaitSetup();
+    receiver_ot->SetChoices(string_ot_choices_);
+    receiver_ot->SendCorrections();
+    sender_ot->SetCorrelation(global_offset_);
+    sender_ot->SendMessages();
+  }
+  for (auto party_id = 0ull; party_id < number_of_parties; ++party_id) {
+    if (party_id == my_id_) continue;
+    auto& receiver_ot = string_ot_receivers_.at(party_id);
+    auto& sender_ot = string_ot_senders_.at(party_id);
+    receiver_ot->ComputeOutputs();
+    sender_ot->ComputeOutputs();
+    string_ot_receiver_outputs_.at(party_id) = receiver_ot->GetOutputs();
+    string_ot_sender_outputs_.at(party_id) = sender_ot->GetOutputs();
+  }
+}
+
+}  // namespace encrypto::motion::proto::bmr
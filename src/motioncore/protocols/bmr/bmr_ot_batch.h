@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "utility/bit_vector.h"
+#include "utility/block.h"
+#include "utility/fiber_condition.h"
+
+namespace encrypto::motion {
+
+class OtProviderManager;
+class XcOtBitSender;
+class XcOtBitReceiver;
+class FixedXcOt128Sender;
+class FixedXcOt128Receiver;
+
+}  // namespace encrypto::motion
+
+namespace encrypto::motion::proto::bmr {
+
+/// \brief Bundles the C-OTs of several BMR AND gates, whose setup is evaluated concurrently, into
+///        one OT vector per party pair and OT flavor.
+/// \details Each gate writes its inputs at its own offset into the batch.  The gate that provides
+///          the last missing inputs of a phase sends the corrections and messages for the whole
+///          batch and computes the outputs, while the other gates of the batch wait for them.
+///          Thus, all AND gates of a batch share a single corrections and a single messages
+///          message per party pair and phase.
+class OtBatch {
+ public:
+  /// \param number_of_gates number of AND gates in the batch
+  /// \param number_of_ots number of 1-bit C-OTs of all gates, i.e., the sum of the number of
+  ///        wires times the number of SIMD values; there are 3 times as many string C-OTs
+  /// \param global_offset the correlation of the string C-OTs
+  OtBatch(std::size_t number_of_gates, std::size_t number_of_ots, const Block128& global_offset,
+          std::size_t my_id, OtProviderManager& ot_provider_manager);
+
+  ~OtBatch();
+
+  /// \brief Resets the per-evaluation state, s.t. the gates of the batch can be evaluated again.
+  void Clear();
+
+  /// \brief Sets the choices and correlations of the 1-bit C-OTs [offset, offset + choices.size())
+  ///        and blocks until the outputs of the whole batch are available.
+  void ExchangeBitOts(std::size_t offset, const BitVector<>& choices,
+                      const BitVector<>& correlations);
+
+  /// \brief Returns the XOR of receiver and sender outputs of the 1-bit C-OTs with party_id.
+  const BitVector<>& GetBitOtOutputs(std::size_t party_id) const {
+    return bit_ot_outputs_.at(party_id);
+  }
+
+  /// \brief Sets the choices of the string C-OTs [3 * offset, 3 * offset + choices.size()) and
+  ///        blocks until the outputs of the whole batch are available.
+  void ExchangeStringOts(std::size_t offset, const BitVector<>& choices);
+
+  const Block128Vector& GetStringOtSenderOutputs(std::size_t party_id) const {
+    return string_ot_sender_outputs_.at(party_id);
+  }
+
+  const Block128Vector& GetStringOtReceiverOutputs(std::size_t party_id) const {
+    return string_ot_receiver_outputs_.at(party_id);
+  }
+
+ private:
+  std::size_t my_id_;
+  Block128 global_offset_;
+
+  std::vector<std::unique_ptr<XcOtBitSender>> bit_ot_senders_;
+  std::vector<std::unique_ptr<XcOtBitReceiver>> bit_ot_receivers_;
+  std::vector<std::unique_ptr<FixedXcOt128Sender>> string_ot_senders_;
+  std::vector<std::unique_ptr<FixedXcOt128Receiver>> string_ot_receivers_;
+
+  BitVector<> bit_ot_choices_;
+  BitVector<> bit_ot_correlations_;
+  BitVector<> string_ot_choices_;
+
+  std::vector<BitVector<>> bit_ot_outputs_;
+  std::vector<Block128Vector> string_ot_sender_outputs_;
+  std::vector<Block128Vector> string_ot_receiver_outputs_;
+
+  std::size_t number_of_gates_;
+  // number of gates that have not yet provided their inputs for the respective phase
+  std::size_t number_of_missing_bit_ot_gates_;
+  std::size_t number_of_missing_string_ot_gates_;
+  bool bit_ot_outputs_ready_ = false;
+  bool string_ot_outputs_ready_ = false;
+  FiberCondition bit_ot_condition_;
+  FiberCondition string_ot_condition_;
+
+  void ComputeBitOts();
+
+  void ComputeStringOts();
+};
+
+}  // namespace encrypto::motion::proto::bmr
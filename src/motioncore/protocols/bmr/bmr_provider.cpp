@@ -1,9 +1,11 @@
 #include "bmr_provider.h"
 #include "bmr_data.h"
+#include "bmr_ot_batch.h"
 
 #include "communication/communication_layer.h"
 #include "communication/fbs_headers/bmr_message_generated.h"
 #include "communication/message_handler.h"
+#include "protocols/gate.h"
 
 namespace encrypto::motion::proto::bmr {
 
@@ -51,6 +53,9 @@ Provider::Provider(communication::CommunicationLayer& communication_layer)
       my_id_(communication_layer_.GetMyId()),
       number_of_parties_(communication_layer_.GetNumberOfParties()),
       global_offset_(Block128::MakeRandom()) {
+  // fix the least significant bit of the offset to 1, so that the keys for 0 and 1 of a wire
+  // differ in that bit (used for point-and-permute in the two-party half-gates mode)
+  *global_offset_.data() |= std::byte{0x01};
   auto my_id = communication_layer_.GetMyId();
   data_.resize(number_of_parties_);
   for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
@@ -118,4 +123,62 @@ std::vector<ReusableFiberFuture<Block128Vector>> Provider::RegisterForGarbledRow
   return futures;
 }
 
+void Provider::RegisterAndGate(std::size_t gate_id, std::size_t number_of_ots) {
+  and_gates_.emplace_back(gate_id, number_of_ots);
+}
+
+void Provider::PreSetup(OtProviderManager& ot_provider_manager,
+                        const std::vector<std::vector<GatePointer>>* gate_layers,
+                        std::size_t maximum_gate_id_span) {
+  ot_batches_.clear();
+  ot_batch_offsets_.clear();
+  if (and_gates_.empty()) return;
+
+  std::unordered_map<std::size_t, std::size_t> and_gate_sizes(and_gates_.begin(),
+                                                              and_gates_.end());
+  // batches of gate ids
+  std::vector<std::vector<std::size_t>> batches;
+  if (gate_layers == nullptr) {
+    // the AND gates are registered in the order of their ids
+    for (const auto& [gate_id, number_of_ots] : and_gates_) {
+      if (batches.empty() ||
+          (maximum_gate_id_span > 0 && gate_id - batches.back().front() >= maximum_gate_id_span)) {
+        batches.emplace_back();
+      }
+      batches.back().push_back(gate_id);
+    }
+  } else {
+    for (const auto& layer : *gate_layers) {
+      std::vector<std::size_t> batch;
+      for (const auto& gate : layer) {
+        if (and_gate_sizes.contains(gate->GetId())) batch.push_back(gate->GetId());
+      }
+      if (!batch.empty()) batches.emplace_back(std::move(batch));
+    }
+  }
+
+  for (const auto& batch : batches) {
+    std::size_t number_of_ots = 0;
+    for (auto gate_id : batch) number_of_ots += and_gate_sizes.at(gate_id);
+    auto& ot_batch = ot_batches_.emplace_back(std::make_unique<OtBatch>(
+        batch.size(), number_of_ots, global_offset_, my_id_, ot_provider_manager));
+    std::size_t offset = 0;
+    for (auto gate_id : batch) {
+      ot_batch_offsets_.emplace(gate_id, std::make_pair(ot_batch.get(), offset));
+      offset += and_gate_sizes.at(gate_id);
+    }
+  }
+  assert(ot_batch_offsets_.size() == and_gates_.size());
+  and_gates_.clear();
+}
+
+std::pair<OtBatch&, std::size_t> Provider::GetOtBatch(std::size_t gate_id) {
+  const auto [ot_batch, offset] = ot_batch_offsets_.at(gate_id);
+  return {*ot_batch, offset};
+}
+
+void Provider::Clear() {
+  for (auto& ot_batch : ot_batches_) ot_batch->Clear();
+}
+
 }  // namespace encrypto::motion::proto::bmr
@@ -23,12 +23,22 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "utility/bit_vector.h"
 #include "utility/block.h"
 #include "utility/reusable_future.h"
 
+namespace encrypto::motion {
+
+class Gate;
+using GatePointer = std::shared_ptr<Gate>;
+class OtProviderManager;
+
+}  // namespace encrypto::motion
+
 namespace encrypto::motion::communication {
 
 class CommunicationLayer;
@@ -38,6 +48,7 @@ class CommunicationLayer;
 namespace encrypto::motion::proto::bmr {
 
 struct Data;
+class OtBatch;
 
 class Provider {
  public:
@@ -54,12 +65,39 @@ class Provider {
   std::vector<ReusableFiberFuture<Block128Vector>> RegisterForGarbledRows(
       std::size_t gate_id, std::size_t number_blocks);
 
+  // registers the C-OTs of an AND gate with number_of_ots 1-bit C-OTs (and 3 times as many string
+  // C-OTs) per party pair, which are evaluated in a batch together with other AND gates
+  void RegisterAndGate(std::size_t gate_id, std::size_t number_of_ots);
+
+  bool NeedOts() const { return !and_gates_.empty(); }
+
+  // groups the registered AND gates into OT batches and registers the OTs of the batches.  If
+  // gate_layers is given, there is one batch per layer, since the gates of different layers are
+  // not evaluated concurrently, and otherwise one batch for the whole circuit.  If
+  // maximum_gate_id_span is not 0, a batch only contains gates whose ids differ by less than it,
+  // since all gates of a batch must be alive at the same time.
+  void PreSetup(OtProviderManager& ot_provider_manager,
+                const std::vector<std::vector<GatePointer>>* gate_layers = nullptr,
+                std::size_t maximum_gate_id_span = 0);
+
+  // returns the batch of the AND gate with gate_id and the offset of its OTs in the batch
+  std::pair<OtBatch&, std::size_t> GetOtBatch(std::size_t gate_id);
+
+  // resets the per-evaluation state of the OT batches, s.t. the circuit can be evaluated again
+  void Clear();
+
  private:
   communication::CommunicationLayer& communication_layer_;
   std::size_t my_id_;
   std::size_t number_of_parties_;
   std::vector<std::unique_ptr<Data>> data_;
   Block128 global_offset_;
+
+  // AND gates registered since the last PreSetup: gate id X number of 1-bit C-OTs
+  std::vector<std::pair<std::size_t, std::size_t>> and_gates_;
+  std::vector<std::unique_ptr<OtBatch>> ot_batches_;
+  // gate id -> batch X offset
+  std::unordered_map<std::size_t, std::pair<OtBatch*, std::size_t>> ot_batch_offsets_;
 };
 
 }  // namespace encrypto::motion::proto::bmr
@@ -26,8 +26,10 @@
 #include "boolean_gmw_wire.h"
 
 #include <fmt/format.h>
+#include <algorithm>
 #include <span>
 
+#include "algorithm/algorithm_description.h"
 #include "base/backend.h"
 #include "base/register.h"
 #include "communication/communication_layer.h"
@@ -97,6 +99,7 @@ void InputGate::EvaluateOnline() {
   auto number_of_parties = communication_layer.GetNumberOfParties();
 
   std::vector<BitVector<>> result(input_.size());
+  BitVector<> randomness(bits_);
   auto sharing_id = boolean_sharing_id_;
   for (auto i = 0ull; i < result.size(); ++i) {
     if (static_cast<std::size_t>(input_owner_id_) == my_id) {
@@ -107,7 +110,7 @@ void InputGate::EvaluateOnline() {
           continue;
         }
         auto& randomness_generator = GetBaseProvider().GetMyRandomnessGenerator(party_id);
-        auto randomness = randomness_generator.GetBits(sharing_id, bits_);
+        randomness_generator.FillBits(sharing_id, randomness);
 
         if constexpr (kVerboseDebug) {
           log_string.append(fmt::format("id#{}:{} ", party_id, randomness.AsString()));
@@ -127,7 +130,8 @@ void InputGate::EvaluateOnline() {
       }
     } else {
       auto& randomness_generator = GetBaseProvider().GetTheirRandomnessGenerator(input_owner_id_);
-      result.at(i) = randomness_generator.GetBits(sharing_id, bits_);
+      result.at(i) = BitVector<>(bits_);
+      randomness_generator.FillBits(sharing_id, result.at(i));
 
       if constexpr (kVerboseDebug) {
         auto s = fmt::format(
@@ -150,12 +154,148 @@ void InputGate::EvaluateOnline() {
   }
 }
 
+void InputGate::SetInput(std::vector<BitVector<>>&& input) {
+  if (input.size() != input_.size() || !BitVector<>::IsEqualSizeDimensions(input) ||
+      input.at(0).GetSize() != bits_) {
+    throw std::invalid_argument(
+        fmt::format("BooleanGmwInputGate#{} expects {} wires of {} SIMD values", gate_id_,
+                    input_.size(), bits_));
+  }
+  input_ = std::move(input);
+}
+
+void InputGate::DynamicClear() {
+  boolean_sharing_id_ = GetRegister().NextBooleanGmwSharingId(input_.size() * bits_);
+}
+
 const boolean_gmw::SharePointer InputGate::GetOutputAsGmwShare() {
   auto result = std::make_shared<boolean_gmw::Share>(output_wires_);
   assert(result);
   return result;
 }
 
+InputTableGate::InputTableGate(std::vector<std::vector<BitVector<>>>&& columns,
+                               std::size_t party_id, Backend& backend)
+    : InputTableGate::Base(backend), columns_(std::move(columns)) {
+  input_owner_id_ = party_id;
+  auto& communication_layer = GetCommunicationLayer();
+  if (static_cast<std::size_t>(input_owner_id_) >= communication_layer.GetNumberOfParties()) {
+    throw std::runtime_error(fmt::format("Invalid input owner: {} of {}", input_owner_id_,
+                                         communication_layer.GetNumberOfParties()));
+  }
+  if (columns_.empty() || columns_.at(0).empty() || columns_.at(0).at(0).GetSize() == 0) {
+    throw std::invalid_argument("BooleanGmwInputTableGate expects a non-empty table");
+  }
+  number_of_rows_ = columns_.at(0).at(0).GetSize();
+  if (!HasTableDimensions(columns_)) {
+    throw std::invalid_argument(fmt::format(
+        "BooleanGmwInputTableGate expects all wires of all columns to have {} rows",
+        number_of_rows_));
+  }
+
+  gate_id_ = GetRegister().NextGateId();
+  for (const auto& column : columns_) number_of_wires_ += column.size();
+  boolean_sharing_id_ = GetRegister().NextBooleanGmwSharingId(number_of_wires_ * number_of_rows_);
+
+  output_wires_.reserve(number_of_wires_);
+  for (std::size_t i = 0; i < number_of_wires_; ++i) {
+    output_wires_.push_back(
+        GetRegister().EmplaceWire<boolean_gmw::Wire>(backend_, number_of_rows_));
+  }
+
+  if constexpr (kDebug) {
+    GetLogger().LogDebug(fmt::format(
+        "Created a BooleanGmwInputTableGate with gate id {}, {} columns and {} rows", gate_id_,
+        columns_.size(), number_of_rows_));
+  }
+}
+
+void InputTableGate::EvaluateSetup() {}
+
+void InputTableGate::EvaluateOnline() {
+  GetBaseProvider().WaitForSetup();
+
+  auto& communication_layer = GetCommunicationLayer();
+  auto my_id = communication_layer.GetMyId();
+  auto number_of_parties = communication_layer.GetNumberOfParties();
+
+  // the randomness of all wires is laid out wire by wire in a single bit vector
+  BitVector<> masks(number_of_wires_ * number_of_rows_);
+
+  if (static_cast<std::size_t>(input_owner_id_) == my_id) {
+    BitVector<> randomness(masks.GetSize());
+    for (auto party_id = 0u; party_id < number_of_parties; ++party_id) {
+      if (party_id == my_id) {
+        continue;
+      }
+      auto& randomness_generator = GetBaseProvider().GetMyRandomnessGenerator(party_id);
+      randomness_generator.FillBits(boolean_sharing_id_, randomness);
+      masks ^= randomness;
+    }
+  } else {
+    auto& randomness_generator = GetBaseProvider().GetTheirRandomnessGenerator(input_owner_id_);
+    randomness_generator.FillBits(boolean_sharing_id_, masks);
+  }
+
+  const bool is_my_input = static_cast<std::size_t>(input_owner_id_) == my_id;
+  std::size_t wire_index = 0;
+  for (const auto& column : columns_) {
+    for (const auto& input : column) {
+      auto wire = std::dynamic_pointer_cast<boolean_gmw::Wire>(output_wires_.at(wire_index));
+      assert(wire);
+      auto& values = wire->GetMutableValues();
+      values = masks.Subset(wire_index * number_of_rows_, (wire_index + 1) * number_of_rows_);
+      if (is_my_input) {
+        values ^= input;
+      }
+      ++wire_index;
+    }
+  }
+
+  if constexpr (kVerboseDebug) {
+    GetLogger().LogTrace(fmt::format("Evaluated BooleanGmwInputTableGate with id#{}", gate_id_));
+  }
+}
+
+std::vector<boolean_gmw::SharePointer> InputTableGate::GetOutputAsGmwShares() {
+  std::vector<boolean_gmw::SharePointer> result;
+  result.reserve(columns_.size());
+  auto wire_iterator = output_wires_.begin();
+  for (const auto& column : columns_) {
+    std::vector<motion::WirePointer> wires(wire_iterator, wire_iterator + column.size());
+    result.push_back(std::make_shared<boolean_gmw::Share>(std::move(wires)));
+    wire_iterator += column.size();
+  }
+  return result;
+}
+
+void InputTableGate::SetInput(std::vector<std::vector<BitVector<>>>&& columns) {
+  const bool same_bit_lengths =
+      columns.size() == columns_.size() &&
+      std::equal(columns.begin(), columns.end(), columns_.begin(),
+                 [](const auto& a, const auto& b) { return a.size() == b.size(); });
+  if (!same_bit_lengths || !HasTableDimensions(columns)) {
+    throw std::invalid_argument(fmt::format(
+        "BooleanGmwInputTableGate#{} expects the {} columns of its initial table with {} rows",
+        gate_id_, columns_.size(), number_of_rows_));
+  }
+  columns_ = std::move(columns);
+}
+
+void InputTableGate::DynamicClear() {
+  boolean_sharing_id_ = GetRegister().NextBooleanGmwSharingId(number_of_wires_ * number_of_rows_);
+}
+
+bool InputTableGate::HasTableDimensions(
+    const std::vector<std::vector<BitVector<>>>& columns) const {
+  return std::all_of(columns.begin(), columns.end(), [this](const auto& column) {
+    return !column.empty() &&
+           std::all_of(column.begin(), column.end(), [this](const auto& wire) {
+             return wire.GetSize() == number_of_rows_;
+           });
+  });
+}
+
 OutputGate::OutputGate(const motion::SharePointer& parent, std::size_t output_owner)
     : OutputGate::Base(parent->GetBackend()) {
   if (parent->GetWires().size() == 0) {
@@ -263,15 +403,17 @@ void OutputGate::EvaluateOnline() {
 
   // we receive shares from other parties
   if (is_my_output_) {
-    // collect shares from all parties
-    std::vector<std::vector<BitVector<>>> shared_outputs(number_of_parties);
+    // collect shares from all parties, they are only kept for the debug output below
+    std::vector<std::vector<BitVector<>>> shared_outputs;
+    if constexpr (kVerboseDebug) {
+      shared_outputs.resize(number_of_parties);
+      shared_outputs.at(my_id) = output;
+    }
+    const auto number_of_simd{parent_.at(0)->GetNumberOfSimdValues()};
     for (std::size_t i = 0; i < number_of_parties; ++i) {
       if (i == my_id) {
-        shared_outputs.at(i) = output;
         continue;
       }
-      // we need space for a BitVector per wire
-      shared_outputs.at(i).reserve(number_of_wires);
 
       // Retrieve the received messsage or wait until it has arrived.
       const auto output_message = output_message_futures_.at(i).get();
@@ -280,26 +422,17 @@ void OutputGate::EvaluateOnline() {
       assert(output_message_pointer);
       assert(output_message_pointer->wires()->size() == number_of_wires);
 
-      // handle each wire
+      // handle each wire by reading the share directly from the received buffer
       for (std::size_t j = 0; j < number_of_wires; ++j) {
         auto payload = output_message_pointer->wires()->Get(j)->payload();
-        auto ptr = reinterpret_cast<const std::byte*>(payload->data());
-        // load payload into a vector of bytes ...
-        std::vector<std::byte> byte_vector(ptr, ptr + payload->size());
-        // ... and construct a new BitVector
-        shared_outputs.at(i).emplace_back(std::move(byte_vector),
-                                          parent_.at(0)->GetNumberOfSimdValues());
+        assert(payload->size() == BitsToBytes(number_of_simd));
+        BitSpan received_share(const_cast<std::uint8_t*>(payload->data()), number_of_simd);
+        if constexpr (kVerboseDebug) {
+          shared_outputs.at(i).emplace_back(received_share.As<BitVector<>>());
+        }
+        // reconstruct the shared value
+        output.at(j) ^= received_share;
       }
-      assert(shared_outputs.at(i).size() == number_of_wires);
-    }
-
-    // reconstruct the shared value
-    if constexpr (kVerboseDebug) {
-      // we need to copy since we have to keep shared_outputs for the debug output below
-      output = BitVector<>::XorBitVectors(shared_outputs);
-    } else {
-      // we can move
-      output = BitVector<>::XorBitVectors(std::move(shared_outputs));
     }
 
     // set the value of the output wires
@@ -527,6 +660,8 @@ AndGate::AndGate(const motion::SharePointer& a, const motion::SharePointer& b)
 
   d_output_ = _register.EmplaceGate<OutputGate>(d_);
   e_output_ = _register.EmplaceGate<OutputGate>(e_);
+  d_output_->SetEnclosingGate(this);
+  e_output_->SetEnclosingGate(this);
 
   gate_id_ = _register.NextGateId();
 
@@ -830,4 +965,218 @@ const motion::SharePointer MuxGate::GetOutputAsShare() const {
   return result;
 }
 
+CircuitGate::CircuitGate(const motion::SharePointer& parent,
+                         std::shared_ptr<const AlgorithmDescription> algorithm_description)
+    : OneGate(parent->GetBackend()), algorithm_description_(std::move(algorithm_description)) {
+  parent_ = parent->GetWires();
+
+  assert(parent_.size() > 0);
+  assert(parent_.at(0)->GetBitLength() > 0);
+
+  if (algorithm_description_->layer_offsets.empty()) {
+    auto layered_algorithm_description =
+        std::make_shared<AlgorithmDescription>(*algorithm_description_);
+    layered_algorithm_description->ComputeLayers();
+    algorithm_description_ = std::move(layered_algorithm_description);
+  }
+  const auto& algorithm = *algorithm_description_;
+
+  const auto number_of_input_wires = algorithm.number_of_input_wires_parent_a +
+                                     algorithm.number_of_input_wires_parent_b.value_or(0);
+  if (parent_.size() != number_of_input_wires) {
+    throw std::invalid_argument(
+        fmt::format("CircuitGate: expected a share of bit length {}, got a share of bit length {}",
+                    number_of_input_wires, parent_.size()));
+  }
+
+  std::size_t number_of_non_linear_gates = 0;
+  std::size_t number_of_rounds = 0;
+  for (std::size_t layer = 0; layer + 1 < algorithm.layer_offsets.size(); ++layer) {
+    bool has_non_linear_gates = false;
+    for (auto i = algorithm.layer_offsets[layer]; i < algorithm.layer_offsets[layer + 1]; ++i) {
+      switch (algorithm.gates[i].type) {
+        case PrimitiveOperationType::kXor:
+        case PrimitiveOperationType::kInv:
+          break;
+        case PrimitiveOperationType::kAnd:
+        case PrimitiveOperationType::kOr:
+          ++number_of_non_linear_gates;
+          has_non_linear_gates = true;
+          break;
+        default:
+          throw std::invalid_argument(fmt::format("CircuitGate: unsupported operation {}",
+                                                  to_string(algorithm.gates[i].type)));
+      }
+    }
+    if (has_non_linear_gates) ++number_of_rounds;
+  }
+
+  requires_online_interaction_ = number_of_rounds > 0;
+  gate_type_ = number_of_rounds > 0 ? GateType::kInteractive : GateType::kNonInteractive;
+
+  gate_id_ = GetRegister().NextGateId();
+
+  for (auto& wire : parent_) {
+    RegisterWaitingFor(wire->GetWireId());
+    wire->RegisterWaitingGate(gate_id_);
+  }
+
+  const auto number_of_simd_values = parent->GetNumberOfSimdValues();
+  output_wires_.reserve(algorithm.number_of_output_wires);
+  for (std::size_t i = 0; i < algorithm.number_of_output_wires; ++i) {
+    output_wires_.emplace_back(
+        GetRegister().EmplaceWire<boolean_gmw::Wire>(backend_, number_of_simd_values));
+  }
+
+  if (number_of_non_linear_gates > 0) {
+    mt_offset_ = backend_.GetMtProvider()->RequestBinaryMts(number_of_non_linear_gates *
+                                                            number_of_simd_values);
+    message_futures_ = GetBaseProvider().RegisterForOutputMessages(gate_id_, number_of_rounds);
+  }
+
+  if constexpr (kDebug) {
+    GetLogger().LogDebug(fmt::format(
+        "Created a BooleanGMW circuit gate with id {} with {} gates in {} layers", gate_id_,
+        algorithm.gates.size(), algorithm.layer_offsets.size() - 1));
+  }
+}
+
+void CircuitGate::EvaluateSetup() {}
+
+void CircuitGate::EvaluateOnline() {
+  const auto& algorithm = *algorithm_description_;
+  auto& communication_layer = GetCommunicationLayer();
+  const auto my_id = communication_layer.GetMyId();
+  const auto number_of_parties = communication_layer.GetNumberOfParties();
+  // this party handles the public constants, i.e., inversions and d & e of the AND gates
+  const bool is_designated_party = static_cast<std::size_t>(gate_id_) % number_of_parties == my_id;
+  const auto number_of_simd_values = parent_.at(0)->GetNumberOfSimdValues();
+
+  std::vector<BitVector<>> wire_values(algorithm.number_of_wires);
+  for (std::size_t i = 0; i < parent_.size(); ++i) {
+    auto wire = std::dynamic_pointer_cast<const boolean_gmw::Wire>(parent_.at(i));
+    assert(wire);
+    wire->GetIsReadyCondition().Wait();
+    wire_values.at(i) = wire->GetValues();
+  }
+
+  const BinaryMtVector* mts = nullptr;
+  if (!message_futures_.empty()) {
+    auto& mt_provider = GetMtProvider();
+    mt_provider.WaitFinished();
+    mts = &mt_provider.GetBinaryAll();
+  }
+
+  std::size_t number_of_evaluated_non_linear_gates = 0;
+  std::size_t round = 0;
+  for (std::size_t layer = 0; layer + 1 < algorithm.layer_offsets.size(); ++layer) {
+    const auto layer_end = algorithm.layer_offsets[layer + 1];
+    // the linear gates precede the non-linear ones within a layer
+    auto i = algorithm.layer_offsets[layer];
+    for (; i < layer_end && IsLinearOperation(algorithm.gates[i].type); ++i) {
+      const auto& gate = algorithm.gates[i];
+      if (gate.type == PrimitiveOperationType::kXor) {
+        wire_values.at(gate.output_wire) =
+            wire_values.at(gate.parent_a) ^ wire_values.at(*gate.parent_b);
+      } else if (is_designated_party) {  // PrimitiveOperationType::kInv
+        wire_values.at(gate.output_wire) = ~wire_values.at(gate.parent_a);
+      } else {
+        wire_values.at(gate.output_wire) = wire_values.at(gate.parent_a);
+      }
+    }
+    if (i == layer_end) {
+      continue;
+    }
+
+    // mask the inputs of all non-linear gates of this layer with MTs
+    const auto non_linear_begin = i;
+    const auto number_of_bits = (layer_end - non_linear_begin) * number_of_simd_values;
+    const auto mt_begin = mt_offset_ + number_of_evaluated_non_linear_gates * number_of_simd_values;
+    auto d = mts->a.Subset(mt_begin, mt_begin + number_of_bits);
+    auto e = mts->b.Subset(mt_begin, mt_begin + number_of_bits);
+    {
+      BitVector<> x(number_of_bits), y(number_of_bits);
+      for (i = non_linear_begin; i < layer_end; ++i) {
+        const auto& gate = algorithm.gates[i];
+        const auto from = (i - non_linear_begin) * number_of_simd_values;
+        x.Copy(from, from + number_of_simd_values, wire_values.at(gate.parent_a));
+        y.Copy(from, from + number_of_simd_values, wire_values.at(*gate.parent_b));
+      }
+      d ^= x;
+      e ^= y;
+    }
+
+    // open d and e with one message per layer
+    {
+      std::vector<std::vector<std::uint8_t>> payloads;
+      for (const auto* masked_values : {&d, &e}) {
+        const auto data = reinterpret_cast<const std::uint8_t*>(masked_values->GetData().data());
+        payloads.emplace_back(data, data + masked_values->GetData().size());
+      }
+      communication_layer.BroadcastMessage(communication::BuildOutputMessage(gate_id_, payloads));
+    }
+    for (std::size_t party_id = 0; party_id < number_of_parties; ++party_id) {
+      if (party_id == my_id) {
+        continue;
+      }
+      const auto output_message = message_futures_.at(party_id).at(round).get();
+      auto message = communication::GetMessage(output_message.data());
+      auto output_message_pointer = communication::GetOutputMessage(message->payload()->data());
+      assert(output_message_pointer);
+      assert(output_message_pointer->wires()->size() == 2);
+      auto received_d = output_message_pointer->wires()->Get(0)->payload();
+      auto received_e = output_message_pointer->wires()->Get(1)->payload();
+      d ^= BitSpan(const_cast<std::uint8_t*>(received_d->data()), number_of_bits);
+      e ^= BitSpan(const_cast<std::uint8_t*>(received_e->data()), number_of_bits);
+    }
+    ++round;
+
+    const auto c = mts->c.Subset(mt_begin, mt_begin + number_of_bits);
+    for (i = non_linear_begin; i < layer_end; ++i) {
+      const auto& gate = algorithm.gates[i];
+      const auto from = (i - non_linear_begin) * number_of_simd_values;
+      const auto to = from + number_of_simd_values;
+      const auto d_i = d.Subset(from, to);
+      const auto e_i = e.Subset(from, to);
+      const auto& x = wire_values.at(gate.parent_a);
+      const auto& y = wire_values.at(*gate.parent_b);
+      auto z = c.Subset(from, to);
+      z ^= (d_i & y) ^ (e_i & x);
+      if (is_designated_party) {
+        z ^= d_i & e_i;
+      }
+      // x | y = x ^ y ^ (x & y)
+      if (gate.type == PrimitiveOperationType::kOr) {
+        z ^= x ^ y;
+      }
+      wire_values.at(gate.output_wire) = std::move(z);
+    }
+    number_of_evaluated_non_linear_gates += layer_end - non_linear_begin;
+  }
+
+  // the output wires of the circuit are its last wires
+  const auto first_output_wire = algorithm.number_of_wires - algorithm.number_of_output_wires;
+  for (std::size_t i = 0; i < output_wires_.size(); ++i) {
+    auto wire = std::dynamic_pointer_cast<boolean_gmw::Wire>(output_wires_.at(i));
+    assert(wire);
+    wire->GetMutableValues() = std::move(wire_values.at(first_output_wire + i));
+  }
+
+  if constexpr (kVerboseDebug) {
+    GetLogger().LogTrace(fmt::format("Evaluated BooleanGMW circuit gate with id#{}", gate_id_));
+  }
+}
+
+const boolean_gmw::SharePointer CircuitGate::GetOutputAsGmwShare() const {
+  auto result = std::make_shared<boolean_gmw::Share>(output_wires_);
+  assert(result);
+  return result;
+}
+
+const motion::SharePointer CircuitGate::GetOutputAsShare() const {
+  auto result = std::static_pointer_cast<motion::Share>(GetOutputAsGmwShare());
+  assert(result);
+  return result;
+}
+
 }  // namespace encrypto::motion::proto::boolean_gmw
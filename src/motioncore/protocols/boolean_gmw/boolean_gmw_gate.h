@@ -28,11 +28,18 @@
 
 #include <span>
 
+#include "communication/message_buffer.h"
 #include "oblivious_transfer/ot_flavors.h"
 #include "protocols/gate.h"
 #include "utility/bit_vector.h"
 #include "utility/reusable_future.h"
 
+namespace encrypto::motion {
+
+struct AlgorithmDescription;
+
+}  // namespace encrypto::motion
+
 namespace encrypto::motion::proto::boolean_gmw {
 
 class InputGate final : public motion::InputGate {
@@ -55,7 +62,14 @@ class InputGate final : public motion::InputGate {
 
   const boolean_gmw::SharePointer GetOutputAsGmwShare();
 
+  /// \brief Replaces the input for the following evaluations of the circuit
+  /// \throws std::invalid_argument if the dimensions differ from the ones of the initial input
+  void SetInput(std::vector<BitVector<>>&& input);
+
  protected:
+  /// draws a fresh sharing id, s.t. a repeated evaluation uses fresh sharing randomness
+  void DynamicClear() final override;
+
   /// two-dimensional vector for storing the raw inputs
   std::vector<BitVector<>> input_;
 
@@ -64,6 +78,51 @@ class InputGate final : public motion::InputGate {
   ///< correlated randomness using AES CTR
 };
 
+/// \brief Shares a whole table of inputs, i.e., a set of columns of Boolean values with the same
+/// number of rows, in a single gate.
+///
+/// A column consists of one BitVector per bit of its values, each holding one bit per row.  The
+/// columns may differ in their bit lengths, but the sharing randomness for the whole table is
+/// expanded in one bulk call per party, s.t. the overhead is constant per table.
+class InputTableGate final : public motion::InputGate {
+  using Base = motion::InputGate;
+
+ public:
+  /// \throws std::invalid_argument if the table is empty or the columns differ in their numbers
+  /// of rows
+  InputTableGate(std::vector<std::vector<BitVector<>>>&& columns, std::size_t party_id,
+                 Backend& backend);
+
+  ~InputTableGate() final = default;
+
+  void EvaluateSetup() final override;
+
+  void EvaluateOnline() final override;
+
+  bool NeedsSetup() const override { return false; }
+
+  /// \brief Returns one share per column
+  std::vector<boolean_gmw::SharePointer> GetOutputAsGmwShares();
+
+  /// \brief Replaces the table for the following evaluations of the circuit
+  /// \throws std::invalid_argument if the dimensions differ from the ones of the initial table
+  void SetInput(std::vector<std::vector<BitVector<>>>&& columns);
+
+ protected:
+  /// draws a fresh sharing id, s.t. a repeated evaluation uses fresh sharing randomness
+  void DynamicClear() final override;
+
+ private:
+  /// checks that all wires of all columns have number_of_rows_ bits
+  bool HasTableDimensions(const std::vector<std::vector<BitVector<>>>& columns) const;
+
+  std::vector<std::vector<BitVector<>>> columns_;
+
+  std::size_t number_of_rows_;
+  std::size_t number_of_wires_ = 0;  ///< Total number of wires over all columns
+  std::size_t boolean_sharing_id_;
+};
+
 constexpr std::size_t kAll = std::numeric_limits<std::int64_t>::max();
 
 class OutputGate final : public motion::OutputGate {
@@ -88,7 +147,7 @@ class OutputGate final : public motion::OutputGate {
   // indicates whether this party obtains the output
   bool is_my_output_ = false;
 
-  std::vector<ReusableFiberFuture<std::vector<std::uint8_t>>> output_message_futures_;
+  std::vector<ReusableFiberFuture<communication::MessageBuffer>> output_message_futures_;
 
   std::mutex m_;
 };
@@ -193,4 +252,42 @@ class MuxGate final : public ThreeGate {
   std::vector<std::unique_ptr<XcOtSender>> ot_sender_;
 };
 
+/// \brief Evaluates a whole Boolean circuit given by an AlgorithmDescription as a single gate.
+/// \details The circuit is evaluated layer by layer (see AlgorithmDescription::ComputeLayers) on
+/// the bit-sliced values of its wires, i.e., each wire holds the bits of all SIMD values in one
+/// BitVector. All AND and OR gates of a layer use one consecutive range of MTs and are opened with
+/// one message to each other party.
+class CircuitGate final : public OneGate {
+ public:
+  /// \param parent the concatenated input share of the circuit
+  /// \param algorithm_description circuit consisting of XOR, INV, AND and OR gates, its layering
+  /// is computed on a copy if it was not computed yet
+  CircuitGate(const motion::SharePointer& parent,
+              std::shared_ptr<const AlgorithmDescription> algorithm_description);
+
+  ~CircuitGate() final = default;
+
+  void EvaluateSetup() final override;
+
+  void EvaluateOnline() final override;
+
+  bool NeedsSetup() const override { return false; }
+
+  const boolean_gmw::SharePointer GetOutputAsGmwShare() const;
+
+  const motion::SharePointer GetOutputAsShare() const;
+
+  CircuitGate() = delete;
+
+  CircuitGate(const Gate&) = delete;
+
+ private:
+  std::shared_ptr<const AlgorithmDescription> algorithm_description_;
+
+  std::size_t mt_offset_ = 0;
+
+  // one future per party and layer with non-linear gates
+  std::vector<std::vector<ReusableFiberFuture<communication::MessageBuffer>>> message_futures_;
+};
+
 }  // namespace encrypto::motion::proto::boolean_gmw
\ No newline at end of file
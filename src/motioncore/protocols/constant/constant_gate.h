@@ -154,17 +154,16 @@ class ConstantArithmeticAdditionGate final : public TwoGate {
     assert(non_constant_wire);
     assert(constant_wire);
 
-    std::vector<T> output;
+    auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+    auto& output = arithmetic_wire->GetAllocatedValues();
     if (GetCommunicationLayer().GetMyId() ==
         (gate_id_ % GetCommunicationLayer().GetNumberOfParties())) {
-      output = RestrictAddVectors(constant_wire->GetValues(), non_constant_wire->GetValues());
+      AddVectors<T>(constant_wire->GetValues(), non_constant_wire->GetValues(), output);
     } else {
-      output = non_constant_wire->GetValues();
+      std::copy(non_constant_wire->GetValues().begin(), non_constant_wire->GetValues().end(),
+                output.begin());
     }
 
-    auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
-    arithmetic_wire->GetMutableValues() = std::move(output);
-
     GetLogger().LogDebug(
         fmt::format("Evaluated arithmetic_gmw::AdditionGate with id#{}", gate_id_));
   }
@@ -249,11 +248,9 @@ class ConstantArithmeticMultiplicationGate final : public TwoGate {
     assert(non_constant_wire);
     assert(constant_wire);
 
-    std::vector<T> output =
-        RestrictMulVectors(constant_wire->GetValues(), non_constant_wire->GetValues());
-
     auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
-    arithmetic_wire->GetMutableValues() = std::move(output);
+    MultiplyVectors<T>(constant_wire->GetValues(), non_constant_wire->GetValues(),
+                       arithmetic_wire->GetAllocatedValues());
 
     GetLogger().LogDebug(
         fmt::format("Evaluated arithmetic_gmw::AdditionGate with id#{}", gate_id_));
@@ -69,6 +69,7 @@ class GmwToArithmeticGate final : public OneGate {
     ts_ = std::make_shared<proto::boolean_gmw::Share>(dummy_wires);
     // also create an output gate for the ts
     ts_output_ = GetRegister().template EmplaceGate<proto::boolean_gmw::OutputGate>(ts_);
+    ts_output_->SetEnclosingGate(this);
 
     // register the required number of shared bits
     number_of_sbs_ = number_of_simd * bit_size;
@@ -115,45 +116,35 @@ class GmwToArithmeticGate final : public OneGate {
     // mask the input bits with the shared bits
     // and assign the result to t
     const auto& sbs = sb_provider.template GetSbsAll<T>();
+    const T* sbs_pointer = sbs.data() + sb_offset_;
     auto& ts_wires = ts_->GetMutableWires();
     for (std::size_t wire_i = 0; wire_i < bit_size; ++wire_i) {
       auto t_wire = std::dynamic_pointer_cast<proto::boolean_gmw::Wire>(ts_wires.at(wire_i));
       auto parent_gmw_wire =
           std::dynamic_pointer_cast<const proto::boolean_gmw::Wire>(parent_.at(wire_i));
-      t_wire->GetMutableValues() = parent_gmw_wire->GetValues();
-      // xor them with the shared bits
-      for (std::size_t j = 0; j < number_of_simd; ++j) {
-        auto b = t_wire->GetValues().Get(j);
-        bool sb = sbs.at(sb_offset_ + wire_i * number_of_simd + j) & 1;
-        t_wire->GetMutableValues().Set(b ^ sb, j);
-      }
+      // the least significant bits of the arithmetic shares of the shared bits are their Boolean
+      // shares, so pack them and xor them with the input bits at once
+      t_wire->GetMutableValues() =
+          PackLeastSignificantBits(sbs_pointer + wire_i * number_of_simd, number_of_simd);
+      t_wire->GetMutableValues() ^= parent_gmw_wire->GetValues();
       t_wire->SetOnlineFinished();
     }
 
     // reconstruct t
     ts_output_->WaitOnline();
     const auto& ts_clear = ts_output_->GetOutputWires();
-    std::vector<std::shared_ptr<proto::boolean_gmw::Wire>> ts_clear_b;
-    ts_clear_b.reserve(ts_clear.size());
-    std::transform(ts_clear.cbegin(), ts_clear.cend(), std::back_inserter(ts_clear_b),
-                   [](auto& w) { return std::dynamic_pointer_cast<proto::boolean_gmw::Wire>(w); });
 
+    // compute the output bit-sliced, i.e., add the contribution of one bit position to all SIMD
+    // values at a time, which keeps the shared bits and the output values in sequential order
     auto output = std::dynamic_pointer_cast<proto::arithmetic_gmw::Wire<T>>(output_wires_.at(0));
-    output->GetMutableValues().resize(number_of_simd);
-    for (std::size_t j = 0; j < number_of_simd; ++j) {
-      T output_value = 0;
-      for (std::size_t wire_i = 0; wire_i < bit_size; ++wire_i) {
-        if (GetCommunicationLayer().GetMyId() == 0) {
-          T t(ts_clear_b.at(wire_i)->GetValues().Get(j));         // the masked bit
-          T r(sbs.at(sb_offset_ + wire_i * number_of_simd + j));  // the arithmetically shared bit
-          output_value += T(t + r - 2 * t * r) << wire_i;
-        } else {
-          T t(ts_clear_b.at(wire_i)->GetValues().Get(j));         // the masked bit
-          T r(sbs.at(sb_offset_ + wire_i * number_of_simd + j));  // the arithmetically shared bit
-          output_value += T(r - 2 * t * r) << wire_i;
-        }
-      }
-      output->GetMutableValues().at(j) = output_value;
+    auto& output_values = output->GetAllocatedValues();
+    std::fill(output_values.begin(), output_values.end(), T(0));
+    const bool is_party_0 = GetCommunicationLayer().GetMyId() == 0;
+    for (std::size_t wire_i = 0; wire_i < bit_size; ++wire_i) {
+      auto t_wire = std::dynamic_pointer_cast<proto::boolean_gmw::Wire>(ts_clear.at(wire_i));
+      assert(t_wire);
+      AccumulateBitPosition(output_values.data(), t_wire->GetValues(),
+                            sbs_pointer + wire_i * number_of_simd, wire_i, is_party_0);
     }
 
     GetLogger().LogDebug(fmt::format("Evaluated B2AGate with id#{}", gate_id_));
@@ -178,6 +169,52 @@ class GmwToArithmeticGate final : public OneGate {
   GmwToArithmeticGate(const Gate&) = delete;
 
  private:
+  /// \brief Packs the least significant bits of values[0..number_of_values) into a BitVector.
+  static BitVector<> PackLeastSignificantBits(const T* values, std::size_t number_of_values) {
+    BitVector<> result(number_of_values);
+    auto result_pointer = reinterpret_cast<std::uint8_t*>(result.GetMutableData().data());
+    const std::size_t number_of_full_bytes = number_of_values / 8;
+    for (std::size_t byte_i = 0; byte_i < number_of_full_bytes; ++byte_i) {
+      const T* block = values + byte_i * 8;
+      std::uint8_t byte = 0;
+      for (std::size_t bit_i = 0; bit_i < 8; ++bit_i) {
+        byte |= static_cast<std::uint8_t>((block[bit_i] & 1) << bit_i);
+      }
+      result_pointer[byte_i] = byte;
+    }
+    for (std::size_t i = number_of_full_bytes * 8; i < number_of_values; ++i) {
+      result.Set(values[i] & 1, i);
+    }
+    return result;
+  }
+
+  /// \brief Adds the arithmetic shares of the bits at position bit_position, i.e.,
+  /// (t + r - 2tr) << bit_position for party 0 and (r - 2tr) << bit_position otherwise, where t
+  /// are the masked bits and r the arithmetic shares of the shared bits, to output.
+  /// Implemented branch-free as t ? (is_party_0 - r) : r, 8 SIMD values per byte of t.
+  static void AccumulateBitPosition(T* output, const BitVector<>& masked_bits,
+                                    const T* shared_bits, std::size_t bit_position,
+                                    bool is_party_0) {
+    const std::size_t number_of_values = masked_bits.GetSize();
+    const auto masked_bytes = reinterpret_cast<const std::uint8_t*>(masked_bits.GetData().data());
+    const T party_0_bit = is_party_0;
+    auto accumulate = [=](std::size_t i, T t) {
+      const T mask = T(0) - t;
+      const T share = T((shared_bits[i] ^ mask) - mask) + T(t & party_0_bit);
+      output[i] += T(share << bit_position);
+    };
+    const std::size_t number_of_full_bytes = number_of_values / 8;
+    for (std::size_t byte_i = 0; byte_i < number_of_full_bytes; ++byte_i) {
+      const std::uint8_t byte = masked_bytes[byte_i];
+      for (std::size_t bit_i = 0; bit_i < 8; ++bit_i) {
+        accumulate(byte_i * 8 + bit_i, T((byte >> bit_i) & 1));
+      }
+    }
+    for (std::size_t i = number_of_full_bytes * 8; i < number_of_values; ++i) {
+      accumulate(i, T(masked_bits.Get(i)));
+    }
+  }
+
   std::size_t number_of_sbs_;
   std::size_t sb_offset_;
   proto::boolean_gmw::SharePointer ts_;
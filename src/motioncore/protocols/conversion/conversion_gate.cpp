@@ -322,19 +322,12 @@ ArithmeticGmwToBmrGate::ArithmeticGmwToBmrGate(const SharePointer& parent)
 
   requires_online_interaction_ = true;
   gate_type_ = GateType::kInteractive;
-  gate_id_ = GetRegister().NextGateId();
 
   // ArithmeticGmwToBmrGate does not own its output wires, since these are the output wires of the
   // last BMR addition circuit. Thus, Gate::SetOnlineReady should not mark the output wires
   // online-ready.
   own_output_wires_ = false;
 
-  for (auto& wire : parent_) {
-    RegisterWaitingFor(wire->GetWireId());
-    wire->RegisterWaitingGate(gate_id_);
-  }
-
-  assert(gate_id_ >= 0);
   const auto& communication_layer = GetCommunicationLayer();
   const auto my_id = communication_layer.GetMyId();
   const auto number_of_parties = communication_layer.GetNumberOfParties();
@@ -347,6 +340,7 @@ ArithmeticGmwToBmrGate::ArithmeticGmwToBmrGate(const SharePointer& parent)
   for (std::size_t party_id = 0; party_id < number_of_parties; ++party_id) {
     const auto input_gate = GetRegister().EmplaceGate<proto::bmr::InputGate>(
         number_of_simd, bitlength, party_id, backend_);
+    input_gate->SetEnclosingGate(this);
     // the party owning the share takes the input promise to assign its input when the parent wires
     // are online-ready
     if (party_id == my_id) input_promise_ = &input_gate->GetInputPromise();
@@ -362,6 +356,15 @@ ArithmeticGmwToBmrGate::ArithmeticGmwToBmrGate(const SharePointer& parent)
   // AGMW to BMR conversion gate
   output_wires_ = result.Get()->GetWires();
 
+  // take the gate id after the gates created above, such that the gate ids follow the order in
+  // which the gates are registered
+  gate_id_ = GetRegister().NextGateId();
+
+  for (auto& wire : parent_) {
+    RegisterWaitingFor(wire->GetWireId());
+    wire->RegisterWaitingGate(gate_id_);
+  }
+
   if constexpr (kDebug) {
     auto gate_info = fmt::format("gate id {}, parent wires: ", gate_id_);
     for (const auto& wire : parent_) gate_info.append(fmt::format("{} ", wire->GetWireId()));
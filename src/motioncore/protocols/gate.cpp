@@ -82,6 +82,7 @@ void Gate::Clear() {
   online_is_ready_ = false;
   added_to_active_queue_ = false;
   number_of_ready_dependencies_ = 0;
+  DynamicClear();
 }
 
 Gate::Gate(Backend& backend)
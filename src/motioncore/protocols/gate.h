@@ -76,12 +76,26 @@ class Gate {
 
   void Clear();
 
+  /// \brief Drops the references to the parent wires once the online phase is finished, s.t. the
+  ///        parents' values can be freed in streaming evaluation.
+  virtual void ReleaseParentWires() {}
+
   void RegisterWaitingFor(std::size_t wire_id);
 
   void SignalDependencyIsReady();
 
   bool AreDependenciesReady() { return wire_dependencies_.size() == number_of_ready_dependencies_; }
 
+  const std::unordered_set<std::size_t>& GetWireDependencies() const { return wire_dependencies_; }
+
+  /// \brief Marks this gate as being evaluated on behalf of \p gate, e.g., an OutputGate opening
+  ///        the masked values inside a multiplication gate. Such a gate waits for values that are
+  ///        only set while \p gate is evaluated, so the layered executor schedules it no earlier
+  ///        than \p gate.
+  void SetEnclosingGate(const Gate* gate) { enclosing_gate_ = gate; }
+
+  const Gate* GetEnclosingGate() const { return enclosing_gate_; }
+
   virtual bool NeedsSetup() const { return true; }
 
   virtual bool NeedsOnline() const { return true; }
@@ -130,6 +144,10 @@ class Gate {
   communication::CommunicationLayer& GetCommunicationLayer();
   OtProvider& GetOtProvider(const std::size_t i);
   bool own_output_wires_{true};
+  const Gate* enclosing_gate_{nullptr};
+
+  // called by Clear() to reset the state of derived gates before a repeated evaluation
+  virtual void DynamicClear() {}
 
  private:
   void IfReadyAddToProcessingQueue();
@@ -155,6 +173,8 @@ class OneGate : public Gate {
 
   OneGate(OneGate&) = delete;
 
+  void ReleaseParentWires() override { parent_.clear(); }
+
  protected:
   std::vector<WirePointer> parent_;
 
@@ -228,6 +248,11 @@ class TwoGate : public Gate {
 
  public:
   ~TwoGate() override = default;
+
+  void ReleaseParentWires() override {
+    parent_a_.clear();
+    parent_b_.clear();
+  }
 };
 
 //
@@ -250,6 +275,12 @@ class ThreeGate : public Gate {
 
  public:
   ~ThreeGate() override = default;
+
+  void ReleaseParentWires() override {
+    parent_a_.clear();
+    parent_b_.clear();
+    parent_c_.clear();
+  }
 };
 
 //
@@ -270,6 +301,8 @@ class NInputGate : public Gate {
 
  public:
   ~NInputGate() override = default;
+
+  void ReleaseParentWires() override { parents_.clear(); }
 };
 
 }  // namespace encrypto::motion
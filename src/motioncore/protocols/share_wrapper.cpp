@@ -254,6 +254,59 @@ ShareWrapper ShareWrapper::operator*(const ShareWrapper& other) const {
   }
 }
 
+ShareWrapper ShareWrapper::DotProduct(const ShareWrapper& other) const {
+  assert(share_);
+  assert(*other);
+  if (share_->GetNumberOfSimdValues() != other->GetNumberOfSimdValues()) {
+    throw std::invalid_argument(fmt::format(
+        "DotProduct expects shares with the same number of SIMD values, got {} and {}",
+        share_->GetNumberOfSimdValues(), other->GetNumberOfSimdValues()));
+  }
+  return MatrixMultiply(other, 1, share_->GetNumberOfSimdValues(), 1);
+}
+
+ShareWrapper ShareWrapper::MatrixMultiply(const ShareWrapper& other, std::size_t rows,
+                                          std::size_t inner, std::size_t columns) const {
+  assert(share_);
+  assert(*other);
+  if (share_->GetProtocol() != MpcProtocol::kArithmeticGmw ||
+      other->GetProtocol() != MpcProtocol::kArithmeticGmw) {
+    throw std::runtime_error("Matrix multiplication is only supported for arithmetic GMW shares");
+  }
+  assert(share_->GetBitLength() == other->GetBitLength());
+
+  if (share_->GetBitLength() == 8u) {
+    return MatrixMul<std::uint8_t>(share_, *other, rows, inner, columns);
+  } else if (share_->GetBitLength() == 16u) {
+    return MatrixMul<std::uint16_t>(share_, *other, rows, inner, columns);
+  } else if (share_->GetBitLength() == 32u) {
+    return MatrixMul<std::uint32_t>(share_, *other, rows, inner, columns);
+  } else if (share_->GetBitLength() == 64u) {
+    return MatrixMul<std::uint64_t>(share_, *other, rows, inner, columns);
+  } else {
+    throw std::bad_cast();
+  }
+}
+
+ShareWrapper ShareWrapper::Truncate(std::size_t shift) const {
+  assert(share_);
+  if (share_->GetProtocol() != MpcProtocol::kArithmeticGmw) {
+    throw std::runtime_error("Truncation is only supported for arithmetic GMW shares");
+  }
+
+  if (share_->GetBitLength() == 8u) {
+    return Truncate<std::uint8_t>(share_, shift);
+  } else if (share_->GetBitLength() == 16u) {
+    return Truncate<std::uint16_t>(share_, shift);
+  } else if (share_->GetBitLength() == 32u) {
+    return Truncate<std::uint32_t>(share_, shift);
+  } else if (share_->GetBitLength() == 64u) {
+    return Truncate<std::uint64_t>(share_, shift);
+  } else {
+    throw std::bad_cast();
+  }
+}
+
 ShareWrapper ShareWrapper::operator==(const ShareWrapper& other) const {
   if (other->GetBitLength() != share_->GetBitLength()) {
     share_->GetBackend().GetLogger()->LogError(
@@ -534,7 +587,23 @@ ShareWrapper ShareWrapper::Concatenate(std::span<const ShareWrapper> input) {
   }
 }
 
+ShareWrapper ShareWrapper::Evaluate(
+    const std::shared_ptr<const AlgorithmDescription>& algorithm) const {
+  if (share_->GetProtocol() == MpcProtocol::kBooleanGmw) {
+    auto circuit_gate{
+        share_->GetRegister()->EmplaceGate<proto::boolean_gmw::CircuitGate>(share_, algorithm)};
+    return ShareWrapper(circuit_gate->GetOutputAsShare());
+  }
+  return Evaluate(*algorithm);
+}
+
 ShareWrapper ShareWrapper::Evaluate(const AlgorithmDescription& algorithm) const {
+  if (share_->GetProtocol() == MpcProtocol::kBooleanGmw) {
+    auto layered_algorithm{std::make_shared<AlgorithmDescription>(algorithm)};
+    if (layered_algorithm->layer_offsets.empty()) layered_algorithm->ComputeLayers();
+    return Evaluate(std::shared_ptr<const AlgorithmDescription>(std::move(layered_algorithm)));
+  }
+
   std::size_t number_of_input_wires = algorithm.number_of_input_wires_parent_a;
   if (algorithm.number_of_input_wires_parent_b)
     number_of_input_wires += *algorithm.number_of_input_wires_parent_b;
@@ -882,6 +951,38 @@ ShareWrapper ShareWrapper::HybridMul(SharePointer share_bit, SharePointer share_
   }
 }
 
+template <typename T>
+ShareWrapper ShareWrapper::MatrixMul(SharePointer share, SharePointer other, std::size_t rows,
+                                     std::size_t inner, std::size_t columns) const {
+  auto this_a = std::dynamic_pointer_cast<proto::arithmetic_gmw::Share<T>>(share);
+  assert(this_a);
+  auto other_a = std::dynamic_pointer_cast<proto::arithmetic_gmw::Share<T>>(other);
+  assert(other_a);
+
+  std::shared_ptr<proto::arithmetic_gmw::MatrixMultiplicationGate<T>> gate;
+  if (rows == 1 && columns == 1) {
+    gate = share_->GetRegister()->EmplaceGate<proto::arithmetic_gmw::DotProductGate<T>>(
+        this_a->GetArithmeticWire(), other_a->GetArithmeticWire());
+  } else {
+    gate = share_->GetRegister()->EmplaceGate<proto::arithmetic_gmw::MatrixMultiplicationGate<T>>(
+        this_a->GetArithmeticWire(), other_a->GetArithmeticWire(), rows, inner, columns);
+  }
+  return ShareWrapper(std::static_pointer_cast<Share>(gate->GetOutputAsArithmeticShare()));
+}
+
+template <typename T>
+ShareWrapper ShareWrapper::Truncate(SharePointer share, std::size_t shift) const {
+  auto this_a = std::dynamic_pointer_cast<proto::arithmetic_gmw::Share<T>>(share);
+  assert(this_a);
+  auto this_wire_a = this_a->GetArithmeticWire();
+
+  auto truncation_gate =
+      share_->GetRegister()->EmplaceGate<proto::arithmetic_gmw::TruncationGate<T>>(this_wire_a,
+                                                                                     shift);
+  auto result = std::static_pointer_cast<Share>(truncation_gate->GetOutputAsArithmeticShare());
+  return ShareWrapper(result);
+}
+
 template <typename T>
 ShareWrapper ShareWrapper::Square(SharePointer share) const {
   auto this_a = std::dynamic_pointer_cast<proto::arithmetic_gmw::Share<T>>(share);
@@ -95,6 +95,24 @@ class ShareWrapper {
     return *this;
   }
 
+  /// \brief computes the inner product of the SIMD values of this and other using a single
+  /// (vector) MT. The result has a single SIMD value.
+  /// \pre this and other are arithmetic GMW shares with the same number of SIMD values.
+  ShareWrapper DotProduct(const ShareWrapper& other) const;
+
+  /// \brief interprets the SIMD values of this and other as row-major rows x inner and
+  /// inner x columns matrices and computes their product, a row-major rows x columns matrix,
+  /// using a matrix MT.
+  /// \pre this and other are arithmetic GMW shares.
+  /// \throws std::invalid_argument if the numbers of SIMD values do not match the dimensions.
+  ShareWrapper MatrixMultiply(const ShareWrapper& other, std::size_t rows, std::size_t inner,
+                              std::size_t columns) const;
+
+  /// \brief shifts the two's complement values of this share to the right by shift bits, e.g., to
+  /// rescale fixed-point values after a multiplication, in a single round. The truncation is
+  /// probabilistic: the result may be off by one in the least significant bit.
+  /// \pre this is an arithmetic GMW share and shift is smaller than its bit length.
+  ShareWrapper Truncate(std::size_t shift) const;
 
   ShareWrapper operator==(const ShareWrapper& other) const;
 
@@ -141,12 +159,14 @@ class ShareWrapper {
   static ShareWrapper Concatenate(std::span<const ShareWrapper> input);
 
   /// \brief evaluates AlgorithmDescription also on this->share_ as input.
+  /// \details In Boolean GMW, the whole circuit is evaluated by a single
+  /// proto::boolean_gmw::CircuitGate, which shares algo instead of copying it.
   /// \returns the output share of the evaluated circuit as ShareWrapper.
-  ShareWrapper Evaluate(const std::shared_ptr<const AlgorithmDescription>& algo) const {
-    return Evaluate(*algo);
-  }
+  ShareWrapper Evaluate(const std::shared_ptr<const AlgorithmDescription>& algo) const;
 
   /// \brief constructs a circuit from AlgorithmDescription algo and sets this->share_ as input.
+  /// \details In Boolean GMW, the whole circuit is evaluated by a single
+  /// proto::boolean_gmw::CircuitGate, otherwise a gate is constructed for each gate of algo.
   /// \returns a share over the output wires of the constructed circuit.
   ShareWrapper Evaluate(const AlgorithmDescription& algo) const;
 
@@ -214,9 +234,16 @@ class ShareWrapper {
   template <typename T>
   ShareWrapper HybridMul(SharePointer share, SharePointer other) const;
 
+  template <typename T>
+  ShareWrapper MatrixMul(SharePointer share, SharePointer other, std::size_t rows,
+                         std::size_t inner, std::size_t columns) const;
+
   template <typename T>
   ShareWrapper Square(SharePointer share) const;
 
+  template <typename T>
+  ShareWrapper Truncate(SharePointer share, std::size_t shift) const;
+
   ShareWrapper ArithmeticGmwToBmr() const;
 
   ShareWrapper BooleanGmwToArithmeticGmw() const;
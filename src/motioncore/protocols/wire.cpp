@@ -55,15 +55,17 @@ void Wire::SetOnlineFinished() {
     throw(std::runtime_error(
         fmt::format("Marking wire #{} as \"online phase ready\" twice", wire_id_)));
   }
+  // signal the waiting gates before they can proceed, since in streaming evaluation a gate is
+  // released from the register as soon as it is evaluated
+  for (auto gate_id : waiting_gate_ids_) {
+    Wire::SignalReadyToDependency(gate_id, backend_);
+  }
+
   {
     std::scoped_lock lock(is_done_condition_.GetMutex());
     is_done_ = true;
   }
   is_done_condition_.NotifyAll();
-
-  for (auto gate_id : waiting_gate_ids_) {
-    Wire::SignalReadyToDependency(gate_id, backend_);
-  }
 }
 
 const std::atomic<bool>& Wire::IsReady() const noexcept { return is_done_; }
@@ -64,8 +64,7 @@ SecureUnsignedInteger SecureUnsignedInteger::operator+(const SecureUnsignedInteg
             fmt::format("Found in cache Boolean integer addition circuit with file path {}", path));
       }
     } else {
-      addition_algorithm =
-          std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristol(path));
+      addition_algorithm = share_->Get()->GetRegister()->LoadAlgorithmDescription(path);
       assert(addition_algorithm);
       if constexpr (kDebug) {
         logger_->LogDebug(fmt::format("Read Boolean integer addition circuit from file {}", path));
@@ -97,8 +96,7 @@ SecureUnsignedInteger SecureUnsignedInteger::operator-(const SecureUnsignedInteg
             fmt::format("Found in cache Boolean integer addition circuit with file path {}", path));
       }
     } else {
-      subtraction_algorithm =
-          std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristol(path));
+      subtraction_algorithm = share_->Get()->GetRegister()->LoadAlgorithmDescription(path);
       assert(subtraction_algorithm);
       if constexpr (kDebug) {
         logger_->LogDebug(fmt::format("Read Boolean integer addition circuit from file {}", path));
@@ -130,8 +128,7 @@ SecureUnsignedInteger SecureUnsignedInteger::operator*(const SecureUnsignedInteg
             fmt::format("Found in cache Boolean integer addition circuit with file path {}", path));
       }
     } else {
-      multiplication_algorithm =
-          std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristol(path));
+      multiplication_algorithm = share_->Get()->GetRegister()->LoadAlgorithmDescription(path);
       assert(multiplication_algorithm);
       if constexpr (kDebug) {
         logger_->LogDebug(fmt::format("Read Boolean integer addition circuit from file {}", path));
@@ -162,8 +159,7 @@ SecureUnsignedInteger SecureUnsignedInteger::operator/(const SecureUnsignedInteg
             fmt::format("Found in cache Boolean integer addition circuit with file path {}", path));
       }
     } else {
-      division_algorithm =
-          std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristol(path));
+      division_algorithm = share_->Get()->GetRegister()->LoadAlgorithmDescription(path);
       assert(division_algorithm);
       if constexpr (kDebug) {
         logger_->LogDebug(fmt::format("Read Boolean integer addition circuit from file {}", path));
@@ -195,8 +191,7 @@ ShareWrapper SecureUnsignedInteger::operator>(const SecureUnsignedInteger& other
             fmt::format("Found in cache Boolean integer addition circuit with file path {}", path));
       }
     } else {
-      is_greater_algorithm =
-          std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristol(path));
+      is_greater_algorithm = share_->Get()->GetRegister()->LoadAlgorithmDescription(path);
       assert(is_greater_algorithm);
       if constexpr (kDebug) {
         logger_->LogDebug(fmt::format("Read Boolean integer addition circuit from file {}", path));
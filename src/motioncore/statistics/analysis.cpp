@@ -45,6 +45,7 @@ void AccumulatedRunTimeStatistics::Add(const RunTimeStatistics& statistics) {
        ++i) {
     accumulators_[i](ComputeDuration(statistics.data[i]));
   }
+  peak_fiber_stack_memory_(statistics.peak_fiber_stack_memory / 1024.0);
   ++count_;
 }
 
@@ -88,6 +89,7 @@ std::string AccumulatedRunTimeStatistics::PrintHumanReadable() const {
      << FormatLine("Base OTs", unit, At(accumulators_, StatId::kBaseOts), kFieldWidth)
      << FormatLine("OT Extension Setup", unit, At(accumulators_, StatId::kOtExtensionSetup),
                    kFieldWidth)
+     << FormatLine("Startup", unit, At(accumulators_, StatId::kStartup), kFieldWidth)
      << "---------------------------------------------------------------------------\n"
      << FormatLine("Preprocessing Total", unit, At(accumulators_, StatId::kPreprocessing),
                    kFieldWidth)
@@ -95,18 +97,21 @@ std::string AccumulatedRunTimeStatistics::PrintHumanReadable() const {
      << FormatLine("Gates Online", unit, At(accumulators_, StatId::kGatesOnline), kFieldWidth)
      << "---------------------------------------------------------------------------\n"
      << FormatLine("Circuit Evaluation", unit, At(accumulators_, StatId::kEvaluate), kFieldWidth);
+  ss << FormatLine("Peak Fiber Stacks", "KiB", peak_fiber_stack_memory_, kFieldWidth - 1);
 
   return ss.str();
 }
 
 boost::json::object AccumulatedRunTimeStatistics::ToJson() const {
-  const auto make_triple = [this](const auto& stat_id) {
-    const auto& acc = At(accumulators_, stat_id);
+  const auto to_triple = [](const AccumulatorType& acc) {
     return boost::json::object({{"mean", boost::accumulators::mean(acc)},
                                 {"median", boost::accumulators::median(acc)},
                                 // uncorrected standard deviation
                                 {"stddev", std::sqrt(boost::accumulators::variance(acc))}});
   };
+  const auto make_triple = [this, &to_triple](const auto& stat_id) {
+    return to_triple(At(accumulators_, stat_id));
+  };
   return {{"repetitions", count_},
           {"mt_presetup", make_triple(StatId::kMtPresetup)},
           {"mt_setup", make_triple(StatId::kMtSetup)},
@@ -116,10 +121,12 @@ boost::json::object AccumulatedRunTimeStatistics::ToJson() const {
           {"sb_setup", make_triple(StatId::kSbSetup)},
           {"base_ots", make_triple(StatId::kBaseOts)},
           {"ot_extension_setup", make_triple(StatId::kOtExtensionSetup)},
+          {"startup", make_triple(StatId::kStartup)},
           {"preprocessing", make_triple(StatId::kPreprocessing)},
           {"gates_setup", make_triple(StatId::kGatesSetup)},
           {"gates_online", make_triple(StatId::kGatesOnline)},
-          {"evaluate", make_triple(StatId::kEvaluate)}};
+          {"evaluate", make_triple(StatId::kEvaluate)},
+          {"peak_fiber_stack_memory_kib", to_triple(peak_fiber_stack_memory_)}};
 }
 
 void AccumulatedCommunicationStatistics::Add(const communication::TransportStatistics& statistics) {
@@ -127,6 +134,11 @@ void AccumulatedCommunicationStatistics::Add(const communication::TransportStati
   accumulators_[kIdxNumberOfMessagesReceived](statistics.number_of_messages_received);
   accumulators_[kIdxNumberOfBytesSent](statistics.number_of_bytes_sent);
   accumulators_[kIdxNumberOfBytesReceived](statistics.number_of_bytes_received);
+  accumulators_[kIdxNumberOfBatchesSent](statistics.number_of_batches_sent);
+  accumulators_[kIdxNumberOfBatchedMessagesSent](statistics.number_of_batched_messages_sent);
+  accumulators_[kIdxNumberOfBatchesReceived](statistics.number_of_batches_received);
+  accumulators_[kIdxNumberOfBatchedMessagesReceived](
+      statistics.number_of_batched_messages_received);
   ++count_;
 }
 
@@ -150,6 +162,20 @@ std::string AccumulatedCommunicationStatistics::PrintHumanReadable() const {
                     boost::accumulators::mean(accumulators_[kIdxNumberOfBytesReceived]) / kMiB,
                     static_cast<std::size_t>(
                         boost::accumulators::mean(accumulators_[kIdxNumberOfMessagesReceived])));
+  const auto print_batches = [this, &ss](const char* direction, std::size_t index_of_batches,
+                                         std::size_t index_of_batched_messages) {
+    const auto number_of_batches = boost::accumulators::mean(accumulators_[index_of_batches]);
+    if (number_of_batches > 0) {
+      const auto number_of_batched_messages =
+          boost::accumulators::mean(accumulators_[index_of_batched_messages]);
+      ss << fmt::format("Batched {}: {:d} messages in {:d} batches (factor {:0.2f})\n", direction,
+                        static_cast<std::size_t>(number_of_batched_messages),
+                        static_cast<std::size_t>(number_of_batches),
+                        number_of_batched_messages / number_of_batches);
+    }
+  };
+  print_batches("sent", kIdxNumberOfBatchesSent, kIdxNumberOfBatchedMessagesSent);
+  print_batches("received", kIdxNumberOfBatchesReceived, kIdxNumberOfBatchedMessagesReceived);
   return ss.str();
 }
 
@@ -162,7 +188,15 @@ boost::json::object AccumulatedCommunicationStatistics::ToJson() const {
       {"bytes_received", static_cast<std::size_t>(
                              boost::accumulators::mean(accumulators_[kIdxNumberOfBytesReceived]))},
       {"num_messages_received", static_cast<std::size_t>(boost::accumulators::mean(
-                                    accumulators_[kIdxNumberOfMessagesReceived]))}};
+                                    accumulators_[kIdxNumberOfMessagesReceived]))},
+      {"num_batches_sent", static_cast<std::size_t>(
+                               boost::accumulators::mean(accumulators_[kIdxNumberOfBatchesSent]))},
+      {"num_batched_messages_sent", static_cast<std::size_t>(boost::accumulators::mean(
+                                        accumulators_[kIdxNumberOfBatchedMessagesSent]))},
+      {"num_batches_received", static_cast<std::size_t>(boost::accumulators::mean(
+                                   accumulators_[kIdxNumberOfBatchesReceived]))},
+      {"num_batched_messages_received", static_cast<std::size_t>(boost::accumulators::mean(
+                                            accumulators_[kIdxNumberOfBatchedMessagesReceived]))}};
 }
 
 std::string PrintMotionInfo() {
@@ -189,4 +223,122 @@ std::string PrintStatistics(const std::string& experiment_name,
   return ss.str();
 }
 
+static const char* GetPhaseName(StatId id) {
+  switch (id) {
+    case StatId::kMtPresetup:
+      return "mt_presetup";
+    case StatId::kMtSetup:
+      return "mt_setup";
+    case StatId::kSbPresetup:
+      return "sb_presetup";
+    case StatId::kSbSetup:
+      return "sb_setup";
+    case StatId::kSpPresetup:
+      return "sp_presetup";
+    case StatId::kSpSetup:
+      return "sp_setup";
+    case StatId::kOtExtensionSetup:
+      return "ot_extension_setup";
+    case StatId::kPreprocessing:
+      return "preprocessing";
+    case StatId::kGatesSetup:
+      return "gates_setup";
+    case StatId::kGatesOnline:
+      return "gates_online";
+    case StatId::kEvaluate:
+      return "evaluate";
+    case StatId::kBaseOts:
+      return "base_ots";
+    case StatId::kStartup:
+      return "startup";
+    default:
+      return "unknown";
+  }
+}
+
+// Chrome trace events use microseconds
+static double ToTraceTimestamp(const Tracer::TimePoint& time_point) {
+  return std::chrono::duration<double, std::micro>(time_point.time_since_epoch()).count();
+}
+
+boost::json::object ToChromeTraceJson(const Tracer& tracer,
+                                      const std::list<RunTimeStatistics>& statistics) {
+  // thread 0 is reserved for the phases, Tracer::GetThreadIndex() starts at 1
+  constexpr std::size_t kPhaseThread = 0;
+  const auto party_id = tracer.GetPartyId();
+  boost::json::array events;
+
+  const auto make_event = [party_id](std::string name, const char* category, std::size_t thread,
+                                     const Tracer::TimePoint& begin, const Tracer::TimePoint& end) {
+    return boost::json::object({{"name", std::move(name)},
+                                {"cat", category},
+                                {"ph", "X"},
+                                {"pid", party_id},
+                                {"tid", thread},
+                                {"ts", ToTraceTimestamp(begin)},
+                                {"dur", ToTraceTimestamp(end) - ToTraceTimestamp(begin)}});
+  };
+
+  events.push_back({{"name", "process_name"},
+                    {"ph", "M"},
+                    {"pid", party_id},
+                    {"args", {{"name", fmt::format("Party {}", party_id)}}}});
+  events.push_back({{"name", "thread_name"},
+                    {"ph", "M"},
+                    {"pid", party_id},
+                    {"tid", kPhaseThread},
+                    {"args", {{"name", "Phases"}}}});
+
+  for (const auto& run : statistics) {
+    for (std::size_t i = 0; i < static_cast<std::size_t>(StatId::kMax); ++i) {
+      const auto& [begin, end] = run.data[i];
+      // skip phases which did not take place in this run
+      if (begin == Tracer::TimePoint() || end < begin) continue;
+      events.push_back(make_event(GetPhaseName(static_cast<StatId>(i)), "phase", kPhaseThread,
+                                  begin, end));
+    }
+  }
+
+  for (const auto& event : tracer.GetEvents()) {
+    switch (event.category) {
+      case TraceCategory::kGateSetup: {
+        auto object = make_event(fmt::format("Gate#{} setup", event.id), "gate", event.thread,
+                                 event.begin, event.end);
+        object["args"] = {{"gate_id", event.id}};
+        events.push_back(std::move(object));
+        break;
+      }
+      case TraceCategory::kGateOnline: {
+        auto object = make_event(fmt::format("Gate#{} online", event.id), "gate", event.thread,
+                                 event.begin, event.end);
+        object["args"] = {{"gate_id", event.id}};
+        events.push_back(std::move(object));
+        break;
+      }
+      case TraceCategory::kWait: {
+        auto object = make_event("wait", "wait", event.thread, event.begin, event.end);
+        object["args"] = {{"gate_id", event.id}};
+        events.push_back(std::move(object));
+        break;
+      }
+      case TraceCategory::kSend: {
+        auto object = make_event(fmt::format("send to Party {}", event.id), "communication",
+                                 event.thread, event.begin, event.end);
+        object["args"] = {{"bytes", event.size}};
+        events.push_back(std::move(object));
+        break;
+      }
+      case TraceCategory::kReceive: {
+        auto object = make_event(fmt::format("receive from Party {}", event.id), "communication",
+                                 event.thread, event.begin, event.end);
+        object["args"] = {{"bytes", event.size}};
+        events.push_back(std::move(object));
+        break;
+      }
+    }
+  }
+
+  return {{"traceEvents", std::move(events)}, {"displayTimeUnit", "ns"}};
+}
+
 }  // namespace encrypto::motion
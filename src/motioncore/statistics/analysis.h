@@ -31,6 +31,7 @@
 #include <boost/json.hpp>
 #include <list>
 #include "run_time_statistics.h"
+#include "trace.h"
 
 namespace encrypto::motion::communication {
 
@@ -60,6 +61,8 @@ class AccumulatedRunTimeStatistics {
   std::size_t count_ = 0;
   std::array<AccumulatorType, static_cast<std::size_t>(RunTimeStatistics::StatisticsId::kMax) + 1>
       accumulators_;
+  // in KiB
+  AccumulatorType peak_fiber_stack_memory_;
 };
 
 class AccumulatedCommunicationStatistics {
@@ -72,6 +75,10 @@ class AccumulatedCommunicationStatistics {
   static constexpr std::size_t kIdxNumberOfMessagesReceived = 1;
   static constexpr std::size_t kIdxNumberOfBytesSent = 2;
   static constexpr std::size_t kIdxNumberOfBytesReceived = 3;
+  static constexpr std::size_t kIdxNumberOfBatchesSent = 4;
+  static constexpr std::size_t kIdxNumberOfBatchedMessagesSent = 5;
+  static constexpr std::size_t kIdxNumberOfBatchesReceived = 6;
+  static constexpr std::size_t kIdxNumberOfBatchedMessagesReceived = 7;
 
   void Add(const communication::TransportStatistics& statistics);
 
@@ -83,10 +90,17 @@ class AccumulatedCommunicationStatistics {
 
  private:
   std::size_t count_ = 0;
-  std::array<AccumulatorType, 4> accumulators_;
+  std::array<AccumulatorType, 8> accumulators_;
 };
 
 std::string PrintStatistics(const std::string& experiment_name, const AccumulatedRunTimeStatistics&,
                             const AccumulatedCommunicationStatistics&);
 
+// Exports the events of tracer and the phases recorded in statistics as Chrome trace events, which
+// can be viewed in chrome://tracing or Perfetto.  Each party is a process, and timestamps are
+// taken from the steady clock, such that the "traceEvents" of locally connected parties can be
+// concatenated.
+boost::json::object ToChromeTraceJson(const Tracer& tracer,
+                                      const std::list<RunTimeStatistics>& statistics = {});
+
 }  // namespace encrypto::motion
@@ -65,6 +65,8 @@ std::string RunTimeStatistics::PrintHumanReadable() const {
                     width)
      << fmt::format("OT Extension Setup  {:{}.3f} ms\n",
                     At(milliseconds, StatisticsId::kOtExtensionSetup), width)
+     << fmt::format("Startup             {:{}.3f} ms\n", At(milliseconds, StatisticsId::kStartup),
+                    width)
      << fmt::format("-------------------------\n")
      << fmt::format("Preprocessing Total {:{}.3f} ms\n",
                     At(milliseconds, StatisticsId::kPreprocessing), width)
@@ -74,7 +76,9 @@ std::string RunTimeStatistics::PrintHumanReadable() const {
                     At(milliseconds, StatisticsId::kGatesOnline), width)
      << fmt::format("-------------------------\n")
      << fmt::format("Circuit Evaluation  {:{}.3f} ms\n", At(milliseconds, StatisticsId::kEvaluate),
-                    width);
+                    width)
+     << fmt::format("Peak Fiber Stacks   {:{}.3f} KiB ({} fibers)\n",
+                    peak_fiber_stack_memory / 1024.0, width, peak_number_of_fibers);
   return ss.str();
 }
 
@@ -47,6 +47,7 @@ struct RunTimeStatistics {
     kGatesOnline,
     kEvaluate,
     kBaseOts,
+    kStartup,  // one-time startup of a session: base OTs, base provider and OT extension setup
     kMax  // maximal value of this Enum, use as size
   };
 
@@ -69,6 +70,10 @@ struct RunTimeStatistics {
   std::string PrintHumanReadable() const;
 
   std::array<TimePointPair, static_cast<std::size_t>(StatisticsId::kMax) + 1> data;
+
+  // maximum number of simultaneously alive gate fibers and the memory of their stacks in bytes
+  std::size_t peak_number_of_fibers = 0;
+  std::size_t peak_fiber_stack_memory = 0;
 };
 
 }  // namespace encrypto::motion
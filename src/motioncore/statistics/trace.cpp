@@ -0,0 +1,117 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "trace.h"
+
+#include <algorithm>
+
+#include <boost/fiber/fss.hpp>
+
+namespace encrypto::motion {
+
+namespace {
+
+// the GateTraceScope of the gate evaluated by the current fiber, the scopes live on the fiber's
+// stack and must not be deleted
+boost::fibers::fiber_specific_ptr<GateTraceScope>& CurrentGateScope() {
+  static boost::fibers::fiber_specific_ptr<GateTraceScope> current_scope(
+      [](GateTraceScope*) {});
+  return current_scope;
+}
+
+}  // namespace
+
+void Tracer::SetEnabled(bool value) noexcept {
+  if (enabled_.exchange(value, std::memory_order_relaxed) != value) {
+    if (value) {
+      number_of_enabled_tracers_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      number_of_enabled_tracers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void Tracer::Record(TraceCategory category, std::size_t id, TimePoint begin, TimePoint end,
+                    std::size_t size) {
+  const auto thread = GetThreadIndex();
+  auto& shard = shards_[thread % kNumberOfShards];
+  std::scoped_lock lock(shard.mutex);
+  shard.events.push_back({category, id, size, thread, begin, end});
+}
+
+std::vector<TraceEvent> Tracer::GetEvents() const {
+  std::vector<TraceEvent> events;
+  for (const auto& shard : shards_) {
+    std::scoped_lock lock(shard.mutex);
+    events.insert(events.end(), shard.events.begin(), shard.events.end());
+  }
+  std::stable_sort(events.begin(), events.end(),
+                   [](const auto& a, const auto& b) { return a.begin < b.begin; });
+  return events;
+}
+
+void Tracer::Clear() {
+  for (auto& shard : shards_) {
+    std::scoped_lock lock(shard.mutex);
+    shard.events.clear();
+  }
+}
+
+std::size_t Tracer::GetThreadIndex() {
+  static std::atomic<std::size_t> number_of_threads = 0;
+  thread_local const std::size_t thread_index = ++number_of_threads;
+  return thread_index;
+}
+
+GateTraceScope::GateTraceScope(Tracer* tracer, TraceCategory category, std::size_t gate_id)
+    : tracer_(tracer != nullptr && tracer->IsEnabled() ? tracer : nullptr),
+      category_(category),
+      gate_id_(gate_id) {
+  if (tracer_ != nullptr) {
+    begin_ = Tracer::ClockType::now();
+    previous_scope_ = CurrentGateScope().release();
+    CurrentGateScope().reset(this);
+  }
+}
+
+GateTraceScope::~GateTraceScope() {
+  if (tracer_ != nullptr) {
+    tracer_->Record(category_, gate_id_, begin_, Tracer::ClockType::now());
+    CurrentGateScope().reset(previous_scope_);
+  }
+}
+
+void WaitTraceScope::Begin() {
+  gate_scope_ = CurrentGateScope().get();
+  if (gate_scope_ != nullptr) {
+    begin_ = Tracer::ClockType::now();
+  }
+}
+
+void WaitTraceScope::End() {
+  gate_scope_->tracer_->Record(TraceCategory::kWait, gate_scope_->gate_id_, begin_,
+                               Tracer::ClockType::now());
+}
+
+}  // namespace encrypto::motion
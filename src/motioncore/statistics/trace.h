@@ -0,0 +1,156 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace encrypto::motion {
+
+enum class TraceCategory : std::uint8_t {
+  kGateSetup,    // Gate::EvaluateSetup, id is the gate id
+  kGateOnline,   // Gate::EvaluateOnline, id is the gate id
+  kWait,         // blocking FiberCondition::Wait inside a gate, id is the gate id
+  kSend,         // write of queued messages to a transport, id is the other party's id
+  kReceive,      // dispatch of a received message, id is the other party's id
+};
+
+struct TraceEvent {
+  using ClockType = std::chrono::steady_clock;
+  using TimePoint = std::chrono::time_point<ClockType>;
+
+  TraceCategory category;
+  std::size_t id;
+  // number of bytes for kSend and kReceive events
+  std::size_t size;
+  // small integer identifying the thread the event began on
+  std::size_t thread;
+  TimePoint begin, end;
+};
+
+// Collects TraceEvents of a party.  Tracing is disabled by default, such that recording an event
+// only costs a relaxed atomic load.  Events are collected in several shards selected by the
+// recording thread to keep lock contention between the worker threads low.  Events of all runs
+// are kept until Clear() is called.
+class Tracer {
+ public:
+  using ClockType = TraceEvent::ClockType;
+  using TimePoint = TraceEvent::TimePoint;
+
+  explicit Tracer(std::size_t party_id) : party_id_(party_id) {}
+
+  ~Tracer() { SetEnabled(false); }
+
+  void SetEnabled(bool value = true) noexcept;
+
+  bool IsEnabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  // whether any tracer of the process is enabled, s.t. scopes can skip all work otherwise
+  static bool IsAnyEnabled() noexcept {
+    return number_of_enabled_tracers_.load(std::memory_order_relaxed) != 0;
+  }
+
+  std::size_t GetPartyId() const noexcept { return party_id_; }
+
+  void Record(TraceCategory category, std::size_t id, TimePoint begin, TimePoint end,
+              std::size_t size = 0);
+
+  // returns the events of all shards sorted by their begin
+  std::vector<TraceEvent> GetEvents() const;
+
+  void Clear();
+
+  // returns a small integer identifying the calling thread, starting from 1
+  static std::size_t GetThreadIndex();
+
+ private:
+  static constexpr std::size_t kNumberOfShards = 16;
+
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    std::vector<TraceEvent> events;
+  };
+
+  static inline std::atomic<std::size_t> number_of_enabled_tracers_ = 0;
+
+  std::size_t party_id_;
+  std::atomic<bool> enabled_ = false;
+  std::array<Shard, kNumberOfShards> shards_;
+};
+
+// Records the evaluation of a gate's setup or online phase from construction to destruction, if
+// tracer is not null and enabled.  While in scope, FiberConditions waited on by the current fiber
+// are recorded as kWait events of this gate.
+class GateTraceScope {
+ public:
+  GateTraceScope(Tracer* tracer, TraceCategory category, std::size_t gate_id);
+  ~GateTraceScope();
+
+  GateTraceScope(const GateTraceScope&) = delete;
+  GateTraceScope& operator=(const GateTraceScope&) = delete;
+
+ private:
+  friend class WaitTraceScope;
+
+  Tracer* tracer_;
+  TraceCategory category_;
+  std::size_t gate_id_;
+  Tracer::TimePoint begin_;
+  GateTraceScope* previous_scope_ = nullptr;
+};
+
+// Records a kWait event from construction to destruction if the current fiber evaluates a gate
+// inside a GateTraceScope.  Costs a relaxed atomic load if no tracer is enabled.
+class WaitTraceScope {
+ public:
+  WaitTraceScope() {
+    if (Tracer::IsAnyEnabled()) {
+      Begin();
+    }
+  }
+
+  ~WaitTraceScope() {
+    if (gate_scope_ != nullptr) {
+      End();
+    }
+  }
+
+  WaitTraceScope(const WaitTraceScope&) = delete;
+  WaitTraceScope& operator=(const WaitTraceScope&) = delete;
+
+ private:
+  void Begin();
+  void End();
+
+  GateTraceScope* gate_scope_ = nullptr;
+  Tracer::TimePoint begin_;
+};
+
+}  // namespace encrypto::motion
@@ -0,0 +1,359 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bit_kernels.h"
+
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+
+#include <immintrin.h>
+
+namespace encrypto::motion {
+
+namespace {
+
+inline std::uint64_t Load64(const std::byte* pointer) {
+  std::uint64_t value;
+  std::memcpy(&value, pointer, sizeof(value));
+  return value;
+}
+
+inline void Store64(std::byte* pointer, std::uint64_t value) {
+  std::memcpy(pointer, &value, sizeof(value));
+}
+
+// ------------------------------ scalar kernels ------------------------------
+
+template <typename Operation>
+inline void BinaryScalar(const std::byte* input, std::byte* result, std::size_t byte_size,
+                         std::size_t i, Operation operation) {
+  for (; i + 8 <= byte_size; i += 8) {
+    Store64(result + i, operation(Load64(result + i), Load64(input + i)));
+  }
+  for (; i < byte_size; ++i) {
+    result[i] = std::byte(operation(std::uint64_t(result[i]), std::uint64_t(input[i])));
+  }
+}
+
+constexpr auto kXor = [](std::uint64_t a, std::uint64_t b) { return a ^ b; };
+constexpr auto kAnd = [](std::uint64_t a, std::uint64_t b) { return a & b; };
+constexpr auto kOr = [](std::uint64_t a, std::uint64_t b) { return a | b; };
+
+void XorScalar(const std::byte* input, std::byte* result, std::size_t byte_size) {
+  BinaryScalar(input, result, byte_size, 0, kXor);
+}
+
+void AndScalar(const std::byte* input, std::byte* result, std::size_t byte_size) {
+  BinaryScalar(input, result, byte_size, 0, kAnd);
+}
+
+void OrScalar(const std::byte* input, std::byte* result, std::size_t byte_size) {
+  BinaryScalar(input, result, byte_size, 0, kOr);
+}
+
+inline void NotScalarFrom(std::byte* data, std::size_t byte_size, std::size_t i) {
+  for (; i + 8 <= byte_size; i += 8) {
+    Store64(data + i, ~Load64(data + i));
+  }
+  for (; i < byte_size; ++i) {
+    data[i] = ~data[i];
+  }
+}
+
+void NotScalar(std::byte* data, std::size_t byte_size) { NotScalarFrom(data, byte_size, 0); }
+
+inline void ShiftRightScalarFrom(const std::byte* source, std::byte* destination,
+                                 std::size_t byte_size, std::size_t shift, std::size_t i) {
+  // source[i + 8] is the last byte needed for the word at i
+  for (; i + 8 <= byte_size; i += 8) {
+    Store64(destination + i, (Load64(source + i) >> shift) |
+                                 (std::uint64_t(source[i + 8]) << (64 - shift)));
+  }
+  for (; i < byte_size; ++i) {
+    destination[i] = (source[i] >> shift) | (source[i + 1] << (8 - shift));
+  }
+}
+
+void ShiftRightScalar(const std::byte* source, std::byte* destination, std::size_t byte_size,
+                      std::size_t shift) {
+  ShiftRightScalarFrom(source, destination, byte_size, shift, 0);
+}
+
+inline void ShiftLeftScalarFrom(const std::byte* source, std::byte* destination,
+                                std::size_t byte_size, std::size_t shift, std::size_t i) {
+  for (; i + 8 <= byte_size; i += 8) {
+    Store64(destination + i,
+            (Load64(source + i) << shift) | (std::uint64_t(source[i - 1]) >> (8 - shift)));
+  }
+  for (; i < byte_size; ++i) {
+    destination[i] = (source[i] << shift) | (source[i - 1] >> (8 - shift));
+  }
+}
+
+void ShiftLeftScalar(const std::byte* source, std::byte* destination, std::size_t byte_size,
+                     std::size_t shift) {
+  ShiftLeftScalarFrom(source, destination, byte_size, shift, 0);
+}
+
+// ------------------------------ AVX2 kernels ------------------------------
+
+#define MOTION_TARGET_AVX2 __attribute__((target("avx2")))
+
+MOTION_TARGET_AVX2 void XorAvx2(const std::byte* input, std::byte* result, std::size_t byte_size) {
+  std::size_t i = 0;
+  for (; i + 32 <= byte_size; i += 32) {
+    const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(result + i));
+    const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_xor_si256(a, b));
+  }
+  BinaryScalar(input, result, byte_size, i, kXor);
+}
+
+MOTION_TARGET_AVX2 void AndAvx2(const std::byte* input, std::byte* result, std::size_t byte_size) {
+  std::size_t i = 0;
+  for (; i + 32 <= byte_size; i += 32) {
+    const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(result + i));
+    const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_and_si256(a, b));
+  }
+  BinaryScalar(input, result, byte_size, i, kAnd);
+}
+
+MOTION_TARGET_AVX2 void OrAvx2(const std::byte* input, std::byte* result, std::size_t byte_size) {
+  std::size_t i = 0;
+  for (; i + 32 <= byte_size; i += 32) {
+    const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(result + i));
+    const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_or_si256(a, b));
+  }
+  BinaryScalar(input, result, byte_size, i, kOr);
+}
+
+MOTION_TARGET_AVX2 void NotAvx2(std::byte* data, std::size_t byte_size) {
+  const auto ones = _mm256_set1_epi64x(-1);
+  std::size_t i = 0;
+  for (; i + 32 <= byte_size; i += 32) {
+    const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_xor_si256(a, ones));
+  }
+  NotScalarFrom(data, byte_size, i);
+}
+
+MOTION_TARGET_AVX2 void ShiftRightAvx2(const std::byte* source, std::byte* destination,
+                                       std::size_t byte_size, std::size_t shift) {
+  const auto right = _mm_cvtsi64_si128(shift);
+  const auto left = _mm_cvtsi64_si128(64 - shift);
+  std::size_t i = 0;
+  // the upper load reads source[i + 8] to source[i + 39]
+  for (; i + 40 <= byte_size + 1; i += 32) {
+    const auto lower = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+    const auto upper = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 8));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i),
+                        _mm256_or_si256(_mm256_srl_epi64(lower, right),
+                                        _mm256_sll_epi64(upper, left)));
+  }
+  ShiftRightScalarFrom(source, destination, byte_size, shift, i);
+}
+
+MOTION_TARGET_AVX2 void ShiftLeftAvx2(const std::byte* source, std::byte* destination,
+                                      std::size_t byte_size, std::size_t shift) {
+  const auto left = _mm_cvtsi64_si128(shift);
+  const auto right = _mm_cvtsi64_si128(64 - shift);
+  // the lower load reads source[i - 8] to source[i + 23], so start at 8
+  ShiftLeftScalarFrom(source, destination, std::min<std::size_t>(byte_size, 8), shift, 0);
+  std::size_t i = 8;
+  for (; i + 32 <= byte_size; i += 32) {
+    const auto upper = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+    const auto lower = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i - 8));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i),
+                        _mm256_or_si256(_mm256_sll_epi64(upper, left),
+                                        _mm256_srl_epi64(lower, right)));
+  }
+  if (i < byte_size) ShiftLeftScalarFrom(source, destination, byte_size, shift, i);
+}
+
+// ------------------------------ AVX-512 kernels ------------------------------
+
+#define MOTION_TARGET_AVX512 __attribute__((target("avx512f")))
+
+MOTION_TARGET_AVX512 void XorAvx512(const std::byte* input, std::byte* result,
+                                    std::size_t byte_size) {
+  std::size_t i = 0;
+  for (; i + 64 <= byte_size; i += 64) {
+    const auto a = _mm512_loadu_si512(result + i);
+    const auto b = _mm512_loadu_si512(input + i);
+    _mm512_storeu_si512(result + i, _mm512_xor_si512(a, b));
+  }
+  BinaryScalar(input, result, byte_size, i, kXor);
+}
+
+MOTION_TARGET_AVX512 void AndAvx512(const std::byte* input, std::byte* result,
+                                    std::size_t byte_size) {
+  std::size_t i = 0;
+  for (; i + 64 <= byte_size; i += 64) {
+    const auto a = _mm512_loadu_si512(result + i);
+    const auto b = _mm512_loadu_si512(input + i);
+    _mm512_storeu_si512(result + i, _mm512_and_si512(a, b));
+  }
+  BinaryScalar(input, result, byte_size, i, kAnd);
+}
+
+MOTION_TARGET_AVX512 void OrAvx512(const std::byte* input, std::byte* result,
+                                    std::size_t byte_size) {
+  std::size_t i = 0;
+  for (; i + 64 <= byte_size; i += 64) {
+    const auto a = _mm512_loadu_si512(result + i);
+    const auto b = _mm512_loadu_si512(input + i);
+    _mm512_storeu_si512(result + i, _mm512_or_si512(a, b));
+  }
+  BinaryScalar(input, result, byte_size, i, kOr);
+}
+
+MOTION_TARGET_AVX512 void NotAvx512(std::byte* data, std::size_t byte_size) {
+  const auto ones = _mm512_set1_epi64(-1);
+  std::size_t i = 0;
+  for (; i + 64 <= byte_size; i += 64) {
+    _mm512_storeu_si512(data + i, _mm512_xor_si512(_mm512_loadu_si512(data + i), ones));
+  }
+  NotScalarFrom(data, byte_size, i);
+}
+
+MOTION_TARGET_AVX512 void ShiftRightAvx512(const std::byte* source, std::byte* destination,
+                                           std::size_t byte_size, std::size_t shift) {
+  const auto right = _mm512_set1_epi64(shift);
+  const auto left = _mm512_set1_epi64(64 - shift);
+  std::size_t i = 0;
+  // the upper load reads source[i + 8] to source[i + 71]
+  for (; i + 72 <= byte_size + 1; i += 64) {
+    const auto lower = _mm512_loadu_si512(source + i);
+    const auto upper = _mm512_loadu_si512(source + i + 8);
+    _mm512_storeu_si512(destination + i, _mm512_or_si512(_mm512_srlv_epi64(lower, right),
+                                                         _mm512_sllv_epi64(upper, left)));
+  }
+  ShiftRightScalarFrom(source, destination, byte_size, shift, i);
+}
+
+MOTION_TARGET_AVX512 void ShiftLeftAvx512(const std::byte* source, std::byte* destination,
+                                          std::size_t byte_size, std::size_t shift) {
+  const auto left = _mm512_set1_epi64(shift);
+  const auto right = _mm512_set1_epi64(64 - shift);
+  // the lower load reads source[i - 8] to source[i + 55], so start at 8
+  ShiftLeftScalarFrom(source, destination, std::min<std::size_t>(byte_size, 8), shift, 0);
+  std::size_t i = 8;
+  for (; i + 64 <= byte_size; i += 64) {
+    const auto upper = _mm512_loadu_si512(source + i);
+    const auto lower = _mm512_loadu_si512(source + i - 8);
+    _mm512_storeu_si512(destination + i, _mm512_or_si512(_mm512_sllv_epi64(upper, left),
+                                                         _mm512_srlv_epi64(lower, right)));
+  }
+  if (i < byte_size) ShiftLeftScalarFrom(source, destination, byte_size, shift, i);
+}
+
+// ------------------------------ dispatch ------------------------------
+
+struct BitKernels {
+  BitKernelLevel level;
+  void (*xor_bytes)(const std::byte*, std::byte*, std::size_t);
+  void (*and_bytes)(const std::byte*, std::byte*, std::size_t);
+  void (*or_bytes)(const std::byte*, std::byte*, std::size_t);
+  void (*not_bytes)(std::byte*, std::size_t);
+  void (*shift_right_bytes)(const std::byte*, std::byte*, std::size_t, std::size_t);
+  void (*shift_left_bytes)(const std::byte*, std::byte*, std::size_t, std::size_t);
+};
+
+constexpr BitKernels kScalarKernels{BitKernelLevel::kScalar, XorScalar, AndScalar, OrScalar,
+                                    NotScalar, ShiftRightScalar, ShiftLeftScalar};
+constexpr BitKernels kAvx2Kernels{BitKernelLevel::kAvx2, XorAvx2, AndAvx2, OrAvx2,
+                                  NotAvx2, ShiftRightAvx2, ShiftLeftAvx2};
+constexpr BitKernels kAvx512Kernels{BitKernelLevel::kAvx512, XorAvx512, AndAvx512, OrAvx512,
+                                    NotAvx512, ShiftRightAvx512, ShiftLeftAvx512};
+
+const BitKernels* GetKernelsFor(BitKernelLevel level) {
+  switch (level) {
+    case BitKernelLevel::kAvx512:
+      return &kAvx512Kernels;
+    case BitKernelLevel::kAvx2:
+      return &kAvx2Kernels;
+    default:
+      return &kScalarKernels;
+  }
+}
+
+std::atomic<const BitKernels*>& CurrentKernels() {
+  static std::atomic<const BitKernels*> kernels{GetKernelsFor(GetSupportedBitKernelLevel())};
+  return kernels;
+}
+
+inline const BitKernels& Kernels() { return *CurrentKernels().load(std::memory_order_relaxed); }
+
+}  // namespace
+
+BitKernelLevel GetSupportedBitKernelLevel() noexcept {
+  static const BitKernelLevel level = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return BitKernelLevel::kAvx512;
+    if (__builtin_cpu_supports("avx2")) return BitKernelLevel::kAvx2;
+    return BitKernelLevel::kScalar;
+  }();
+  return level;
+}
+
+BitKernelLevel GetBitKernelLevel() noexcept { return Kernels().level; }
+
+void SetBitKernelLevel(BitKernelLevel level) noexcept {
+  if (static_cast<int>(level) > static_cast<int>(GetSupportedBitKernelLevel())) {
+    level = GetSupportedBitKernelLevel();
+  }
+  CurrentKernels().store(GetKernelsFor(level), std::memory_order_relaxed);
+}
+
+void XorBytes(const std::byte* input, std::byte* result, std::size_t byte_size) noexcept {
+  Kernels().xor_bytes(input, result, byte_size);
+}
+
+void AndBytes(const std::byte* input, std::byte* result, std::size_t byte_size) noexcept {
+  Kernels().and_bytes(input, result, byte_size);
+}
+
+void OrBytes(const std::byte* input, std::byte* result, std::size_t byte_size) noexcept {
+  Kernels().or_bytes(input, result, byte_size);
+}
+
+void NotBytes(std::byte* data, std::size_t byte_size) noexcept {
+  Kernels().not_bytes(data, byte_size);
+}
+
+void ShiftRightBytes(const std::byte* source, std::byte* destination, std::size_t byte_size,
+                     std::size_t shift) noexcept {
+  Kernels().shift_right_bytes(source, destination, byte_size, shift);
+}
+
+void ShiftLeftBytes(const std::byte* source, std::byte* destination, std::size_t byte_size,
+                    std::size_t shift) noexcept {
+  Kernels().shift_left_bytes(source, destination, byte_size, shift);
+}
+
+}  // namespace encrypto::motion
@@ -0,0 +1,70 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+
+namespace encrypto::motion {
+
+// Byte-wise bulk kernels on bit strings used by BitVector and BitSpan.  Each kernel is available as
+// scalar, AVX2 and AVX-512 version, the fastest one supported by the CPU is chosen at runtime.
+// Bit i of a string is stored in bit i % 8 of byte i / 8.
+
+enum class BitKernelLevel { kScalar, kAvx2, kAvx512 };
+
+// Returns the best level supported by the CPU.
+BitKernelLevel GetSupportedBitKernelLevel() noexcept;
+
+BitKernelLevel GetBitKernelLevel() noexcept;
+
+// Selects the kernels used from now on, e.g., to compare their performance.  Levels that are not
+// supported by the CPU are lowered to the best supported one.
+void SetBitKernelLevel(BitKernelLevel level) noexcept;
+
+// result[i] ^= input[i] for i < byte_size
+void XorBytes(const std::byte* input, std::byte* result, std::size_t byte_size) noexcept;
+
+// result[i] &= input[i] for i < byte_size
+void AndBytes(const std::byte* input, std::byte* result, std::size_t byte_size) noexcept;
+
+// result[i] |= input[i] for i < byte_size
+void OrBytes(const std::byte* input, std::byte* result, std::size_t byte_size) noexcept;
+
+// data[i] = ~data[i] for i < byte_size
+void NotBytes(std::byte* data, std::size_t byte_size) noexcept;
+
+// Copies the bit string starting at bit offset 0 < shift < 8 of source to the byte-aligned
+// destination, i.e., destination[i] = (source[i] >> shift) | (source[i + 1] << (8 - shift)) for
+// i < byte_size.  source must be readable up to index byte_size.
+void ShiftRightBytes(const std::byte* source, std::byte* destination, std::size_t byte_size,
+                     std::size_t shift) noexcept;
+
+// Copies the byte-aligned bit string source to bit offset 0 < shift < 8, i.e.,
+// destination[i] = (source[i] << shift) | (source[i - 1] >> (8 - shift)) for i < byte_size.
+// source must be readable from index -1.
+void ShiftLeftBytes(const std::byte* source, std::byte* destination, std::size_t byte_size,
+                    std::size_t shift) noexcept;
+
+}  // namespace encrypto::motion
@@ -27,6 +27,8 @@
 #include <bit>
 #include <span>
 
+#include "bit_kernels.h"
+
 namespace encrypto::motion {
 
 auto constexpr NumberOfBitsToNumberOfBytes(std::size_t number_of_bits) {
@@ -100,54 +102,36 @@ inline bool AlignedEqualImplementation(const T* pointer1, const U* pointer2,
 
 template <typename T, typename U>
 inline void XorImplementation(const T* input, U* result, const std::size_t byte_size) {
-  const auto input_cast{reinterpret_cast<const std::byte*>(input)};
-  auto result_cast{reinterpret_cast<std::byte*>(result)};
-  std::transform(input_cast, input_cast + byte_size, result_cast, result_cast,
-                 [](const std::byte& a, const std::byte& b) { return a ^ b; });
+  XorBytes(reinterpret_cast<const std::byte*>(input), reinterpret_cast<std::byte*>(result),
+           byte_size);
 }
 
-// TODO: check how good this is vectorized
+// the kernels use unaligned loads, which are as fast as aligned ones on aligned data
 template <typename T, typename U>
 inline void AlignedXorImplementation(const T* input, U* result, const std::size_t byte_size) {
-  const auto input_cast{
-      reinterpret_cast<const std::byte*>(__builtin_assume_aligned(input, kAlignment))};
-  auto result_cast{reinterpret_cast<std::byte*>(__builtin_assume_aligned(result, kAlignment))};
-  std::transform(input_cast, input_cast + byte_size, result_cast, result_cast,
-                 [](const std::byte& a, const std::byte& b) { return a ^ b; });
+  XorImplementation(input, result, byte_size);
 }
 
 template <typename T, typename U>
 inline void AndImplementation(const T* input, U* result, const std::size_t byte_size) {
-  const auto input_cast{reinterpret_cast<const std::byte*>(input)};
-  auto result_cast{reinterpret_cast<std::byte*>(result)};
-  std::transform(input_cast, input_cast + byte_size, result_cast, result_cast,
-                 [](const std::byte& a, const std::byte& b) { return a & b; });
+  AndBytes(reinterpret_cast<const std::byte*>(input), reinterpret_cast<std::byte*>(result),
+           byte_size);
 }
 
 template <typename T, typename U>
 inline void AlignedAndImplementation(const T* input, U* result, const std::size_t byte_size) {
-  const auto input_cast{
-      reinterpret_cast<const std::byte*>(__builtin_assume_aligned(input, kAlignment))};
-  auto result_cast{reinterpret_cast<std::byte*>(__builtin_assume_aligned(result, kAlignment))};
-  std::transform(input_cast, input_cast + byte_size, result_cast, result_cast,
-                 [](const std::byte& a, const std::byte& b) { return a & b; });
+  AndImplementation(input, result, byte_size);
 }
 
 template <typename T, typename U>
 inline void OrImplementation(const T* input, U* result, const std::size_t byte_size) {
-  const auto input_cast{reinterpret_cast<const std::byte*>(input)};
-  auto result_cast{reinterpret_cast<std::byte*>(result)};
-  std::transform(input_cast, input_cast + byte_size, result_cast, result_cast,
-                 [](const std::byte& a, const std::byte& b) { return a | b; });
+  OrBytes(reinterpret_cast<const std::byte*>(input), reinterpret_cast<std::byte*>(result),
+          byte_size);
 }
 
 template <typename T, typename U>
 inline void AlignedOrImplementation(const T* input, U* result, const std::size_t byte_size) {
-  const auto input_cast{
-      reinterpret_cast<const std::byte*>(__builtin_assume_aligned(input, kAlignment))};
-  auto result_cast{reinterpret_cast<std::byte*>(__builtin_assume_aligned(result, kAlignment))};
-  std::transform(input_cast, input_cast + byte_size, result_cast, result_cast,
-                 [](const std::byte& a, const std::byte& b) { return a | b; });
+  OrImplementation(input, result, byte_size);
 }
 
 inline void CopyImplementation(const std::size_t from, const std::size_t to,
@@ -175,9 +159,7 @@ inline void CopyImplementation(const std::size_t from, const std::size_t to,
   } else if ((from % 8) == 0) {
     const auto number_of_bytes = BitsToBytes(number_of_bits);
     const bool has_remainder = destination_to_offset > 0;
-    for (std::size_t i = 0; i < number_of_bytes - (has_remainder ? 1 : 0); ++i) {
-      destination[from_bytes + i] = source[i];
-    }
+    std::copy_n(source, number_of_bytes - (has_remainder ? 1 : 0), destination + from_bytes);
     if (destination_to_offset > 0) {
       const auto mask = TruncationBitMask[destination_to_offset];
       destination[from_bytes + number_of_bytes - 1] &= ~mask;
@@ -192,11 +174,9 @@ inline void CopyImplementation(const std::size_t from, const std::size_t to,
     destination[from_bytes] &= TruncationBitMask[destination_from_offset];
     destination[from_bytes] |= source[0] << destination_from_offset;
 
-    for (std::size_t byte_i = 1; byte_i <= number_of_complete_bytes; ++byte_i) {
-      std::byte lower_part{source[byte_i - 1] >> (8 - destination_from_offset)};
-      std::byte upper_part{source[byte_i] << destination_from_offset};
-      destination[from_bytes + byte_i] = lower_part | upper_part;
-    }
+    // destination[from_bytes + i] = (source[i - 1] >> (8 - offset)) | (source[i] << offset)
+    ShiftLeftBytes(source + 1, destination + from_bytes + 1, number_of_complete_bytes,
+                   destination_from_offset);
 
     if (destination_to_offset > 0) {
       destination[from_bytes + number_of_bytes - 1] &= ~TruncationBitMask[destination_to_offset];
@@ -233,18 +213,17 @@ inline BitVector<Allocator> SubsetImplementation(const std::size_t from, const s
     result.GetMutableData()[0] = source[from / 8];
     result.GetMutableData()[0] >>= from_bit_offset;
   } else {
-    auto new_byte_offset = 0ull;
-    auto bit_counter = 0ull;
-    const auto max = result.GetSize();
-    for (; bit_counter < max; ++new_byte_offset) {
-      auto left_part = source[(from / 8) + new_byte_offset] >> from_bit_offset;
-      result.GetMutableData()[new_byte_offset] |= left_part;
-      bit_counter += 8 - from_bit_offset;
-      if (bit_counter < max) {
-        auto right_part = source[(from / 8) + new_byte_offset + 1] << (8 - from_bit_offset);
-        result.GetMutableData()[new_byte_offset] |= right_part;
-        bit_counter += from_bit_offset;
-      }
+    const auto source_from = source + from / 8;
+    // the last byte of the result needs a second source byte only if the source extends further
+    const auto number_of_source_bytes = BitsToBytes(to) - from / 8;
+    const auto number_of_result_bytes = result.GetMutableData().size();
+    auto result_data = result.GetMutableData().data();
+    if (number_of_source_bytes > number_of_result_bytes) {
+      ShiftRightBytes(source_from, result_data, number_of_result_bytes, from_bit_offset);
+    } else {
+      ShiftRightBytes(source_from, result_data, number_of_result_bytes - 1, from_bit_offset);
+      result_data[number_of_result_bytes - 1] =
+          source_from[number_of_result_bytes - 1] >> from_bit_offset;
     }
   }
 
@@ -343,9 +322,7 @@ BitVector<Allocator>::BitVector(const std::vector<bool>& data, std::size_t numbe
 
 template <typename Allocator>
 void BitVector<Allocator>::Invert() {
-  for (auto i = 0ull; i < data_vector_.size(); ++i) {
-    data_vector_.at(i) = ~data_vector_.at(i);
-  }
+  NotBytes(data_vector_.data(), data_vector_.size());
 
   TruncateToFit();
 }
@@ -539,9 +516,7 @@ BitVector<Allocator>& BitVector<Allocator>::operator&=(
 
   Resize(max_bit_size, true);
 
-  for (auto i = 0ull; i < min_byte_size; ++i) {
-    data_vector_.at(i) &= other.GetData().at(i);
-  }
+  AndBytes(other.GetData().data(), data_vector_.data(), min_byte_size);
   return *this;
 }
 
@@ -573,9 +548,7 @@ BitVector<Allocator>& BitVector<Allocator>::operator^=(
     const BitVector<OtherAllocator>& other) noexcept {
   auto min_byte_size = std::min(data_vector_.size(), other.data_vector_.size());
 
-  std::transform(data_vector_.cbegin(), data_vector_.cbegin() + min_byte_size,
-                 other.data_vector_.cbegin(), data_vector_.begin(),
-                 [](auto a, auto b) { return a ^ b; });
+  XorBytes(other.data_vector_.data(), data_vector_.data(), min_byte_size);
 
   return *this;
 }
@@ -612,9 +585,7 @@ BitVector<Allocator>& BitVector<Allocator>::operator|=(
 
   Resize(max_bit_size, true);
 
-  for (auto i = 0ull; i < min_byte_size; ++i) {
-    data_vector_.at(i) |= other.GetData().at(i);
-  }
+  OrBytes(other.GetData().data(), data_vector_.data(), min_byte_size);
 
   if (min_byte_size == max_byte_size) {
     for (auto i = min_byte_size; i < max_byte_size; ++i) {
@@ -1404,8 +1375,7 @@ void BitSpan::Set(const bool value, const std::size_t position) {
 }
 
 void BitSpan::Invert() {
-  std::transform(pointer_, pointer_ + NumberOfBitsToNumberOfBytes(bit_size_), pointer_,
-                 [](std::byte& b) { return ~b; });
+  NotBytes(pointer_, NumberOfBitsToNumberOfBytes(bit_size_));
   TruncateToFitImplementation(pointer_, bit_size_);
 }
 
@@ -0,0 +1,46 @@
+// MIT License
+//
+// Copyright (c) 2022
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "fiber_condition.h"
+
+#include "statistics/trace.h"
+
+namespace encrypto::motion {
+
+void FiberCondition::Wait() const {
+  std::unique_lock<decltype(mutex_)> lock(mutex_);
+  if (condition_function_()) return;
+  WaitTraceScope trace_scope;
+  condition_variable_.wait(lock, condition_function_);
+}
+
+bool FiberCondition::WaitForNanoseconds(std::chrono::nanoseconds duration) const {
+  std::unique_lock<decltype(mutex_)> lock(mutex_);
+  if (condition_function_()) return true;
+  WaitTraceScope trace_scope;
+  condition_variable_.wait_for(lock, duration, condition_function_);
+  return condition_function_();
+}
+
+}  // namespace encrypto::motion
@@ -26,6 +26,7 @@
 
 #include <boost/fiber/condition_variable.hpp>
 #include <boost/fiber/mutex.hpp>
+#include <chrono>
 #include <functional>
 
 namespace encrypto::motion {
@@ -50,18 +51,15 @@ class FiberCondition {
   // }
 
   /// \brief Blocks until fiber is notified and condition_function_ returns true.
-  void Wait() const {
-    std::unique_lock<decltype(mutex_)> lock(mutex_);
-    condition_variable_.wait(lock, condition_function_);
-  }
+  /// \note If the fiber actually blocks inside a GateTraceScope, the blocked time is recorded
+  ///       as TraceCategory::kWait event of the gate.
+  void Wait() const;
 
   /// \brief Blocks until fiber is notified and condition_function_ returns true
   ///        or \p duration time has passed.
   template <typename Tick, typename Period>
   bool WaitFor(std::chrono::duration<Tick, Period> duration) const {
-    std::unique_lock<decltype(mutex_)> lock(mutex_);
-    condition_variable_.wait_for(lock, duration, condition_function_);
-    return condition_function_();
+    return WaitForNanoseconds(std::chrono::ceil<std::chrono::nanoseconds>(duration));
   }
 
   /// \brief Unblocks one thread waiting for condition_variable_.
@@ -76,6 +74,8 @@ class FiberCondition {
   boost::fibers::mutex& GetMutex() noexcept { return mutex_; }
 
  private:
+  bool WaitForNanoseconds(std::chrono::nanoseconds duration) const;
+
   mutable boost::fibers::condition_variable condition_variable_;
   mutable boost::fibers::mutex mutex_;
   const std::function<bool()> condition_function_;
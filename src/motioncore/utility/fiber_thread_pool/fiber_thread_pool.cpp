@@ -42,17 +42,17 @@
 namespace encrypto::motion {
 
 FiberThreadPool::FiberThreadPool(std::size_t number_of_workers, std::size_t number_of_tasks,
-                                 bool suspend_scheduler)
+                                 bool suspend_scheduler, bool pin_threads, std::size_t stack_size)
     : number_of_workers_(number_of_workers > 0 ? number_of_workers
-                         : std::thread::hardware_concurrency()),
+                         : std::max(std::thread::hardware_concurrency(), 1u)),
       running_(false),
       suspend_scheduler_(suspend_scheduler),
+      pin_threads_(pin_threads),
+      stack_size_(stack_size > 0 ? stack_size : kFiberStackSize),
+      number_of_fibers_(0),
+      peak_number_of_fibers_(0),
       task_queue_(std::make_unique<boost::fibers::buffered_channel<task_t>>(64)),
       worker_barrier_(std::make_unique<boost::fibers::barrier>(number_of_workers_)) {
-    if (number_of_workers_ == 1) {
-        throw std::invalid_argument("FiberThreadPool needs at least two worker threads");
-    }
-
     (void)number_of_tasks;
 
     // create the worker threads
@@ -69,7 +69,9 @@ FiberThreadPool::~FiberThreadPool() {
 template <typename StackAllocator>
 static void worker_fctn(std::shared_ptr<pool_ctx> pool_ctx,
                         boost::fibers::buffered_channel<FiberThreadPool::task_t>& task_queue,
-                        boost::fibers::barrier& barrier) {
+                        boost::fibers::barrier& barrier, std::uint32_t numa_node,
+                        std::size_t stack_size, std::atomic<std::size_t>& number_of_fibers,
+                        std::atomic<std::size_t>& peak_number_of_fibers) {
     LockedFiberQueue<boost::fibers::fiber> cleanup_channel;
 
     // start cleanup thread for joining the created fibers
@@ -80,19 +82,31 @@ static void worker_fctn(std::shared_ptr<pool_ctx> pool_ctx,
     });
 
     // register this thread with the pool
-    boost::fibers::use_scheduling_algorithm<pooled_work_stealing>(pool_ctx);
+    boost::fibers::use_scheduling_algorithm<pooled_work_stealing>(pool_ctx, numa_node);
 
     FiberThreadPool::task_t task;
 
     // allocator the the fibers' stacks
     StackAllocator stack_allocator(
-        std::max(kFiberStackSize, StackAllocator::traits_type::minimum_size()));
+        std::max(stack_size, StackAllocator::traits_type::minimum_size()));
 
     // try to get new tasks from the queue until the channel is closed and empty,
     // which is the signal to therminate the pool
     while (task_queue.pop(task) != boost::fibers::channel_op_status::closed) {
+        // keep track of the maximum number of simultaneously allocated stacks
+        const auto current_number_of_fibers = ++number_of_fibers;
+        auto peak = peak_number_of_fibers.load();
+        while (current_number_of_fibers > peak &&
+                !peak_number_of_fibers.compare_exchange_weak(peak, current_number_of_fibers)) {
+        }
+
         // create a fiber from the task we retrieved and store its handle
-        cleanup_channel.enqueue(boost::fibers::fiber(std::allocator_arg_t{}, stack_allocator, task));
+        cleanup_channel.enqueue(boost::fibers::fiber(
+                                    std::allocator_arg_t{}, stack_allocator,
+        [task = std::move(task), &number_of_fibers] {
+            task();
+            --number_of_fibers;
+        }));
 
         // give another fiber the chance to run
         boost::this_fiber::yield();
@@ -120,16 +134,34 @@ void FiberThreadPool::create_threads() {
         worker_function = worker_fctn<boost::context::protected_fixedsize_stack>;
         break;
     case FiberStackAllocator::kPooledFixedSize:
-        worker_function = worker_fctn<singleton_pooled_fixedsize_stack<kFiberStackSize>>;
+        // the pool's stack size is a template parameter, so other sizes are not pooled
+        if (stack_size_ == kFiberStackSize) {
+            worker_function = worker_fctn<singleton_pooled_fixedsize_stack<kFiberStackSize>>;
+        } else {
+            worker_function = worker_fctn<boost::context::fixedsize_stack>;
+        }
         break;
     }
 
+    // assign the workers round-robin to the available cpus, which are grouped by NUMA node
+    std::vector<std::size_t> cpus;
+    if (pin_threads_) {
+        cpus = GetAvailableCpus();
+    }
+
     // create the worker threads
     worker_threads_.reserve(number_of_workers_);
     for (std::size_t i = 0; i < number_of_workers_; ++i) {
+        const std::uint32_t numa_node =
+            cpus.empty() ? 0 : GetNumaNode(cpus.at(i % cpus.size()));
         auto& t = worker_threads_.emplace_back(worker_function, pool_ctx_, std::ref(*task_queue_),
-                                               std::ref(*worker_barrier_));
+                                               std::ref(*worker_barrier_), numa_node, stack_size_,
+                                               std::ref(number_of_fibers_),
+                                               std::ref(peak_number_of_fibers_));
 
+        if (!cpus.empty()) {
+            ThreadSetAffinity(t, cpus.at(i % cpus.size()));
+        }
         if constexpr (kDebug) {
             ThreadSetName(t, fmt::format("pool-worker-{}", i));
         }
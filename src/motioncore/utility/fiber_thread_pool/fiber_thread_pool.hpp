@@ -21,6 +21,7 @@
 #ifndef FIBER_THREAD_POOL_HPP
 #define FIBER_THREAD_POOL_HPP
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <thread>
@@ -45,13 +46,18 @@ public:
     // Create a thread pool with given number of workers
     // - number_of_workers
     //   if 0 then the value of std::thread::hardware_concurrency() is used
-    //   else it must be at least 2
     // - number_of_tasks
     //   number of tasks that are to be expected
     // - suspend_scheduler
     //   suspend if there is no work to be done
+    // - pin_threads
+    //   pin each worker to one of the available cpus, and let idle workers
+    //   steal from workers on the same NUMA node first
+    // - stack_size
+    //   size of the fibers' stacks in bytes, if 0 then kFiberStackSize is used
     FiberThreadPool(std::size_t number_of_workers, std::size_t number_of_tasks = 0,
-                    bool suspend_scheduler = true);
+                    bool suspend_scheduler = true, bool pin_threads = false,
+                    std::size_t stack_size = 0);
 
     // Destructor, calls join() if necessary
     ~FiberThreadPool();
@@ -69,12 +75,22 @@ public:
     // No new fibers must be created during this call.
     void join_fibers();
 
+    std::size_t get_stack_size() const noexcept { return stack_size_; }
+
+    // Maximum number of fibers that were alive at the same time, i.e., whose
+    // stacks were allocated at the same time
+    std::size_t get_peak_number_of_fibers() const noexcept { return peak_number_of_fibers_; }
+
 private:
     void create_threads();
 
     std::size_t number_of_workers_;
     bool running_;
     bool suspend_scheduler_;
+    bool pin_threads_;
+    std::size_t stack_size_;
+    std::atomic<std::size_t> number_of_fibers_;
+    std::atomic<std::size_t> peak_number_of_fibers_;
     std::unique_ptr<boost::fibers::buffered_channel<task_t>> task_queue_;
     std::unique_ptr<boost::fibers::barrier> worker_barrier_;
     std::vector<std::thread> worker_threads_;
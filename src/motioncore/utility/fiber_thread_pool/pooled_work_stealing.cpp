@@ -24,13 +24,16 @@ struct pool_ctx {
           suspend_(suspend),
           counter_(0),
           schedulers_(thread_count, nullptr),
+          numa_nodes_(thread_count, 0),
           barrier_(thread_count) {
-        BOOST_ASSERT(thread_count > 1);
+        BOOST_ASSERT(thread_count > 0);
     }
     const std::uint32_t thread_count_;
     const bool suspend_;
     std::atomic<std::uint32_t> counter_;
     std::vector<pooled_work_stealing*> schedulers_;
+    // NUMA node of the thread of each scheduler
+    std::vector<std::uint32_t> numa_nodes_;
     boost::barrier barrier_;
 };
 
@@ -40,13 +43,28 @@ std::shared_ptr<pool_ctx> pooled_work_stealing::create_pool_ctx(std::uint32_t th
     return ctx;
 }
 
-pooled_work_stealing::pooled_work_stealing(std::shared_ptr<pool_ctx> pool_ctx)
+pooled_work_stealing::pooled_work_stealing(std::shared_ptr<pool_ctx> pool_ctx,
+        std::uint32_t numa_node)
     : pool_ctx_{pool_ctx},
       id_{pool_ctx_->counter_++},
       thread_count_{pool_ctx_->thread_count_},
       suspend_{pool_ctx_->suspend_} {
     pool_ctx_->schedulers_[id_] = this;
+    pool_ctx_->numa_nodes_[id_] = numa_node;
     pool_ctx_->barrier_.wait();
+
+    // steal from the schedulers on the same NUMA node first
+    for (std::uint32_t id = 0; id < thread_count_; ++id) {
+        if (id == id_) {
+            continue;
+        }
+        if (pool_ctx_->numa_nodes_[id] == numa_node) {
+            local_victims_.push_back(id);
+        }
+        else {
+            remote_victims_.push_back(id);
+        }
+    }
 }
 
 pooled_work_stealing::~pooled_work_stealing() {
@@ -71,24 +89,10 @@ boost::fibers::context* pooled_work_stealing::pick_next() noexcept {
         }
     }
     else {
-        std::uint32_t id = 0;
-        std::size_t count = 0, size = pool_ctx_->schedulers_.size();
-        static thread_local std::minstd_rand generator{std::random_device{}()};
-        std::uniform_int_distribution<std::uint32_t> distribution{
-            0, static_cast<std::uint32_t>(thread_count_ - 1)};
-        do {
-            do {
-                ++count;
-                // random selection of one logical cpu
-                // that belongs to the local NUMA node
-                id = distribution(generator);
-                // prevent stealing from own scheduler
-            }
-            while (id == id_);
-            // steal context from other scheduler
-            victim = pool_ctx_->schedulers_[id]->steal();
+        victim = steal_from(local_victims_);
+        if (nullptr == victim) {
+            victim = steal_from(remote_victims_);
         }
-        while (nullptr == victim && count < size);
         if (nullptr != victim) {
             boost::context::detail::prefetch_range(victim, sizeof(boost::fibers::context));
             BOOST_ASSERT(!victim->is_context(boost::fibers::type::pinned_context));
@@ -98,6 +102,21 @@ boost::fibers::context* pooled_work_stealing::pick_next() noexcept {
     return victim;
 }
 
+boost::fibers::context* pooled_work_stealing::steal_from(
+    const std::vector<std::uint32_t>& victims) noexcept {
+    if (victims.empty()) {
+        return nullptr;
+    }
+    static thread_local std::minstd_rand generator{std::random_device{}()};
+    std::uniform_int_distribution<std::size_t> distribution{0, victims.size() - 1};
+    boost::fibers::context* victim = nullptr;
+    for (std::size_t count = 0; nullptr == victim && count < victims.size(); ++count) {
+        // random selection of one of the given schedulers
+        victim = pool_ctx_->schedulers_[victims[distribution(generator)]]->steal();
+    }
+    return victim;
+}
+
 void pooled_work_stealing::suspend_until(
     std::chrono::steady_clock::time_point const& time_point) noexcept {
     if (suspend_) {
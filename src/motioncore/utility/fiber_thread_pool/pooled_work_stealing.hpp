@@ -37,6 +37,9 @@ class pooled_work_stealing : public boost::fibers::algo::algorithm {
 
     std::uint32_t id_;
     std::uint32_t thread_count_;
+    // ids of the other schedulers on the same and on other NUMA nodes
+    std::vector<std::uint32_t> local_victims_;
+    std::vector<std::uint32_t> remote_victims_;
 #ifdef BOOST_FIBERS_USE_SPMC_QUEUE
     boost::fibers::detail::context_spmc_queue rqueue_ {};
 #else
@@ -49,9 +52,11 @@ class pooled_work_stealing : public boost::fibers::algo::algorithm {
 
     static void init_(std::uint32_t, std::vector<boost::intrusive_ptr<pooled_work_stealing>>&);
 
+    boost::fibers::context* steal_from(const std::vector<std::uint32_t>&) noexcept;
+
 public:
     static std::shared_ptr<pool_ctx> create_pool_ctx(std::uint32_t, bool = false);
-    pooled_work_stealing(std::shared_ptr<pool_ctx>);
+    pooled_work_stealing(std::shared_ptr<pool_ctx>, std::uint32_t numa_node = 0);
     ~pooled_work_stealing();
 
     pooled_work_stealing(pooled_work_stealing const&) = delete;
@@ -26,7 +26,9 @@
 
 #include <flatbuffers/flatbuffers.h>
 #include <fmt/format.h>
+#include <cassert>
 #include <random>
+#include <span>
 
 #include "condition.h"
 #include "primitives/random/default_rng.h"
@@ -90,62 +92,133 @@ inline std::vector<UnsignedIntegralType> FromByteVector(
   return result;
 }
 
+// The following kernels write their result to a caller-provided output span and thus do not
+// allocate. The output may be identical to one of the inputs for in-place computation, but must not
+// partially overlap them. The loops are vectorized for the ISA the library is compiled for.
+
+/// \brief Computes \p output[i] = \p a[i] + \p b[i].
+/// \pre \p a, \p b and \p output must be of equal size.
+template <typename T>
+inline void AddVectors(std::span<const T> a, std::span<const T> b, std::span<T> output) {
+  assert(a.size() == b.size() && a.size() == output.size());
+  const T* a_pointer{a.data()};
+  const T* b_pointer{b.data()};
+  T* output_pointer{output.data()};
+#pragma omp simd
+  for (std::size_t i = 0; i < output.size(); ++i) {
+    output_pointer[i] = a_pointer[i] + b_pointer[i];
+  }
+}
+
+/// \brief Computes \p output[i] = \p a[i] - \p b[i].
+/// \pre \p a, \p b and \p output must be of equal size.
+template <typename T>
+inline void SubVectors(std::span<const T> a, std::span<const T> b, std::span<T> output) {
+  assert(a.size() == b.size() && a.size() == output.size());
+  const T* a_pointer{a.data()};
+  const T* b_pointer{b.data()};
+  T* output_pointer{output.data()};
+#pragma omp simd
+  for (std::size_t i = 0; i < output.size(); ++i) {
+    output_pointer[i] = a_pointer[i] - b_pointer[i];
+  }
+}
+
+/// \brief Computes \p output[i] = \p a[i] * \p b[i].
+/// \pre \p a, \p b and \p output must be of equal size.
+template <typename T>
+inline void MultiplyVectors(std::span<const T> a, std::span<const T> b, std::span<T> output) {
+  assert(a.size() == b.size() && a.size() == output.size());
+  const T* a_pointer{a.data()};
+  const T* b_pointer{b.data()};
+  T* output_pointer{output.data()};
+#pragma omp simd
+  for (std::size_t i = 0; i < output.size(); ++i) {
+    output_pointer[i] = a_pointer[i] * b_pointer[i];
+  }
+}
+
+/// \brief Computes \p output[i] = \p values[0][i] + ... + \p values[m][i].
+/// \pre All vectors in \p values must be of the same size as \p output.
+template <typename T>
+inline void RowSumReduction(const std::vector<std::vector<T>>& values, std::span<T> output) {
+  std::fill(output.begin(), output.end(), T(0));
+  for (const auto& row : values) {
+    AddVectors<T>(output, row, output);
+  }
+}
+
+/// \brief Computes \p output += \p a * \p b for the row-major matrices \p a (rows x inner),
+/// \p b (inner x columns) and \p output (rows x columns).
+template <typename T>
+inline void MatrixMultiplyAdd(std::span<const T> a, std::span<const T> b, std::span<T> output,
+                              std::size_t rows, std::size_t inner, std::size_t columns) {
+  assert(a.size() == rows * inner && b.size() == inner * columns);
+  assert(output.size() == rows * columns);
+  if (columns == 1) {
+    // matrix-vector products (and dot products) are vectorized along the inner dimension
+    for (std::size_t row = 0; row < rows; ++row) {
+      const T* a_row{a.data() + row * inner};
+      const T* b_pointer{b.data()};
+      T sum{0};
+#pragma omp simd reduction(+ : sum)
+      for (std::size_t l = 0; l < inner; ++l) {
+        sum += a_row[l] * b_pointer[l];
+      }
+      output[row] += sum;
+    }
+    return;
+  }
+  // the innermost loop runs along the rows of b and output, so that it can be vectorized
+  for (std::size_t row = 0; row < rows; ++row) {
+    T* output_row{output.data() + row * columns};
+    for (std::size_t l = 0; l < inner; ++l) {
+      const T a_value{a[row * inner + l]};
+      const T* b_row{b.data() + l * columns};
+#pragma omp simd
+      for (std::size_t column = 0; column < columns; ++column) {
+        output_row[column] += a_value * b_row[column];
+      }
+    }
+  }
+}
+
 /// \brief Adds each element in \p a and \p b and returns the result.
-/// \tparam T type of the elements in the vectors. T must provide the += operator.
+/// \tparam T type of the elements in the vectors. T must provide the binary + operator.
 /// \param a
 /// \param b
 /// \return A vector containing at position i the sum the ith element in a and b.
 /// \pre \p a and \p b must be of equal size.
 template <typename T>
 inline std::vector<T> AddVectors(const std::vector<T>& a, const std::vector<T>& b) {
-  assert(a.size() == b.size());
-  if (a.size() == 0) {
-    return {};
-  }  // if empty input vector
-  std::vector<T> result = a;
-#pragma omp simd
-  for (auto j = 0ull; j < result.size(); ++j) {
-    result.at(j) += b.at(j);  // TODO: implement using AVX2 and AVX512
-  }
+  std::vector<T> result(a.size());
+  AddVectors<T>(a, b, result);
   return result;
 }
 
 /// \brief Subtracts each element in \p a and \p b and returns the result.
-/// \tparam T type of the elements in the vectors. T must provide the -= operator.
+/// \tparam T type of the elements in the vectors. T must provide the binary - operator.
 /// \param a
 /// \param b
 /// \return A vector containing at position i the difference the ith element in a and b.
 /// \pre \p a and \p b must be of equal size.
 template <typename T>
 inline std::vector<T> SubVectors(const std::vector<T>& a, const std::vector<T>& b) {
-  assert(a.size() == b.size());
-  if (a.size() == 0) {
-    return {};
-  }  // if empty input vector
-  std::vector<T> result = a;
-  for (auto j = 0ull; j < result.size(); ++j) {
-    result.at(j) -= b.at(j);  // TODO: implement using AVX2 and AVX512
-  }
+  std::vector<T> result(a.size());
+  SubVectors<T>(a, b, result);
   return result;
 }
 
 /// \brief Multiplies each element in \p a and \p b and returns the result.
-/// \tparam T type of the elements in the vectors. T must provide the *= operator.
+/// \tparam T type of the elements in the vectors. T must provide the binary * operator.
 /// \param a
 /// \param b
 /// \return A vector containing at position i the product the ith element in a and b.
 /// \pre \p a and \p b must be of equal size.
 template <typename T>
-inline std::vector<T> MultiplyVectors(std::vector<T> a, std::vector<T> b) {
-  assert(a.size() == b.size());
-  if (a.size() == 0) {
-    return {};
-  }  // if empty input vector
-  std::vector<T> result = a;
-
-  for (auto j = 0ull; j < result.size(); ++j) {
-    result.at(j) *= b.at(j);  // TODO: implement using AVX2 and AVX512
-  }
+inline std::vector<T> MultiplyVectors(const std::vector<T>& a, const std::vector<T>& b) {
+  std::vector<T> result(a.size());
+  MultiplyVectors<T>(a, b, result);
   return result;
 }
 
@@ -160,16 +233,8 @@ inline std::vector<T> AddVectors(std::vector<std::vector<T>>& vectors) {
   if (vectors.size() == 0) {
     return {};
   }  // if empty input vector
-
-  std::vector<T> result = vectors.at(0);
-
-  for (auto i = 1ull; i < vectors.size(); ++i) {
-    auto& inner_vector = vectors.at(i);
-    assert(inner_vector.size() == result.size());  // expect the vectors to be of the same size
-    for (auto j = 0ull; j < result.size(); ++j) {
-      result.at(j) += inner_vector.at(j);  // TODO: implement using AVX2 and AVX512
-    }
-  }
+  std::vector<T> result(vectors.at(0).size());
+  RowSumReduction<T>(vectors, result);
   return result;
 }
 
@@ -195,17 +260,7 @@ inline std::vector<T> AddVectors(std::vector<std::vector<T>>&& vectors) {
 /// \pre \p a and \p b must be of equal size.
 template <typename T>
 inline std::vector<T> RestrictAddVectors(const std::vector<T>& a, const std::vector<T>& b) {
-  assert(a.size() == b.size());
-  if (a.size() == 0) {
-    return {};
-  }  // if empty input vector
-  std::vector<T> result(a.size());
-  const T* __restrict__ a_pointer{a.data()};
-  const T* __restrict__ b_pointer{b.data()};
-  T* __restrict__ result_pointer{result.data()};
-  std::transform(a_pointer, a_pointer + a.size(), b_pointer, result_pointer,
-                 [](const T& a_value, const T& b_value) { return a_value + b_value; });
-  return result;
+  return AddVectors(a, b);
 }
 
 /// \brief Subtracts each element in \p a and \p b and returns the result.
@@ -217,17 +272,7 @@ inline std::vector<T> RestrictAddVectors(const std::vector<T>& a, const std::vec
 /// \pre \p a and \p b must be of equal size.
 template <typename T>
 inline std::vector<T> RestrictSubVectors(const std::vector<T>& a, const std::vector<T>& b) {
-  assert(a.size() == b.size());
-  if (a.size() == 0) {
-    return {};
-  }  // if empty input vector
-  std::vector<T> result(a.size());
-  const T* __restrict__ a_pointer{a.data()};
-  const T* __restrict__ b_pointer{b.data()};
-  T* __restrict__ result_pointer{result.data()};
-  std::transform(a_pointer, a_pointer + a.size(), b_pointer, result_pointer,
-                 [](const T& a_value, const T& b_value) { return a_value - b_value; });
-  return result;
+  return SubVectors(a, b);
 }
 
 /// \brief Mulitiplies each element in \p a and \p b and returns the result.
@@ -239,17 +284,7 @@ inline std::vector<T> RestrictSubVectors(const std::vector<T>& a, const std::vec
 /// \pre \p a and \p b must be of equal size.
 template <typename T>
 inline std::vector<T> RestrictMulVectors(const std::vector<T>& a, const std::vector<T>& b) {
-  assert(a.size() == b.size());
-  if (a.size() == 0) {
-    return {};
-  }  // if empty input vector
-  std::vector<T> result(a.size());
-  const T* __restrict__ a_pointer{a.data()};
-  const T* __restrict__ b_pointer{b.data()};
-  T* __restrict__ result_pointer{result.data()};
-  std::transform(a_pointer, a_pointer + a.size(), b_pointer, result_pointer,
-                 [](const T& a_value, const T& b_value) { return a_value * b_value; });
-  return result;
+  return MultiplyVectors(a, b);
 }
 
 /// \brief Returns the sum of each element in \p values.
@@ -317,19 +352,10 @@ template <typename T>
 inline std::vector<T> RowSumReduction(const std::vector<std::vector<T>>& values) {
   if (values.size() == 0) {
     return {};
-  } else {
-    std::vector<T> sum(values.at(0).size());
-    for (auto i = 1ull; i < values.size(); ++i) {
-      assert(values.at(0).size() == values.at(i).size());
-    }
-
-    for (auto i = 0ull; i < sum.size(); ++i) {
-      for (auto j = 0ull; j < values.size(); ++j) {
-        sum.at(i) += values.at(j).at(i);
-      }
-    }
-    return std::move(sum);
   }
+  std::vector<T> sum(values.at(0).size());
+  RowSumReduction<T>(values, sum);
+  return sum;
 }
 
 /// \brief Returns the difference of each row in a matrix.
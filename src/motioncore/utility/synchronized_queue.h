@@ -34,6 +34,7 @@
 #undef GetMessage
 #endif
 
+#include <chrono>
 #include <future>
 #include <iostream>
 #include <mutex>
@@ -160,6 +161,30 @@ class BasicSynchronizedQueue {
     return std::optional<std::queue<T>>(std::move(output));
   }
 
+  /**
+   * Extract all elements of the queue, but wait at most for the given duration
+   * if the queue is currently empty.  Returns an empty queue on timeout.
+   */
+  template <typename Rep, typename Period>
+  std::optional<std::queue<T>> BatchDequeueFor(
+      std::chrono::duration<Rep, Period> duration) noexcept {
+    std::queue<T> output;
+    std::unique_lock lock(mutex_);
+    if (queue_.empty() && closed_) {
+      return std::nullopt;
+    }
+    if (queue_.empty() && !closed_) {
+      condition_variable_.wait_for(lock, duration,
+                                   [this] { return !this->queue_.empty() || this->closed_; });
+    }
+    if (queue_.empty() && closed_) {
+      return std::nullopt;
+    }
+    std::swap(queue_, output);
+    lock.unlock();
+    return std::optional<std::queue<T>>(std::move(output));
+  }
+
  private:
   bool closed_ = false;
   std::queue<T> queue_;
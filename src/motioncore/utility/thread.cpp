@@ -20,7 +20,10 @@
 
 #include "thread.h"
 #include <pthread.h>
+#include <sched.h>
+#include <algorithm>
 #include <cassert>
+#include <filesystem>
 #include <string>
 #include <thread>
 
@@ -32,4 +35,50 @@ void ThreadSetName(std::thread& thread, const std::string& name) {
   pthread_setname_np(handle, name.c_str());
 }
 
+void ThreadSetAffinity(std::thread& thread, std::size_t cpu) {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  [[maybe_unused]] auto result =
+      pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set);
+  assert(result == 0);
+}
+
+std::size_t GetNumaNode(std::size_t cpu) {
+  // Linux exposes the node of a cpu as a directory entry /sys/devices/system/cpu/cpuX/nodeY
+  std::error_code error;
+  const std::filesystem::path cpu_directory{"/sys/devices/system/cpu/cpu" + std::to_string(cpu)};
+  for (const auto& entry : std::filesystem::directory_iterator(cpu_directory, error)) {
+    const auto name = entry.path().filename().string();
+    if (name.starts_with("node") && name.size() > 4 &&
+        name.find_first_not_of("0123456789", 4) == std::string::npos) {
+      return std::stoul(name.substr(4));
+    }
+  }
+  return 0;
+}
+
+std::vector<std::size_t> GetAvailableCpus() {
+  std::vector<std::size_t> cpus;
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpu_set)) cpus.emplace_back(cpu);
+    }
+  }
+  if (cpus.empty()) {
+    for (std::size_t cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu) {
+      cpus.emplace_back(cpu);
+    }
+  }
+  // group the cpus by their node, such that consecutively created threads share a node
+  std::vector<std::pair<std::size_t, std::size_t>> nodes_and_cpus;
+  nodes_and_cpus.reserve(cpus.size());
+  for (auto cpu : cpus) nodes_and_cpus.emplace_back(GetNumaNode(cpu), cpu);
+  std::sort(nodes_and_cpus.begin(), nodes_and_cpus.end());
+  for (std::size_t i = 0; i < cpus.size(); ++i) cpus.at(i) = nodes_and_cpus.at(i).second;
+  return cpus;
+}
+
 }  // namespace encrypto::motion
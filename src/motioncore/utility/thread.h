@@ -20,8 +20,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace encrypto::motion {
 
@@ -29,4 +31,13 @@ namespace encrypto::motion {
 // - name.size() <= 16
 void ThreadSetName(std::thread& thread, const std::string& name);
 
+// Restricts the thread to run on the given logical cpu.
+void ThreadSetAffinity(std::thread& thread, std::size_t cpu);
+
+// Returns the NUMA node of the given logical cpu, or 0 if it cannot be determined.
+std::size_t GetNumaNode(std::size_t cpu);
+
+// Returns the logical cpus this process may run on, grouped by their NUMA node.
+std::vector<std::size_t> GetAvailableCpus();
+
 }  // namespace encrypto::motion
@@ -110,7 +110,18 @@ inline std::string to_string(PrimitiveOperationType t) {
   }
 }
 
-enum class IntegerOperationType : unsigned int { kAdd, kDiv, kGt, kEq, kMul, kSub, kInvalid };
+// kB2a is the Boolean to arithmetic GMW conversion, listed here to be benchmarked alongside the
+// integer operations
+enum class IntegerOperationType : unsigned int {
+  kAdd,
+  kDiv,
+  kGt,
+  kEq,
+  kMul,
+  kSub,
+  kB2a,
+  kInvalid
+};
 
 inline std::string to_string(IntegerOperationType p) {
   switch (p) {
@@ -132,6 +143,9 @@ inline std::string to_string(IntegerOperationType p) {
     case IntegerOperationType::kSub: {
       return "INT_SUB";
     }
+    case IntegerOperationType::kB2a: {
+      return "INT_B2A";
+    }
     default:
       throw std::invalid_argument("Invalid IntegerOperationType");
   }
@@ -157,6 +157,37 @@ TEST(AesNi128, TmmoBatch4) {
   EXPECT_EQ(output, kExpectedOutput);
 }
 
+TEST(AesNi128, TmmoTweaked) {
+  std::array<std::uint8_t, kAesKeySize128> kKey = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                                   0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+  alignas(kAesBlockSize) std::array<std::uint8_t, kAesRoundKeysSize128> round_keys;
+  std::copy(std::begin(kKey), std::end(kKey), std::begin(round_keys));
+  AesniKeyExpansion128(round_keys.data());
+
+  // 4 batched blocks and a remainder of 1 block, with two different tweaks
+  constexpr std::size_t kNumberOfBlocks = 5;
+  alignas(kAesBlockSize) std::array<std::uint8_t, kNumberOfBlocks * kAesBlockSize> input;
+  for (std::size_t i = 0; i < input.size(); ++i) input[i] = static_cast<std::uint8_t>(i);
+  const __uint128_t tweak_0 = 0xdeadbeefdeadcafe, tweak_1 = 0xbeefcafecafebeef;
+  alignas(kAesBlockSize) std::array<__uint128_t, kNumberOfBlocks> tweaks = {
+      tweak_0, tweak_0, tweak_1, tweak_1, tweak_0};
+
+  alignas(kAesBlockSize) auto output = input;
+  AesniTmmoTweaked(round_keys.data(), output.data(), tweaks.data(), kNumberOfBlocks);
+
+  // compare each block with the single-tweak batch implementation
+  for (std::size_t i = 0; i < kNumberOfBlocks; ++i) {
+    alignas(kAesBlockSize) std::array<std::uint8_t, 4 * kAesBlockSize> expected;
+    for (std::size_t j = 0; j < 4; ++j) {
+      std::copy_n(input.data() + i * kAesBlockSize, kAesBlockSize,
+                  expected.data() + j * kAesBlockSize);
+    }
+    AesniTmmoBatch4(round_keys.data(), expected.data(), tweaks[i]);
+    EXPECT_TRUE(std::equal(expected.data(), expected.data() + kAesBlockSize,
+                           output.data() + i * kAesBlockSize));
+  }
+}
+
 TEST(AesNi128, MmoSingle) {
   std::array<std::uint8_t, kAesKeySize128> kKey = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
                                                    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
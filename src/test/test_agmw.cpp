@@ -23,9 +23,15 @@
 // SOFTWARE.
 
 #include <gtest/gtest.h>
+#include <filesystem>
 #include <future>
 
+#include <fmt/format.h>
+
+#include "base/compiled_circuit.h"
 #include "base/party.h"
+#include "base/register.h"
+#include "multiplication_triple/preprocessing_store.h"
 #include "protocols/arithmetic_gmw/arithmetic_gmw_gate.h"
 #include "protocols/arithmetic_gmw/arithmetic_gmw_wire.h"
 #include "protocols/share_wrapper.h"
@@ -94,6 +100,47 @@ TEST(ArithmeticGmw, InputOutput_1_1K_Simd_2_3_4_5_10_parties) {
   }
 }
 
+TEST(ArithmeticGmw, InputTable_3_Columns_100_Rows_2_3_parties) {
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  constexpr std::size_t kNumberOfColumns = 3, kNumberOfRows = 100;
+  for (auto number_of_parties : {2u, 3u}) {
+    const std::size_t input_owner = std::rand() % number_of_parties;
+    std::vector<std::vector<std::uint32_t>> global_table;
+    for (std::size_t column = 0; column < kNumberOfColumns; ++column) {
+      global_table.push_back(::RandomVector<std::uint32_t>(kNumberOfRows));
+    }
+    std::vector<PartyPointer> motion_parties(
+        std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+    for (auto& party : motion_parties) {
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+    }
+#pragma omp parallel for num_threads(motion_parties.size())
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      std::vector<std::vector<std::uint32_t>> table(
+          kNumberOfColumns, std::vector<std::uint32_t>(kNumberOfRows, 0u));
+      if (party_id == input_owner) {
+        table = global_table;
+      }
+
+      EXPECT_THROW(motion_parties.at(party_id)->InTable<kArithmeticGmw>(
+                       std::vector<std::vector<std::uint32_t>>(table), number_of_parties),
+                   std::runtime_error);
+      auto columns =
+          motion_parties.at(party_id)->InTable<kArithmeticGmw>(std::move(table), input_owner);
+      EXPECT_EQ(columns.size(), kNumberOfColumns);
+      std::vector<ShareWrapper> outputs;
+      for (auto& column : columns) outputs.push_back(column.Out());
+
+      motion_parties.at(party_id)->Run();
+
+      for (std::size_t column = 0; column < kNumberOfColumns; ++column) {
+        EXPECT_EQ(outputs.at(column).As<std::vector<std::uint32_t>>(), global_table.at(column));
+      }
+      motion_parties.at(party_id)->Finish();
+    }
+  }
+}
+
 TEST(ArithmeticGmw, Addition_1_1K_Simd_2_3_4_5_10_parties) {
   constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
   std::srand(std::time(nullptr));
@@ -485,6 +532,274 @@ TEST(ArithmeticGmw, Multiplication_1_100_Simd_2_3_parties) {
   }
 }
 
+TEST(ArithmeticGmw, DotProductAndMatrixMultiplication_2_3_parties) {
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  constexpr std::size_t kRows = 3, kInner = 4, kColumns = 5, kVectorSize = 100;
+  auto template_test = [](auto template_variable) {
+    using T = decltype(template_variable);
+    for (auto number_of_parties : {2u, 3u}) {
+      // party 0 inputs a and x, the last party inputs b and y
+      const std::size_t b_owner = number_of_parties - 1;
+      const std::vector<T> a = ::RandomVector<T>(kRows * kInner);
+      const std::vector<T> b = ::RandomVector<T>(kInner * kColumns);
+      const std::vector<T> x = ::RandomVector<T>(kVectorSize);
+      const std::vector<T> y = ::RandomVector<T>(kVectorSize);
+
+      std::vector<T> expected_matrix(kRows * kColumns, 0);
+      encrypto::motion::MatrixMultiplyAdd<T>(a, b, expected_matrix, kRows, kInner, kColumns);
+      T expected_dot_product = 0;
+      for (std::size_t i = 0; i < kVectorSize; ++i) expected_dot_product += x.at(i) * y.at(i);
+
+      std::vector<PartyPointer> motion_parties(
+          std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+      for (auto& party : motion_parties) {
+        party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        party->GetConfiguration()->SetOnlineAfterSetup(random_value() % 2 == 1);
+      }
+      std::vector<std::future<void>> futures;
+      for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+        futures.emplace_back(std::async(std::launch::async, [&, party_id] {
+          auto& party = motion_parties.at(party_id);
+          // dummy 0-vectors as input for the parties that do not own the input
+          auto input = [party_id](const std::vector<T>& values, std::size_t owner) {
+            return party_id == owner ? values : std::vector<T>(values.size(), 0);
+          };
+          encrypto::motion::ShareWrapper share_a{party->In<kArithmeticGmw>(input(a, 0), 0)};
+          encrypto::motion::ShareWrapper share_b{
+              party->In<kArithmeticGmw>(input(b, b_owner), b_owner)};
+          encrypto::motion::ShareWrapper share_x{party->In<kArithmeticGmw>(input(x, 0), 0)};
+          encrypto::motion::ShareWrapper share_y{
+              party->In<kArithmeticGmw>(input(y, b_owner), b_owner)};
+
+          auto share_matrix = share_a.MatrixMultiply(share_b, kRows, kInner, kColumns).Out();
+          auto share_dot_product = share_x.DotProduct(share_y).Out();
+
+          party->Run();
+
+          EXPECT_EQ(share_matrix.As<std::vector<T>>(), expected_matrix);
+          EXPECT_EQ(share_dot_product.As<T>(), expected_dot_product);
+          party->Finish();
+        }));
+      }
+      for (auto& f : futures) f.get();
+    }
+  };
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    template_test(static_cast<std::uint8_t>(0));
+    template_test(static_cast<std::uint16_t>(0));
+    template_test(static_cast<std::uint32_t>(0));
+    template_test(static_cast<std::uint64_t>(0));
+  }
+}
+
+TEST(ArithmeticGmw, Truncation_1K_Simd_2_3_parties) {
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  constexpr std::size_t kNumberOfSimd = 1000;
+  auto template_test = [](auto template_variable) {
+    using T = decltype(template_variable);
+    using SignedT = std::make_signed_t<T>;
+    for (auto number_of_parties : {2u, 3u}) {
+      // small positive and negative values, for which the truncation fails with negligible
+      // probability, i.e., at most 2^-24 per value
+      std::vector<T> input(kNumberOfSimd);
+      for (auto& value : input) value = static_cast<T>(SignedT(random_value() % 512) - 256);
+      const std::size_t shift = 1 + random_value() % 8;
+      const std::size_t input_owner = random_value() % number_of_parties;
+
+      std::vector<PartyPointer> motion_parties(
+          std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+      for (auto& party : motion_parties) {
+        party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        party->GetConfiguration()->SetOnlineAfterSetup(random_value() % 2 == 1);
+      }
+      std::vector<std::future<void>> futures;
+      for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+        futures.emplace_back(std::async(std::launch::async, [&, party_id] {
+          auto& party = motion_parties.at(party_id);
+          std::vector<T> my_input =
+              party_id == input_owner ? input : std::vector<T>(kNumberOfSimd, 0);
+          encrypto::motion::ShareWrapper share{
+              party->In<kArithmeticGmw>(std::move(my_input), input_owner)};
+          auto share_output = share.Truncate(shift).Out();
+
+          party->Run();
+
+          const auto result = share_output.As<std::vector<T>>();
+          for (std::size_t i = 0; i < kNumberOfSimd; ++i) {
+            const T expected = static_cast<T>(static_cast<SignedT>(input.at(i)) >> shift);
+            // the probabilistic truncation may be off by one
+            EXPECT_LE(static_cast<T>(result.at(i) - expected), 1u);
+          }
+          party->Finish();
+        }));
+      }
+      for (auto& f : futures) f.get();
+    }
+  };
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    template_test(static_cast<std::uint32_t>(0));
+    template_test(static_cast<std::uint64_t>(0));
+  }
+}
+
+TEST(ArithmeticGmw, CompiledCircuit_Multiplication_100_Simd_3_Evaluations_2_parties) {
+  constexpr std::size_t kNumberOfParties = 2;
+  constexpr std::size_t kNumberOfSimd = 100;
+  constexpr std::size_t kNumberOfEvaluations = 3;
+  const auto get_path = [](std::size_t party_id) {
+    return (std::filesystem::temp_directory_path() /
+            fmt::format("motion_test_compiled_circuit_{}.bin", party_id))
+        .string();
+  };
+
+  // enough MTs for all evaluations
+  encrypto::motion::PreprocessingDemand demand;
+  demand.number_of_mts_64 = kNumberOfSimd * kNumberOfEvaluations;
+  {
+    std::vector<PartyPointer> motion_parties(
+        std::move(MakeLocallyConnectedParties(kNumberOfParties, kPortOffset)));
+    std::vector<std::future<void>> futures;
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      futures.emplace_back(std::async(std::launch::async, [&, party_id] {
+        auto& party = motion_parties.at(party_id);
+        party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        party->PrecomputePreprocessing(demand, get_path(party_id));
+        party->Finish();
+      }));
+    }
+    for (auto& f : futures) f.get();
+  }
+
+  std::vector<std::vector<std::vector<std::uint64_t>>> inputs(kNumberOfEvaluations);
+  for (auto& evaluation_inputs : inputs) {
+    evaluation_inputs.resize(kNumberOfParties, std::vector<std::uint64_t>(kNumberOfSimd));
+    for (auto& input : evaluation_inputs) {
+      for (auto& value : input) value = random_value();
+    }
+  }
+
+  std::vector<PartyPointer> motion_parties(
+      std::move(MakeLocallyConnectedParties(kNumberOfParties, kPortOffset)));
+  std::vector<std::future<void>> futures;
+  for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+    futures.emplace_back(std::async(std::launch::async, [&, party_id] {
+      auto& party = motion_parties.at(party_id);
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      party->LoadPreprocessing(get_path(party_id));
+
+      // the circuit is built once, x_0 * x_1 + x_0
+      encrypto::motion::CompiledCircuit circuit(*party);
+      std::vector<encrypto::motion::ShareWrapper> shares;
+      for (std::size_t input_owner = 0; input_owner < kNumberOfParties; ++input_owner) {
+        auto input = input_owner == party_id ? inputs.at(0).at(input_owner)
+                                             : std::vector<std::uint64_t>(kNumberOfSimd, 0);
+        shares.push_back(circuit.In(std::move(input), input_owner));
+      }
+      auto share_output = (shares.at(0) * shares.at(1) + shares.at(0)).Out();
+      const auto number_of_gates = party->GetBackend()->GetRegister()->GetTotalNumberOfGates();
+
+      for (std::size_t evaluation = 0; evaluation < kNumberOfEvaluations; ++evaluation) {
+        if (evaluation > 0) {
+          circuit.SetInput(party_id, inputs.at(evaluation).at(party_id));
+        }
+        circuit.Evaluate();
+
+        const auto& x_0 = inputs.at(evaluation).at(0);
+        const auto& x_1 = inputs.at(evaluation).at(1);
+        const auto result = share_output.As<std::vector<std::uint64_t>>();
+        for (std::size_t i = 0; i < kNumberOfSimd; ++i) {
+          EXPECT_EQ(result.at(i), x_0.at(i) * x_1.at(i) + x_0.at(i));
+        }
+      }
+      EXPECT_EQ(circuit.GetNumberOfEvaluations(), kNumberOfEvaluations);
+      EXPECT_EQ(party->GetBackend()->GetRegister()->GetTotalNumberOfGates(), number_of_gates);
+      party->Finish();
+    }));
+  }
+  for (auto& f : futures) f.get();
+
+  // every evaluation consumed fresh MTs
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    using Section = encrypto::motion::PreprocessingStore::Section;
+    encrypto::motion::PreprocessingStore store(get_path(party_id), party_id, kNumberOfParties);
+    EXPECT_EQ(store.GetNumberOfAvailable(Section::kMts64), 0u);
+    std::filesystem::remove(get_path(party_id));
+  }
+}
+
+TEST(ArithmeticGmw, StreamingEvaluation_Addition_Chain_16K_Simd_2_parties) {
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  constexpr auto kArithmeticConstant = encrypto::motion::MpcProtocol::kArithmeticConstant;
+  constexpr std::size_t kNumberOfParties = 2;
+  constexpr std::size_t kNumberOfSimd = 16 * 1024;
+  constexpr std::size_t kNumberOfAdditions = 32;
+  constexpr std::size_t kSizeOfValues = kNumberOfSimd * sizeof(std::uint64_t);
+  const auto input = ::RandomVector<std::uint64_t>(kNumberOfSimd);
+  const auto constant = ::RandomVector<std::uint64_t>(kNumberOfSimd);
+
+  // evaluates x + x + ... + x + c, a circuit of width 1, and returns the peak heap memory of the
+  // evaluation
+  auto run = [&](bool streaming_evaluation, bool online_after_setup) {
+    std::vector<PartyPointer> motion_parties(
+        std::move(MakeLocallyConnectedParties(kNumberOfParties, kPortOffset)));
+    std::vector<encrypto::motion::ShareWrapper> share_outputs;
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      auto& party = motion_parties.at(party_id);
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      party->GetConfiguration()->SetOnlineAfterSetup(online_after_setup);
+      party->GetConfiguration()->SetStreamingEvaluation(streaming_evaluation);
+      // otherwise, the fiber stacks grow with the size of the circuit
+      party->GetConfiguration()->SetMaximumNumberOfFibers(4);
+
+      const encrypto::motion::ShareWrapper share_input = party->In<kArithmeticGmw>(
+          party_id == 0 ? input : std::vector<std::uint64_t>(kNumberOfSimd, 0), 0);
+      const encrypto::motion::ShareWrapper share_constant =
+          party->In<kArithmeticConstant>(constant);
+      // only the gates refer to the intermediate sums
+      auto share_sum = share_input;
+      for (std::size_t i = 0; i < kNumberOfAdditions; ++i) share_sum = share_sum + share_input;
+      share_sum = share_sum + share_constant;
+      share_outputs.push_back(share_sum.Out());
+    }
+
+    ResetPeakHeapMemory();
+    std::vector<std::future<void>> futures;
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      futures.emplace_back(std::async(std::launch::async, [&, party_id] {
+        motion_parties.at(party_id)->Run();
+        motion_parties.at(party_id)->Finish();
+      }));
+    }
+    for (auto& f : futures) f.get();
+    const auto peak_heap_memory = GetPeakHeapMemory();
+
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      const auto result = share_outputs.at(party_id).As<std::vector<std::uint64_t>>();
+      for (std::size_t i = 0; i < kNumberOfSimd; ++i) {
+        EXPECT_EQ(result.at(i), (kNumberOfAdditions + 1) * input.at(i) + constant.at(i));
+      }
+      if (streaming_evaluation) {
+        // including the constant input gate, which is not posted to the fiber pool
+        const auto& gates = motion_parties.at(party_id)->GetBackend()->GetRegister()->GetGates();
+        EXPECT_TRUE(std::all_of(gates.begin(), gates.end(),
+                                [](const auto& gate) { return gate == nullptr; }));
+      }
+    }
+    return peak_heap_memory;
+  };
+
+  constexpr std::size_t kSizeOfAllValues = kNumberOfParties * kNumberOfAdditions * kSizeOfValues;
+  for (bool online_after_setup : {false, true}) {
+    const auto peak_heap_memory = run(false, online_after_setup);
+    const auto peak_heap_memory_streaming = run(true, online_after_setup);
+    // without streaming evaluation, the values of all gates are alive at the end
+    EXPECT_GE(peak_heap_memory, kSizeOfAllValues);
+    // with streaming evaluation, only the values of the few gates being evaluated are alive, so at
+    // least half of the values are saved
+    EXPECT_LE(peak_heap_memory_streaming + kSizeOfAllValues / 2, peak_heap_memory);
+  }
+}
+
 TEST(ArithmeticGmw, ConstantMultiplication_1_1K_Simd_2_3_4_5_10_parties) {
   constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
   constexpr auto kArithmeticConstant = encrypto::motion::MpcProtocol::kArithmeticConstant;
@@ -24,9 +24,17 @@
 
 #include "test_constants.h"
 
+#include <filesystem>
+
+#include <fmt/format.h>
+
 #include "base/backend.h"
+#include "base/configuration.h"
 #include "base/party.h"
 #include "data_storage/base_ot_data.h"
+#include "multiplication_triple/mt_provider.h"
+#include "multiplication_triple/preprocessing_store.h"
+#include "oblivious_transfer/base_ots/base_ot_cache.h"
 #include "oblivious_transfer/base_ots/base_ot_provider.h"
 
 using namespace encrypto::motion;
@@ -114,3 +122,76 @@ TEST(ObliviousTransfer, BaseOt) {
     }
   }
 }
+
+TEST(ObliviousTransfer, BaseOtCache) {
+  constexpr std::size_t kNumberOfParties = 2;
+  constexpr std::size_t kNumberOfMts = 128;
+  const auto directory = std::filesystem::temp_directory_path() / "motion_test_base_ot_cache";
+  const auto get_store_path = [&directory](std::size_t party_id) {
+    return (directory / fmt::format("preprocessing_{}.bin", party_id)).string();
+  };
+  std::filesystem::remove_all(directory);
+
+  encrypto::motion::PreprocessingDemand demand;
+  demand.number_of_binary_mts = kNumberOfMts;
+
+  // the first run computes and stores the base OTs, the second run resumes them
+  std::vector<std::pair<ReceiverMessage, SenderMessage>> first_base_ots(kNumberOfParties);
+  for (std::size_t run = 0; run < 2; ++run) {
+    auto motion_parties = MakeLocallyConnectedParties(kNumberOfParties, kPortOffset);
+    std::vector<std::future<void>> futures;
+    for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+      futures.emplace_back(std::async(std::launch::async, [&, party_id] {
+        auto& party = motion_parties.at(party_id);
+        party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        party->GetConfiguration()->SetBaseOtCacheDirectory(directory.string());
+        party->PrecomputePreprocessing(demand, get_store_path(party_id));
+        party->Finish();
+      }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+
+    const auto& binary_mts_0 = motion_parties.at(0)->GetBackend()->GetMtProvider()->GetBinaryAll();
+    const auto& binary_mts_1 = motion_parties.at(1)->GetBackend()->GetMtProvider()->GetBinaryAll();
+    EXPECT_EQ(binary_mts_0.c ^ binary_mts_1.c,
+              (binary_mts_0.a ^ binary_mts_1.a) & (binary_mts_0.b ^ binary_mts_1.b));
+
+    for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+      const std::size_t other_id = 1 - party_id;
+      BaseOtCache cache(directory.string(), party_id, kNumberOfParties);
+      EXPECT_TRUE(std::filesystem::exists(cache.GetPath(other_id)));
+
+      auto base_ots = motion_parties.at(party_id)->GetBackend()->ExportBaseOts(other_id);
+      auto other_base_ots = motion_parties.at(other_id)->GetBackend()->ExportBaseOts(party_id);
+      const auto& [receiver_message, sender_message] = base_ots;
+      for (std::size_t k = 0; k < kKappa; ++k) {
+        const auto& other_sender_message = std::get<1>(other_base_ots);
+        EXPECT_EQ(receiver_message.messages_c.at(k),
+                  receiver_message.c.Get(k) ? other_sender_message.messages_1.at(k)
+                                            : other_sender_message.messages_0.at(k));
+      }
+
+      if (run == 0) {
+        first_base_ots.at(party_id) = std::move(base_ots);
+      } else {
+        // resumed sessions keep the choice bits, but derive fresh keys
+        const auto& [first_receiver_message, first_sender_message] = first_base_ots.at(party_id);
+        EXPECT_EQ(receiver_message.c, first_receiver_message.c);
+        EXPECT_NE(receiver_message.messages_c, first_receiver_message.messages_c);
+        EXPECT_NE(sender_message.messages_0, first_sender_message.messages_0);
+        EXPECT_NE(sender_message.messages_1, first_sender_message.messages_1);
+      }
+    }
+  }
+
+  // the cache directory is private to the user, entries in a directory others can access are
+  // ignored
+  EXPECT_EQ(std::filesystem::status(directory).permissions() & std::filesystem::perms::all,
+            std::filesystem::perms::owner_all);
+  std::filesystem::permissions(directory, std::filesystem::perms::others_write,
+                               std::filesystem::perm_options::add);
+  BaseOtCache cache(directory.string(), 0, kNumberOfParties);
+  cache.Load();
+  EXPECT_TRUE(cache.GetCacheIds().at(1).empty());
+  std::filesystem::remove_all(directory);
+}
@@ -23,10 +23,13 @@
 // SOFTWARE.
 
 #include <gtest/gtest.h>
+#include "algorithm/algorithm_description.h"
 #include "base/party.h"
+#include "base/register.h"
 #include "protocols/boolean_gmw/boolean_gmw_gate.h"
 #include "protocols/boolean_gmw/boolean_gmw_wire.h"
 #include "protocols/share_wrapper.h"
+#include "statistics/run_time_statistics.h"
 #include "test_constants.h"
 #include "test_helpers.h"
 
@@ -90,6 +93,55 @@ TEST(BooleanGmw, InputOutput_1_1K_Simd_2_3_4_5_10_parties) {
   }
 }
 
+TEST(BooleanGmw, InputTable_1_and_8_bit_Columns_100_Rows_2_3_parties) {
+  constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+  constexpr std::size_t kNumberOfRows = 100;
+  const std::vector<std::size_t> bit_lengths{1, 8};
+  for (auto number_of_parties : {2u, 3u}) {
+    const std::size_t input_owner = std::rand() % number_of_parties;
+    std::vector<std::vector<BitVector<>>> global_table;
+    for (auto bit_length : bit_lengths) {
+      auto& column = global_table.emplace_back();
+      for (std::size_t bit = 0; bit < bit_length; ++bit) {
+        column.push_back(BitVector<>::SecureRandom(kNumberOfRows));
+      }
+    }
+    std::vector<PartyPointer> motion_parties(
+        std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+    for (auto& party : motion_parties) {
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+    }
+#pragma omp parallel for num_threads(motion_parties.size())
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      std::vector<std::vector<BitVector<>>> table;
+      for (auto bit_length : bit_lengths) {
+        table.emplace_back(bit_length, BitVector<>(kNumberOfRows));
+      }
+      if (party_id == input_owner) {
+        table = global_table;
+      }
+
+      auto columns =
+          motion_parties.at(party_id)->InTable<kBooleanGmw>(std::move(table), input_owner);
+      EXPECT_EQ(columns.size(), bit_lengths.size());
+      std::vector<ShareWrapper> outputs;
+      for (auto& column : columns) outputs.push_back(column.Out());
+
+      motion_parties.at(party_id)->Run();
+
+      for (std::size_t column = 0; column < bit_lengths.size(); ++column) {
+        const auto& wires = outputs.at(column)->GetWires();
+        EXPECT_EQ(wires.size(), bit_lengths.at(column));
+        for (std::size_t bit = 0; bit < wires.size(); ++bit) {
+          auto wire = std::dynamic_pointer_cast<proto::boolean_gmw::Wire>(wires.at(bit));
+          EXPECT_EQ(wire->GetValues(), global_table.at(column).at(bit));
+        }
+      }
+      motion_parties.at(party_id)->Finish();
+    }
+  }
+}
+
 TEST(BooleanGmw, Inv_1K_Simd_2_3_4_5_10_parties) {
   for (auto i = 0ull; i < kTestIterations; ++i) {
     constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
@@ -704,6 +756,269 @@ TEST(BooleanGmw, And_64_bit_10_Simd_2_3_parties) {
   }
 }
 
+TEST(BooleanGmw, LayeredEvaluation_And_Xor_64_bit_10_Simd_2_3_parties) {
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+    std::srand(std::time(nullptr));
+    for (auto number_of_parties : {2u, 3u}) {
+      const std::size_t output_owner = std::rand() % number_of_parties;
+      std::vector<std::vector<encrypto::motion::BitVector<>>> global_input_10_64_bit(
+          number_of_parties);
+      for (auto& bv_v : global_input_10_64_bit) {
+        bv_v.resize(64);
+        for (auto& bv : bv_v) {
+          bv = encrypto::motion::BitVector<>::SecureRandom(10);
+        }
+      }
+      std::vector<encrypto::motion::BitVector<>> dummy_input_10_64_bit(
+          64, encrypto::motion::BitVector<>(10, false));
+
+      try {
+        std::vector<PartyPointer> motion_parties(
+            std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+        for (auto& party : motion_parties) {
+          party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+          party->GetConfiguration()->SetOnlineAfterSetup(i % 2 == 1);
+          party->GetConfiguration()->SetLayeredEvaluation(true);
+        }
+#pragma omp parallel for num_threads(motion_parties.size() + 1)
+        for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+          std::vector<encrypto::motion::ShareWrapper> share_input;
+
+          for (auto j = 0ull; j < number_of_parties; ++j) {
+            if (j == motion_parties.at(party_id)->GetConfiguration()->GetMyId()) {
+              share_input.push_back(
+                  motion_parties.at(party_id)->In<kBooleanGmw>(global_input_10_64_bit.at(j), j));
+            } else {
+              share_input.push_back(
+                  motion_parties.at(party_id)->In<kBooleanGmw>(dummy_input_10_64_bit, j));
+            }
+          }
+
+          // (x_0 & x_1) ^ x_1, (... & x_j) ^ x_j, i.e., a circuit with alternating interactive and
+          // non-interactive layers
+          auto share_result = (share_input.at(0) & share_input.at(1)) ^ share_input.at(1);
+
+          for (auto j = 2ull; j < number_of_parties; ++j) {
+            share_result = (share_result & share_input.at(j)) ^ share_input.at(j);
+          }
+
+          auto share_output = share_result.Out(output_owner);
+
+          // evaluate twice to check that the cached layers are reused correctly
+          motion_parties.at(party_id)->Run(2);
+
+          if (party_id == output_owner) {
+            for (auto j = 0ull; j < global_input_10_64_bit.size(); ++j) {
+              auto wire_single =
+                  std::dynamic_pointer_cast<encrypto::motion::proto::boolean_gmw::Wire>(
+                      share_output->GetWires().at(j));
+              assert(wire_single);
+
+              auto expected_result = (global_input_10_64_bit.at(0).at(j) &
+                                      global_input_10_64_bit.at(1).at(j)) ^
+                                     global_input_10_64_bit.at(1).at(j);
+              for (auto k = 2ull; k < number_of_parties; ++k) {
+                expected_result = (expected_result & global_input_10_64_bit.at(k).at(j)) ^
+                                  global_input_10_64_bit.at(k).at(j);
+              }
+
+              EXPECT_EQ(wire_single->GetValues(), expected_result);
+            }
+          }
+
+          motion_parties.at(party_id)->Finish();
+        }
+      } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+      }
+    }
+  }
+}
+
+TEST(BooleanGmw, BoundedFibers_And_Xor_64_bit_10_Simd_2_3_parties) {
+  constexpr std::size_t kMaximumNumberOfFibers = 4;
+  constexpr std::size_t kNumberOfThreads = 2;
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+    std::srand(std::time(nullptr));
+    for (auto number_of_parties : {2u, 3u}) {
+      const std::size_t output_owner = std::rand() % number_of_parties;
+      std::vector<std::vector<encrypto::motion::BitVector<>>> global_input_10_64_bit(
+          number_of_parties);
+      for (auto& bv_v : global_input_10_64_bit) {
+        bv_v.resize(64);
+        for (auto& bv : bv_v) {
+          bv = encrypto::motion::BitVector<>::SecureRandom(10);
+        }
+      }
+      std::vector<encrypto::motion::BitVector<>> dummy_input_10_64_bit(
+          64, encrypto::motion::BitVector<>(10, false));
+
+      try {
+        std::vector<PartyPointer> motion_parties(
+            std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+        for (auto& party : motion_parties) {
+          party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+          party->GetConfiguration()->SetOnlineAfterSetup(i % 2 == 1);
+          party->GetConfiguration()->SetMaximumNumberOfFibers(kMaximumNumberOfFibers);
+          party->GetConfiguration()->SetNumOfThreads(kNumberOfThreads);
+          party->GetConfiguration()->SetFiberStackSize(64 * 1024);
+        }
+#pragma omp parallel for num_threads(motion_parties.size() + 1)
+        for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+          std::vector<encrypto::motion::ShareWrapper> share_input;
+
+          for (auto j = 0ull; j < number_of_parties; ++j) {
+            if (j == motion_parties.at(party_id)->GetConfiguration()->GetMyId()) {
+              share_input.push_back(
+                  motion_parties.at(party_id)->In<kBooleanGmw>(global_input_10_64_bit.at(j), j));
+            } else {
+              share_input.push_back(
+                  motion_parties.at(party_id)->In<kBooleanGmw>(dummy_input_10_64_bit, j));
+            }
+          }
+
+          // a chain of (x_0 & x_1) ^ x_1, (... & x_j) ^ x_j that is longer than the bound on the
+          // live fibers
+          auto share_result = (share_input.at(0) & share_input.at(1)) ^ share_input.at(1);
+          for (auto j = 2ull; j < 4 * number_of_parties; ++j) {
+            const auto& x = share_input.at(j % number_of_parties);
+            share_result = (share_result & x) ^ x;
+          }
+
+          auto share_output = share_result.Out(output_owner);
+
+          motion_parties.at(party_id)->Run();
+
+          if (party_id == output_owner) {
+            for (auto j = 0ull; j < global_input_10_64_bit.size(); ++j) {
+              auto wire_single =
+                  std::dynamic_pointer_cast<encrypto::motion::proto::boolean_gmw::Wire>(
+                      share_output->GetWires().at(j));
+              assert(wire_single);
+
+              auto expected_result = (global_input_10_64_bit.at(0).at(j) &
+                                      global_input_10_64_bit.at(1).at(j)) ^
+                                     global_input_10_64_bit.at(1).at(j);
+              for (auto k = 2ull; k < 4 * number_of_parties; ++k) {
+                const auto& x = global_input_10_64_bit.at(k % number_of_parties).at(j);
+                expected_result = (expected_result & x) ^ x;
+              }
+
+              EXPECT_EQ(wire_single->GetValues(), expected_result);
+            }
+          }
+
+          // an AND gate is admitted together with the two output gates opening its masked inputs,
+          // and each worker thread may still run a fiber whose gate just released its slot
+          const auto& statistics =
+              motion_parties.at(party_id)->GetBackend()->GetRunTimeStatistics().back();
+          EXPECT_LE(statistics.peak_number_of_fibers,
+                    kMaximumNumberOfFibers + 2 + kNumberOfThreads);
+          EXPECT_EQ(statistics.peak_fiber_stack_memory,
+                    statistics.peak_number_of_fibers * 64 * 1024);
+
+          motion_parties.at(party_id)->Finish();
+        }
+      } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+      }
+    }
+  }
+}
+
+TEST(BooleanGmw, StreamingEvaluation_And_Xor_64_bit_10_Simd_2_3_parties) {
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+    std::srand(std::time(nullptr));
+    for (auto number_of_parties : {2u, 3u}) {
+      const std::size_t output_owner = std::rand() % number_of_parties;
+      std::vector<std::vector<encrypto::motion::BitVector<>>> global_input_10_64_bit(
+          number_of_parties);
+      for (auto& bv_v : global_input_10_64_bit) {
+        bv_v.resize(64);
+        for (auto& bv : bv_v) {
+          bv = encrypto::motion::BitVector<>::SecureRandom(10);
+        }
+      }
+      std::vector<encrypto::motion::BitVector<>> dummy_input_10_64_bit(
+          64, encrypto::motion::BitVector<>(10, false));
+
+      try {
+        std::vector<PartyPointer> motion_parties(
+            std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+        for (auto& party : motion_parties) {
+          party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+          party->GetConfiguration()->SetOnlineAfterSetup(i % 2 == 1);
+          party->GetConfiguration()->SetStreamingEvaluation(true);
+        }
+#pragma omp parallel for num_threads(motion_parties.size() + 1)
+        for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+          std::vector<encrypto::motion::ShareWrapper> share_input;
+
+          for (auto j = 0ull; j < number_of_parties; ++j) {
+            if (j == motion_parties.at(party_id)->GetConfiguration()->GetMyId()) {
+              share_input.push_back(
+                  motion_parties.at(party_id)->In<kBooleanGmw>(global_input_10_64_bit.at(j), j));
+            } else {
+              share_input.push_back(
+                  motion_parties.at(party_id)->In<kBooleanGmw>(dummy_input_10_64_bit, j));
+            }
+          }
+
+          // only the gates and shares refer to the intermediate wires
+          std::vector<std::weak_ptr<encrypto::motion::Wire>> intermediate_wires;
+          auto share_result = (share_input.at(0) & share_input.at(1)) ^ share_input.at(1);
+          for (auto j = 2ull; j < 4 * number_of_parties; ++j) {
+            const auto& x = share_input.at(j % number_of_parties);
+            for (auto& wire : share_result->GetWires()) {
+              intermediate_wires.emplace_back(wire);
+            }
+            share_result = (share_result & x) ^ x;
+          }
+
+          auto share_output = share_result.Out(output_owner);
+
+          motion_parties.at(party_id)->Run();
+
+          if (party_id == output_owner) {
+            for (auto j = 0ull; j < global_input_10_64_bit.size(); ++j) {
+              auto wire_single =
+                  std::dynamic_pointer_cast<encrypto::motion::proto::boolean_gmw::Wire>(
+                      share_output->GetWires().at(j));
+              assert(wire_single);
+
+              auto expected_result = (global_input_10_64_bit.at(0).at(j) &
+                                      global_input_10_64_bit.at(1).at(j)) ^
+                                     global_input_10_64_bit.at(1).at(j);
+              for (auto k = 2ull; k < 4 * number_of_parties; ++k) {
+                const auto& x = global_input_10_64_bit.at(k % number_of_parties).at(j);
+                expected_result = (expected_result & x) ^ x;
+              }
+
+              EXPECT_EQ(wire_single->GetValues(), expected_result);
+            }
+          }
+
+          // all gates are released after their evaluation, and with them the intermediate wires
+          for (const auto& gate :
+               motion_parties.at(party_id)->GetBackend()->GetRegister()->GetGates()) {
+            EXPECT_FALSE(gate);
+          }
+          for (const auto& wire : intermediate_wires) {
+            EXPECT_TRUE(wire.expired());
+          }
+
+          motion_parties.at(party_id)->Finish();
+        }
+      } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+      }
+    }
+  }
+}
+
 TEST(BooleanGmw, Or_1_bit_1_1K_Simd_2_3_parties) {
   for (auto i = 0ull; i < kTestIterations; ++i) {
     constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
@@ -860,3 +1175,67 @@ TEST(BooleanGmw, Or_64_bit_10_Simd_2_3_parties) {
     }
   }
 }
+
+TEST(BooleanGmw, CircuitGate_10_Simd_2_3_parties) {
+  // w3 = w0 & w1, w4 = w3 | w2, w5 = ~w4, w6 = w5 ^ w0, w7 = w6 & w3; outputs are w6 and w7
+  auto algorithm = std::make_shared<AlgorithmDescription>();
+  algorithm->number_of_input_wires_parent_a = 3;
+  algorithm->number_of_output_wires = 2;
+  algorithm->number_of_wires = 8;
+  algorithm->gates = {{PrimitiveOperationType::kAnd, 0, 1, std::nullopt, 3},
+                      {PrimitiveOperationType::kOr, 3, 2, std::nullopt, 4},
+                      {PrimitiveOperationType::kInv, 4, std::nullopt, std::nullopt, 5},
+                      {PrimitiveOperationType::kXor, 5, 0, std::nullopt, 6},
+                      {PrimitiveOperationType::kAnd, 6, 3, std::nullopt, 7}};
+  algorithm->number_of_gates = algorithm->gates.size();
+  algorithm->ComputeLayers();
+
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+    std::srand(std::time(nullptr));
+    for (auto number_of_parties : {2u, 3u}) {
+      const std::size_t input_owner = std::rand() % number_of_parties,
+                        output_owner = std::rand() % number_of_parties;
+      std::vector<BitVector<>> global_input(3), dummy_input(3, BitVector<>(10, false));
+      for (auto& bv : global_input) bv = BitVector<>::SecureRandom(10);
+
+      const auto w3 = global_input.at(0) & global_input.at(1);
+      const auto w6 = ~(w3 | global_input.at(2)) ^ global_input.at(0);
+      const std::vector<BitVector<>> expected_output{w6, w6 & w3};
+
+      try {
+        std::vector<PartyPointer> motion_parties(
+            std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+        for (auto& party : motion_parties) {
+          party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+          party->GetConfiguration()->SetOnlineAfterSetup(i % 2 == 1);
+        }
+#pragma omp parallel for num_threads(motion_parties.size() + 1)
+        for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+          const bool is_input_owner =
+              motion_parties.at(party_id)->GetConfiguration()->GetMyId() == input_owner;
+          ShareWrapper share_input = motion_parties.at(party_id)->In<kBooleanGmw>(
+              is_input_owner ? global_input : dummy_input, input_owner);
+
+          auto share_output = share_input.Evaluate(algorithm).Out(output_owner);
+
+          motion_parties.at(party_id)->Run();
+
+          if (party_id == output_owner) {
+            ASSERT_EQ(share_output->GetWires().size(), expected_output.size());
+            for (auto j = 0ull; j < expected_output.size(); ++j) {
+              auto wire_single = std::dynamic_pointer_cast<proto::boolean_gmw::Wire>(
+                  share_output->GetWires().at(j));
+              assert(wire_single);
+              EXPECT_EQ(wire_single->GetValues(), expected_output.at(j));
+            }
+          }
+
+          motion_parties.at(party_id)->Finish();
+        }
+      } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+      }
+    }
+  }
+}
@@ -27,6 +27,7 @@
 
 #include <gtest/gtest.h>
 
+#include "utility/bit_kernels.h"
 #include "utility/bit_vector.h"
 
 #include "test_constants.h"
@@ -689,4 +690,36 @@ TEST(BitVectorAndSpan, HammingWeight) {
     }
   }
 }
+
+TEST(BitKernels, AllLevelsAgree) {
+  using encrypto::motion::BitKernelLevel;
+  using encrypto::motion::BitVector;
+
+  // computes all operations backed by the kernels at the given level
+  const auto compute = [](BitKernelLevel level, const BitVector<>& a, const BitVector<>& b) {
+    encrypto::motion::SetBitKernelLevel(level);
+    const auto size = a.GetSize();
+    std::vector<BitVector<>> results{a ^ b, a & b, a | b, ~a};
+    for (std::size_t from : {std::size_t(1), std::size_t(3), size / 3}) {
+      if (from >= size) continue;
+      results.emplace_back(a.Subset(from, size));
+      auto copy = b;
+      copy.Copy(from, size, a);
+      results.emplace_back(std::move(copy));
+    }
+    return results;
+  };
+
+  const auto supported_level = encrypto::motion::GetSupportedBitKernelLevel();
+  for (std::size_t size : {1, 7, 9, 63, 65, 255, 257, 511, 513, 1000, 4099, 100'003}) {
+    const auto a = BitVector<>::SecureRandom(size);
+    const auto b = BitVector<>::SecureRandom(size);
+    const auto expected = compute(BitKernelLevel::kScalar, a, b);
+    for (auto level : {BitKernelLevel::kAvx2, BitKernelLevel::kAvx512}) {
+      EXPECT_EQ(compute(level, a, b), expected);
+    }
+  }
+  encrypto::motion::SetBitKernelLevel(supported_level);
+}
+
 }  // namespace
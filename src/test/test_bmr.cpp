@@ -23,14 +23,17 @@
 // SOFTWARE.
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <future>
 #include <random>
+#include <stdexcept>
 #include <vector>
 
 #include <fmt/format.h>
 #include <gtest/gtest.h>
 
+#include "base/compiled_circuit.h"
 #include "base/party.h"
 #include "multiplication_triple/mt_provider.h"
 #include "protocols/bmr/bmr_wire.h"
@@ -605,4 +608,141 @@ INSTANTIATE_TEST_SUITE_P(BMRHeavyTestSuite, BmrHeavyTest,
                                std::get<1>(info.param), std::get<2>(info.param), mode);
                            return name;
                          });
+
+TEST(Bmr, HalfGatesTwoParties) {
+  constexpr auto kBmr = MpcProtocol::kBmr;
+  constexpr auto kBooleanGmw = MpcProtocol::kBooleanGmw;
+  constexpr std::size_t kNumberOfParties = 2, kNumberOfWires = 4, kNumberOfSimd = 10;
+  constexpr std::size_t kOutputOwner = 1;
+
+  for (const bool online_after_setup : {false, true}) {
+    std::array<std::vector<BitVector<>>, kNumberOfParties + 1> global_input;
+    for (auto& input : global_input) {
+      input.resize(kNumberOfWires);
+      for (auto& bv : input) bv = BitVector<>::SecureRandom(kNumberOfSimd);
+    }
+    const std::vector<BitVector<>> dummy_input(kNumberOfWires, BitVector<>(kNumberOfSimd));
+
+    std::vector<PartyPointer> motion_parties(
+        MakeLocallyConnectedParties(kNumberOfParties, kPortOffset));
+    for (auto& party : motion_parties) {
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      party->GetConfiguration()->SetOnlineAfterSetup(online_after_setup);
+      party->GetConfiguration()->SetBmrHalfGates(true);
+    }
+    std::vector<std::thread> threads;
+    for (auto party_id = 0u; party_id < kNumberOfParties; ++party_id) {
+      threads.emplace_back([party_id, &motion_parties, &global_input, &dummy_input]() {
+        auto& party = motion_parties.at(party_id);
+        // party 0 provides a and c, party 1 provides b
+        ShareWrapper a = party->In<kBmr>(party_id == 0 ? global_input.at(0) : dummy_input, 0);
+        ShareWrapper b = party->In<kBmr>(party_id == 1 ? global_input.at(1) : dummy_input, 1);
+        ShareWrapper c = party->In<kBmr>(party_id == 0 ? global_input.at(2) : dummy_input, 0);
+
+        const auto a_and_b = a & b;
+        const auto result = ~((a_and_b ^ c) & a) & (b ^ c);
+        auto output_bmr = result.Out(kOutputOwner);
+        auto output_gmw = a_and_b.Convert<kBooleanGmw>().Out(kOutputOwner);
+
+        party->Run();
+
+        if (party_id == kOutputOwner) {
+          for (auto wire_i = 0ull; wire_i < kNumberOfWires; ++wire_i) {
+            const auto& input_a = global_input.at(0).at(wire_i);
+            const auto& input_b = global_input.at(1).at(wire_i);
+            const auto& input_c = global_input.at(2).at(wire_i);
+            const auto expected_and = input_a & input_b;
+            const auto expected = ~((expected_and ^ input_c) & input_a) & (input_b ^ input_c);
+
+            const auto bmr_wire =
+                std::dynamic_pointer_cast<proto::bmr::Wire>(output_bmr->GetWires().at(wire_i));
+            const auto gmw_wire = std::dynamic_pointer_cast<proto::boolean_gmw::Wire>(
+                output_gmw->GetWires().at(wire_i));
+            assert(bmr_wire);
+            assert(gmw_wire);
+            EXPECT_EQ(bmr_wire->GetPublicValues(), expected);
+            EXPECT_EQ(gmw_wire->GetValues(), expected_and);
+          }
+        }
+        party->Finish();
+      });
+    }
+    for (auto& t : threads) t.join();
+  }
+}
+
+TEST(Bmr, AndTwoRepetitions) {
+  constexpr auto kBmr = MpcProtocol::kBmr;
+  constexpr std::size_t kNumberOfParties = 3, kNumberOfWires = 4, kNumberOfSimd = 10;
+  constexpr std::size_t kOutputOwner = 2;
+
+  // the batched C-OTs of the AND gates must be reset between the evaluations
+  for (const bool online_after_setup : {false, true}) {
+    std::array<std::vector<BitVector<>>, kNumberOfParties> global_input;
+    for (auto& input : global_input) {
+      input.resize(kNumberOfWires);
+      for (auto& bv : input) bv = BitVector<>::SecureRandom(kNumberOfSimd);
+    }
+    const std::vector<BitVector<>> dummy_input(kNumberOfWires, BitVector<>(kNumberOfSimd));
+
+    std::vector<PartyPointer> motion_parties(
+        MakeLocallyConnectedParties(kNumberOfParties, kPortOffset));
+    for (auto& party : motion_parties) {
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      party->GetConfiguration()->SetOnlineAfterSetup(online_after_setup);
+    }
+    std::vector<std::thread> threads;
+    for (auto party_id = 0u; party_id < kNumberOfParties; ++party_id) {
+      threads.emplace_back([party_id, &motion_parties, &global_input, &dummy_input]() {
+        auto& party = motion_parties.at(party_id);
+        ShareWrapper result = party->In<kBmr>(party_id == 0 ? global_input.at(0) : dummy_input, 0);
+        for (auto j = 1u; j < kNumberOfParties; ++j) {
+          result = result & party->In<kBmr>(party_id == j ? global_input.at(j) : dummy_input, j);
+        }
+        auto output = result.Out(kOutputOwner);
+
+        party->Run(2);
+
+        if (party_id == kOutputOwner) {
+          for (auto wire_i = 0ull; wire_i < kNumberOfWires; ++wire_i) {
+            std::vector<BitVector<>> global_input_single;
+            for (const auto& input : global_input) global_input_single.push_back(input.at(wire_i));
+            const auto bmr_wire =
+                std::dynamic_pointer_cast<proto::bmr::Wire>(output->GetWires().at(wire_i));
+            assert(bmr_wire);
+            EXPECT_EQ(bmr_wire->GetPublicValues(), BitVector<>::AndBitVectors(global_input_single));
+          }
+        }
+        party->Finish();
+      });
+    }
+    for (auto& t : threads) t.join();
+  }
+}
+
+TEST(Bmr, CompiledCircuit_AndRejectsSecondEvaluation) {
+  constexpr auto kBmr = MpcProtocol::kBmr;
+  constexpr std::size_t kNumberOfParties = 2, kNumberOfSimd = 10;
+
+  // the OTs of the AND gate are only generated once, so it cannot be evaluated again
+  std::vector<PartyPointer> motion_parties(
+      MakeLocallyConnectedParties(kNumberOfParties, kPortOffset));
+  std::vector<std::future<void>> futures;
+  for (auto party_id = 0u; party_id < kNumberOfParties; ++party_id) {
+    futures.emplace_back(std::async(std::launch::async, [party_id, &motion_parties] {
+      auto& party = motion_parties.at(party_id);
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      CompiledCircuit circuit(*party);
+      const std::vector<BitVector<>> input(1, BitVector<>::SecureRandom(kNumberOfSimd));
+      const ShareWrapper a = party->In<kBmr>(input, 0), b = party->In<kBmr>(input, 1);
+      auto output = (a & b).Out();
+
+      circuit.Evaluate();
+      EXPECT_THROW(circuit.Evaluate(), std::logic_error);
+      EXPECT_EQ(circuit.GetNumberOfEvaluations(), 1u);
+      party->Finish();
+    }));
+  }
+  for (auto& f : futures) f.get();
+}
 }  // namespace
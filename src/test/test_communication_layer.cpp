@@ -24,6 +24,7 @@
 #include <boost/log/trivial.hpp>
 
 #include "communication/communication_layer.h"
+#include "communication/message_buffer.h"
 #include "communication/message_handler.h"
 #include "utility/logger.h"
 
@@ -90,6 +91,80 @@ TEST(CommunicationLayer, Dummy) {
   std::for_each(std::begin(futures), std::end(futures), [](auto& f) { f.get(); });
 }
 
+TEST(CommunicationLayer, MessageBatching) {
+  constexpr std::size_t kNumberOfMessages = 100;
+  auto communication_layers = encrypto::motion::communication::MakeDummyCommunicationLayers(2);
+  auto& communication_layer_alice = communication_layers.at(0);
+  auto& communication_layer_bob = communication_layers.at(1);
+
+  communication_layer_alice->SetMessageBatching(1024, std::chrono::milliseconds(10));
+  communication_layer_bob->RegisterFallbackMessageHandler([](auto party_id) {
+    return std::make_shared<encrypto::motion::communication::QueueHandler>();
+  });
+  auto& queue_handler_bob = dynamic_cast<encrypto::motion::communication::QueueHandler&>(
+      communication_layer_bob->GetFallbackMessageHandler(0));
+
+  std::for_each(std::begin(communication_layers), std::end(communication_layers),
+                [](auto& cl) { cl->Start(); });
+
+  for (std::size_t i = 0; i < kNumberOfMessages; ++i) {
+    std::vector<std::uint8_t> message = {0xde, 0xad, 0xbe, static_cast<std::uint8_t>(i)};
+    communication_layer_alice->SendMessage(1, std::move(message));
+  }
+  // messages arrive unpacked and in order
+  for (std::size_t i = 0; i < kNumberOfMessages; ++i) {
+    auto received_message = queue_handler_bob.GetQueue().dequeue();
+    EXPECT_EQ(received_message,
+              (std::vector<std::uint8_t>{0xde, 0xad, 0xbe, static_cast<std::uint8_t>(i)}));
+  }
+
+  // shutdown all commmunication layers
+  std::vector<std::future<void>> futures;
+  for (auto& cl : communication_layers) {
+    futures.emplace_back(std::async(std::launch::async, [&cl] { cl->Shutdown(); }));
+  }
+  std::for_each(std::begin(futures), std::end(futures), [](auto& f) { f.get(); });
+
+  const auto statistics_alice = communication_layer_alice->GetTransportStatistics().at(0);
+  const auto statistics_bob = communication_layer_bob->GetTransportStatistics().at(0);
+  EXPECT_GE(statistics_alice.number_of_batches_sent, 1);
+  EXPECT_LT(statistics_alice.number_of_messages_sent, kNumberOfMessages);
+  EXPECT_EQ(statistics_alice.number_of_batches_sent, statistics_bob.number_of_batches_received);
+  EXPECT_EQ(statistics_alice.number_of_batched_messages_sent,
+            statistics_bob.number_of_batched_messages_received);
+}
+
+TEST(MessageBuffer, SliceAndPoolReuse) {
+  using encrypto::motion::communication::BufferPool;
+  using encrypto::motion::communication::MessageBuffer;
+
+  BufferPool pool;
+  MessageBuffer slice;
+  {
+    auto buffer = pool.Allocate(8);
+    ASSERT_EQ(buffer.size(), 8);
+    for (std::size_t i = 0; i < buffer.size(); ++i) buffer.data()[i] = static_cast<std::uint8_t>(i);
+    slice = buffer.Slice(2, 4);
+  }
+  // the slice keeps the memory alive after the original buffer is gone
+  EXPECT_EQ(std::vector<std::uint8_t>(slice.begin(), slice.end()),
+            (std::vector<std::uint8_t>{2, 3, 4, 5}));
+  EXPECT_EQ(std::move(slice).ReleaseVector(), (std::vector<std::uint8_t>{2, 3, 4, 5}));
+  slice = MessageBuffer();
+
+  // the memory has been returned to the pool and is reused for the next allocation
+  auto buffer = pool.Allocate(4);
+  EXPECT_EQ(buffer.size(), 4);
+  EXPECT_EQ(pool.GetNumberOfAllocations(), 1);
+  EXPECT_EQ(pool.GetNumberOfReuses(), 1);
+
+  // a buffer owning a vector releases it without copying
+  std::vector<std::uint8_t> vector{1, 2, 3};
+  const auto* data = vector.data();
+  auto released = MessageBuffer(std::move(vector)).ReleaseVector();
+  EXPECT_EQ(released.data(), data);
+}
+
 class CommunicationLayerTest : public testing::TestWithParam<bool> {};
 
 TEST_P(CommunicationLayerTest, Tcp) {
@@ -215,7 +215,7 @@ class ArithmeticConversionTest : public testing::TestWithParam<ArithmeticConvers
 
 template <typename T>
 void A2YRun(const std::size_t number_of_parties, const std::size_t number_of_simd,
-            const bool online_after_setup) {
+            const bool online_after_setup, const std::size_t maximum_number_of_fibers = 0) {
   constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
   std::srand(0);
   std::mt19937 mersenne_twister(0);
@@ -237,6 +237,7 @@ void A2YRun(const std::size_t number_of_parties, const std::size_t number_of_sim
     for (auto& party : motion_parties) {
       party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
       party->GetConfiguration()->SetOnlineAfterSetup(online_after_setup);
+      party->GetConfiguration()->SetMaximumNumberOfFibers(maximum_number_of_fibers);
     }
     std::vector<std::thread> threads;
     for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
@@ -293,6 +294,16 @@ TEST_P(ArithmeticConversionTest, A2Y_64_bit) {
   A2YRun<std::uint64_t>(this->number_of_parties_, this->number_of_simd_, this->online_after_setup_);
 }
 
+// the BMR input gates of the conversion wait for the conversion gate, which is registered after the
+// BMR addition circuit summing their outputs
+TEST(ArithmeticConversion, A2Y_16_bit_BoundedFibers) {
+  for (const std::size_t maximum_number_of_fibers : {1u, 2u}) {
+    for (const bool online_after_setup : {false, true}) {
+      A2YRun<std::uint16_t>(3, 10, online_after_setup, maximum_number_of_fibers);
+    }
+  }
+}
+
 template <typename T>
 void A2BRun(const std::size_t number_of_parties, const std::size_t number_of_simd,
             const bool online_after_setup) {
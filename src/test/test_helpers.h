@@ -40,3 +40,11 @@ inline std::vector<T> RandomVector(std::size_t size) {
   std::generate(v.begin(), v.end(), Rand<T>);
   return v;
 }
+
+// The heap memory allocated with operator new by the test binary is counted in
+// test_motion_main.cpp. Sets the baseline for GetPeakHeapMemory to the memory currently allocated.
+void ResetPeakHeapMemory();
+
+// Returns the peak of the heap memory allocated since the last ResetPeakHeapMemory() call minus
+// the memory allocated at that call, in bytes.
+std::size_t GetPeakHeapMemory();
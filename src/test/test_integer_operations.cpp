@@ -22,6 +22,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <random>
 
@@ -79,6 +81,89 @@ TEST(AlgorithmDescription, FromBristolFormatIntAdd8Size) {
   EXPECT_EQ(gate33.selection_bit.has_value(), false);
 }
 
+TEST(AlgorithmDescription, BinaryFormatRoundTrip) {
+  auto aes = encrypto::motion::AlgorithmDescription::FromBristol(
+      std::string(encrypto::motion::kRootDir) + "/circuits/advanced/aes_128.bristol");
+  aes.ComputeLayers();
+  ASSERT_FALSE(aes.layer_offsets.empty());
+  EXPECT_EQ(aes.layer_offsets.front(), 0);
+  EXPECT_EQ(aes.layer_offsets.back(), aes.gates.size());
+  EXPECT_GT(aes.depth, 0);
+
+  const auto path = (std::filesystem::temp_directory_path() / "motion_test_aes_128.bin").string();
+  aes.ToBinary(path);
+  const auto binary_aes = encrypto::motion::AlgorithmDescription::FromBinary(path);
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(binary_aes.number_of_gates, aes.number_of_gates);
+  EXPECT_EQ(binary_aes.number_of_wires, aes.number_of_wires);
+  EXPECT_EQ(binary_aes.number_of_input_wires_parent_a, aes.number_of_input_wires_parent_a);
+  EXPECT_EQ(binary_aes.number_of_input_wires_parent_b, aes.number_of_input_wires_parent_b);
+  EXPECT_EQ(binary_aes.number_of_output_wires, aes.number_of_output_wires);
+  EXPECT_EQ(binary_aes.depth, aes.depth);
+  EXPECT_EQ(binary_aes.layer_offsets, aes.layer_offsets);
+  ASSERT_EQ(binary_aes.gates.size(), aes.gates.size());
+  for (std::size_t i = 0; i < aes.gates.size(); ++i) {
+    EXPECT_EQ(binary_aes.gates[i].type, aes.gates[i].type);
+    EXPECT_EQ(binary_aes.gates[i].parent_a, aes.gates[i].parent_a);
+    EXPECT_EQ(binary_aes.gates[i].parent_b, aes.gates[i].parent_b);
+    EXPECT_EQ(binary_aes.gates[i].selection_bit, aes.gates[i].selection_bit);
+    EXPECT_EQ(binary_aes.gates[i].output_wire, aes.gates[i].output_wire);
+  }
+}
+
+TEST(AlgorithmDescription, BinaryFormatRejectsOutOfRangeIndices) {
+  using encrypto::motion::AlgorithmDescription;
+  const auto int_add8 = AlgorithmDescription::FromBristol(
+      std::string(encrypto::motion::kRootDir) + "/circuits/int/int_add8_size.bristol");
+  const auto path = (std::filesystem::temp_directory_path() / "motion_test_int_add8.bin").string();
+  // overwrites the 4 or 8 bytes at offset of a freshly written binary circuit
+  const auto write_corrupt = [&](std::streamoff offset, auto value) {
+    int_add8.ToBinary(path);
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offset >= 0 ? offset : std::filesystem::file_size(path) + offset);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  constexpr std::streamoff kHeaderSize = 72;
+
+  // the output wire of the last gate
+  write_corrupt(-4, static_cast<std::uint32_t>(int_add8.number_of_wires));
+  EXPECT_THROW(AlgorithmDescription::FromBinary(path), std::runtime_error);
+  // the first layer offset
+  write_corrupt(kHeaderSize, std::uint64_t{1});
+  EXPECT_THROW(AlgorithmDescription::FromBinary(path), std::runtime_error);
+  // the number of layers, s.t. the expected file size overflows
+  write_corrupt(kHeaderSize - 8, ~std::uint64_t{0});
+  EXPECT_THROW(AlgorithmDescription::FromBinary(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(AlgorithmDescription, StaleBinaryCircuitIsRegenerated) {
+  using encrypto::motion::AlgorithmDescription;
+  const auto directory = std::filesystem::temp_directory_path() / "motion_test_stale_circuit";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  const auto bristol_path = (directory / "int_add8_size.bristol").string();
+  std::filesystem::copy_file(
+      std::string(encrypto::motion::kRootDir) + "/circuits/int/int_add8_size.bristol",
+      bristol_path);
+  // a binary circuit of a different circuit that is older than the Bristol circuit
+  const auto binary_path = AlgorithmDescription::GetBinaryPath(bristol_path);
+  AlgorithmDescription::FromBristol(std::string(encrypto::motion::kRootDir) +
+                                    "/circuits/int/int_add16_size.bristol")
+      .ToBinary(binary_path);
+  std::filesystem::last_write_time(
+      binary_path, std::filesystem::last_write_time(bristol_path) - std::chrono::hours(1));
+
+  const auto int_add8 = AlgorithmDescription::FromBristol(bristol_path);
+  const auto loaded = AlgorithmDescription::FromBristolOrBinary(bristol_path);
+  EXPECT_EQ(loaded.number_of_gates, int_add8.number_of_gates);
+  EXPECT_FALSE(loaded.layer_offsets.empty());
+  EXPECT_EQ(AlgorithmDescription::FromBinary(binary_path).number_of_gates,
+            int_add8.number_of_gates);
+  std::filesystem::remove_all(directory);
+}
+
 // TODO: rewrite as generic tests
 template <typename T>
 class SecureUintTest : public ::testing::Test {
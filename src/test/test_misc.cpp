@@ -28,9 +28,12 @@
 
 #include <gtest/gtest.h>
 
+#include "statistics/trace.h"
 #include "test_constants.h"
 #include "utility/bit_vector.h"
 #include "utility/condition.h"
+#include "utility/fiber_condition.h"
+#include "utility/helpers.h"
 
 namespace {
 TEST(Condition, WaitNotifyOne) {
@@ -199,6 +202,76 @@ TEST(Condition, WaitForComplexFunction) {
   ASSERT_TRUE(wait_2.get());
 }
 
+TEST(Tracer, GateAndWaitEvents) {
+  using encrypto::motion::TraceCategory;
+  encrypto::motion::Tracer tracer(0);
+
+  // disabled tracers do not record anything
+  { encrypto::motion::GateTraceScope scope(&tracer, TraceCategory::kGateOnline, 1); }
+  EXPECT_TRUE(tracer.GetEvents().empty());
+
+  tracer.SetEnabled();
+  bool ready = false;
+  encrypto::motion::FiberCondition condition([&ready] { return ready; });
+  std::thread notifier([&condition, &ready] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    {
+      std::scoped_lock lock(condition.GetMutex());
+      ready = true;
+    }
+    condition.NotifyAll();
+  });
+  {
+    encrypto::motion::GateTraceScope scope(&tracer, TraceCategory::kGateOnline, 42);
+    condition.Wait();
+  }
+  notifier.join();
+  // waits outside of a gate are not recorded
+  condition.Wait();
+
+  const auto events = tracer.GetEvents();
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_TRUE(events.at(0).category == TraceCategory::kGateOnline);
+  EXPECT_EQ(events.at(0).id, 42);
+  EXPECT_TRUE(events.at(1).category == TraceCategory::kWait);
+  EXPECT_EQ(events.at(1).id, 42);
+  EXPECT_LE(events.at(0).begin, events.at(1).begin);
+  EXPECT_LE(events.at(1).end, events.at(0).end);
+
+  tracer.Clear();
+  EXPECT_TRUE(tracer.GetEvents().empty());
+}
+
+TEST(Helpers, InPlaceVectorKernels) {
+  auto f = [](auto type_value) {
+    using T = decltype(type_value);
+    constexpr std::size_t kSize = 1001;
+    const auto a{encrypto::motion::RandomVector<T>(kSize)};
+    const auto b{encrypto::motion::RandomVector<T>(kSize)};
+    std::vector<T> output(kSize);
+
+    encrypto::motion::AddVectors<T>(a, b, output);
+    for (std::size_t i = 0; i < kSize; ++i) EXPECT_EQ(output.at(i), T(a.at(i) + b.at(i)));
+    encrypto::motion::SubVectors<T>(a, b, output);
+    for (std::size_t i = 0; i < kSize; ++i) EXPECT_EQ(output.at(i), T(a.at(i) - b.at(i)));
+    encrypto::motion::MultiplyVectors<T>(a, b, output);
+    for (std::size_t i = 0; i < kSize; ++i) EXPECT_EQ(output.at(i), T(a.at(i) * b.at(i)));
+
+    // the output may be one of the inputs
+    output = a;
+    encrypto::motion::AddVectors<T>(output, b, output);
+    EXPECT_EQ(output, encrypto::motion::AddVectors(a, b));
+
+    encrypto::motion::RowSumReduction<T>({a, b, a}, output);
+    for (std::size_t i = 0; i < kSize; ++i) EXPECT_EQ(output.at(i), T(a.at(i) + b.at(i) + a.at(i)));
+  };
+  f(std::uint8_t{});
+  f(std::uint16_t{});
+  f(std::uint32_t{});
+  f(std::uint64_t{});
+  f(__uint128_t{});
+}
+
 TEST(InputOutputUnVectorization, UnsignedIntegers) {
   constexpr std::uint8_t kV8 = 156;
   constexpr std::uint8_t kV8Min = std::numeric_limits<std::uint8_t>::min();
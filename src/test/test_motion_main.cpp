@@ -23,6 +23,47 @@
 // SOFTWARE.
 
 #include <gtest/gtest.h>
+#include <malloc.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "test_helpers.h"
+
+namespace {
+
+std::atomic<std::size_t> heap_memory = 0;
+std::atomic<std::size_t> peak_heap_memory = 0;
+std::atomic<std::size_t> baseline_heap_memory = 0;
+
+}  // namespace
+
+// count the heap memory, such that tests can check how much memory is alive at the same time
+void* operator new(std::size_t size) {
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr) throw std::bad_alloc();
+  const auto size_of_allocation = malloc_usable_size(pointer);
+  const auto memory = heap_memory.fetch_add(size_of_allocation) + size_of_allocation;
+  auto peak = peak_heap_memory.load();
+  while (memory > peak && !peak_heap_memory.compare_exchange_weak(peak, memory)) {
+  }
+  return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+  if (pointer == nullptr) return;
+  heap_memory.fetch_sub(malloc_usable_size(pointer));
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept { operator delete(pointer); }
+
+void ResetPeakHeapMemory() {
+  baseline_heap_memory = heap_memory.load();
+  peak_heap_memory = baseline_heap_memory.load();
+}
+
+std::size_t GetPeakHeapMemory() { return peak_heap_memory - baseline_heap_memory; }
 
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -26,8 +26,13 @@
 
 #include "test_constants.h"
 
+#include <filesystem>
+
+#include <fmt/format.h>
+
 #include "base/party.h"
 #include "multiplication_triple/mt_provider.h"
+#include "multiplication_triple/preprocessing_store.h"
 namespace {
 
 constexpr auto kNumberOfPartiesList = {2u, 3u};
@@ -154,4 +159,81 @@ TEST(MultiplicationTriples, Integer) {
   TemplateTestInteger<std::uint64_t>();
 }
 
+TEST(MultiplicationTriples, PreprocessingStore) {
+  constexpr std::size_t kNumberOfParties = 2;
+  constexpr std::size_t kNumberOfMts = 128;
+  const auto get_path = [](std::size_t party_id) {
+    return (std::filesystem::temp_directory_path() /
+            fmt::format("motion_test_preprocessing_{}.bin", party_id))
+        .string();
+  };
+
+  encrypto::motion::PreprocessingDemand demand;
+  demand.number_of_binary_mts = kNumberOfMts;
+  demand.number_of_mts_64 = kNumberOfMts;
+  {
+    auto motion_parties =
+        encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, kPortOffset);
+    std::vector<std::future<void>> futures;
+    for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+      futures.emplace_back(std::async(std::launch::async, [&, party_id] {
+        auto& party = motion_parties.at(party_id);
+        party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        party->PrecomputePreprocessing(demand, get_path(party_id));
+        party->Finish();
+      }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+  }
+
+  // consume the store in two runs which use half of the MTs each
+  for (std::size_t run = 0; run < 2; ++run) {
+    auto motion_parties =
+        encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, kPortOffset);
+    std::vector<std::future<void>> futures;
+    for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+      futures.emplace_back(std::async(std::launch::async, [&, party_id] {
+        auto& party = motion_parties.at(party_id);
+        party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        party->LoadPreprocessing(get_path(party_id));
+        auto& mt_provider = party->GetBackend()->GetMtProvider();
+        mt_provider->RequestBinaryMts(kNumberOfMts / 2);
+        mt_provider->RequestArithmeticMts<std::uint64_t>(kNumberOfMts / 2);
+        mt_provider->PreSetup();
+        mt_provider->Setup();
+        party->Finish();
+      }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+
+    const auto& mt_provider_0 = motion_parties.at(0)->GetBackend()->GetMtProvider();
+    const auto& mt_provider_1 = motion_parties.at(1)->GetBackend()->GetMtProvider();
+    const auto& binary_mts_0 = mt_provider_0->GetBinaryAll();
+    const auto& binary_mts_1 = mt_provider_1->GetBinaryAll();
+    EXPECT_EQ(binary_mts_0.a.GetSize(), kNumberOfMts / 2);
+    EXPECT_EQ(binary_mts_0.c ^ binary_mts_1.c,
+              (binary_mts_0.a ^ binary_mts_1.a) & (binary_mts_0.b ^ binary_mts_1.b));
+
+    const auto& mts_0 = mt_provider_0->GetIntegerAll<std::uint64_t>();
+    const auto& mts_1 = mt_provider_1->GetIntegerAll<std::uint64_t>();
+    EXPECT_EQ(mts_0.a.size(), kNumberOfMts / 2);
+    for (std::size_t k = 0; k < mts_0.a.size(); ++k) {
+      EXPECT_EQ(mts_0.c.at(k) + mts_1.c.at(k),
+                (mts_0.a.at(k) + mts_1.a.at(k)) * (mts_0.b.at(k) + mts_1.b.at(k)));
+    }
+  }
+
+  // all MTs were consumed
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    using Section = encrypto::motion::PreprocessingStore::Section;
+    encrypto::motion::PreprocessingStore store(get_path(party_id), party_id, kNumberOfParties);
+    EXPECT_EQ(store.GetNumberOfAvailable(Section::kBinaryMts), 0u);
+    EXPECT_EQ(store.GetNumberOfAvailable(Section::kMts64), 0u);
+    EXPECT_THROW(store.Consume(Section::kMts64, 1), std::runtime_error);
+  }
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    std::filesystem::remove(get_path(party_id));
+  }
+}
+
 }  // namespace
@@ -30,6 +30,7 @@
 #include "oblivious_transfer/base_ots/base_ot_provider.h"
 #include "oblivious_transfer/ot_flavors.h"
 #include "oblivious_transfer/ot_provider.h"
+#include "oblivious_transfer/silent_ot_provider.h"
 #include "utility/block.h"
 
 class OtFlavorTest : public ::testing::Test {
@@ -128,6 +129,40 @@ TEST_F(OtFlavorTest, FixedXcOt128) {
   }
 }
 
+TEST_F(OtFlavorTest, FixedXcOt128WithSilentOtExtension) {
+  // enough OTs s.t. the silent OT extension does not fall back to IKNP
+  constexpr std::size_t kNumberOfOts = 600'000;
+  ASSERT_TRUE(encrypto::motion::OtProviderFromSilentOt::UseSilentOt(kNumberOfOts));
+  for (auto& ot_provider_wrapper : ot_provider_wrappers_) {
+    ot_provider_wrapper->SetOtExtensionProtocol(encrypto::motion::OtExtensionProtocol::kSilent);
+  }
+  const auto correlation = encrypto::motion::Block128::MakeRandom();
+  const auto choice_bits = encrypto::motion::BitVector<>::SecureRandom(kNumberOfOts);
+  auto ot_sender = GetSenderProvider().RegisterSendFixedXcOt128(kNumberOfOts);
+  auto ot_receiver = GetReceiverProvider().RegisterReceiveFixedXcOt128(kNumberOfOts);
+
+  RunOtExtensionSetup();
+
+  ot_sender->SetCorrelation(correlation);
+  ot_sender->SendMessages();
+
+  ot_receiver->SetChoices(choice_bits);
+  ot_receiver->SendCorrections();
+
+  ot_sender->ComputeOutputs();
+  ot_receiver->ComputeOutputs();
+  const auto sender_output = ot_sender->GetOutputs();
+  const auto receiver_output = ot_receiver->GetOutputs();
+
+  for (std::size_t ot_i = 0; ot_i < kNumberOfOts; ++ot_i) {
+    if (choice_bits.Get(ot_i)) {
+      ASSERT_EQ(receiver_output[ot_i], sender_output[ot_i] ^ correlation);
+    } else {
+      ASSERT_EQ(receiver_output[ot_i], sender_output[ot_i]);
+    }
+  }
+}
+
 TEST_F(OtFlavorTest, XcOtBit) {
   constexpr std::size_t kNumberOfOts = 1000;
   const auto correlations = encrypto::motion::BitVector<>::SecureRandom(kNumberOfOts);
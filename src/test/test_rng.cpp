@@ -23,6 +23,7 @@
 #include "gtest/gtest.h"
 #include "primitives/random/aes128_ctr_rng.h"
 #include "primitives/random/openssl_rng.h"
+#include "primitives/sharing_randomness_generator.h"
 #include "test_constants.h"
 
 // Test vectors from NIST FIPS 197, Appendix A
@@ -80,3 +81,36 @@ TEST(OpenSslRng, NoTrivialOutput) {
   rngt.RandomBlocksAligned(output_1.data(), 10);
   EXPECT_NE(output_0, output_1);
 }
+
+TEST(SharingRandomnessGenerator, BulkRandomnessIsConsistent) {
+  std::array<std::uint8_t, encrypto::motion::primitives::SharingRandomnessGenerator::
+                               kMasterSeedByteLength>
+      seed;
+  for (std::size_t i = 0; i < seed.size(); ++i) seed[i] = static_cast<std::uint8_t>(i);
+  encrypto::motion::primitives::SharingRandomnessGenerator generator_0(0), generator_1(1);
+  generator_0.Initialize(seed.data());
+  generator_1.Initialize(seed.data());
+
+  // both parties derive the same randomness from the same seed
+  constexpr std::size_t kNumberOfValues = 1000;
+  std::vector<std::uint32_t> values_0(kNumberOfValues), values_1(kNumberOfValues);
+  generator_0.FillUnsigned<std::uint32_t>(42, values_0);
+  generator_1.FillUnsigned<std::uint32_t>(42, values_1);
+  EXPECT_EQ(values_0, values_1);
+  // the value of a sharing id does not depend on the size of the request
+  for (std::size_t i = 0; i < kNumberOfValues; i += 99) {
+    EXPECT_EQ(values_0.at(i), generator_1.GetUnsigned<std::uint32_t>(42 + i));
+  }
+  EXPECT_NE(values_0.at(0), values_0.at(1));
+
+  constexpr std::size_t kNumberOfBits = 1000;
+  encrypto::motion::BitVector<> bits_0(kNumberOfBits), bits_1(kNumberOfBits);
+  generator_0.FillBits(42, bits_0);
+  generator_1.FillBits(42, bits_1);
+  EXPECT_EQ(bits_0, bits_1);
+  EXPECT_EQ(bits_0, generator_1.GetBits(42, kNumberOfBits));
+  // a truncated request only generates a prefix of the bits
+  EXPECT_EQ(bits_0.Subset(0, 200), generator_1.GetBits(42, 200));
+  EXPECT_NE(bits_0.HammingWeight(), 0);
+  EXPECT_NE(bits_0.HammingWeight(), kNumberOfBits);
+}